@@ -392,6 +392,37 @@ namespace LLC
 	}
 
 
+	/** SK512Lanes
+     *
+     *  Get the total messages SK512Batch hashes at once on this CPU, being 8 with AVX-512, 4 with AVX2, or 1.
+     *
+     **/
+	uint32_t SK512Lanes();
+
+
+	/** SK512Batch
+     *
+     *  Hash a batch of independent messages with SK512, several at a time in the lanes of AVX2 or AVX-512
+     *  registers when the CPU has them, otherwise one at a time. The hashes are not cached.
+     *
+     *  @param[in] vData The pointers to and sizes of the messages.
+     *  @param[out] vHashes The hashes, in the same order as the messages.
+     *
+     **/
+	void SK512Batch(const std::vector<std::pair<const uint8_t*, uint64_t> >& vData, std::vector<uint512_t>& vHashes);
+
+
+	/** SK512Batch
+     *
+     *  Hash a batch of independent messages with SK512.
+     *
+     *  @param[in] vData The messages.
+     *  @param[out] vHashes The hashes, in the same order as the messages.
+     *
+     **/
+	void SK512Batch(const std::vector<std::vector<uint8_t> >& vData, std::vector<uint512_t>& vHashes);
+
+
 	/** SK1024
      *
      *  1024-bit hashing template used to build Block Hashes.
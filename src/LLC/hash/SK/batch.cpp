@@ -0,0 +1,420 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+#include <LLC/hash/SK/skein_iv.h>
+
+#include <algorithm>
+#include <cstring>
+
+/* The multi-buffer kernels use GCC vector extensions with runtime dispatch, so they are only built for x86-64. */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define SK_BATCH_SIMD 1
+    #define SK_INLINE inline __attribute__((always_inline))
+#else
+    #define SK_BATCH_SIMD 0
+#endif
+
+/* Rotate each 64-bit lane left, for scalar or vector types. */
+#define SK_ROTL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+
+namespace LLC
+{
+
+    /* Hash a single message, without the cache. */
+    static void sk512_scalar(const uint8_t* pData, const uint64_t nSize, uint512_t& hashOut)
+    {
+        uint512_t hashSkein;
+        Skein_512_Ctxt_t ctxSkein;
+        Skein_512_Init  (&ctxSkein, 512);
+        Skein_512_Update(&ctxSkein, (nSize == 0 ? pblank : pData), nSize);
+        Skein_512_Final (&ctxSkein, (uint8_t *)&hashSkein);
+
+        Keccak_HashInstance ctxKeccak;
+        Keccak_HashInitialize_SHA3_512(&ctxKeccak);
+        Keccak_HashUpdate(&ctxKeccak, (uint8_t *)&hashSkein, 512);
+        Keccak_HashFinal(&ctxKeccak, (uint8_t *)&hashOut);
+    }
+
+
+#if SK_BATCH_SIMD
+
+    /* Skein-512 tweak flags and block types. */
+    const uint64_t SK_T1_FIRST = SKEIN_T1_FLAG_FIRST;
+    const uint64_t SK_T1_FINAL = SKEIN_T1_FLAG_FINAL;
+    const uint64_t SK_T1_MSG   = SKEIN_T1_BLK_TYPE_MSG;
+    const uint64_t SK_T1_OUT   = SKEIN_T1_BLK_TYPE_OUT;
+
+
+    /* Skein-512 rotation constants, matching skein_block.cpp. */
+    const uint32_t SK_ROTATIONS[8][4] =
+    {
+        {R_512_0_0, R_512_0_1, R_512_0_2, R_512_0_3},
+        {R_512_1_0, R_512_1_1, R_512_1_2, R_512_1_3},
+        {R_512_2_0, R_512_2_1, R_512_2_2, R_512_2_3},
+        {R_512_3_0, R_512_3_1, R_512_3_2, R_512_3_3},
+        {R_512_4_0, R_512_4_1, R_512_4_2, R_512_4_3},
+        {R_512_5_0, R_512_5_1, R_512_5_2, R_512_5_3},
+        {R_512_6_0, R_512_6_1, R_512_6_2, R_512_6_3},
+        {R_512_7_0, R_512_7_1, R_512_7_2, R_512_7_3}
+    };
+
+
+    /* Skein-512 word permutation of each round in a group of four. */
+    const uint32_t SK_PERMUTE[4][8] =
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7},
+        {2, 1, 4, 7, 6, 5, 0, 3},
+        {4, 1, 6, 3, 0, 5, 2, 7},
+        {6, 1, 0, 7, 2, 5, 4, 3}
+    };
+
+
+    /* Keccak-f[1600] round constants. */
+    const uint64_t KECCAK_ROUNDS[24] =
+    {
+        0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+        0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+        0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+        0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+        0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+        0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+    };
+
+
+    /* Keccak-f[1600] rho rotations and pi lanes, in the order the lanes are visited. */
+    const uint32_t KECCAK_RHO[24] = { 1,  3,  6, 10, 15, 21, 28, 36, 45, 55,  2, 14, 27, 41, 56,  8, 25, 43, 62, 18, 39, 61, 20, 44 };
+    const uint32_t KECCAK_PI[24]  = {10,  7, 11, 17, 18,  3,  5, 16,  8, 21, 24,  4, 15, 23, 19, 13, 12,  2, 20, 14, 22,  9,  6,  1 };
+
+
+    /* Vectors of 64-bit lanes, one message per lane. */
+    typedef uint64_t v4u64 __attribute__((vector_size(32)));
+    typedef uint64_t v8u64 __attribute__((vector_size(64)));
+
+
+    /* Set every lane of a vector to a value. */
+    template<typename V>
+    SK_INLINE void sk_set(V& v, const uint64_t n)
+    {
+        const V zero = {};
+        v = zero + n;
+    }
+
+
+    /* Process one Skein-512 block in every lane, with the chaining value in X. */
+    template<typename V>
+    SK_INLINE void skein_block(V* X, const V* w, const V& t0, const uint64_t t1)
+    {
+        /* Build the key schedule. */
+        V ks[9];
+        ks[8] = X[0] ^ X[1] ^ X[2] ^ X[3] ^ X[4] ^ X[5] ^ X[6] ^ X[7] ^ SKEIN_KS_PARITY;
+        for(uint32_t i = 0; i < 8; ++i)
+            ks[i] = X[i];
+
+        V ts[3];
+        ts[0] = t0;
+        ts[2] = t0 ^ t1;
+        sk_set<V>(ts[1], t1);
+
+        /* The first key injection. */
+        V S[8];
+        for(uint32_t i = 0; i < 8; ++i)
+            S[i] = w[i] + ks[i];
+
+        S[5] += ts[0];
+        S[6] += ts[1];
+
+        /* 72 rounds, with a key injection after every four. */
+        for(uint32_t s = 1; s <= 18; ++s)
+        {
+            const uint32_t nGroup = ((s - 1) & 1) * 4;
+            for(uint32_t r = 0; r < 4; ++r)
+            {
+                const uint32_t* p = SK_PERMUTE[r];
+                const uint32_t* n = SK_ROTATIONS[nGroup + r];
+
+                S[p[0]] += S[p[1]]; S[p[1]] = SK_ROTL64(S[p[1]], n[0]); S[p[1]] ^= S[p[0]];
+                S[p[2]] += S[p[3]]; S[p[3]] = SK_ROTL64(S[p[3]], n[1]); S[p[3]] ^= S[p[2]];
+                S[p[4]] += S[p[5]]; S[p[5]] = SK_ROTL64(S[p[5]], n[2]); S[p[5]] ^= S[p[4]];
+                S[p[6]] += S[p[7]]; S[p[7]] = SK_ROTL64(S[p[7]], n[3]); S[p[7]] ^= S[p[6]];
+            }
+
+            for(uint32_t i = 0; i < 8; ++i)
+                S[i] += ks[(s + i) % 9];
+
+            S[5] += ts[s % 3];
+            S[6] += ts[(s + 1) % 3];
+            S[7] += s;
+        }
+
+        /* Feed forward into the chaining value. */
+        for(uint32_t i = 0; i < 8; ++i)
+            X[i] = S[i] ^ w[i];
+    }
+
+
+    /* Run Keccak-f[1600] in every lane. */
+    template<typename V>
+    SK_INLINE void keccak_f1600(V* A)
+    {
+        for(uint32_t nRound = 0; nRound < 24; ++nRound)
+        {
+            /* Theta. */
+            V C[5];
+            for(uint32_t x = 0; x < 5; ++x)
+                C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
+
+            for(uint32_t x = 0; x < 5; ++x)
+            {
+                const V D = C[(x + 4) % 5] ^ SK_ROTL64(C[(x + 1) % 5], 1);
+                for(uint32_t y = 0; y < 25; y += 5)
+                    A[y + x] ^= D;
+            }
+
+            /* Rho and pi. */
+            V T = A[1];
+            for(uint32_t i = 0; i < 24; ++i)
+            {
+                const uint32_t j = KECCAK_PI[i];
+
+                const V B = A[j];
+                A[j] = SK_ROTL64(T, KECCAK_RHO[i]);
+                T = B;
+            }
+
+            /* Chi. */
+            for(uint32_t y = 0; y < 25; y += 5)
+            {
+                for(uint32_t x = 0; x < 5; ++x)
+                    C[x] = A[y + x];
+
+                for(uint32_t x = 0; x < 5; ++x)
+                    A[y + x] ^= (~C[(x + 1) % 5]) & C[(x + 2) % 5];
+            }
+
+            /* Iota. */
+            A[0] ^= KECCAK_ROUNDS[nRound];
+        }
+    }
+
+
+    /* Hash LANES messages that have the same total of Skein blocks, one message in each lane. */
+    template<typename V, uint32_t LANES>
+    SK_INLINE void sk512_lanes(const uint8_t* const* pData, const uint64_t* pSize, uint512_t* pHashes)
+    {
+        /* Skein-512 with a 512-bit output starts from the precomputed chaining value. */
+        V X[8];
+        for(uint32_t i = 0; i < 8; ++i)
+            sk_set<V>(X[i], SKEIN_512_IV_512[i]);
+
+        /* The total of blocks, being at least one for an empty message. */
+        const uint64_t nBlocks = std::max(uint64_t(1), (pSize[0] + SKEIN_512_BLOCK_BYTES - 1) / SKEIN_512_BLOCK_BYTES);
+
+        /* Process the message blocks. */
+        uint64_t aWords[8][LANES] __attribute__((aligned(64)));
+        uint64_t aTweak[LANES]    __attribute__((aligned(64)));
+        for(uint64_t nBlock = 0; nBlock < nBlocks; ++nBlock)
+        {
+            const uint64_t nOffset = nBlock * SKEIN_512_BLOCK_BYTES;
+            for(uint32_t nLane = 0; nLane < LANES; ++nLane)
+            {
+                /* Copy the block with zero padding, since the last one can be short. */
+                uint64_t aBlock[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+                const uint64_t nBytes = std::min(uint64_t(SKEIN_512_BLOCK_BYTES), pSize[nLane] - nOffset);
+                if(nBytes > 0)
+                    std::memcpy(aBlock, pData[nLane] + nOffset, nBytes);
+
+                /* Transpose into one word of each lane. */
+                for(uint32_t i = 0; i < 8; ++i)
+                    aWords[i][nLane] = aBlock[i];
+
+                /* The tweak position is the total of bytes processed including this block. */
+                aTweak[nLane] = nOffset + nBytes;
+            }
+
+            V w[8];
+            for(uint32_t i = 0; i < 8; ++i)
+                std::memcpy(&w[i], aWords[i], sizeof(V));
+
+            V t0;
+            std::memcpy(&t0, aTweak, sizeof(V));
+
+            /* Set the flags for the first and final blocks. */
+            uint64_t t1 = SK_T1_MSG;
+            if(nBlock == 0)
+                t1 |= SK_T1_FIRST;
+
+            if(nBlock + 1 == nBlocks)
+                t1 |= SK_T1_FINAL;
+
+            skein_block<V>(X, w, t0, t1);
+        }
+
+        /* The output block is a zero counter. */
+        {
+            V w[8], t0;
+            for(uint32_t i = 0; i < 8; ++i)
+                sk_set<V>(w[i], 0);
+
+            sk_set<V>(t0, 8);
+            skein_block<V>(X, w, t0, SK_T1_OUT | SK_T1_FIRST | SK_T1_FINAL);
+        }
+
+        /* SHA3-512 of the 64 byte Skein output fits in one block of the sponge. */
+        V A[25];
+        for(uint32_t i = 0; i < 25; ++i)
+            sk_set<V>(A[i], 0);
+
+        for(uint32_t i = 0; i < 8; ++i)
+            A[i] = X[i];
+
+        A[8] ^= 0x8000000000000006ULL;
+        keccak_f1600<V>(A);
+
+        /* Copy the hashes out of the lanes. */
+        for(uint32_t i = 0; i < 8; ++i)
+            std::memcpy(aWords[i], &A[i], sizeof(V));
+
+        for(uint32_t nLane = 0; nLane < LANES; ++nLane)
+        {
+            uint64_t aHash[8];
+            for(uint32_t i = 0; i < 8; ++i)
+                aHash[i] = aWords[i][nLane];
+
+            std::memcpy((uint8_t *)&pHashes[nLane], aHash, sizeof(aHash));
+        }
+    }
+
+
+    /* Hash four messages with AVX2. */
+    __attribute__((target("avx2")))
+    static void sk512_avx2(const uint8_t* const* pData, const uint64_t* pSize, uint512_t* pHashes)
+    {
+        sk512_lanes<v4u64, 4>(pData, pSize, pHashes);
+    }
+
+
+    /* Hash eight messages with AVX-512. */
+    __attribute__((target("avx512f")))
+    static void sk512_avx512(const uint8_t* const* pData, const uint64_t* pSize, uint512_t* pHashes)
+    {
+        sk512_lanes<v8u64, 8>(pData, pSize, pHashes);
+    }
+
+#endif
+
+
+    /* Get the total messages hashed at once by SK512Batch on this CPU. */
+    uint32_t SK512Lanes()
+    {
+    #if SK_BATCH_SIMD
+        static const uint32_t nLanes = []()
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f") ? 8 : (__builtin_cpu_supports("avx2") ? 4 : 1);
+        }();
+
+        return nLanes;
+    #else
+        return 1;
+    #endif
+    }
+
+
+    /* Hash a batch of independent messages with SK512. */
+    void SK512Batch(const std::vector<std::pair<const uint8_t*, uint64_t> >& vData, std::vector<uint512_t>& vHashes)
+    {
+        vHashes.resize(vData.size());
+
+        /* Use the scalar hash when there aren't enough messages to fill the lanes. */
+        const uint32_t nLanes = SK512Lanes();
+        if(nLanes == 1 || vData.size() < 2)
+        {
+            for(uint32_t n = 0; n < vData.size(); ++n)
+                sk512_scalar(vData[n].first, vData[n].second, vHashes[n]);
+
+            return;
+        }
+
+    #if SK_BATCH_SIMD
+        /* Group the messages by their total of Skein blocks, since every lane processes the same blocks. */
+        std::vector<std::pair<uint64_t, uint32_t> > vOrder;
+        vOrder.reserve(vData.size());
+        for(uint32_t n = 0; n < vData.size(); ++n)
+            vOrder.push_back(std::make_pair((vData[n].second + SKEIN_512_BLOCK_BYTES - 1) / SKEIN_512_BLOCK_BYTES, n));
+
+        std::sort(vOrder.begin(), vOrder.end());
+
+        /* Hash each group of lanes. */
+        uint32_t nStart = 0;
+        while(nStart < vOrder.size())
+        {
+            /* Find the messages with the same total of blocks, up to the total of lanes. Empty messages are one block. */
+            const uint64_t nBlocks = std::max(uint64_t(1), vOrder[nStart].first);
+
+            uint32_t nEnd = nStart + 1;
+            while(nEnd < vOrder.size() && nEnd - nStart < nLanes && std::max(uint64_t(1), vOrder[nEnd].first) == nBlocks)
+                ++nEnd;
+
+            /* A single message is faster on its own. */
+            const uint32_t nTotal = nEnd - nStart;
+            if(nTotal == 1)
+            {
+                const uint32_t n = vOrder[nStart].second;
+                sk512_scalar(vData[n].first, vData[n].second, vHashes[n]);
+
+                nStart = nEnd;
+                continue;
+            }
+
+            /* Fill the unused lanes with the first message. */
+            const uint8_t* pData[8];
+            uint64_t       pSize[8];
+            uint512_t      pHashes[8];
+            for(uint32_t nLane = 0; nLane < nLanes; ++nLane)
+            {
+                const uint32_t n = vOrder[nStart + (nLane < nTotal ? nLane : 0)].second;
+
+                pData[nLane] = vData[n].first;
+                pSize[nLane] = vData[n].second;
+            }
+
+            /* Run the kernel for this CPU. */
+            if(nLanes == 8)
+                sk512_avx512(pData, pSize, pHashes);
+            else
+                sk512_avx2(pData, pSize, pHashes);
+
+            /* Copy out the hashes in order. */
+            for(uint32_t nLane = 0; nLane < nTotal; ++nLane)
+                vHashes[vOrder[nStart + nLane].second] = pHashes[nLane];
+
+            nStart = nEnd;
+        }
+    #endif
+    }
+
+
+    /* Hash a batch of independent messages with SK512. */
+    void SK512Batch(const std::vector<std::vector<uint8_t> >& vData, std::vector<uint512_t>& vHashes)
+    {
+        /* Get the pointers to the messages. */
+        std::vector<std::pair<const uint8_t*, uint64_t> > vPointers;
+        vPointers.reserve(vData.size());
+        for(const auto& vch : vData)
+            vPointers.push_back(std::make_pair(vch.empty() ? pblank : &vch[0], uint64_t(vch.size())));
+
+        SK512Batch(vPointers, vHashes);
+    }
+}
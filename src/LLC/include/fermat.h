@@ -0,0 +1,59 @@
+/*__________________________________________________________________________________________
+
+			(c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+			(c) Copyright The Nexus Developers 2014 - 2019
+
+			Distributed under the MIT software license, see the accompanying
+			file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+			"ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLC_INCLUDE_FERMAT_H
+#define NEXUS_LLC_INCLUDE_FERMAT_H
+
+#include <LLC/types/uint1024.h>
+
+#include <vector>
+
+namespace LLC
+{
+
+    /** FermatLanes
+     *
+     *  Get the total numbers FermatBatch tests at once on this CPU, being 8 with AVX-512 IFMA, or 1.
+     *
+     **/
+    uint32_t FermatLanes();
+
+
+    /** FermatTest
+     *
+     *  Calculate the base 2 Fermat remainder 2^(p - 1) mod p with OpenSSL, for a single number.
+     *  A remainder of 1 means the number is a probable prime.
+     *
+     *  @param[in] hashPrime The number to test.
+     *
+     *  @return The Fermat remainder.
+     *
+     **/
+    uint1024_t FermatTest(const uint1024_t& hashPrime);
+
+
+    /** FermatBatch
+     *
+     *  Calculate the base 2 Fermat remainders of many numbers, eight at a time in the lanes of AVX-512 registers
+     *  with 52-bit multiply-add (IFMA) when the CPU has it, otherwise one at a time.
+     *
+     *  @param[in] vPrimes The numbers to test.
+     *  @param[out] vRemainders The Fermat remainders, in the same order as the numbers.
+     *
+     **/
+    void FermatBatch(const std::vector<uint1024_t>& vPrimes, std::vector<uint1024_t>& vRemainders);
+
+}
+
+#endif
@@ -0,0 +1,445 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/fermat.h>
+#include <LLC/types/bignum.h>
+
+#include <openssl/bn.h>
+
+#include <algorithm>
+#include <cstring>
+
+/* The lane kernel uses AVX-512 IFMA intrinsics with runtime dispatch, so it is only built for x86-64. */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define FERMAT_SIMD 1
+    #define FERMAT_TARGET __attribute__((target("avx512f,avx512ifma")))
+    #include <immintrin.h>
+#else
+    #define FERMAT_SIMD 0
+#endif
+
+
+namespace LLC
+{
+
+    /* Calculate the Fermat remainder one number at a time with OpenSSL's Montgomery code. */
+    static uint1024_t fermat_openssl(const uint1024_t& hashPrime)
+    {
+        CAutoBN_CTX pctx;
+
+        CBigNum bnPrime(hashPrime);
+        CBigNum bnBase(2);
+        CBigNum bnExp = bnPrime - 1;
+
+        CBigNum bnResult;
+        BN_mod_exp(bnResult.getBN(), bnBase.getBN(), bnExp.getBN(), bnPrime.getBN(), pctx);
+
+        return bnResult.getuint1024();
+    }
+
+
+#if FERMAT_SIMD
+
+    /* Total 64-bit words in a 1024-bit number. */
+    const uint32_t FERMAT_WORDS = 16;
+
+
+    /* Total lanes, bits per limb and limbs per number in the lane kernel. The limbs hold 16 more bits than the
+     * largest number, which lets Montgomery multiplication skip the final subtraction. */
+    const uint32_t FERMAT_LANES = 8;
+    const uint32_t FERMAT_BITS  = 52;
+    const uint32_t FERMAT_LIMBS = 20;
+
+
+    /* Get the total bits in a number. */
+    static uint32_t bit_length(const uint64_t* a)
+    {
+        for(int32_t i = FERMAT_WORDS - 1; i >= 0; --i)
+        {
+            if(a[i])
+                return (i * 64) + 64 - __builtin_clzll(a[i]);
+        }
+
+        return 0;
+    }
+
+
+    /* Check if a >= b. */
+    static bool greater_equal(const uint64_t* a, const uint64_t* b)
+    {
+        for(int32_t i = FERMAT_WORDS - 1; i >= 0; --i)
+        {
+            if(a[i] != b[i])
+                return a[i] > b[i];
+        }
+
+        return true;
+    }
+
+
+    /* Set a = a - b, ignoring the borrow. */
+    static void subtract(uint64_t* a, const uint64_t* b)
+    {
+        uint64_t nBorrow = 0;
+        for(uint32_t i = 0; i < FERMAT_WORDS; ++i)
+        {
+            const uint64_t nDiff = a[i] - b[i] - nBorrow;
+            nBorrow = (a[i] < b[i]) || (a[i] - b[i] < nBorrow);
+            a[i] = nDiff;
+        }
+    }
+
+
+    /* Set r = 2^nPower mod n, for odd n with the given total bits. */
+    static void mod_power2(uint64_t* r, const uint64_t* n, const uint32_t nBits, const uint32_t nPower)
+    {
+        /* 2^(nBits - 1) is less than n, since n is odd. */
+        std::fill(r, r + FERMAT_WORDS, 0);
+        r[(nBits - 1) / 64] = uint64_t(1) << ((nBits - 1) % 64);
+
+        for(uint32_t i = nBits - 1; i < nPower; ++i)
+        {
+            /* Double, where the carry is 2^1024 so subtracting n wraps to the right value. */
+            const uint64_t nCarry = r[FERMAT_WORDS - 1] >> 63;
+            for(uint32_t j = FERMAT_WORDS - 1; j > 0; --j)
+                r[j] = (r[j] << 1) | (r[j - 1] >> 63);
+
+            r[0] <<= 1;
+
+            if(nCarry || greater_equal(r, n))
+                subtract(r, n);
+        }
+    }
+
+
+    /* Get -n^-1 mod 2^64 by Newton's iteration, which doubles the correct bits from 3 each step. */
+    static uint64_t mont_inverse(const uint64_t n0)
+    {
+        uint64_t x = n0;
+        for(uint32_t i = 0; i < 5; ++i)
+            x *= 2 - n0 * x;
+
+        return ~x + 1;
+    }
+
+
+    /* Get the limb of a 1024-bit number at a bit offset. */
+    static uint64_t get_limb(const uint64_t* a, const uint32_t nOffset)
+    {
+        const uint32_t i = nOffset / 64;
+        const uint32_t s = nOffset % 64;
+        if(i >= FERMAT_WORDS)
+            return 0;
+
+        uint64_t nLimb = a[i] >> s;
+        if(s + FERMAT_BITS > 64 && i + 1 < FERMAT_WORDS)
+            nLimb |= a[i + 1] << (64 - s);
+
+        return nLimb & ((uint64_t(1) << FERMAT_BITS) - 1);
+    }
+
+
+    /* Add a limb to a 1024-bit number at a bit offset. The bits past 1024 are dropped. */
+    static void set_limb(uint64_t* a, const uint32_t nOffset, const uint64_t nLimb)
+    {
+        const uint32_t i = nOffset / 64;
+        const uint32_t s = nOffset % 64;
+        if(i >= FERMAT_WORDS)
+            return;
+
+        a[i] |= nLimb << s;
+        if(s + FERMAT_BITS > 64 && i + 1 < FERMAT_WORDS)
+            a[i + 1] |= nLimb >> (64 - s);
+    }
+
+
+    /* Keep the bits of each lane that fit in a limb. */
+    FERMAT_TARGET
+    static inline __m512i lane_mask(const __m512i& a)
+    {
+        return _mm512_and_si512(a, _mm512_set1_epi64((uint64_t(1) << FERMAT_BITS) - 1));
+    }
+
+
+    /* Get the bits of each lane past a limb. */
+    FERMAT_TARGET
+    static inline __m512i lane_carry(const __m512i& a)
+    {
+        return _mm512_maskz_srli_epi64(0xFF, a, FERMAT_BITS);
+    }
+
+
+    /* Add the low and high halves of the 104-bit products a * b to lo and hi. */
+    FERMAT_TARGET
+    static inline void lane_madd(__m512i& lo, __m512i& hi, const __m512i& a, const __m512i& b)
+    {
+        lo = _mm512_madd52lo_epu64(lo, a, b);
+        hi = _mm512_madd52hi_epu64(hi, a, b);
+    }
+
+
+    /* Add the products x[j] * y[c - j] for j from nBegin to before nEnd, in four chains so the multiplies overlap. */
+    FERMAT_TARGET
+    static inline void lane_column(__m512i& lo, __m512i& hi, const __m512i* x, const __m512i* y,
+                                   const uint32_t c, const uint32_t nBegin, const uint32_t nEnd)
+    {
+        __m512i lo1 = _mm512_setzero_si512(), hi1 = _mm512_setzero_si512();
+        __m512i lo2 = _mm512_setzero_si512(), hi2 = _mm512_setzero_si512();
+        __m512i lo3 = _mm512_setzero_si512(), hi3 = _mm512_setzero_si512();
+
+        uint32_t j = nBegin;
+        for(; j + 3 < nEnd; j += 4)
+        {
+            lane_madd(lo,  hi,  x[j],     y[c - j]);
+            lane_madd(lo1, hi1, x[j + 1], y[c - j - 1]);
+            lane_madd(lo2, hi2, x[j + 2], y[c - j - 2]);
+            lane_madd(lo3, hi3, x[j + 3], y[c - j - 3]);
+        }
+
+        for(; j < nEnd; ++j)
+            lane_madd(lo, hi, x[j], y[c - j]);
+
+        lo = _mm512_add_epi64(_mm512_add_epi64(lo, lo1), _mm512_add_epi64(lo2, lo3));
+        hi = _mm512_add_epi64(_mm512_add_epi64(hi, hi1), _mm512_add_epi64(hi2, hi3));
+    }
+
+
+    /* Montgomery multiplication z = a * b / 2^1040 mod n in every lane, one column of the product at a time so the
+     * sums stay in registers. Squares add their cross products once and double them. Inputs below 4n give results
+     * below 2n. z can be a or b, since each limb of z is written after the last column that reads it. */
+    FERMAT_TARGET
+    static void lane_mont(__m512i* z, const __m512i* a, const __m512i* b, const __m512i* n, const __m512i& k,
+                          const bool fSquare)
+    {
+        /* The multiples of n for each low column. */
+        __m512i m[FERMAT_LIMBS];
+
+        /* The sum of this column, and the high halves of the products going to the next. */
+        __m512i lo = _mm512_setzero_si512();
+        __m512i hi = _mm512_setzero_si512();
+        for(uint32_t c = 0; c < (FERMAT_LIMBS << 1) - 1; ++c)
+        {
+            const uint32_t nBegin = (c < FERMAT_LIMBS ? 0 : c - FERMAT_LIMBS + 1);
+
+            /* Add the products of a and b in this column. */
+            if(fSquare)
+            {
+                __m512i vLo = _mm512_setzero_si512();
+                __m512i vHi = _mm512_setzero_si512();
+                lane_column(vLo, vHi, a, a, c, nBegin, (c + 1) >> 1);
+
+                lo = _mm512_add_epi64(lo, _mm512_add_epi64(vLo, vLo));
+                hi = _mm512_add_epi64(hi, _mm512_add_epi64(vHi, vHi));
+
+                if(!(c & 1))
+                    lane_madd(lo, hi, a[c >> 1], a[c >> 1]);
+            }
+            else
+                lane_column(lo, hi, a, b, c, nBegin, std::min(c + 1, FERMAT_LIMBS));
+
+            /* Add the products of n and the multiples found so far. */
+            lane_column(lo, hi, m, n, c, nBegin, std::min(c, FERMAT_LIMBS));
+
+            /* Clear the low columns with a new multiple of n, and keep the high columns as the result. */
+            if(c < FERMAT_LIMBS)
+            {
+                m[c] = lane_mask(_mm512_madd52lo_epu64(_mm512_setzero_si512(), lo, k));
+                lane_madd(lo, hi, n[0], m[c]);
+            }
+            else
+                z[c - FERMAT_LIMBS] = lane_mask(lo);
+
+            /* Carry into the next column. */
+            lo = _mm512_add_epi64(hi, lane_carry(lo));
+            hi = _mm512_setzero_si512();
+        }
+
+        /* The last column only has carries. */
+        z[FERMAT_LIMBS - 1] = lo;
+    }
+
+
+    /* Calculate r = 2^(n - 1) mod n for one odd n > 1 in each lane. */
+    FERMAT_TARGET
+    static void fermat_lanes(const uint64_t* const* pPrimes, uint64_t* const* pRemainders)
+    {
+        /* Get each lane's modulus, Montgomery constant, and one in Montgomery form, in limbs. */
+        uint64_t aN[FERMAT_LIMBS][FERMAT_LANES];
+        uint64_t aX[FERMAT_LIMBS][FERMAT_LANES];
+        uint64_t aK[FERMAT_LANES];
+
+        uint32_t nMaxBits = 0;
+        for(uint32_t nLane = 0; nLane < FERMAT_LANES; ++nLane)
+        {
+            const uint64_t* n = pPrimes[nLane];
+
+            const uint32_t nBits = bit_length(n);
+            nMaxBits = std::max(nMaxBits, nBits);
+
+            aK[nLane] = mont_inverse(n[0]) & ((uint64_t(1) << FERMAT_BITS) - 1);
+
+            uint64_t x[FERMAT_WORDS];
+            mod_power2(x, n, nBits, FERMAT_LIMBS * FERMAT_BITS);
+
+            for(uint32_t j = 0; j < FERMAT_LIMBS; ++j)
+            {
+                aN[j][nLane] = get_limb(n, j * FERMAT_BITS);
+                aX[j][nLane] = get_limb(x, j * FERMAT_BITS);
+            }
+        }
+
+        __m512i vN[FERMAT_LIMBS];
+        __m512i vX[FERMAT_LIMBS];
+        for(uint32_t j = 0; j < FERMAT_LIMBS; ++j)
+        {
+            vN[j] = _mm512_loadu_si512((const void*)aN[j]);
+            vX[j] = _mm512_loadu_si512((const void*)aX[j]);
+        }
+
+        const __m512i vK = _mm512_loadu_si512((const void*)aK);
+
+        /* Square for each bit of n - 1, and double the lanes with the bit set. Bit 0 of n - 1 is clear, since n is
+         * odd. The leading zeros of shorter numbers square one, which stays one. */
+        for(int32_t i = nMaxBits - 1; i >= 0; --i)
+        {
+            lane_mont(vX, vX, vX, vN, vK, true);
+            if(i == 0)
+                continue;
+
+            __mmask8 nDouble = 0;
+            for(uint32_t nLane = 0; nLane < FERMAT_LANES; ++nLane)
+                nDouble |= ((pPrimes[nLane][i / 64] >> (i % 64)) & 1) << nLane;
+
+            if(!nDouble)
+                continue;
+
+            /* Doubling a number below 2n leaves it below 4n, so it only needs its carries. */
+            __m512i c = _mm512_setzero_si512();
+            for(uint32_t j = 0; j < FERMAT_LIMBS; ++j)
+            {
+                const __m512i x = _mm512_add_epi64(_mm512_mask_add_epi64(vX[j], nDouble, vX[j], vX[j]), c);
+
+                c     = lane_carry(x);
+                vX[j] = lane_mask(x);
+            }
+        }
+
+        /* Convert out of Montgomery form. */
+        __m512i vOne[FERMAT_LIMBS];
+        vOne[0] = _mm512_set1_epi64(1);
+        for(uint32_t j = 1; j < FERMAT_LIMBS; ++j)
+            vOne[j] = _mm512_setzero_si512();
+
+        lane_mont(vX, vX, vOne, vN, vK, false);
+
+        /* Copy the remainders out of the lanes. They are at most n. */
+        for(uint32_t j = 0; j < FERMAT_LIMBS; ++j)
+            _mm512_storeu_si512((void*)aX[j], vX[j]);
+
+        for(uint32_t nLane = 0; nLane < FERMAT_LANES; ++nLane)
+        {
+            uint64_t* r = pRemainders[nLane];
+            std::fill(r, r + FERMAT_WORDS, 0);
+
+            for(uint32_t j = 0; j < FERMAT_LIMBS; ++j)
+                set_limb(r, j * FERMAT_BITS, aX[j][nLane]);
+
+            if(greater_equal(r, pPrimes[nLane]))
+                subtract(r, pPrimes[nLane]);
+        }
+    }
+
+#endif
+
+
+    /* Get the total numbers tested at once by FermatBatch on this CPU. */
+    uint32_t FermatLanes()
+    {
+    #if FERMAT_SIMD
+        static const uint32_t nLanes = []()
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512ifma") ? FERMAT_LANES : 1;
+        }();
+
+        return nLanes;
+    #else
+        return 1;
+    #endif
+    }
+
+
+    /* Calculate the base 2 Fermat remainder 2^(p - 1) mod p. */
+    uint1024_t FermatTest(const uint1024_t& hashPrime)
+    {
+        return fermat_openssl(hashPrime);
+    }
+
+
+    /* Calculate the base 2 Fermat remainders of many numbers. */
+    void FermatBatch(const std::vector<uint1024_t>& vPrimes, std::vector<uint1024_t>& vRemainders)
+    {
+        vRemainders.resize(vPrimes.size());
+
+        /* Get the odd numbers above one, which Montgomery multiplication can reduce by. */
+        std::vector<uint32_t> vIndex;
+        vIndex.reserve(vPrimes.size());
+        for(uint32_t n = 0; n < vPrimes.size(); ++n)
+        {
+            if((vPrimes[n].Get64(0) & 1) && vPrimes[n] > 1)
+                vIndex.push_back(n);
+            else
+                vRemainders[n] = fermat_openssl(vPrimes[n]);
+        }
+
+        /* Test each group of lanes. */
+        uint32_t nStart = 0;
+
+    #if FERMAT_SIMD
+        const uint32_t nLanes = FermatLanes();
+
+        /* A group costs about as much as three numbers tested one at a time. */
+        while(nLanes > 1 && vIndex.size() - nStart >= 3)
+        {
+            const uint32_t nTotal = std::min(nLanes, uint32_t(vIndex.size() - nStart));
+
+            /* Fill the unused lanes with the first number. */
+            uint64_t aPrimes[FERMAT_LANES][FERMAT_WORDS];
+            uint64_t aRemainders[FERMAT_LANES][FERMAT_WORDS];
+
+            const uint64_t* pPrimes[FERMAT_LANES];
+            uint64_t* pRemainders[FERMAT_LANES];
+            for(uint32_t nLane = 0; nLane < FERMAT_LANES; ++nLane)
+            {
+                const uint32_t n = vIndex[nStart + (nLane < nTotal ? nLane : 0)];
+                std::memcpy(aPrimes[nLane], vPrimes[n].begin(), sizeof(aPrimes[nLane]));
+
+                pPrimes[nLane]     = aPrimes[nLane];
+                pRemainders[nLane] = aRemainders[nLane];
+            }
+
+            fermat_lanes(pPrimes, pRemainders);
+
+            /* Copy out the remainders in order. */
+            for(uint32_t nLane = 0; nLane < nTotal; ++nLane)
+                std::memcpy(vRemainders[vIndex[nStart + nLane]].begin(), aRemainders[nLane], sizeof(aRemainders[nLane]));
+
+            nStart += nTotal;
+        }
+    #endif
+
+        /* Test the rest one at a time. */
+        for(; nStart < vIndex.size(); ++nStart)
+            vRemainders[vIndex[nStart]] = fermat_openssl(vPrimes[vIndex[nStart]]);
+    }
+}
@@ -0,0 +1,483 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+____________________________________________________________________________________________*/
+
+#include <LLD/cache/binary_clock.h>
+#include <LLD/templates/key.h>
+#include <LLD/hash/xxh3.h>
+
+#include <Util/include/mutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace LLD
+{
+    /* Key hashes with special meaning in a slot. */
+    const uint64_t CLOCK_EMPTY     = 0;
+    const uint64_t CLOCK_TOMBSTONE = 1;
+
+
+    /*  Node to hold the binary data of a record in the clock. */
+    struct ClockNode
+    {
+        /** Store the key as 64-bit hash, since we have checksum to verify against too. Published last. **/
+        std::atomic<uint64_t> hashKey;
+
+        /** The data in the binary node, only read and written with the atomic shared_ptr functions. **/
+        std::shared_ptr<const std::vector<uint8_t>> pData;
+
+        /** Set when the node is read, cleared when the clock hand passes it. **/
+        std::atomic<bool> fReference;
+
+        /** Reserved nodes are passed over by the clock hand. Guarded by the shard lock. **/
+        bool fReserved;
+
+
+        /** Default constructor **/
+        ClockNode()
+        : hashKey    (CLOCK_EMPTY)
+        , pData      ( )
+        , fReference (false)
+        , fReserved  (false)
+        {
+        }
+
+
+        /** Check if node holds a record. **/
+        bool IsNull() const
+        {
+            return hashKey.load(std::memory_order_relaxed) <= CLOCK_TOMBSTONE;
+        }
+    };
+
+
+    /*  The nodes of a shard, addressed by key hash with linear probing. */
+    struct ClockRing
+    {
+        /** The nodes of the ring. **/
+        ClockNode* vNodes;
+
+        /** The slots in the ring less one, as a power of two mask. **/
+        uint32_t nMask;
+
+
+        /** Size Constructor **/
+        ClockRing(const uint64_t nSlots)
+        : vNodes (new ClockNode[nSlots])
+        , nMask  (static_cast<uint32_t>(nSlots - 1))
+        {
+        }
+
+
+        /** Default destructor **/
+        ~ClockRing()
+        {
+            delete[] vNodes;
+        }
+    };
+
+
+    /*  One shard of the cache, with a lock for writers and a ring that readers search without it. */
+    struct ClockShard
+    {
+        /** Mutex for writers. **/
+        mutable std::mutex MUTEX;
+
+        /** The ring of nodes the clock hand sweeps. **/
+        std::atomic<ClockRing*> pRing;
+
+        /** Rings replaced by a larger one, kept until destruction as readers may still be searching them. **/
+        std::vector<ClockRing*> vRetired;
+
+        /** The position of the clock hand. **/
+        uint32_t nHand;
+
+        /** The nodes holding records, and the slots left by removed nodes. **/
+        uint32_t nCount;
+        uint32_t nTombstones;
+
+        /** The current size of the shard. **/
+        uint64_t nCurrentSize;
+
+        /** The maximum size of the shard. **/
+        uint64_t nMaxSize;
+
+
+        /** Default constructor **/
+        ClockShard()
+        : MUTEX        ( )
+        , pRing        (nullptr)
+        , vRetired     ( )
+        , nHand        (0)
+        , nCount       (0)
+        , nTombstones  (0)
+        , nCurrentSize (0)
+        , nMaxSize     (0)
+        {
+        }
+
+
+        /** Default destructor **/
+        ~ClockShard()
+        {
+            delete pRing.load();
+            for(auto& pRetired : vRetired)
+                delete pRetired;
+        }
+
+
+        /** The memory accounted to a node apart from its data. **/
+        static uint64_t Overhead()
+        {
+            return sizeof(ClockNode) * 2 + sizeof(std::vector<uint8_t>) + sizeof(void*) * 4;
+        }
+
+
+        /** Size the ring for the records that fit in the shard, with room left for probing. **/
+        void Initialize(const uint64_t nMaxSizeIn)
+        {
+            nMaxSize = nMaxSizeIn;
+
+            /* Records are expected to be at least a cache line of data. */
+            uint64_t nSlots = 64;
+            while(nSlots < (nMaxSize / (Overhead() + 64)) * 2)
+                nSlots <<= 1;
+
+            pRing.store(new ClockRing(nSlots));
+        }
+
+
+        /** The ring, as seen by the writer holding the lock. **/
+        ClockRing& Ring() const
+        {
+            return *pRing.load(std::memory_order_relaxed);
+        }
+
+
+        /** The most records kept before evicting by count, leaving half of the ring empty so probes stay short. **/
+        uint32_t Limit() const
+        {
+            return (Ring().nMask + 1) / 2;
+        }
+
+
+        /** Find the data of a key hash. Called without the lock, so the node is checked again after its data is read. **/
+        std::shared_ptr<const std::vector<uint8_t>> Find(const uint64_t hashKey) const
+        {
+            const ClockRing& ring = *pRing.load(std::memory_order_acquire);
+            for(uint32_t nProbe = 0, nSlot = hashKey & ring.nMask; nProbe <= ring.nMask; ++nProbe, nSlot = (nSlot + 1) & ring.nMask)
+            {
+                ClockNode& node = ring.vNodes[nSlot];
+
+                const uint64_t hashSlot = node.hashKey.load(std::memory_order_acquire);
+                if(hashSlot == CLOCK_EMPTY)
+                    break;
+
+                if(hashSlot != hashKey)
+                    continue;
+
+                /* A node removed or reused while it was read is a miss. */
+                std::shared_ptr<const std::vector<uint8_t>> pData = std::atomic_load(&node.pData);
+                if(!pData || node.hashKey.load(std::memory_order_acquire) != hashKey)
+                    break;
+
+                node.fReference.store(true, std::memory_order_relaxed);
+                return pData;
+            }
+
+            return nullptr;
+        }
+
+
+        /** Find the slot of a key hash with the lock held, or the slot to insert it into. **/
+        bool Slot(const uint64_t hashKey, uint32_t& nSlot) const
+        {
+            const ClockRing& ring = Ring();
+
+            uint32_t nInsert = ring.nMask + 1;
+            for(uint32_t nProbe = 0, n = hashKey & ring.nMask; nProbe <= ring.nMask; ++nProbe, n = (n + 1) & ring.nMask)
+            {
+                const uint64_t hashSlot = ring.vNodes[n].hashKey.load(std::memory_order_relaxed);
+                if(hashSlot == hashKey)
+                {
+                    nSlot = n;
+                    return true;
+                }
+
+                /* Reuse the first slot left by a removed node. */
+                if(hashSlot == CLOCK_TOMBSTONE && nInsert > ring.nMask)
+                    nInsert = n;
+
+                if(hashSlot == CLOCK_EMPTY)
+                {
+                    nSlot = (nInsert > ring.nMask ? n : nInsert);
+                    return false;
+                }
+            }
+
+            nSlot = nInsert;
+            return false;
+        }
+
+
+        /** Write a record into a free slot, publishing its key hash after its data. **/
+        void Insert(const uint32_t nSlot, const uint64_t hashKey, const std::shared_ptr<const std::vector<uint8_t>>& pData, const bool fReserved, const bool fReference)
+        {
+            ClockNode& node = Ring().vNodes[nSlot];
+            if(node.hashKey.load(std::memory_order_relaxed) == CLOCK_TOMBSTONE)
+                --nTombstones;
+
+            std::atomic_store(&node.pData, pData);
+            node.fReference.store(fReference, std::memory_order_relaxed);
+            node.fReserved = fReserved;
+            node.hashKey.store(hashKey, std::memory_order_release);
+
+            nCurrentSize += pData->size() + Overhead();
+            ++nCount;
+        }
+
+
+        /** Remove the node in a slot. **/
+        void Erase(const uint32_t nSlot)
+        {
+            ClockNode& node = Ring().vNodes[nSlot];
+
+            /* Unpublish the key first, so readers stop matching it before the data goes. */
+            node.hashKey.store(CLOCK_TOMBSTONE, std::memory_order_release);
+
+            nCurrentSize -= std::atomic_load(&node.pData)->size() + Overhead();
+            std::atomic_store(&node.pData, std::shared_ptr<const std::vector<uint8_t>>());
+
+            node.fReference.store(false, std::memory_order_relaxed);
+            node.fReserved = false;
+
+            --nCount;
+            ++nTombstones;
+        }
+
+
+        /** Sweep the clock hand until the shard fits, never evicting the slot just written. **/
+        void Evict(const uint32_t nKeep)
+        {
+            ClockRing& ring = Ring();
+
+            /* Two passes clear every reference bit, so stop there if everything left is reserved. */
+            uint64_t nSweep = uint64_t(ring.nMask + 1) * 2;
+            while((nCurrentSize > nMaxSize || nCount > Limit()) && nSweep-- > 0)
+            {
+                const uint32_t nSlot = nHand & ring.nMask;
+                nHand = nSlot + 1;
+
+                /* Skip over empty, reserved and the newest nodes. */
+                ClockNode& node = ring.vNodes[nSlot];
+                if(node.IsNull() || node.fReserved || nSlot == nKeep)
+                    continue;
+
+                /* Give referenced nodes a second chance. */
+                if(node.fReference.exchange(false, std::memory_order_relaxed))
+                    continue;
+
+                Erase(nSlot);
+            }
+
+            /* Reserved records can't be evicted, so give them a larger ring once they fill this one. */
+            if(nCount > Limit())
+                Resize((ring.nMask + 1) * 2);
+
+            /* Clear out removed nodes once they make probes long. */
+            else if(nCount + nTombstones > (ring.nMask + 1) / 4 * 3)
+                Resize(ring.nMask + 1);
+        }
+
+
+        /** Insert every record into a ring of a given size, dropping the slots of removed nodes. **/
+        void Resize(const uint64_t nSlots)
+        {
+            ClockRing& ring = Ring();
+
+            /* Take the records out of the ring. */
+            struct Saved
+            {
+                uint64_t hashKey;
+                std::shared_ptr<const std::vector<uint8_t>> pData;
+                bool fReserved;
+                bool fReference;
+            };
+
+            std::vector<Saved> vSaved;
+            vSaved.reserve(nCount);
+
+            for(uint32_t nSlot = 0; nSlot <= ring.nMask; ++nSlot)
+            {
+                ClockNode& node = ring.vNodes[nSlot];
+                if(!node.IsNull())
+                    vSaved.push_back({node.hashKey.load(std::memory_order_relaxed), std::atomic_load(&node.pData),
+                        node.fReserved, node.fReference.load(std::memory_order_relaxed)});
+            }
+
+            /* A larger ring is published whole, while the same ring is cleared in place and readers may miss until it is filled. */
+            if(nSlots != uint64_t(ring.nMask) + 1)
+            {
+                vRetired.push_back(&ring);
+                pRing.store(new ClockRing(nSlots), std::memory_order_release);
+            }
+
+            for(uint32_t nSlot = 0; nSlot <= ring.nMask; ++nSlot)
+            {
+                ClockNode& node = ring.vNodes[nSlot];
+
+                node.hashKey.store(CLOCK_EMPTY, std::memory_order_release);
+                std::atomic_store(&node.pData, std::shared_ptr<const std::vector<uint8_t>>());
+                node.fReserved = false;
+            }
+
+            nCount       = 0;
+            nTombstones  = 0;
+            nCurrentSize = 0;
+
+            for(const auto& saved : vSaved)
+            {
+                uint32_t nSlot = 0;
+                Slot(saved.hashKey, nSlot);
+
+                Insert(nSlot, saved.hashKey, saved.pData, saved.fReserved, saved.fReference);
+            }
+        }
+    };
+
+
+    /* Hash a key, keeping clear of the hashes that mark empty and removed slots. */
+    static uint64_t HashKey(const std::vector<uint8_t>& vKey)
+    {
+        const uint64_t hashKey = XXH64(&vKey[0], vKey.size(), 0);
+        return std::max(hashKey, CLOCK_TOMBSTONE + 1);
+    }
+
+
+    /** Cache Size Constructor **/
+    BinaryCLOCK::BinaryCLOCK(const uint32_t nCacheSizeIn)
+    : MAX_CACHE_SIZE   (nCacheSizeIn)
+    , MAX_CACHE_SHARDS (std::min(uint32_t(MAX_SHARDS), std::max(1u, nCacheSizeIn / MIN_SHARD_SIZE)))
+    , shards           (new ClockShard[MAX_CACHE_SHARDS])
+    {
+        /* Split the cache size evenly between the shards. */
+        for(uint32_t n = 0; n < MAX_CACHE_SHARDS; ++n)
+            shards[n].Initialize(MAX_CACHE_SIZE / MAX_CACHE_SHARDS);
+    }
+
+
+    /** Class Destructor. **/
+    BinaryCLOCK::~BinaryCLOCK()
+    {
+        delete[] shards;
+    }
+
+
+    /*  Check if data exists. */
+    bool BinaryCLOCK::Has(const std::vector<uint8_t>& vKey) const
+    {
+        const uint64_t hashKey = HashKey(vKey);
+
+        return shard(hashKey).Find(hashKey) != nullptr;
+    }
+
+
+    /*  Get the data by index */
+    bool BinaryCLOCK::Get(const std::vector<uint8_t>& vKey, std::vector<uint8_t>& vData)
+    {
+        const uint64_t hashKey = HashKey(vKey);
+
+        /* Find the data without the shard lock, which also marks the node as referenced. */
+        std::shared_ptr<const std::vector<uint8_t>> pData = shard(hashKey).Find(hashKey);
+        if(!pData)
+            return false;
+
+        vData = *pData;
+
+        return true;
+    }
+
+
+    /*  Add data in the Pool. */
+    void BinaryCLOCK::Put(const SectorKey& key, const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData, bool fReserve)
+    {
+        const uint64_t hashKey = HashKey(vKey);
+
+        /* Copy the data before taking the lock. */
+        std::shared_ptr<const std::vector<uint8_t>> pData = std::make_shared<const std::vector<uint8_t>>(vData);
+
+        ClockShard& cShard = shard(hashKey);
+        LOCK(cShard.MUTEX);
+
+        /* Replace the data of a node already in the cache. */
+        uint32_t nSlot = 0;
+        if(cShard.Slot(hashKey, nSlot))
+        {
+            ClockNode& node = cShard.Ring().vNodes[nSlot];
+            cShard.nCurrentSize -= std::atomic_load(&node.pData)->size();
+            cShard.nCurrentSize += pData->size();
+
+            std::atomic_store(&node.pData, pData);
+            node.fReference.store(true, std::memory_order_relaxed);
+            node.fReserved = fReserve;
+        }
+
+        /* New nodes start unreferenced so records read only once are the first to go. */
+        else
+            cShard.Insert(nSlot, hashKey, pData, fReserve, false);
+
+        /* Evict nodes until the shard fits. */
+        cShard.Evict(nSlot);
+    }
+
+
+    /*  Reserve this item in the cache permanently if true, unreserve if false. */
+    void BinaryCLOCK::Reserve(const std::vector<uint8_t>& vKey, bool fReserve)
+    {
+        const uint64_t hashKey = HashKey(vKey);
+
+        ClockShard& cShard = shard(hashKey);
+        LOCK(cShard.MUTEX);
+
+        uint32_t nSlot = 0;
+        if(cShard.Slot(hashKey, nSlot))
+            cShard.Ring().vNodes[nSlot].fReserved = fReserve;
+    }
+
+
+    /*  Force Remove Object by Index. */
+    bool BinaryCLOCK::Remove(const std::vector<uint8_t>& vKey)
+    {
+        const uint64_t hashKey = HashKey(vKey);
+
+        ClockShard& cShard = shard(hashKey);
+        LOCK(cShard.MUTEX);
+
+        uint32_t nSlot = 0;
+        if(!cShard.Slot(hashKey, nSlot))
+            return false;
+
+        cShard.Erase(nSlot);
+
+        return true;
+    }
+
+
+    /*  Find the shard a key hash belongs to. */
+    ClockShard& BinaryCLOCK::shard(const uint64_t hashKey) const
+    {
+        /* Use the high bits, as the low bits address the shard's ring. */
+        return shards[(hashKey >> 32) % MAX_CACHE_SHARDS];
+    }
+}
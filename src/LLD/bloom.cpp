@@ -0,0 +1,193 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/filter/bloom.h>
+#include <LLD/hash/xxh3.h>
+
+#include <Util/include/debug.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace LLD
+{
+
+    /* Capacity Constructor. Sizes the filter for given number of keys. */
+    BloomFilter::BloomFilter(const uint64_t nCapacity, const uint32_t nBitsPerKey)
+    : pBits           (nullptr)
+    , nBits           (((std::max(nCapacity, uint64_t(1)) * nBitsPerKey + 63) / 64) * 64)
+    , nHashes         (std::max(uint32_t(nBitsPerKey * 69 / 100), 1u)) //k = ln(2) * bits per key
+    , nElements       (0)
+    , nNegatives      (0)
+    , nFalsePositives (0)
+    {
+        pBits = new std::atomic<uint64_t>[nBits / 64]();
+    }
+
+
+    /* Default Destructor. */
+    BloomFilter::~BloomFilter()
+    {
+        if(pBits)
+            delete[] pBits;
+    }
+
+
+    /* Add a key to the filter. */
+    void BloomFilter::Insert(const uint8_t* pData, const uint32_t nSize)
+    {
+        /* Use double hashing to derive the bit positions. */
+        const uint64_t nHash1 = XXH64(pData, nSize, 2);
+        const uint64_t nHash2 = XXH64(pData, nSize, 3) | 1;
+
+        /* Set the bits for every hash function. */
+        for(uint32_t n = 0; n < nHashes; ++n)
+        {
+            const uint64_t nBit = (nHash1 + n * nHash2) % nBits;
+            pBits[nBit / 64].fetch_or(uint64_t(1) << (nBit % 64), std::memory_order_relaxed);
+        }
+
+        ++nElements;
+    }
+
+
+    /* Check if a key may have been added to the filter. */
+    bool BloomFilter::Contains(const uint8_t* pData, const uint32_t nSize)
+    {
+        /* Use double hashing to derive the bit positions. */
+        const uint64_t nHash1 = XXH64(pData, nSize, 2);
+        const uint64_t nHash2 = XXH64(pData, nSize, 3) | 1;
+
+        /* Check the bits for every hash function. */
+        for(uint32_t n = 0; n < nHashes; ++n)
+        {
+            const uint64_t nBit = (nHash1 + n * nHash2) % nBits;
+            if(!(pBits[nBit / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (nBit % 64))))
+            {
+                ++nNegatives;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    /* Record a lookup that passed the filter but wasn't found in the keychain. */
+    void BloomFilter::FalsePositive()
+    {
+        ++nFalsePositives;
+    }
+
+
+    /* Get the observed rate of false positives among lookups for missing keys. */
+    double BloomFilter::FalsePositiveRate() const
+    {
+        /* Get the total lookups for missing keys. */
+        const uint64_t nMissing = nNegatives.load() + nFalsePositives.load();
+        if(nMissing == 0)
+            return 0;
+
+        return nFalsePositives.load() / double(nMissing);
+    }
+
+
+    /* Reset the lookup counters used for the false positive rate. */
+    void BloomFilter::ResetStats()
+    {
+        nNegatives      = 0;
+        nFalsePositives = 0;
+    }
+
+
+    /* Get the total keys that have been inserted. */
+    uint64_t BloomFilter::Elements() const
+    {
+        return nElements.load();
+    }
+
+
+    /* Get the total keys the filter was sized for. */
+    uint64_t BloomFilter::Capacity() const
+    {
+        return nBits * 69 / (100 * nHashes);
+    }
+
+
+    /* Get the total memory used by the bit array. */
+    uint64_t BloomFilter::Bytes() const
+    {
+        return nBits / 8;
+    }
+
+
+    /* Load the filter from disk, replacing the current bit array. */
+    bool BloomFilter::Load(const std::string& strPath)
+    {
+        /* Open the filter file. */
+        std::ifstream stream(strPath, std::ios::in | std::ios::binary);
+        if(!stream.is_open())
+            return false;
+
+        /* Read the filter header. */
+        uint64_t nBitsIn = 0, nElementsIn = 0;
+        uint32_t nHashesIn = 0;
+        stream.read((char*)&nBitsIn, sizeof(nBitsIn));
+        stream.read((char*)&nHashesIn, sizeof(nHashesIn));
+        stream.read((char*)&nElementsIn, sizeof(nElementsIn));
+        if(!stream || nBitsIn == 0 || nBitsIn % 64 != 0 || nHashesIn == 0)
+            return debug::error(FUNCTION, "invalid filter header in ", strPath);
+
+        /* Read the bit array. */
+        std::vector<uint64_t> vWords(nBitsIn / 64, 0);
+        stream.read((char*)&vWords[0], vWords.size() * sizeof(uint64_t));
+        if(!stream)
+            return debug::error(FUNCTION, "only ", stream.gcount(), " filter bytes read from ", strPath);
+
+        /* Replace the current bit array. */
+        delete[] pBits;
+        pBits = new std::atomic<uint64_t>[vWords.size()]();
+        for(uint64_t n = 0; n < vWords.size(); ++n)
+            pBits[n].store(vWords[n]);
+
+        nBits     = nBitsIn;
+        nHashes   = nHashesIn;
+        nElements = nElementsIn;
+
+        return true;
+    }
+
+
+    /* Save the filter to disk. */
+    bool BloomFilter::Save(const std::string& strPath) const
+    {
+        /* Copy the bit array out of the atomics. */
+        std::vector<uint64_t> vWords(nBits / 64, 0);
+        for(uint64_t n = 0; n < vWords.size(); ++n)
+            vWords[n] = pBits[n].load();
+
+        /* Write the header and bit array. */
+        std::ofstream stream(strPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!stream.is_open())
+            return debug::error(FUNCTION, "failed to open ", strPath);
+
+        const uint64_t nElementsOut = nElements.load();
+        stream.write((char*)&nBits, sizeof(nBits));
+        stream.write((char*)&nHashes, sizeof(nHashes));
+        stream.write((char*)&nElementsOut, sizeof(nElementsOut));
+        stream.write((char*)&vWords[0], vWords.size() * sizeof(uint64_t));
+
+        return bool(stream);
+    }
+}
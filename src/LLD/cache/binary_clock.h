@@ -0,0 +1,176 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_CACHE_BINARY_CLOCK_H
+#define NEXUS_LLD_CACHE_BINARY_CLOCK_H
+
+#include <cstdint>
+#include <vector>
+
+
+namespace LLD
+{
+    class SectorKey;
+
+
+    /** ClockShard
+     *
+     *  One shard of the cache, with its own lock, index and clock.
+     *
+     **/
+    struct ClockShard;
+
+
+    /** BinaryCLOCK
+    *
+    *   CLOCK - Second chance eviction over a ring of nodes.
+    *   This class holds the same binary records as BinaryLRU and can be used in its place as the
+    *   cache of a sector database. Keys are sharded by hash so that writers rarely meet on the
+    *   same lock, and reads take no lock at all: a cache hit searches the shard's ring and sets
+    *   the node's atomic reference bit rather than relinking a list. The clock hand clears
+    *   reference bits as it sweeps and evicts the first node it finds that hasn't been
+    *   referenced since its last pass.
+    *
+    **/
+    class BinaryCLOCK
+    {
+        /* The Maximum Size of the Cache. */
+        uint32_t MAX_CACHE_SIZE;
+
+
+        /* The total shards of the cache. */
+        uint32_t MAX_CACHE_SHARDS;
+
+
+        /* The shards of the cache. */
+        ClockShard* shards;
+
+
+    public:
+
+
+        /** The most shards, for caches large enough to give every shard the minimum size. **/
+        static const uint32_t MAX_SHARDS = 64;
+
+
+        /** The least size of a shard, so that a shard holds enough records for its clock to choose well. **/
+        static const uint32_t MIN_SHARD_SIZE = 1024 * 256;
+
+
+        /** Default Constructor. **/
+        BinaryCLOCK()                                    = delete;
+
+
+        /** Copy Constructor. **/
+        BinaryCLOCK(const BinaryCLOCK& cache)            = delete;
+
+
+        /** Move Constructor. **/
+        BinaryCLOCK(BinaryCLOCK&& cache)                 = delete;
+
+
+        /** Copy assignment. **/
+        BinaryCLOCK& operator=(const BinaryCLOCK& cache) = delete;
+
+
+        /** Move assignment. **/
+        BinaryCLOCK& operator=(BinaryCLOCK&& cache)      = delete;
+
+
+        /** Class Destructor. **/
+        ~BinaryCLOCK();
+
+
+        /** Cache Size Constructor
+         *
+         *  @param[in] nCacheSizeIn The maximum size of this Cache Pool
+         *
+         **/
+        BinaryCLOCK(const uint32_t nCacheSizeIn);
+
+
+        /** Has
+         *
+         *  Check if data exists.
+         *
+         *  @param[in] vKey The binary data of the key.
+         *
+         *  @return True/False whether pool contains data by index.
+         *
+         **/
+        bool Has(const std::vector<uint8_t>& vKey) const;
+
+
+        /** Get
+         *
+         *  Get the data by index
+         *
+         *  @param[in] vKey The binary data of the key.
+         *  @param[out] vData The binary data of the cached record.
+         *
+         *  @return True if object was found, false if none found by index.
+         *
+         **/
+        bool Get(const std::vector<uint8_t>& vKey, std::vector<uint8_t>& vData);
+
+
+        /** Put
+         *
+         *  Add data in the Pool
+         *
+         *  @param[in] key The sector key of the record.
+         *  @param[in] vKey The key in binary form.
+         *  @param[in] vData The input data in binary form.
+         *  @param[in] fReserve Flag for if item should be saved from cache eviction.
+         *
+         **/
+        void Put(const SectorKey& key, const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData, bool fReserve = false);
+
+
+        /** Reserve
+         *
+         *  Reserve this item in the cache permanently if true, unreserve if false
+         *
+         *  @param[in] vKey The key to flag as reserved true/false
+         *  @param[in] fReserve If this object is to be reserved for disk.
+         *
+         **/
+        void Reserve(const std::vector<uint8_t>& vKey, bool fReserve = true);
+
+
+        /** Remove
+         *
+         *  Force Remove Object by Index
+         *
+         *  @param[in] vKey Binary Data of the Key
+         *
+         *  @return True on successful removal, false if it fails
+         *
+         **/
+        bool Remove(const std::vector<uint8_t>& vKey);
+
+
+    private:
+
+        /** Shard
+         *
+         *  Find the shard a key hash belongs to.
+         *
+         *  @param[in] hashKey The 64-bit hash of the key.
+         *
+         **/
+        ClockShard& shard(const uint64_t hashKey) const;
+    };
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#define LZ4_STATIC_LINKING_ONLY
+
+#include <LLD/compress/codec.h>
+#include <LLD/compress/lz4.h>
+#include <LLD/include/version.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+#include <Util/templates/datastream.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace LLD
+{
+
+    /* Definitions of the codec constants. */
+    const uint8_t  RecordCodec::MARKER;
+    const uint32_t RecordCodec::MAX_DICTIONARY_SIZE;
+    const uint32_t RecordCodec::MAX_SAMPLE_SIZE;
+    const uint32_t RecordCodec::MIN_RECORD_SIZE;
+
+
+    /* Constructor. */
+    RecordCodec::RecordCodec(const std::string& strPathIn, const bool fTrainIn)
+    : MUTEX       ( )
+    , strPath     (strPathIn)
+    , vDictionary ( )
+    , pDictionary (nullptr)
+    , fDictionary (false)
+    , fTrain      (fTrainIn)
+    , vSamples    ( )
+    {
+        /* Load the dictionary if one was already trained, as records may reference it. */
+        std::ifstream stream(strPath, std::ios::in | std::ios::binary);
+        if(!stream.is_open())
+            return;
+
+        std::vector<uint8_t> vData((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        if(vData.empty())
+            return;
+
+        LOCK(MUTEX);
+        load(vData);
+
+        debug::log(2, FUNCTION, "Loaded ", vData.size(), " byte dictionary from ", strPath);
+    }
+
+
+    /* Default Destructor. */
+    RecordCodec::~RecordCodec()
+    {
+        if(pDictionary)
+            LZ4_freeStream(pDictionary);
+    }
+
+
+    /* Check if a record is compressed from its first byte. */
+    bool RecordCodec::Compressed(const uint8_t nByte)
+    {
+        return nByte == MARKER;
+    }
+
+
+    /* Compress a record. */
+    bool RecordCodec::Encode(const std::vector<uint8_t>& vData, std::vector<uint8_t>& vRecord)
+    {
+        /* Check that the record is worth compressing. */
+        if(vData.size() < MIN_RECORD_SIZE || vData.size() > LZ4_MAX_INPUT_SIZE)
+            return false;
+
+        /* Sample the record until there is a dictionary. */
+        bool fDict = fDictionary.load(std::memory_order_acquire);
+        if(!fDict && fTrain.load())
+            sample(vData);
+
+        /* Write the header. */
+        DataStream ssHeader(SER_LLD, DATABASE_VERSION);
+        ssHeader << MARKER << uint8_t(fDict ? LZ4_DICT : LZ4);
+        WriteCompactSize(ssHeader, vData.size());
+
+        /* Compress after the header. */
+        const int32_t nBound = LZ4_compressBound(static_cast<int32_t>(vData.size()));
+        vRecord.resize(ssHeader.size() + nBound);
+        std::copy(ssHeader.begin(), ssHeader.end(), vRecord.begin());
+
+        int32_t nCompressed = 0;
+        if(fDict)
+        {
+            /* Attach the pre-loaded dictionary rather than loading it for every record. */
+            LZ4_stream_t stream;
+            LZ4_initStream(&stream, sizeof(stream));
+            LZ4_attach_dictionary(&stream, pDictionary);
+
+            nCompressed = LZ4_compress_fast_continue(&stream, (const char*)&vData[0], (char*)&vRecord[ssHeader.size()],
+                static_cast<int32_t>(vData.size()), nBound, 1);
+        }
+        else
+            nCompressed = LZ4_compress_default((const char*)&vData[0], (char*)&vRecord[ssHeader.size()],
+                static_cast<int32_t>(vData.size()), nBound);
+
+        /* Store the record as is if it didn't get smaller. */
+        if(nCompressed <= 0 || ssHeader.size() + nCompressed >= vData.size())
+            return false;
+
+        vRecord.resize(ssHeader.size() + nCompressed);
+
+        return true;
+    }
+
+
+    /* Decompress a record in place. */
+    bool RecordCodec::Decode(std::vector<uint8_t>& vData) const
+    {
+        /* Check that the record is compressed. */
+        if(vData.empty() || !Compressed(vData[0]))
+            return true;
+
+        try
+        {
+            /* Read the header. */
+            DataStream ssHeader(vData, SER_LLD, DATABASE_VERSION);
+
+            uint8_t nMarker = 0, nCodec = 0;
+            ssHeader >> nMarker >> nCodec;
+
+            uint64_t nSize = ReadCompactSize(ssHeader);
+            if(nSize == 0 || nSize > LZ4_MAX_INPUT_SIZE || ssHeader.End())
+                return debug::error(FUNCTION, "record size ", nSize, " out of range");
+
+            /* Decompress after the header. */
+            std::vector<uint8_t> vRecord(nSize);
+
+            const uint64_t nPos = ssHeader.GetPos();
+            const int32_t nCompressed = static_cast<int32_t>(vData.size() - nPos);
+
+            int32_t nDecompressed = -1;
+            if(nCodec == LZ4)
+                nDecompressed = LZ4_decompress_safe((const char*)&vData[nPos], (char*)&vRecord[0],
+                    nCompressed, static_cast<int32_t>(nSize));
+            else if(nCodec == LZ4_DICT)
+            {
+                /* Check that the dictionary the record was compressed with is still here. */
+                if(!fDictionary.load(std::memory_order_acquire))
+                    return debug::error(FUNCTION, "record needs dictionary missing from ", strPath);
+
+                nDecompressed = LZ4_decompress_safe_usingDict((const char*)&vData[nPos], (char*)&vRecord[0],
+                    nCompressed, static_cast<int32_t>(nSize),
+                    (const char*)&vDictionary[0], static_cast<int32_t>(vDictionary.size()));
+            }
+            else
+                return debug::error(FUNCTION, "unknown codec ", uint32_t(nCodec));
+
+            /* Check the record decompressed to its full size. */
+            if(nDecompressed < 0 || static_cast<uint64_t>(nDecompressed) != nSize)
+                return debug::error(FUNCTION, "corrupted record ", nDecompressed, "/", nSize, " bytes");
+
+            vData.swap(vRecord);
+        }
+        catch(const std::exception& e)
+        {
+            return debug::error(FUNCTION, "failed to read record header: ", e.what());
+        }
+
+        return true;
+    }
+
+
+    /* Sample a record for the dictionary. */
+    void RecordCodec::sample(const std::vector<uint8_t>& vData)
+    {
+        LOCK(MUTEX);
+
+        /* Check that another record didn't finish the dictionary. */
+        if(fDictionary.load())
+            return;
+
+        /* Add the start of the record, which holds its type and most common fields. */
+        const uint32_t nSample = std::min(static_cast<uint32_t>(vData.size()), MAX_SAMPLE_SIZE);
+        vSamples.insert(vSamples.end(), vData.begin(), vData.begin() + nSample);
+
+        /* Check that enough records have been sampled. */
+        if(vSamples.size() < MAX_DICTIONARY_SIZE)
+            return;
+
+        vSamples.resize(MAX_DICTIONARY_SIZE);
+
+        /* Save the dictionary before any record can reference it. */
+        {
+            std::ofstream stream(strPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if(!stream.is_open())
+            {
+                debug::error(FUNCTION, "failed to open ", strPath);
+
+                /* Keep compressing without a dictionary. */
+                fTrain.store(false);
+                vSamples.clear();
+
+                return;
+            }
+
+            stream.write((char*)&vSamples[0], vSamples.size());
+        }
+
+    #ifndef WIN32
+        int32_t nFile = ::open(strPath.c_str(), O_WRONLY);
+        if(nFile >= 0)
+        {
+            ::fsync(nFile);
+            ::close(nFile);
+        }
+    #endif
+
+        load(vSamples);
+        vSamples.clear();
+        vSamples.shrink_to_fit();
+
+        debug::log(0, FUNCTION, "Trained ", vDictionary.size(), " byte dictionary for ", strPath);
+    }
+
+
+    /* Set the dictionary and load it into its LZ4 stream. */
+    void RecordCodec::load(const std::vector<uint8_t>& vData)
+    {
+        vDictionary = vData;
+        if(vDictionary.size() > MAX_DICTIONARY_SIZE)
+            vDictionary.erase(vDictionary.begin(), vDictionary.end() - MAX_DICTIONARY_SIZE);
+
+        pDictionary = LZ4_createStream();
+        LZ4_loadDict(pDictionary, (const char*)&vDictionary[0], static_cast<int32_t>(vDictionary.size()));
+
+        fDictionary.store(true, std::memory_order_release);
+    }
+}
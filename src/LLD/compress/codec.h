@@ -0,0 +1,182 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_COMPRESS_CODEC_H
+#define NEXUS_LLD_COMPRESS_CODEC_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef union LZ4_stream_u LZ4_stream_t;
+
+namespace LLD
+{
+
+    /** RecordCodec
+     *
+     *  Compresses the records of a sector database with LZ4. A compressed record begins with a
+     *  header of the marker byte, the codec and the uncompressed size, so compressed and plain
+     *  records can live side by side in the same sector files. Plain records begin with the
+     *  compact size of their type string, which can never be the marker byte.
+     *
+     *  The first records compressed are sampled into a dictionary for the database. Once it is
+     *  full it is saved next to the sector files and used for every record after, which helps
+     *  the small records of the ledger that compress poorly on their own.
+     *
+     **/
+    class RecordCodec
+    {
+    public:
+
+        /** The byte a compressed record begins with. **/
+        static const uint8_t MARKER = 0xff;
+
+
+        /** The codecs records can be compressed with. **/
+        enum CODEC : uint8_t
+        {
+            LZ4      = 0x01,
+            LZ4_DICT = 0x02
+        };
+
+
+        /** The maximum size of a dictionary, as LZ4 only references the last 64 KB. **/
+        static const uint32_t MAX_DICTIONARY_SIZE = 1024 * 64;
+
+
+        /** The maximum bytes sampled from a single record for the dictionary. **/
+        static const uint32_t MAX_SAMPLE_SIZE = 1024;
+
+
+        /** Records smaller than this are not worth compressing. **/
+        static const uint32_t MIN_RECORD_SIZE = 32;
+
+
+    private:
+
+        /** Mutex for dictionary training. **/
+        std::mutex MUTEX;
+
+
+        /** The file the dictionary is saved to. **/
+        std::string strPath;
+
+
+        /** The dictionary, which never changes once it is set. **/
+        std::vector<uint8_t> vDictionary;
+
+
+        /** The dictionary loaded into an LZ4 stream, for attaching to the stream of each record. **/
+        LZ4_stream_t* pDictionary;
+
+
+        /** Flag to tell if the dictionary is set. **/
+        std::atomic<bool> fDictionary;
+
+
+        /** Flag to tell if a dictionary should be trained from the records compressed. **/
+        std::atomic<bool> fTrain;
+
+
+        /** The records sampled for the dictionary so far. **/
+        std::vector<uint8_t> vSamples;
+
+
+    public:
+
+        /** Constructor
+         *
+         *  @param[in] strPathIn The file the dictionary is saved to and loaded from.
+         *  @param[in] fTrainIn Flag to train a dictionary if there is none yet.
+         *
+         **/
+        RecordCodec(const std::string& strPathIn, const bool fTrainIn);
+
+
+        /** Copy Constructor. **/
+        RecordCodec(const RecordCodec& codec) = delete;
+
+
+        /** Copy Assignment Operator. **/
+        RecordCodec& operator=(const RecordCodec& codec) = delete;
+
+
+        /** Default Destructor. **/
+        ~RecordCodec();
+
+
+        /** Compressed
+         *
+         *  Check if a record is compressed from its first byte.
+         *
+         *  @param[in] nByte The first byte of the record.
+         *
+         *  @return True if the record is compressed.
+         *
+         **/
+        static bool Compressed(const uint8_t nByte);
+
+
+        /** Encode
+         *
+         *  Compress a record. Records that don't get smaller are left as they are.
+         *
+         *  @param[in] vData The record to compress.
+         *  @param[out] vRecord The compressed record with its header.
+         *
+         *  @return True if the record was compressed into vRecord, false to store vData as is.
+         *
+         **/
+        bool Encode(const std::vector<uint8_t>& vData, std::vector<uint8_t>& vRecord);
+
+
+        /** Decode
+         *
+         *  Decompress a record in place. Records that aren't compressed are left as they are.
+         *
+         *  @param[out] vData The record read from disk, replaced with its uncompressed data.
+         *
+         *  @return True if the record is ready to be deserialized.
+         *
+         **/
+        bool Decode(std::vector<uint8_t>& vData) const;
+
+
+    private:
+
+        /** sample
+         *
+         *  Sample a record for the dictionary, setting the dictionary once enough are sampled.
+         *
+         *  @param[in] vData The record to sample.
+         *
+         **/
+        void sample(const std::vector<uint8_t>& vData);
+
+
+        /** load
+         *
+         *  Set the dictionary and load it into its LZ4 stream. Must be called with MUTEX held.
+         *
+         *  @param[in] vData The dictionary.
+         *
+         **/
+        void load(const std::vector<uint8_t>& vData);
+    };
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_FILTER_BLOOM_H
+#define NEXUS_LLD_FILTER_BLOOM_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace LLD
+{
+
+    /** BloomFilter
+     *
+     *  Probabilistic set of the keys that have been written to a keychain.
+     *  A negative answer is always correct, so lookups for keys that were never
+     *  written can return without probing the keychain files.
+     *
+     *  Bits are only ever set, so inserts and lookups are safe from any thread.
+     *
+     **/
+    class BloomFilter
+    {
+        /** The bit array stored in 64-bit words. **/
+        std::atomic<uint64_t>* pBits;
+
+
+        /** The total bits in the filter. **/
+        uint64_t nBits;
+
+
+        /** The total hash functions used per key. **/
+        uint32_t nHashes;
+
+
+        /** The total keys inserted into the filter. **/
+        std::atomic<uint64_t> nElements;
+
+
+        /** The total lookups that were filtered as negative. **/
+        std::atomic<uint64_t> nNegatives;
+
+
+        /** The total lookups that passed the filter but were not found. **/
+        std::atomic<uint64_t> nFalsePositives;
+
+
+    public:
+
+        /** Default Constructor. **/
+        BloomFilter() = delete;
+
+
+        /** Copy Constructor. **/
+        BloomFilter(const BloomFilter& filter) = delete;
+
+
+        /** Copy Assignment Operator. **/
+        BloomFilter& operator=(const BloomFilter& filter) = delete;
+
+
+        /** Capacity Constructor. Sizes the filter for given number of keys. **/
+        BloomFilter(const uint64_t nCapacity, const uint32_t nBitsPerKey = 10);
+
+
+        /** Default Destructor. **/
+        ~BloomFilter();
+
+
+        /** Insert
+         *
+         *  Add a key to the filter.
+         *
+         *  @param[in] pData Pointer to the key data.
+         *  @param[in] nSize The size of the key.
+         *
+         **/
+        void Insert(const uint8_t* pData, const uint32_t nSize);
+
+
+        /** Contains
+         *
+         *  Check if a key may have been added to the filter.
+         *
+         *  @param[in] pData Pointer to the key data.
+         *  @param[in] nSize The size of the key.
+         *
+         *  @return False if the key was never added, true if it might have been.
+         *
+         **/
+        bool Contains(const uint8_t* pData, const uint32_t nSize);
+
+
+        /** FalsePositive
+         *
+         *  Record a lookup that passed the filter but wasn't found in the keychain.
+         *
+         **/
+        void FalsePositive();
+
+
+        /** FalsePositiveRate
+         *
+         *  Get the observed rate of false positives among lookups for missing keys.
+         *
+         *  @return The false positive rate from 0 to 1.
+         *
+         **/
+        double FalsePositiveRate() const;
+
+
+        /** ResetStats
+         *
+         *  Reset the lookup counters used for the false positive rate.
+         *
+         **/
+        void ResetStats();
+
+
+        /** Elements
+         *
+         *  Get the total keys that have been inserted.
+         *
+         **/
+        uint64_t Elements() const;
+
+
+        /** Capacity
+         *
+         *  Get the total keys the filter was sized for.
+         *
+         **/
+        uint64_t Capacity() const;
+
+
+        /** Bytes
+         *
+         *  Get the total memory used by the bit array.
+         *
+         **/
+        uint64_t Bytes() const;
+
+
+        /** Load
+         *
+         *  Load the filter from disk, replacing the current bit array.
+         *
+         *  @param[in] strPath The path of the file to load.
+         *
+         *  @return True if the filter was loaded, false otherwise.
+         *
+         **/
+        bool Load(const std::string& strPath);
+
+
+        /** Save
+         *
+         *  Save the filter to disk.
+         *
+         *  @param[in] strPath The path of the file to save.
+         *
+         *  @return True if the filter was saved, false otherwise.
+         *
+         **/
+        bool Save(const std::string& strPath) const;
+
+    };
+}
+
+#endif
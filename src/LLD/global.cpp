@@ -15,6 +15,8 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/enum.h> //for internal flags
 
+#include <algorithm>
+
 namespace LLD
 {
     /* The LLD global instance pointers. */
@@ -34,24 +36,37 @@ namespace LLD
     {
         debug::log(0, FUNCTION, "Initializing LLD");
 
+        /* Memory map the keychains of our larger databases unless disabled. */
+        const uint8_t nMapped = config::GetBoolArg("-mapkeychain", true) ? FLAGS::MAPPED : 0;
+
+        /* Keep key filters in front of the databases that see mostly negative lookups. */
+        const uint8_t nFilter = config::GetBoolArg("-keyfilter", true) ? FLAGS::FILTER : 0;
+
+        /* Compress the records of the databases opted in by name, such as -compress=ledger. */
+        const std::vector<std::string> vCompress = config::mapMultiArgs["-compress"];
+        auto fnCompress = [&vCompress](const std::string& strName) -> uint8_t
+        {
+            return std::find(vCompress.begin(), vCompress.end(), strName) != vCompress.end() ? FLAGS::COMPRESS : 0;
+        };
+
         /* Create the contract database instance. */
         uint32_t nContractCacheSize = config::GetArg("-contractcache", 1);
         Contract = new ContractDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | fnCompress("contract"),
                         77773,
                         nContractCacheSize * 1024 * 1024);
 
         /* Create the contract database instance. */
         uint32_t nRegisterCacheSize = config::GetArg("-registercache", 2);
         Register = new RegisterDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | nMapped | nFilter | fnCompress("register"),
                         77773,
                         nRegisterCacheSize * 1024 * 1024);
 
         /* Create the ledger database instance. */
         uint32_t nLedgerCacheSize = config::GetArg("-ledgercache", 2);
         Ledger    = new LedgerDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | nMapped | nFilter | fnCompress("ledger"),
                         config::fClient.load() ? 77773 : (256 * 256 * 64),
                         nLedgerCacheSize * 1024 * 1024);
 
@@ -59,26 +74,26 @@ namespace LLD
         /* Create the legacy database instance. */
         uint32_t nLegacyCacheSize = config::GetArg("-legacycache", 1);
         Legacy = new LegacyDB(
-                        FLAGS::CREATE | FLAGS::FORCE,
+                        FLAGS::CREATE | FLAGS::FORCE | nMapped | nFilter | fnCompress("legacy"),
                         config::fClient.load() ? 77773 : 256 * 256 * 64,
                         nLegacyCacheSize * 1024 * 1024);
 
 
         /* Create the trust database instance. */
         Trust  = new TrustDB(
-                        FLAGS::CREATE | FLAGS::FORCE);
+                        FLAGS::CREATE | FLAGS::FORCE | fnCompress("trust"));
 
 
         /* Create the local database instance. */
         Local    = new LocalDB(
-                        FLAGS::CREATE | FLAGS::FORCE);
+                        FLAGS::CREATE | FLAGS::FORCE | fnCompress("local"));
         
 
         if(config::fClient.load())
         {
             /* Create new client database if enabled. */
             Client    = new ClientDB(
-                            FLAGS::CREATE | FLAGS::FORCE,
+                            FLAGS::CREATE | FLAGS::FORCE | fnCompress("client"),
                             77773);
         }
 
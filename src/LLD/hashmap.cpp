@@ -16,12 +16,23 @@ ________________________________________________________________________________
 #include <LLD/include/version.h>
 #include <LLD/hash/xxh3.h>
 
+#include <Util/templates/bufferpool.h>
 #include <Util/templates/datastream.h>
+#include <Util/templates/readstream.h>
 #include <Util/include/filesystem.h>
 #include <Util/include/debug.h>
 #include <Util/include/hex.h>
 
+#include <algorithm>
 #include <iomanip>
+#include <set>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace LLD
 {
@@ -38,6 +49,9 @@ namespace LLD
     , HASHMAP_KEY_ALLOCATION (static_cast<uint16_t>(HASHMAP_MAX_KEY_SIZE + 13))
     , nFlags                 (nFlagsIn)
     , RECORD_MUTEX           (1024)
+    , vMapped                ( )
+    , vFingerprints          ( )
+    , pFilter                (nullptr)
     {
         Initialize();
     }
@@ -55,6 +69,9 @@ namespace LLD
     , HASHMAP_KEY_ALLOCATION (map.HASHMAP_KEY_ALLOCATION)
     , nFlags                 (map.nFlags)
     , RECORD_MUTEX           (map.RECORD_MUTEX.size())
+    , vMapped                ( )
+    , vFingerprints          ( )
+    , pFilter                (nullptr)
     {
         Initialize();
     }
@@ -72,6 +89,9 @@ namespace LLD
     , HASHMAP_KEY_ALLOCATION (std::move(map.HASHMAP_KEY_ALLOCATION))
     , nFlags                 (std::move(map.nFlags))
     , RECORD_MUTEX           (map.RECORD_MUTEX.size())
+    , vMapped                ( )
+    , vFingerprints          ( )
+    , pFilter                (nullptr)
     {
         Initialize();
     }
@@ -121,6 +141,20 @@ namespace LLD
 
         if(pindex)
             delete pindex;
+
+        /* Persist the filter so the next startup doesn't need to rebuild it. */
+        if(pFilter)
+        {
+            pFilter->Save(debug::safe_printstr(strBaseLocation, "_hashmap.filter"));
+            delete pFilter;
+        }
+
+    #ifndef WIN32
+        /* Release the memory mapped views. */
+        for(uint8_t* pMapped : vMapped)
+            if(pMapped)
+                munmap(pMapped, HASHMAP_TOTAL_BUCKETS * HASHMAP_KEY_ALLOCATION);
+    #endif
     }
 
 
@@ -155,6 +189,80 @@ namespace LLD
     }
 
 
+    /* Calculates the in-memory fingerprint of a compressed key. */
+    uint8_t BinaryHashMap::GetFingerprint(const uint8_t* pKey, const uint16_t nSize) const
+    {
+        /* Use the top byte of a seeded xxHash, so it is independent of the bucket. */
+        uint8_t nFingerprint = static_cast<uint8_t>(XXH64(pKey, nSize, 1) >> 56);
+
+        return (nFingerprint == 0) ? 1 : nFingerprint;
+    }
+
+
+    /* Memory map a hashmap file and build the fingerprints of its buckets. */
+    bool BinaryHashMap::MapFile(const uint16_t nFile)
+    {
+    #ifdef WIN32
+        return false;
+    #else
+        /* Check that we are within our mapping limits. */
+        if(nFile >= vMapped.size())
+            return false;
+
+        /* Check if the file was already mapped. */
+        if(vMapped[nFile])
+            return true;
+
+        /* Open the file descriptor for mapping. */
+        std::string file = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), nFile);
+        int fd = open(file.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+
+        /* Check that the file has been fully allocated. */
+        const uint64_t nFileSize = uint64_t(HASHMAP_TOTAL_BUCKETS) * HASHMAP_KEY_ALLOCATION;
+
+        struct stat st;
+        if(fstat(fd, &st) != 0 || uint64_t(st.st_size) < nFileSize)
+        {
+            close(fd);
+            return debug::error(FUNCTION, "hashmap file ", nFile, " is too small to map");
+        }
+
+        /* Map the file as a shared read only view, writes will still go through the streams. */
+        void* pMap = mmap(nullptr, nFileSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if(pMap == MAP_FAILED)
+            return debug::error(FUNCTION, "failed to map hashmap file ", nFile, " (", strerror(errno), ")");
+
+        /* Build the fingerprints from the keys on disk. */
+        const uint8_t* pBegin = static_cast<const uint8_t*>(pMap);
+
+        std::vector<uint8_t> vFingerprint(HASHMAP_TOTAL_BUCKETS, 0);
+        for(uint32_t nBucket = 0; nBucket < HASHMAP_TOTAL_BUCKETS; ++nBucket)
+        {
+            /* Get the bucket in the file. */
+            const uint8_t* pBucket = pBegin + (nBucket * HASHMAP_KEY_ALLOCATION);
+            if(pBucket[0] == STATE::EMPTY)
+                continue;
+
+            /* Get the key length from the sector key header. */
+            uint16_t nLength = 0;
+            std::copy(pBucket + 1, pBucket + 3, (uint8_t*)&nLength);
+
+            vFingerprint[nBucket] = GetFingerprint(pBucket + 13, std::min(nLength, HASHMAP_MAX_KEY_SIZE));
+        }
+
+        /* Set the file to mapped. */
+        vFingerprints[nFile].swap(vFingerprint);
+        vMapped[nFile] = static_cast<uint8_t*>(pMap);
+
+        return true;
+    #endif
+    }
+
+
     /* Read a key index from the disk hashmaps. */
     void BinaryHashMap::Initialize()
     {
@@ -223,60 +331,229 @@ namespace LLD
 
         /* Load the stream object into the stream LRU cache. */
         fileCache->Put(0, new std::fstream(file, std::ios::in | std::ios::out | std::ios::binary));
+
+        /* Memory map the hashmap files if enabled. */
+        if(nFlags & FLAGS::MAPPED)
+        {
+            vMapped.assign(MAX_HASHMAP_FILES, nullptr);
+            vFingerprints.assign(MAX_HASHMAP_FILES, std::vector<uint8_t>());
+
+            /* Find the total files that are in use. */
+            uint32_t nTotalFiles = 0;
+            for(uint32_t nBucket = 0; nBucket < HASHMAP_TOTAL_BUCKETS; ++nBucket)
+                nTotalFiles = std::max(nTotalFiles, uint32_t(hashmap[nBucket]));
+
+            /* Map all of the files, falling back to streams if any fail. */
+            for(uint32_t nFile = 0; nFile < std::max(nTotalFiles, 1u); ++nFile)
+            {
+                if(!MapFile(nFile))
+                {
+                    debug::log(0, FUNCTION, "failed to map hashmap file ", nFile, ", falling back to streams");
+                    nFlags &= ~FLAGS::MAPPED;
+
+                    break;
+                }
+            }
+
+            /* Debug output showing mapping of the files. */
+            if(nFlags & FLAGS::MAPPED)
+                debug::log(0, FUNCTION, "Mapped ", std::max(nTotalFiles, 1u), " Hash Map files with ",
+                    std::max(nTotalFiles, 1u) * HASHMAP_TOTAL_BUCKETS, " bytes of fingerprints");
+        }
+
+        /* Build the key filter if enabled. */
+        if(nFlags & FLAGS::FILTER)
+            BuildFilter();
+    }
+
+
+    /* Load the persisted key filter, or rebuild it from the hashmap files. */
+    void BinaryHashMap::BuildFilter()
+    {
+        /* Find the total keys and files that are in use. */
+        uint64_t nTotalKeys  = 0;
+        uint32_t nTotalFiles = 0;
+        for(uint32_t nBucket = 0; nBucket < HASHMAP_TOTAL_BUCKETS; ++nBucket)
+        {
+            nTotalKeys += hashmap[nBucket];
+            nTotalFiles = std::max(nTotalFiles, uint32_t(hashmap[nBucket]));
+        }
+
+        /* Size the filter with room for the keychain to double. */
+        if(pFilter)
+            delete pFilter;
+
+        pFilter = new BloomFilter(std::max(nTotalKeys * 2, uint64_t(HASHMAP_TOTAL_BUCKETS)));
+
+        /* Load the filter persisted from a clean shutdown if it still has room. */
+        std::string strFilter = debug::safe_printstr(strBaseLocation, "_hashmap.filter");
+        if(pFilter->Load(strFilter))
+        {
+            /* Remove the file, so a crash before the next shutdown forces a rebuild. */
+            filesystem::remove(strFilter);
+
+            /* Use the loaded filter if it still has room. */
+            if(pFilter->Capacity() >= nTotalKeys)
+            {
+                debug::log(0, FUNCTION, "Loaded Key Filter of ", pFilter->Bytes(), " bytes and ", pFilter->Elements(), " keys");
+                return;
+            }
+
+            /* Otherwise start from an empty filter. */
+            delete pFilter;
+            pFilter = new BloomFilter(std::max(nTotalKeys * 2, uint64_t(HASHMAP_TOTAL_BUCKETS)));
+        }
+
+        /* Read the buckets in chunks when not memory mapped. */
+        const uint32_t nChunk = 1024 * 64;
+        std::vector<uint8_t> vBuffer;
+
+        /* Rebuild the filter from every key in the hashmap files. */
+        for(uint32_t nFile = 0; nFile < nTotalFiles; ++nFile)
+        {
+            /* Open the file stream if not mapped. */
+            std::ifstream stream;
+            if(!(nFlags & FLAGS::MAPPED))
+            {
+                stream.open(debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), nFile),
+                    std::ios::in | std::ios::binary);
+
+                if(!stream.is_open())
+                    continue;
+            }
+
+            for(uint32_t nStart = 0; nStart < HASHMAP_TOTAL_BUCKETS; nStart += nChunk)
+            {
+                /* Get the buckets in this chunk. */
+                const uint32_t nEnd = std::min(nStart + nChunk, HASHMAP_TOTAL_BUCKETS);
+
+                const uint8_t* pChunk = nullptr;
+                if(nFlags & FLAGS::MAPPED)
+                    pChunk = vMapped[nFile] + (uint64_t(nStart) * HASHMAP_KEY_ALLOCATION);
+                else
+                {
+                    vBuffer.resize((nEnd - nStart) * HASHMAP_KEY_ALLOCATION);
+
+                    stream.seekg(uint64_t(nStart) * HASHMAP_KEY_ALLOCATION, std::ios::beg);
+                    if(!stream.read((char*)&vBuffer[0], vBuffer.size()))
+                        break;
+
+                    pChunk = &vBuffer[0];
+                }
+
+                /* Add the keys that are in the bucket's linked file list. */
+                for(uint32_t nBucket = nStart; nBucket < nEnd; ++nBucket)
+                {
+                    if(hashmap[nBucket] <= nFile)
+                        continue;
+
+                    /* Skip over empty buckets. */
+                    const uint8_t* pBucket = pChunk + ((nBucket - nStart) * HASHMAP_KEY_ALLOCATION);
+                    if(pBucket[0] == STATE::EMPTY)
+                        continue;
+
+                    /* Get the key length from the sector key header. */
+                    uint16_t nLength = 0;
+                    std::copy(pBucket + 1, pBucket + 3, (uint8_t*)&nLength);
+
+                    pFilter->Insert(pBucket + 13, std::min(nLength, HASHMAP_MAX_KEY_SIZE));
+                }
+            }
+        }
+
+        /* Debug output showing the rebuilt filter. */
+        debug::log(0, FUNCTION, "Rebuilt Key Filter of ", pFilter->Bytes(), " bytes and ", pFilter->Elements(), " keys");
+    }
+
+
+    /* Get the key filter in front of this keychain. */
+    BloomFilter* BinaryHashMap::Filter() const
+    {
+        return pFilter;
     }
 
 
     /* Read a key index from the disk hashmaps. */
     bool BinaryHashMap::Get(const std::vector<uint8_t>& vKey, SectorKey &cKey)
     {
-        LOCK(KEY_MUTEX);
-
         /* Get the assigned bucket for the hashmap. */
         uint32_t nBucket = GetBucket(vKey);
 
+        /* Compress any keys larger than max size, in a pooled buffer. */
+        PooledStream ssCompressed(SER_LLD, DATABASE_VERSION);
+        std::vector<uint8_t>& vKeyCompressed = ssCompressed.Bytes();
+        vKeyCompressed.assign(vKey.begin(), vKey.end());
+        CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
+
+        /* Check the filter for keys that were never written. */
+        if(pFilter && !pFilter->Contains(&vKeyCompressed[0], vKeyCompressed.size()))
+            return false;
+
+        /* Mapped reads only need to lock the bucket's stripe, streams need the whole keychain. */
+        const bool fMapped = (nFlags & FLAGS::MAPPED);
+        std::unique_lock<std::mutex> lk(fMapped ? RECORD_MUTEX[nBucket % RECORD_MUTEX.size()] : KEY_MUTEX);
+
         /* Get the file binary position. */
         uint32_t nFilePos = nBucket * HASHMAP_KEY_ALLOCATION;
 
         /* Set the cKey return value non compressed. */
         cKey.vKey = vKey;
 
-        /* Compress any keys larger than max size. */
-        std::vector<uint8_t> vKeyCompressed = vKey;
-        CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
+        /* Get the fingerprint for the key. */
+        const uint8_t nFingerprint = fMapped ? GetFingerprint(&vKeyCompressed[0], vKeyCompressed.size()) : 0;
+
+        /* Only streams need a buffer to read buckets into. */
+        PooledStream ssBucket(SER_LLD, DATABASE_VERSION);
+        std::vector<uint8_t>& vBucket = ssBucket.Bytes();
+        if(!fMapped)
+            vBucket.resize(HASHMAP_KEY_ALLOCATION, 0);
 
         /* Reverse iterate the linked file list from hashmap to get most recent keys first. */
-        std::vector<uint8_t> vBucket(HASHMAP_KEY_ALLOCATION, 0);
         for(int16_t i = hashmap[nBucket] - 1; i >= 0; --i)
         {
-            /* Find the file stream for LRU cache. */
-            std::fstream *pstream;
-            if(!fileCache->Get(i, pstream))
+            /* Read the bucket in place from the memory mapped view, which the stripe lock keeps from changing. */
+            const uint8_t* pBucket = nullptr;
+            if(fMapped)
             {
-                /* Set the new stream pointer. */
-                std::string filename = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i);
-
-                pstream = new std::fstream(filename, std::ios::in | std::ios::out | std::ios::binary);
-                if(!pstream->is_open())
-                {
-                    delete pstream;
+                /* Skip over files that can't have the key. */
+                if(vFingerprints[i][nBucket] != nFingerprint)
                     continue;
-                }
 
-                /* If file not found add to LRU cache. */
-                fileCache->Put(i, pstream);
+                pBucket = vMapped[i] + nFilePos;
             }
+            else
+            {
+                /* Find the file stream for LRU cache. */
+                std::fstream *pstream;
+                if(!fileCache->Get(i, pstream))
+                {
+                    /* Set the new stream pointer. */
+                    std::string filename = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), i);
 
-            /* Seek to the hashmap index in file. */
-            pstream->seekg(nFilePos, std::ios::beg);
+                    pstream = new std::fstream(filename, std::ios::in | std::ios::out | std::ios::binary);
+                    if(!pstream->is_open())
+                    {
+                        delete pstream;
+                        continue;
+                    }
 
-            /* Read the bucket binary data from file stream */
-            pstream->read((char*) &vBucket[0], vBucket.size());
+                    /* If file not found add to LRU cache. */
+                    fileCache->Put(i, pstream);
+                }
+
+                /* Seek to the hashmap index in file. */
+                pstream->seekg(nFilePos, std::ios::beg);
+
+                /* Read the bucket binary data from file stream */
+                pstream->read((char*) &vBucket[0], vBucket.size());
+                pBucket = &vBucket[0];
+            }
 
             /* Check if this bucket has the key */
-            if(std::equal(vBucket.begin() + 13, vBucket.begin() + 13 + vKeyCompressed.size(), vKeyCompressed.begin()))
+            if(std::equal(pBucket + 13, pBucket + 13 + vKeyCompressed.size(), vKeyCompressed.begin()))
             {
                 /* Deserialie key and return if found. */
-                DataStream ssKey(vBucket, SER_LLD, DATABASE_VERSION);
+                const ReadStream ssKey(pBucket, pBucket + HASHMAP_KEY_ALLOCATION, SER_LLD, DATABASE_VERSION);
                 ssKey >> cKey;
 
                 /* Check if the key is ready. */
@@ -299,6 +576,10 @@ namespace LLD
             }
         }
 
+        /* Track the keys that got through the filter. */
+        if(pFilter)
+            pFilter->FalsePositive();
+
         return false;
     }
 
@@ -306,18 +587,37 @@ namespace LLD
     /* Write a key to the disk hashmaps. */
     bool BinaryHashMap::Put(const SectorKey& cKey)
     {
-        LOCK(KEY_MUTEX);
+        std::set<uint16_t> setFiles;
+        if(!put(cKey, setFiles))
+            return false;
+
+        return flush(setFiles, false);
+    }
+
 
+    /* Write a key to the disk hashmaps, leaving the writes in the streams. */
+    bool BinaryHashMap::put(const SectorKey& cKey, std::set<uint16_t>& setFiles)
+    {
         /* Get the assigned bucket for the hashmap. */
         uint32_t nBucket = GetBucket(cKey.vKey);
 
+        /* Lock the bucket's stripe before the streams. */
+        LOCK(RECORD_MUTEX[nBucket % RECORD_MUTEX.size()]);
+        LOCK2(KEY_MUTEX);
+
         /* Get the file binary position. */
         uint32_t nFilePos = nBucket * HASHMAP_KEY_ALLOCATION;
 
-        /* Compress any keys larger than max size. */
-        std::vector<uint8_t> vKeyCompressed = cKey.vKey;
+        /* Compress any keys larger than max size, in a pooled buffer. */
+        PooledStream ssCompressed(SER_LLD, DATABASE_VERSION);
+        std::vector<uint8_t>& vKeyCompressed = ssCompressed.Bytes();
+        vKeyCompressed.assign(cKey.vKey.begin(), cKey.vKey.end());
         CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
 
+        /* Get the fingerprint for the key. */
+        const bool fMapped = (nFlags & FLAGS::MAPPED);
+        const uint8_t nFingerprint = fMapped ? GetFingerprint(&vKeyCompressed[0], vKeyCompressed.size()) : 0;
+
         /* Handle if not in append mode which will update the key. */
         if(!(nFlags & FLAGS::APPEND))
         {
@@ -325,6 +625,10 @@ namespace LLD
             std::vector<uint8_t> vBucket(HASHMAP_KEY_ALLOCATION, 0);
             for(int16_t i = hashmap[nBucket] - 1; i >= 0; --i)
             {
+                /* Skip over files that are neither empty nor holding the key. */
+                if(fMapped && vFingerprints[i][nBucket] != 0 && vFingerprints[i][nBucket] != nFingerprint)
+                    continue;
+
                 /* Find the file stream for LRU cache. */
                 std::fstream* pstream;
                 if(!fileCache->Get(i, pstream))
@@ -354,7 +658,7 @@ namespace LLD
                 if(vBucket[0] == STATE::EMPTY || std::equal(vBucket.begin() + 13, vBucket.begin() + 13 + vKeyCompressed.size(), vKeyCompressed.begin()))
                 {
                     /* Serialize the key and return if found. */
-                    DataStream ssKey(SER_LLD, DATABASE_VERSION);
+                    PooledStream ssKey(SER_LLD, DATABASE_VERSION);
                     ssKey << cKey;
 
                     /* Serialize the key into the end of the vector. */
@@ -383,7 +687,15 @@ namespace LLD
                     /* Handle the disk writing operations. */
                     pstream->seekp (nFilePos, std::ios::beg);
                     pstream->write((char*)&ssKey.Bytes()[0], ssKey.size());
-                    pstream->flush();
+                    setFiles.insert(i);
+
+                    /* Update the bucket fingerprint. */
+                    if(fMapped)
+                        vFingerprints[i][nBucket] = nFingerprint;
+
+                    /* Add the key to the filter if it is new. */
+                    if(pFilter && vBucket[0] == STATE::EMPTY)
+                        pFilter->Insert(&vKeyCompressed[0], vKeyCompressed.size());
 
 
                     /* Debug Output of Sector Key Information. */
@@ -422,8 +734,12 @@ namespace LLD
             stream.close();
         }
 
+        /* Map the new file so readers can find it. */
+        if(fMapped && !MapFile(hashmap[nBucket]))
+            return debug::error(FUNCTION, "failed to map hashmap file ", hashmap[nBucket]);
+
         /* Read the State and Size of Sector Header. */
-        DataStream ssKey(SER_LLD, DATABASE_VERSION);
+        PooledStream ssKey(SER_LLD, DATABASE_VERSION);
         ssKey << cKey;
 
         /* Serialize the key into the end of the vector. */
@@ -445,10 +761,18 @@ namespace LLD
             fileCache->Put(hashmap[nBucket], pstream);
         }
 
-        /* Flush the key file to disk. */
+        /* Write the key into the file. */
         pstream->seekp (nFilePos, std::ios::beg);
         pstream->write((char*)&ssKey.Bytes()[0], ssKey.size());
-        pstream->flush();
+        setFiles.insert(hashmap[nBucket]);
+
+        /* Set the bucket fingerprint before the index makes it visible. */
+        if(fMapped)
+            vFingerprints[hashmap[nBucket]][nBucket] = nFingerprint;
+
+        /* Add the key to the filter. */
+        if(pFilter)
+            pFilter->Insert(&vKeyCompressed[0], vKeyCompressed.size());
 
         /* Seek to the index position. */
         pindex->seekp((nBucket * 2), std::ios::beg);
@@ -461,7 +785,6 @@ namespace LLD
 
         /* Write the index into hashmap. */
         pindex->write((char*)&vBucket[0], vBucket.size());
-        pindex->flush();
 
         /* Debug Output of Sector Key Information. */
         if(config::nVerbose >= 4)
@@ -480,6 +803,220 @@ namespace LLD
     }
 
 
+    /* Write a batch of keys to the disk hashmaps. */
+    bool BinaryHashMap::Put(const std::vector<SectorKey>& vKeys)
+    {
+        /* Get the buckets for the batch. */
+        std::vector< std::pair<uint32_t, uint32_t> > vOrder;
+        vOrder.reserve(vKeys.size());
+
+        for(uint32_t n = 0; n < vKeys.size(); ++n)
+            vOrder.push_back(std::make_pair(GetBucket(vKeys[n].vKey), n));
+
+        /* Sort by bucket, keeping batch order for keys in the same bucket. */
+        std::stable_sort(vOrder.begin(), vOrder.end(),
+            [](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b)
+            {
+                return a.first < b.first;
+            });
+
+        /* Write the keys in file order, flushing each file once. */
+        std::set<uint16_t> setFiles;
+        for(const auto& order : vOrder)
+            if(!put(vKeys[order.second], setFiles))
+                return false;
+
+        /* Sync the keys to disk, so they are as durable as the records they point to. */
+        return flush(setFiles, true);
+    }
+
+
+    /* Flush the streams of the hashmap files and the index. */
+    bool BinaryHashMap::flush(const std::set<uint16_t>& setFiles, const bool fSync)
+    {
+        {
+            LOCK(KEY_MUTEX);
+
+            /* Streams that were closed by the LRU cache were flushed as they closed. */
+            for(const auto& nFile : setFiles)
+            {
+                std::fstream* pstream;
+                if(fileCache->Get(nFile, pstream) && !pstream->flush())
+                    return debug::error(FUNCTION, "failed to flush hashmap file ", nFile);
+            }
+
+            if(!pindex->flush())
+                return debug::error(FUNCTION, "failed to flush hashmap index");
+        }
+
+    #ifndef WIN32
+        if(fSync)
+        {
+            std::vector<std::string> vFiles;
+            for(const auto& nFile : setFiles)
+                vFiles.push_back(debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), nFile));
+
+            vFiles.push_back(debug::safe_printstr(strBaseLocation, "_hashmap.index"));
+
+            for(const auto& strFile : vFiles)
+            {
+                int32_t nFile = ::open(strFile.c_str(), O_WRONLY);
+                if(nFile < 0)
+                    return debug::error(FUNCTION, "failed to open ", strFile);
+
+                /* fdatasync is not available on OSX. */
+            #ifdef MAC_OSX
+                bool fSynced = (::fsync(nFile) == 0);
+            #else
+                bool fSynced = (::fdatasync(nFile) == 0);
+            #endif
+
+                ::close(nFile);
+                if(!fSynced)
+                    return debug::error(FUNCTION, "failed to sync ", strFile);
+            }
+        }
+    #endif
+
+        return true;
+    }
+
+
+    /* Find every valid key in the hashmap files that points into a given sector file. */
+    bool BinaryHashMap::Sectors(const uint16_t nSectorFile, std::vector< std::pair<uint64_t, SectorKey> >& vKeys)
+    {
+        /* Find the total files that are in use. */
+        uint32_t nTotalFiles = 0;
+        {
+            LOCK(KEY_MUTEX);
+            for(uint32_t nBucket = 0; nBucket < HASHMAP_TOTAL_BUCKETS; ++nBucket)
+                nTotalFiles = std::max(nTotalFiles, uint32_t(hashmap[nBucket]));
+        }
+
+        /* Read the buckets in chunks through independent streams. */
+        const uint32_t nChunk = 1024 * 64;
+        std::vector<uint8_t> vBuffer;
+
+        for(uint32_t nFile = 0; nFile < nTotalFiles; ++nFile)
+        {
+            std::ifstream stream(debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), nFile),
+                std::ios::in | std::ios::binary);
+
+            if(!stream.is_open())
+                return debug::error(FUNCTION, "couldn't open hashmap file ", nFile);
+
+            for(uint32_t nStart = 0; nStart < HASHMAP_TOTAL_BUCKETS; nStart += nChunk)
+            {
+                /* Read the buckets in this chunk. */
+                const uint32_t nEnd = std::min(nStart + nChunk, HASHMAP_TOTAL_BUCKETS);
+                vBuffer.resize((nEnd - nStart) * HASHMAP_KEY_ALLOCATION);
+
+                stream.seekg(uint64_t(nStart) * HASHMAP_KEY_ALLOCATION, std::ios::beg);
+                if(!stream.read((char*)&vBuffer[0], vBuffer.size()))
+                    break;
+
+                /* Check the sector key header of every valid bucket. */
+                for(uint32_t nBucket = nStart; nBucket < nEnd; ++nBucket)
+                {
+                    const uint8_t* pBucket = &vBuffer[(nBucket - nStart) * HASHMAP_KEY_ALLOCATION];
+                    if(pBucket[0] != STATE::READY)
+                        continue;
+
+                    /* Deserialize the sector key header. */
+                    const ReadStream ssKey(pBucket, pBucket + 13, SER_LLD, DATABASE_VERSION);
+
+                    SectorKey cKey;
+                    ssKey >> cKey;
+
+                    /* Skip keychain only entries and other sector files. */
+                    if(cKey.nSectorFile != nSectorFile || cKey.nSectorSize == 0)
+                        continue;
+
+                    vKeys.push_back(std::make_pair((uint64_t(nFile) << 32) | nBucket, cKey));
+                }
+            }
+        }
+
+        return true;
+    }
+
+
+    /* Repoint the keys found by Sectors to the new locations of their moved sectors. */
+    bool BinaryHashMap::Relocate(const uint16_t nSectorFile, const std::vector< std::pair<uint64_t, SectorKey> >& vKeys,
+                                 const std::map<uint32_t, std::pair<uint16_t, uint32_t> >& mapMoved,
+                                 std::map<uint32_t, std::pair<uint16_t, uint32_t> >& mapRelocated)
+    {
+        for(const auto& slot : vKeys)
+        {
+            /* Check that the sector was moved. */
+            auto it = mapMoved.find(slot.second.nSectorStart);
+            if(it == mapMoved.end())
+                continue;
+
+            /* Get the slot position. */
+            const uint16_t nFile   = static_cast<uint16_t>(slot.first >> 32);
+            const uint32_t nBucket = static_cast<uint32_t>(slot.first);
+
+            /* Lock the bucket's stripe before the streams. */
+            LOCK(RECORD_MUTEX[nBucket % RECORD_MUTEX.size()]);
+            LOCK2(KEY_MUTEX);
+
+            /* Find the file stream for LRU cache. */
+            std::fstream* pstream;
+            if(!fileCache->Get(nFile, pstream))
+            {
+                std::string filename = debug::safe_printstr(strBaseLocation, "_hashmap.", std::setfill('0'), std::setw(5), nFile);
+
+                /* Set the new stream pointer. */
+                pstream = new std::fstream(filename, std::ios::in | std::ios::out | std::ios::binary);
+                if(!pstream->is_open())
+                {
+                    delete pstream;
+                    return debug::error(FUNCTION, "couldn't create hashmap object at: ",
+                        filename, " (", strerror(errno), ")");
+                }
+
+                /* If file not found add to LRU cache. */
+                fileCache->Put(nFile, pstream);
+            }
+
+            /* Read the sector key header again now that the bucket is locked. */
+            const uint64_t nFilePos = uint64_t(nBucket) * HASHMAP_KEY_ALLOCATION;
+
+            DataStream ssKey(SER_LLD, DATABASE_VERSION);
+            ssKey.resize(13);
+
+            pstream->seekg(nFilePos, std::ios::beg);
+            if(!pstream->read((char*)ssKey.data(), ssKey.size()))
+                return debug::error(FUNCTION, "failed to read hashmap bucket ", nBucket);
+
+            SectorKey cKey;
+            ssKey >> cKey;
+
+            /* Skip keys that were changed since the scan. */
+            if(cKey.nState != STATE::READY || cKey.nSectorFile != nSectorFile || cKey.nSectorStart != slot.second.nSectorStart)
+                continue;
+
+            /* Write the new location into the header. */
+            cKey.nSectorFile  = it->second.first;
+            cKey.nSectorStart = it->second.second;
+
+            DataStream ssNew(SER_LLD, DATABASE_VERSION);
+            ssNew << cKey;
+
+            pstream->seekp(nFilePos, std::ios::beg);
+            if(!pstream->write((char*)ssNew.data(), ssNew.size()))
+                return debug::error(FUNCTION, "failed to write hashmap bucket ", nBucket);
+
+            pstream->flush();
+
+            mapRelocated.insert(*it);
+        }
+
+        return true;
+    }
+
+
     /* Flush all buffers to disk if using ACID transaction. */
     void BinaryHashMap::Flush()
     {
@@ -503,11 +1040,13 @@ namespace LLD
      *  TODO: This should be optimized further. */
     bool BinaryHashMap::Erase(const std::vector<uint8_t> &vKey)
     {
-        LOCK(KEY_MUTEX);
-
         /* Get the assigned bucket for the hashmap. */
         uint32_t nBucket = GetBucket(vKey);
 
+        /* Lock the bucket's stripe before the streams. */
+        LOCK(RECORD_MUTEX[nBucket % RECORD_MUTEX.size()]);
+        LOCK2(KEY_MUTEX);
+
         /* Get the file binary position. */
         uint32_t nFilePos = nBucket * HASHMAP_KEY_ALLOCATION;
 
@@ -515,10 +1054,18 @@ namespace LLD
         std::vector<uint8_t> vKeyCompressed = vKey;
         CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
 
+        /* Get the fingerprint for the key. */
+        const bool fMapped = (nFlags & FLAGS::MAPPED);
+        const uint8_t nFingerprint = fMapped ? GetFingerprint(&vKeyCompressed[0], vKeyCompressed.size()) : 0;
+
         /* Reverse iterate the linked file list from hashmap to get most recent keys first. */
         std::vector<uint8_t> vBucket(HASHMAP_KEY_ALLOCATION, 0);
         for(int16_t i = hashmap[nBucket] - 1; i >= 0; --i)
         {
+            /* Skip over files that can't have the key. */
+            if(fMapped && vFingerprints[i][nBucket] != nFingerprint)
+                continue;
+
             /* Find the file stream for LRU cache. */
             std::fstream* pstream;
             if(!fileCache->Get(i, pstream))
@@ -554,6 +1101,10 @@ namespace LLD
                 pstream->write((char*) &vEmpty[0], vEmpty.size());
                 pstream->flush();
 
+                /* Clear the bucket fingerprint. */
+                if(fMapped)
+                    vFingerprints[i][nBucket] = 0;
+
                 /* Debug Output of Sector Key Information. */
                 if(config::nVerbose >= 4)
                     debug::log(4, FUNCTION, "Erased State: ", cKey.nState == STATE::READY ? "Valid" : "Invalid",
@@ -577,11 +1128,13 @@ namespace LLD
     /* Restore an index in the hashmap if it is found. */
     bool BinaryHashMap::Restore(const std::vector<uint8_t> &vKey)
     {
-        LOCK(KEY_MUTEX);
-
         /* Get the assigned bucket for the hashmap. */
         uint32_t nBucket = GetBucket(vKey);
 
+        /* Lock the bucket's stripe before the streams. */
+        LOCK(RECORD_MUTEX[nBucket % RECORD_MUTEX.size()]);
+        LOCK2(KEY_MUTEX);
+
         /* Get the file binary position. */
         uint32_t nFilePos = nBucket * HASHMAP_KEY_ALLOCATION;
 
@@ -589,10 +1142,18 @@ namespace LLD
         std::vector<uint8_t> vKeyCompressed = vKey;
         CompressKey(vKeyCompressed, HASHMAP_MAX_KEY_SIZE);
 
+        /* Get the fingerprint for the key. */
+        const bool fMapped = (nFlags & FLAGS::MAPPED);
+        const uint8_t nFingerprint = fMapped ? GetFingerprint(&vKeyCompressed[0], vKeyCompressed.size()) : 0;
+
         /* Reverse iterate the linked file list from hashmap to get most recent keys first. */
         std::vector<uint8_t> vBucket(HASHMAP_KEY_ALLOCATION, 0);
         for(int16_t i = hashmap[nBucket] - 1; i >= 0; --i)
         {
+            /* Skip over files that can't have the key. */
+            if(fMapped && vFingerprints[i][nBucket] != nFingerprint)
+                continue;
+
             /* Find the file stream for LRU cache. */
             std::fstream* pstream;
             if(!fileCache->Get(i, pstream))
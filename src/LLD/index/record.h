@@ -0,0 +1,306 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_INDEX_RECORD_H
+#define NEXUS_LLD_INDEX_RECORD_H
+
+#include <LLD/templates/key.h>
+
+#include <Util/templates/datastream.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace LLD
+{
+
+    /** RecordIndex
+     *
+     *  Secondary index of the live records in a sector database by their type string,
+     *  and optionally by a field extracted from the record. Records are tracked by their
+     *  sector location, so listing a type reads its records directly instead of scanning
+     *  every sector file. Each record costs a compact entry: its type is interned and its
+     *  field is kept as a 64-bit hash.
+     *
+     **/
+    class RecordIndex
+    {
+    public:
+
+        /** Extracts the serialized field to index a record by, from the stream positioned after the type. **/
+        typedef std::function<bool(DataStream&, std::vector<uint8_t>&)> FieldExtractor;
+
+
+        /** Marks a record whose type isn't indexed. **/
+        static const uint16_t TYPE_NONE = 0xffff;
+
+
+        /** Entry
+         *
+         *  The interned type, hashed field and size of an indexed record.
+         *
+         **/
+        struct Entry
+        {
+            /** The 64-bit hash of the serialized field, or zero if the record has no field. **/
+            uint64_t hashField;
+
+            /** The size of the record's sector. **/
+            uint32_t nSize;
+
+            /** The position of the record's type in the registered types. **/
+            uint16_t nType;
+
+
+            /** Default Constructor. **/
+            Entry()
+            : hashField (0)
+            , nSize     (0)
+            , nType     (TYPE_NONE)
+            {
+            }
+        };
+
+
+    private:
+
+        /** Mutex for thread safety. **/
+        mutable std::mutex MUTEX;
+
+
+        /** The indexed record types, with their optional field extractors. **/
+        std::vector<std::pair<std::string, FieldExtractor> > vTypes;
+
+
+        /** The position of each type in the registered types. **/
+        std::map<std::string, uint16_t> mapTypes;
+
+
+        /** The locations of the records of each type. **/
+        std::vector<std::set<uint64_t> > vRecords;
+
+
+        /** The locations of the records of each type by field hash. **/
+        std::vector<std::unordered_map<uint64_t, std::set<uint64_t> > > vFields;
+
+
+        /** The index entry of each location. **/
+        std::unordered_map<uint64_t, Entry> mapLocations;
+
+
+    public:
+
+        /** Default Constructor. **/
+        RecordIndex();
+
+
+        /** Copy Constructor. **/
+        RecordIndex(const RecordIndex& index) = delete;
+
+
+        /** Copy Assignment Operator. **/
+        RecordIndex& operator=(const RecordIndex& index) = delete;
+
+
+        /** Default Destructor. **/
+        ~RecordIndex();
+
+
+        /** Location
+         *
+         *  Get the index location of a sector.
+         *
+         *  @param[in] nSectorFile The sector file.
+         *  @param[in] nSectorStart The position of the sector in its file.
+         *
+         *  @return The location packed into 64 bits.
+         *
+         **/
+        static uint64_t Location(const uint16_t nSectorFile, const uint32_t nSectorStart);
+
+
+        /** Register
+         *
+         *  Add a record type to the index.
+         *
+         *  @param[in] strType The type string records are written with.
+         *  @param[in] fnField Optional extractor of the field to index records by.
+         *
+         **/
+        void Register(const std::string& strType, const FieldExtractor& fnField = FieldExtractor());
+
+
+        /** Types
+         *
+         *  Get the total record types in the index.
+         *
+         **/
+        uint32_t Types() const;
+
+
+        /** Indexed
+         *
+         *  Check if a record type is indexed.
+         *
+         *  @param[in] strType The type string to check.
+         *
+         *  @return True if records of the type are indexed.
+         *
+         **/
+        bool Indexed(const std::string& strType) const;
+
+
+        /** Extract
+         *
+         *  Get the index entry of a record, without changing the index. This parses the
+         *  record, so call it before taking any locks that Add is called under.
+         *
+         *  @param[in] vData The binary data of the record, beginning with its type string.
+         *  @param[out] entry The entry of the record, with no type if the type isn't registered.
+         *
+         **/
+        void Extract(const std::vector<uint8_t>& vData, Entry& entry) const;
+
+
+        /** Add
+         *
+         *  Index a record written to a sector, replacing what was indexed at that location.
+         *  Records of types that aren't registered are ignored.
+         *
+         *  @param[in] cKey The sector key of the record.
+         *  @param[in] entry The entry of the record from Extract.
+         *
+         **/
+        void Add(const SectorKey& cKey, const Entry& entry);
+
+
+        /** Add
+         *
+         *  Index a record written to a sector, replacing what was indexed at that location.
+         *  Records of types that aren't registered are ignored.
+         *
+         *  @param[in] cKey The sector key of the record.
+         *  @param[in] vData The binary data of the record, beginning with its type string.
+         *
+         **/
+        void Add(const SectorKey& cKey, const std::vector<uint8_t>& vData);
+
+
+        /** Remove
+         *
+         *  Remove a sector from the index when its record is no longer live.
+         *
+         *  @param[in] cKey The sector key of the record.
+         *
+         **/
+        void Remove(const SectorKey& cKey);
+
+
+        /** Move
+         *
+         *  Move the records of a compacted sector file to their new locations.
+         *
+         *  @param[in] nSectorFile The sector file the records were moved out of.
+         *  @param[in] mapMoved The old sector start mapped to its new sector file and start.
+         *
+         **/
+        void Move(const uint16_t nSectorFile, const std::map<uint32_t, std::pair<uint16_t, uint32_t> >& mapMoved);
+
+
+        /** Get
+         *
+         *  Get the sectors of the records of a type, in sector order.
+         *
+         *  @param[in] strType The type string of the records.
+         *  @param[out] vKeys The sector keys of the records.
+         *
+         **/
+        void Get(const std::string& strType, std::vector<SectorKey>& vKeys) const;
+
+
+        /** Get
+         *
+         *  Get the sectors of the records of a type with a given field, in sector order.
+         *
+         *  @param[in] strType The type string of the records.
+         *  @param[in] vField The serialized field of the records.
+         *  @param[out] vKeys The sector keys of the records.
+         *
+         **/
+        void Get(const std::string& strType, const std::vector<uint8_t>& vField, std::vector<SectorKey>& vKeys) const;
+
+
+        /** Clear
+         *
+         *  Remove every record from the index, keeping the registered types.
+         *
+         **/
+        void Clear();
+
+
+        /** Load
+         *
+         *  Load the index from disk, if it was saved with the same registered types.
+         *
+         *  @param[in] strPath The file to load from.
+         *
+         *  @return True if the index was loaded.
+         *
+         **/
+        bool Load(const std::string& strPath);
+
+
+        /** Save
+         *
+         *  Save the index to disk.
+         *
+         *  @param[in] strPath The file to save to.
+         *
+         *  @return True if the index was saved.
+         *
+         **/
+        bool Save(const std::string& strPath) const;
+
+
+    private:
+
+        /** remove
+         *
+         *  Remove a location from the index. Must be called with MUTEX held.
+         *
+         *  @param[in] nLocation The location to remove.
+         *
+         **/
+        void remove(const uint64_t nLocation);
+
+
+        /** insert
+         *
+         *  Insert a location into the index. Must be called with MUTEX held.
+         *
+         *  @param[in] nLocation The location to insert.
+         *  @param[in] entry The entry of the location.
+         *
+         **/
+        void insert(const uint64_t nLocation, const Entry& entry);
+    };
+}
+
+#endif
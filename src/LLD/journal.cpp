@@ -0,0 +1,366 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/templates/journal.h>
+#include <LLD/include/version.h>
+#include <LLD/hash/xxh3.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+#include <Util/templates/datastream.h>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace LLD
+{
+
+    /* Constructor. */
+    SectorJournal::SectorJournal(const std::string& strPathIn, const uint64_t nCheckpointSizeIn)
+    : MUTEX           ( )
+    , strPath         (strPathIn)
+    , stream          ( )
+    , nSize           (0)
+    , nCheckpointSize (nCheckpointSizeIn)
+    , fFailed         (false)
+    , fPending        (false)
+    {
+    }
+
+
+    /* Default Destructor. */
+    SectorJournal::~SectorJournal()
+    {
+        if(stream.is_open())
+            stream.close();
+    }
+
+
+    /* Append a record to the log. */
+    bool SectorJournal::Write(const uint8_t nType, const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
+    {
+        uint64_t nPos = 0;
+        return Write(nType, vKey, vData, nPos);
+    }
+
+
+    /* Append a record to the log, giving its position so it can be read back. */
+    bool SectorJournal::Write(const uint8_t nType, const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData, uint64_t& nPos)
+    {
+        /* Serialize the operation. */
+        DataStream ssRecord(SER_LLD, DATABASE_VERSION);
+        if(nType >= WRITE && nType <= INDEX)
+            ssRecord << vKey << vData;
+
+        /* Frame the record with its type, length and checksum. */
+        const uint32_t nLength   = static_cast<uint32_t>(ssRecord.size());
+        const uint32_t nChecksum = XXH32(ssRecord.size() ? &ssRecord.Bytes()[0] : nullptr, ssRecord.size(), nType);
+
+        DataStream ssFrame(SER_LLD, DATABASE_VERSION);
+        ssFrame << nType << nLength << nChecksum;
+
+        LOCK(MUTEX);
+        if(!open())
+        {
+            fFailed = true;
+            return debug::error(FUNCTION, "failed to open journal ", strPath);
+        }
+
+        stream.write((char*)ssFrame.data(), ssFrame.size());
+        if(nLength > 0)
+            stream.write((char*)ssRecord.data(), nLength);
+
+        if(!stream)
+        {
+            fFailed = true;
+            return debug::error(FUNCTION, "failed to write to journal ", strPath);
+        }
+
+        nPos   = nSize;
+        nSize += ssFrame.size() + nLength;
+
+        /* Track if the last transaction is released. */
+        if(nType == BEGIN)
+            fPending = true;
+        else if(nType == RELEASE)
+            fPending = false;
+
+        return true;
+    }
+
+
+    /* Flush the log through to stable storage. */
+    bool SectorJournal::Sync()
+    {
+        LOCK(MUTEX);
+        if(!stream.is_open())
+            return !fFailed;
+
+        stream.flush();
+        if(!stream)
+            return debug::error(FUNCTION, "failed to flush journal ", strPath);
+
+    #ifndef WIN32
+        int32_t nFile = ::open(strPath.c_str(), O_WRONLY);
+        if(nFile < 0)
+            return debug::error(FUNCTION, "failed to open journal ", strPath);
+
+        /* fdatasync is not available on OSX. */
+    #ifdef MAC_OSX
+        bool fSynced = (::fsync(nFile) == 0);
+    #else
+        bool fSynced = (::fdatasync(nFile) == 0);
+    #endif
+
+        ::close(nFile);
+        if(!fSynced)
+            return debug::error(FUNCTION, "failed to sync journal ", strPath);
+    #endif
+
+        return !fFailed;
+    }
+
+
+    /* Mark the last transaction of the log as released. */
+    void SectorJournal::Release()
+    {
+        /* Check that there is a transaction to release. */
+        {
+            LOCK(MUTEX);
+            if(!fPending)
+                return;
+        }
+
+        /* Write and flush the marker, leaving it to the next sync to make durable. */
+        Write(RELEASE);
+
+        LOCK(MUTEX);
+        if(stream.is_open())
+            stream.flush();
+
+        /* Truncate the log as a checkpoint once it is large enough. */
+        if(nSize < nCheckpointSize)
+            return;
+
+        debug::log(3, FUNCTION, "truncating journal ", strPath, " at ", nSize, " bytes");
+
+        if(stream.is_open())
+            stream.close();
+
+        if(!open(true))
+            debug::error(FUNCTION, "failed to truncate journal ", strPath);
+    }
+
+
+    /* Read back records written by the pending transaction. */
+    bool SectorJournal::Read(const std::vector<uint64_t>& vPos, std::vector<Record>& vRecords)
+    {
+        LOCK(MUTEX);
+
+        /* Make sure the records are visible to the read. */
+        if(stream.is_open())
+            stream.flush();
+
+        std::ifstream file(strPath, std::ios::in | std::ios::binary);
+        if(!file.is_open())
+            return debug::error(FUNCTION, "failed to open journal ", strPath);
+
+        /* Get the size of the log. */
+        file.seekg(0, std::ios::end);
+        const uint64_t nFileSize = static_cast<uint64_t>(file.tellg());
+
+        vRecords.reserve(vRecords.size() + vPos.size());
+        for(const auto& nPos : vPos)
+        {
+            uint8_t nType = 0;
+            DataStream ssRecord(SER_LLD, DATABASE_VERSION);
+            if(!frame(file, nPos, nFileSize, nType, ssRecord) || nType < WRITE || nType > INDEX)
+                return debug::error(FUNCTION, "journal ", strPath, " has no record at ", nPos);
+
+            try
+            {
+                Record record;
+                record.nType = nType;
+                record.nPos  = nPos;
+
+                ssRecord >> record.vKey >> record.vData;
+
+                vRecords.push_back(std::move(record));
+            }
+            catch(const std::exception& e)
+            {
+                return debug::error(FUNCTION, "failed to read journal record: ", e.what());
+            }
+        }
+
+        return true;
+    }
+
+
+    /* Read the records of the last transaction in the log. */
+    bool SectorJournal::Tail(std::vector<Record>& vRecords, const uint64_t nMaxData)
+    {
+        LOCK(MUTEX);
+
+        /* Make sure anything written is visible to the read. */
+        if(stream.is_open())
+            stream.flush();
+
+        std::ifstream file(strPath, std::ios::in | std::ios::binary);
+        if(!file.is_open())
+            return false;
+
+        /* Get the size of the log. */
+        file.seekg(0, std::ios::end);
+        const uint64_t nFileSize = static_cast<uint64_t>(file.tellg());
+
+        /* Walk the records, keeping the ones after the last begin. Nothing past a torn record is used. */
+        bool fBegin = false;
+        uint64_t nPos = 0, nData = 0;
+        while(nPos + HEADER_SIZE <= nFileSize)
+        {
+            uint8_t nType = 0;
+            DataStream ssRecord(SER_LLD, DATABASE_VERSION);
+            if(!frame(file, nPos, nFileSize, nType, ssRecord))
+            {
+                debug::log(0, FUNCTION, "journal ", strPath, " has a torn record at ", nPos);
+                break;
+            }
+
+            const uint64_t nLength = ssRecord.size();
+
+            Record record;
+            record.nType = nType;
+            record.nPos  = nPos;
+
+            /* Start over at each begin, since only the last transaction can be pending. */
+            if(nType == BEGIN)
+            {
+                vRecords.clear();
+                fBegin = true;
+                nData  = 0;
+            }
+            else if(nType >= WRITE && nType <= INDEX)
+            {
+                try
+                {
+                    ssRecord >> record.vKey;
+
+                    /* Leave large data in the log, to be read back when it is committed. */
+                    if(nType != WRITE || nData + nLength <= nMaxData)
+                    {
+                        ssRecord >> record.vData;
+                        if(nType == WRITE)
+                            nData += record.vData.size();
+                    }
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "failed to read journal record: ", e.what());
+                    break;
+                }
+            }
+
+            nPos += HEADER_SIZE + nLength;
+
+            /* Skip the begin itself. */
+            if(nType != BEGIN)
+                vRecords.push_back(std::move(record));
+        }
+
+        /* Cut off a torn record, so records appended after it can be read back. */
+        if(nPos < nFileSize)
+        {
+            if(stream.is_open())
+                stream.close();
+
+        #ifndef WIN32
+            if(::truncate(strPath.c_str(), nPos) != 0)
+                debug::error(FUNCTION, "failed to cut torn record from journal ", strPath);
+        #endif
+        }
+
+        /* Check that there is a transaction. */
+        if(!fBegin)
+        {
+            if(nFileSize > 0)
+                debug::log(0, FUNCTION, "journal ", strPath, " of ", nFileSize, " bytes has no transaction");
+
+            return false;
+        }
+
+        /* The last transaction is pending until released. */
+        fPending = (vRecords.empty() || vRecords.back().nType != RELEASE);
+
+        return true;
+    }
+
+
+    /* Open the append stream if it isn't open. */
+    bool SectorJournal::open(const bool fTruncate)
+    {
+        if(stream.is_open())
+            return true;
+
+        stream.open(strPath, std::ios::out | std::ios::binary | (fTruncate ? std::ios::trunc : std::ios::app));
+        if(!stream.is_open())
+            return false;
+
+        /* Get the current size to know when to truncate. */
+        if(fTruncate)
+        {
+            nSize   = 0;
+            fFailed = false;
+        }
+        else
+        {
+            stream.seekp(0, std::ios::end);
+            nSize = static_cast<uint64_t>(stream.tellp());
+        }
+
+        return true;
+    }
+
+
+    /* Read a record of the log and check it wasn't torn. */
+    bool SectorJournal::frame(std::ifstream& file, const uint64_t nPos, const uint64_t nFileSize, uint8_t& nType, DataStream& ssRecord)
+    {
+        if(nPos + HEADER_SIZE > nFileSize)
+            return false;
+
+        /* Read the frame of type, length and checksum. */
+        DataStream ssFrame(SER_LLD, DATABASE_VERSION);
+        ssFrame.resize(HEADER_SIZE);
+
+        file.clear();
+        file.seekg(nPos, std::ios::beg);
+        if(!file.read((char*)ssFrame.data(), HEADER_SIZE))
+            return false;
+
+        uint32_t nLength = 0, nChecksum = 0;
+        ssFrame >> nType >> nLength >> nChecksum;
+
+        /* A frame running past the end was torn by a crash. */
+        if(nType < BEGIN || nType > RELEASE || nPos + HEADER_SIZE + nLength > nFileSize)
+            return false;
+
+        /* Read the record and check it against its checksum. */
+        ssRecord.resize(nLength);
+        if(nLength > 0 && !file.read((char*)ssRecord.data(), nLength))
+            return false;
+
+        return XXH32(nLength ? &ssRecord.Bytes()[0] : nullptr, nLength, nType) == nChecksum;
+    }
+}
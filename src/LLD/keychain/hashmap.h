@@ -17,6 +17,10 @@ ________________________________________________________________________________
 
 #include <LLD/keychain/keychain.h>
 #include <LLD/cache/template_lru.h>
+#include <LLD/filter/bloom.h>
+
+#include <map>
+#include <set>
 #include <LLD/include/enum.h>
 
 #include <cstdint>
@@ -28,6 +32,10 @@ ________________________________________________________________________________
 namespace LLD
 {
 
+    /* Maximum number of hashmap files that can be memory mapped. */
+    const uint32_t MAX_HASHMAP_FILES = 1 << 15;
+
+
     /** BinaryHashMap
      *
      *  This class is responsible for managing the keys to the sector database.
@@ -36,6 +44,13 @@ namespace LLD
      *  It uses a linked file list based on index to iterate trhough files and binary Positions
      *  when there is a collision that is found.
      *
+     *  In MAPPED mode the hashmap files are memory mapped and a one byte fingerprint of
+     *  every bucket is kept in memory, so a lookup only touches the files whose
+     *  fingerprint matches, and readers only lock the stripe their bucket belongs to.
+     *
+     *  In FILTER mode a bloom filter of every key written is kept in front of the files,
+     *  so lookups for keys that were never written return without any probing.
+     *
      **/
     class BinaryHashMap : public Keychain
     {
@@ -81,6 +96,18 @@ namespace LLD
         mutable std::vector<std::mutex> RECORD_MUTEX;
 
 
+        /** Memory mapped views of the hashmap files, indexed by file number. **/
+        std::vector<uint8_t*> vMapped;
+
+
+        /** In-memory key fingerprints of every bucket, indexed by file number. **/
+        std::vector< std::vector<uint8_t> > vFingerprints;
+
+
+        /** Filter of all keys written, to short-circuit negative lookups. **/
+        BloomFilter* pFilter;
+
+
     public:
 
 
@@ -136,6 +163,50 @@ namespace LLD
         uint32_t GetBucket(const std::vector<uint8_t>& vKey);
 
 
+        /** GetFingerprint
+         *
+         *  Calculates the in-memory fingerprint of a compressed key.
+         *  A fingerprint of zero is reserved for empty buckets.
+         *
+         *  @param[in] pKey Pointer to the compressed key data.
+         *  @param[in] nSize The size of the compressed key.
+         *
+         *  @return The fingerprint of the key.
+         *
+         **/
+        uint8_t GetFingerprint(const uint8_t* pKey, const uint16_t nSize) const;
+
+
+        /** MapFile
+         *
+         *  Memory map a hashmap file and build the fingerprints of its buckets.
+         *
+         *  @param[in] nFile The hashmap file number to map.
+         *
+         *  @return True if the file was mapped, false otherwise.
+         *
+         **/
+        bool MapFile(const uint16_t nFile);
+
+
+        /** BuildFilter
+         *
+         *  Load the persisted key filter, or rebuild it from the hashmap files.
+         *
+         **/
+        void BuildFilter();
+
+
+        /** Filter
+         *
+         *  Get the key filter in front of this keychain.
+         *
+         *  @return The key filter, or nullptr if FILTER mode is disabled.
+         *
+         **/
+        BloomFilter* Filter() const;
+
+
         /** Initialize
          *
          *  Initialize the binary hash map keychain.
@@ -169,6 +240,53 @@ namespace LLD
         bool Put(const SectorKey& cKey);
 
 
+        /** Put
+         *
+         *  Write a batch of keys to the disk hashmaps.
+         *  Keys are written in bucket order so that the hashmap files are updated
+         *  front to back, and later keys in the batch overwrite earlier ones.
+         *  Each file is flushed once and synced to disk before this returns.
+         *
+         *  @param[in] vKeys The key objects to write.
+         *
+         *  @return True if all keys were written, false otherwise.
+         *
+         **/
+        bool Put(const std::vector<SectorKey>& vKeys);
+
+
+        /** Sectors
+         *
+         *  Find every valid key in the hashmap files that points into a given sector file.
+         *
+         *  @param[in] nSectorFile The sector file to search for.
+         *  @param[out] vKeys The hashmap slots found, as the slot position paired with its sector key.
+         *
+         *  @return True if the hashmap files were scanned.
+         *
+         **/
+        bool Sectors(const uint16_t nSectorFile, std::vector< std::pair<uint64_t, SectorKey> >& vKeys);
+
+
+        /** Relocate
+         *
+         *  Repoint the keys found by Sectors to the new locations of their moved sectors.
+         *  Each slot is verified under its bucket lock before it is rewritten, so keys
+         *  updated since they were found are left alone.
+         *
+         *  @param[in] nSectorFile The sector file the sectors were moved out of.
+         *  @param[in] vKeys The slots found by Sectors to repoint.
+         *  @param[in] mapMoved The old sector start mapped to its new sector file and start.
+         *  @param[out] mapRelocated The moved sectors that had a key repointed to them.
+         *
+         *  @return True if the keys were relocated.
+         *
+         **/
+        bool Relocate(const uint16_t nSectorFile, const std::vector< std::pair<uint64_t, SectorKey> >& vKeys,
+                      const std::map<uint32_t, std::pair<uint16_t, uint32_t> >& mapMoved,
+                      std::map<uint32_t, std::pair<uint16_t, uint32_t> >& mapRelocated);
+
+
         /** Flush
          *
          *  Flush all buffers to disk if using ACID transaction.
@@ -200,6 +318,34 @@ namespace LLD
          *
          **/
         bool Erase(const std::vector<uint8_t> &vKey);
+
+
+    private:
+
+        /** put
+         *
+         *  Write a key to the disk hashmaps, leaving the writes in the streams.
+         *
+         *  @param[in] cKey The key object to write.
+         *  @param[out] setFiles The hashmap files that were written to.
+         *
+         *  @return True if the key was written, false otherwise.
+         *
+         **/
+        bool put(const SectorKey& cKey, std::set<uint16_t>& setFiles);
+
+
+        /** flush
+         *
+         *  Flush the streams of the hashmap files and the index.
+         *
+         *  @param[in] setFiles The hashmap files to flush.
+         *  @param[in] fSync Sync the files and the index to disk after flushing.
+         *
+         *  @return True if the files were flushed.
+         *
+         **/
+        bool flush(const std::set<uint16_t>& setFiles, const bool fSync);
     };
 }
 
@@ -26,6 +26,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/types/merkle.h>
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Ledger/types/client.h>
+#include <TAO/Ledger/types/event_queue.h>
 
 #include <tuple>
 
@@ -624,9 +625,17 @@ namespace LLD
 
         /* Check for client mode. */
         if(config::fClient.load())
-            return Client->Index(std::make_pair(hashAddress, nSequence), hashTx);
+        {
+            if(!Client->Index(std::make_pair(hashAddress, nSequence), hashTx))
+                return false;
+        }
+        else if(!Index(std::make_pair(hashAddress, nSequence), hashTx))
+            return false;
+
+        /* Queue the event if its sigchain is tracked. */
+        TAO::Ledger::EventQueue::GetInstance().Push(hashAddress, nSequence);
 
-        return Index(std::make_pair(hashAddress, nSequence), hashTx);
+        return true;
     }
 
 
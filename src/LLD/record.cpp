@@ -0,0 +1,412 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/index/record.h>
+#include <LLD/include/enum.h>
+#include <LLD/include/version.h>
+#include <LLD/hash/xxh3.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+#include <Util/templates/readstream.h>
+
+#include <fstream>
+#include <iterator>
+
+namespace LLD
+{
+
+    /* Marks an index file in the format with interned types. */
+    const std::string RECORD_INDEX_MAGIC = "recordindex.2";
+
+
+    /* Hash a serialized field, keeping clear of zero which marks no field. */
+    static uint64_t FieldHash(const std::vector<uint8_t>& vField)
+    {
+        const uint64_t hashField = XXH64(vField.data(), vField.size(), 0);
+        return hashField == 0 ? 1 : hashField;
+    }
+
+
+    /* Default Constructor. */
+    RecordIndex::RecordIndex()
+    : MUTEX        ( )
+    , vTypes       ( )
+    , mapTypes     ( )
+    , vRecords     ( )
+    , vFields      ( )
+    , mapLocations ( )
+    {
+    }
+
+
+    /* Default Destructor. */
+    RecordIndex::~RecordIndex()
+    {
+    }
+
+
+    /* Get the index location of a sector. */
+    uint64_t RecordIndex::Location(const uint16_t nSectorFile, const uint32_t nSectorStart)
+    {
+        return (uint64_t(nSectorFile) << 32) | nSectorStart;
+    }
+
+
+    /* Add a record type to the index. */
+    void RecordIndex::Register(const std::string& strType, const FieldExtractor& fnField)
+    {
+        LOCK(MUTEX);
+
+        /* Replace the extractor of a type registered again. */
+        auto it = mapTypes.find(strType);
+        if(it != mapTypes.end())
+        {
+            vTypes[it->second].second = fnField;
+            return;
+        }
+
+        mapTypes[strType] = static_cast<uint16_t>(vTypes.size());
+        vTypes.push_back(std::make_pair(strType, fnField));
+
+        vRecords.emplace_back();
+        vFields.emplace_back();
+    }
+
+
+    /* Get the total record types in the index. */
+    uint32_t RecordIndex::Types() const
+    {
+        LOCK(MUTEX);
+
+        return static_cast<uint32_t>(vTypes.size());
+    }
+
+
+    /* Check if a record type is indexed. */
+    bool RecordIndex::Indexed(const std::string& strType) const
+    {
+        LOCK(MUTEX);
+
+        return mapTypes.count(strType);
+    }
+
+
+    /* Get the index entry of a record, without changing the index. */
+    void RecordIndex::Extract(const std::vector<uint8_t>& vData, Entry& entry) const
+    {
+        entry = Entry();
+
+        /* Find the extractor of the type, then parse the record without the lock. */
+        FieldExtractor fnField;
+        try
+        {
+            /* Get the type of the record. */
+            const ReadStream ssType(vData, SER_LLD, DATABASE_VERSION);
+
+            std::string strType;
+            ssType >> strType;
+
+            {
+                LOCK(MUTEX);
+
+                /* Check that the type is indexed. */
+                auto it = mapTypes.find(strType);
+                if(it == mapTypes.end())
+                    return;
+
+                entry.nType = it->second;
+                fnField     = vTypes[it->second].second;
+            }
+
+            /* Extract the field if the type is indexed by one. */
+            if(fnField)
+            {
+                DataStream ssData(vData, SER_LLD, DATABASE_VERSION);
+                ssData.SetPos(ssType.GetPos());
+
+                std::vector<uint8_t> vField;
+                if(fnField(ssData, vField) && !vField.empty())
+                    entry.hashField = FieldHash(vField);
+            }
+        }
+        catch(const std::exception& e)
+        {
+            entry = Entry();
+            debug::error(FUNCTION, "failed to index record: ", e.what());
+        }
+    }
+
+
+    /* Index a record written to a sector, replacing what was indexed at that location. */
+    void RecordIndex::Add(const SectorKey& cKey, const Entry& entry)
+    {
+        const uint64_t nLocation = Location(cKey.nSectorFile, cKey.nSectorStart);
+
+        LOCK(MUTEX);
+
+        /* The record replaces anything that was at the location. */
+        remove(nLocation);
+
+        /* Check that the type is indexed. */
+        if(entry.nType >= vTypes.size())
+            return;
+
+        Entry indexed = entry;
+        indexed.nSize = cKey.nSectorSize;
+
+        insert(nLocation, indexed);
+    }
+
+
+    /* Index a record written to a sector, replacing what was indexed at that location. */
+    void RecordIndex::Add(const SectorKey& cKey, const std::vector<uint8_t>& vData)
+    {
+        Entry entry;
+        Extract(vData, entry);
+
+        Add(cKey, entry);
+    }
+
+
+    /* Remove a sector from the index when its record is no longer live. */
+    void RecordIndex::Remove(const SectorKey& cKey)
+    {
+        LOCK(MUTEX);
+
+        remove(Location(cKey.nSectorFile, cKey.nSectorStart));
+    }
+
+
+    /* Move the records of a compacted sector file to their new locations. */
+    void RecordIndex::Move(const uint16_t nSectorFile, const std::map<uint32_t, std::pair<uint16_t, uint32_t> >& mapMoved)
+    {
+        LOCK(MUTEX);
+
+        for(const auto& moved : mapMoved)
+        {
+            /* Check that the old location was indexed. */
+            auto it = mapLocations.find(Location(nSectorFile, moved.first));
+            if(it == mapLocations.end())
+                continue;
+
+            /* Re-insert the entry at its new location. */
+            Entry entry = it->second;
+            remove(it->first);
+
+            insert(Location(moved.second.first, moved.second.second), entry);
+        }
+    }
+
+
+    /* Get the sectors of the records of a type, in sector order. */
+    void RecordIndex::Get(const std::string& strType, std::vector<SectorKey>& vKeys) const
+    {
+        LOCK(MUTEX);
+
+        auto it = mapTypes.find(strType);
+        if(it == mapTypes.end())
+            return;
+
+        const std::set<uint64_t>& setRecords = vRecords[it->second];
+
+        vKeys.reserve(vKeys.size() + setRecords.size());
+        for(const auto& nLocation : setRecords)
+            vKeys.push_back(SectorKey(STATE::READY, std::vector<uint8_t>(), static_cast<uint16_t>(nLocation >> 32),
+                static_cast<uint32_t>(nLocation), mapLocations.at(nLocation).nSize));
+    }
+
+
+    /* Get the sectors of the records of a type with a given field, in sector order. */
+    void RecordIndex::Get(const std::string& strType, const std::vector<uint8_t>& vField, std::vector<SectorKey>& vKeys) const
+    {
+        const uint64_t hashField = FieldHash(vField);
+
+        LOCK(MUTEX);
+
+        auto it = mapTypes.find(strType);
+        if(it == mapTypes.end())
+            return;
+
+        auto field = vFields[it->second].find(hashField);
+        if(field == vFields[it->second].end())
+            return;
+
+        vKeys.reserve(vKeys.size() + field->second.size());
+        for(const auto& nLocation : field->second)
+            vKeys.push_back(SectorKey(STATE::READY, std::vector<uint8_t>(), static_cast<uint16_t>(nLocation >> 32),
+                static_cast<uint32_t>(nLocation), mapLocations.at(nLocation).nSize));
+    }
+
+
+    /* Remove every record from the index, keeping the registered types. */
+    void RecordIndex::Clear()
+    {
+        LOCK(MUTEX);
+
+        for(auto& records : vRecords)
+            records.clear();
+
+        for(auto& fields : vFields)
+            fields.clear();
+
+        mapLocations.clear();
+    }
+
+
+    /* Load the index from disk, if it was saved with the same registered types. */
+    bool RecordIndex::Load(const std::string& strPath)
+    {
+        std::ifstream stream(strPath, std::ios::in | std::ios::binary);
+        if(!stream.is_open())
+            return false;
+
+        std::vector<uint8_t> vData((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        LOCK(MUTEX);
+        try
+        {
+            DataStream ssIndex(vData, SER_LLD, DATABASE_VERSION);
+
+            /* Check the format, as older files are rebuilt. */
+            std::string strMagic;
+            ssIndex >> strMagic;
+
+            if(strMagic != RECORD_INDEX_MAGIC)
+                return false;
+
+            /* Check that the index was saved with the same types, mapping their saved positions. */
+            std::vector<std::string> vSaved;
+            ssIndex >> vSaved;
+
+            if(vSaved.size() != vTypes.size())
+                return false;
+
+            std::vector<uint16_t> vPositions;
+            for(const auto& strType : vSaved)
+            {
+                auto it = mapTypes.find(strType);
+                if(it == mapTypes.end())
+                    return false;
+
+                vPositions.push_back(it->second);
+            }
+
+            /* Read the entries. */
+            uint64_t nEntries = 0;
+            ssIndex >> nEntries;
+
+            mapLocations.reserve(nEntries);
+            for(uint64_t n = 0; n < nEntries; ++n)
+            {
+                uint64_t nLocation = 0;
+
+                Entry entry;
+                ssIndex >> nLocation >> entry.nType >> entry.hashField >> entry.nSize;
+
+                if(entry.nType >= vPositions.size())
+                    throw std::runtime_error("entry has an unknown type");
+
+                entry.nType = vPositions[entry.nType];
+                insert(nLocation, entry);
+            }
+        }
+        catch(const std::exception& e)
+        {
+            /* Start from an empty index on a bad file. */
+            for(auto& records : vRecords)
+                records.clear();
+
+            for(auto& fields : vFields)
+                fields.clear();
+
+            mapLocations.clear();
+
+            return debug::error(FUNCTION, "failed to load record index: ", e.what());
+        }
+
+        return true;
+    }
+
+
+    /* Save the index to disk. */
+    bool RecordIndex::Save(const std::string& strPath) const
+    {
+        DataStream ssIndex(SER_LLD, DATABASE_VERSION);
+        {
+            LOCK(MUTEX);
+
+            /* Write the types the index was built with, in the order entries refer to them. */
+            std::vector<std::string> vSaved;
+            for(const auto& type : vTypes)
+                vSaved.push_back(type.first);
+
+            ssIndex << RECORD_INDEX_MAGIC << vSaved;
+
+            /* Write the entries. */
+            ssIndex << uint64_t(mapLocations.size());
+            for(const auto& location : mapLocations)
+                ssIndex << location.first << location.second.nType << location.second.hashField << location.second.nSize;
+        }
+
+        std::ofstream stream(strPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!stream.is_open())
+            return debug::error(FUNCTION, "failed to open ", strPath);
+
+        stream.write((char*)ssIndex.data(), ssIndex.size());
+
+        return true;
+    }
+
+
+    /* Remove a location from the index. */
+    void RecordIndex::remove(const uint64_t nLocation)
+    {
+        auto it = mapLocations.find(nLocation);
+        if(it == mapLocations.end())
+            return;
+
+        const Entry& entry = it->second;
+
+        /* Remove from the type's records. */
+        vRecords[entry.nType].erase(nLocation);
+
+        /* Remove from the field's records. */
+        if(entry.hashField != 0)
+        {
+            auto& mapField = vFields[entry.nType];
+
+            auto field = mapField.find(entry.hashField);
+            if(field != mapField.end())
+            {
+                field->second.erase(nLocation);
+                if(field->second.empty())
+                    mapField.erase(field);
+            }
+        }
+
+        mapLocations.erase(it);
+    }
+
+
+    /* Insert a location into the index. */
+    void RecordIndex::insert(const uint64_t nLocation, const Entry& entry)
+    {
+        vRecords[entry.nType].insert(nLocation);
+
+        if(entry.hashField != 0)
+            vFields[entry.nType][entry.hashField].insert(nLocation);
+
+        mapLocations[nLocation] = entry;
+    }
+}
@@ -18,6 +18,9 @@ ________________________________________________________________________________
 #include <LLD/types/register.h>
 
 #include <TAO/Register/include/enum.h>
+#include <TAO/Register/types/object.h>
+
+#include <Util/include/args.h>
 
 namespace LLD
 {
@@ -34,6 +37,36 @@ namespace LLD
     , pMiner(nullptr)
     , pCommit(new RegisterTransaction())
     {
+        /* Index the register types that are listed by the API. */
+        if(config::GetBoolArg("-recordindex", true))
+        {
+            AddIndex("trust");
+            AddIndex("name");
+            AddIndex("namespace");
+            AddIndex("object");
+            AddIndex("crypto");
+            AddIndex("token");
+            AddIndex("append");
+            AddIndex("raw");
+            AddIndex("readonly");
+
+            /* Owned registers are listed by their owner. */
+            AddIndex("owner", std::function<uint256_t(std::pair<uint256_t, uint256_t>&)>([](std::pair<uint256_t, uint256_t>& pair)
+            {
+                return pair.first;
+            }));
+
+            /* Token accounts are also listed by the token they hold. */
+            AddIndex("account", std::function<uint256_t(TAO::Register::Object&)>([](TAO::Register::Object& object)
+            {
+                if(!object.Parse())
+                    throw debug::exception(FUNCTION, "failed to parse object");
+
+                return object.get<uint256_t>("token");
+            }));
+
+            BuildIndex();
+        }
     }
 
 
@@ -402,6 +435,57 @@ namespace LLD
     }
 
 
+    /* Index a register to the genesis that owns it, or has transferred it and not had it claimed yet. */
+    bool RegisterDB::IndexOwner(const uint256_t& hashGenesis, const uint256_t& hashRegister)
+    {
+        return Write(std::make_tuple(std::string("owner"), hashGenesis, hashRegister),
+            std::make_pair(hashGenesis, hashRegister), "owner");
+    }
+
+
+    /* Erase a register from the owner index of a genesis. */
+    bool RegisterDB::EraseOwner(const uint256_t& hashGenesis, const uint256_t& hashRegister)
+    {
+        return Erase(std::make_tuple(std::string("owner"), hashGenesis, hashRegister));
+    }
+
+
+    /* List the registers indexed to a genesis. */
+    bool RegisterDB::ListOwned(const uint256_t& hashGenesis, std::vector<uint256_t>& vRegisters)
+    {
+        /* Don't read every owner record when the record index is disabled. */
+        if(!HasIndex("owner"))
+            return false;
+
+        /* Read the index records of the genesis. */
+        std::vector<std::pair<uint256_t, uint256_t>> vOwned;
+        BatchReadField("owner", hashGenesis, vOwned, -1);
+
+        /* Check the owner of each index record. */
+        for(const auto& owned : vOwned)
+        {
+            if(owned.first == hashGenesis)
+                vRegisters.push_back(owned.second);
+        }
+
+        return !vRegisters.empty();
+    }
+
+
+    /* Mark that the registers of a genesis from before the owner index have been added to it. */
+    bool RegisterDB::WriteOwnerIndexed(const uint256_t& hashGenesis)
+    {
+        return Write(std::make_pair(std::string("owner.indexed"), hashGenesis));
+    }
+
+
+    /* Check if the registers of a genesis from before the owner index have been added to it. */
+    bool RegisterDB::HasOwnerIndexed(const uint256_t& hashGenesis)
+    {
+        return Exists(std::make_pair(std::string("owner.indexed"), hashGenesis));
+    }
+
+
     /* Determines if a state exists in the register database. */
     bool RegisterDB::HasState(const uint256_t& hashRegister, const uint8_t nFlags)
     {
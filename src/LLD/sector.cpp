@@ -13,6 +13,7 @@ ________________________________________________________________________________
 
 #include <LLD/templates/sector.h>
 
+#include <LLD/cache/binary_clock.h>
 #include <LLD/cache/binary_lfu.h>
 #include <LLD/cache/binary_lru.h>
 
@@ -26,6 +27,12 @@ ________________________________________________________________________________
 
 #include <functional>
 
+#ifndef WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace LLD
 {
 
@@ -43,22 +50,40 @@ namespace LLD
     , strName(strNameIn)
     , runtime()
     , pTransaction(nullptr)
+    , pJournal(new SectorJournal(config::GetDataDir() + strName + "/journal.dat",
+        static_cast<uint64_t>(config::GetArg("-journalcheckpoint", 16)) * 1024 * 1024))
+    , nSpillSize(static_cast<uint64_t>(config::GetArg("-journalspill", 64)) * 1024 * 1024)
     , pSectorKeys(new KeychainType((config::GetDataDir() + strName + "/keychain/"), nFlagsIn, nBucketsIn))
     , cachePool(new CacheType(nCacheIn))
     , fileCache(new TemplateLRU<uint32_t, std::fstream*>(8))
+    , pRecordIndex(new RecordIndex())
+    , pCodec(new RecordCodec(strBaseLocation + "_sector.dict", (nFlagsIn & FLAGS::COMPRESS) && config::GetBoolArg("-compressdict", true)))
+    , pReadFiles(new std::atomic<int32_t>[MAX_SECTOR_FILES])
+    , pSectorVersions(new std::atomic<uint32_t>[SECTOR_VERSIONS])
     , nCurrentFile(0)
     , nCurrentFileSize(0)
     , CacheWriterThread()
     , MeterThread()
+    , CompactorThread()
+    , mapDeadBytes()
+    , nCompactFile(COMPACT_NONE)
     , vDiskBuffer()
     , nBufferBytes(0)
     , nBytesRead(0)
     , nBytesWrote(0)
     , nRecordsFlushed(0)
     , fDestruct(false)
+    , fFlushFailed(false)
     , fInitialized(false)
     , nFlags(nFlagsIn)
     {
+        /* No read descriptors are open yet. */
+        for(uint32_t n = 0; n < MAX_SECTOR_FILES; ++n)
+            pReadFiles[n].store(-1);
+
+        for(uint32_t n = 0; n < SECTOR_VERSIONS; ++n)
+            pSectorVersions[n].store(0);
+
         /* Set readonly flag if write or append are not specified. */
         if(!(nFlags & FLAGS::FORCE) && !(nFlags & FLAGS::WRITE) && !(nFlags & FLAGS::APPEND))
             nFlags |= FLAGS::READONLY;
@@ -74,6 +99,7 @@ namespace LLD
 
         CacheWriterThread = std::thread(std::bind(&SectorDatabase::CacheWriter, this));
         MeterThread = std::thread(std::bind(&SectorDatabase::Meter, this));
+        CompactorThread = std::thread(std::bind(&SectorDatabase::Compactor, this));
     }
 
 
@@ -90,15 +116,56 @@ namespace LLD
         if(MeterThread.joinable())
             MeterThread.join();
 
+        if(CompactorThread.joinable())
+            CompactorThread.join();
+
+        /* Persist the dead bytes of each sector file for the compactor. */
+        if(!(nFlags & FLAGS::READONLY))
+        {
+            DataStream ssDead(SER_LLD, DATABASE_VERSION);
+            ssDead << mapDeadBytes;
+
+            std::ofstream stream(strBaseLocation + "_sector.dead", std::ios::out | std::ios::binary | std::ios::trunc);
+            stream.write((char*)ssDead.data(), ssDead.size());
+
+            /* Persist the record index so it doesn't need to be rebuilt. */
+            if(pRecordIndex->Types() > 0)
+                pRecordIndex->Save(strBaseLocation + "_sector.index");
+        }
+
+        if(pRecordIndex)
+            delete pRecordIndex;
+
+        if(pCodec)
+            delete pCodec;
+
         if(pTransaction)
             delete pTransaction;
 
+        if(pJournal)
+            delete pJournal;
+
         if(cachePool)
             delete cachePool;
 
         if(fileCache)
             delete fileCache;
 
+        /* Close the shared read descriptors. */
+        if(pReadFiles)
+        {
+        #ifndef WIN32
+            for(uint32_t n = 0; n < MAX_SECTOR_FILES; ++n)
+                if(pReadFiles[n].load() >= 0)
+                    ::close(pReadFiles[n].load());
+        #endif
+
+            delete[] pReadFiles;
+        }
+
+        if(pSectorVersions)
+            delete[] pSectorVersions;
+
         if(pSectorKeys)
             delete pSectorKeys;
     }
@@ -144,6 +211,23 @@ namespace LLD
             ++nCurrentFile;
         }
 
+        /* Load the dead bytes of each sector file. */
+        std::ifstream stream(strBaseLocation + "_sector.dead", std::ios::in | std::ios::binary);
+        if(stream.is_open())
+        {
+            std::vector<uint8_t> vDead((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            try
+            {
+                DataStream ssDead(vDead, SER_LLD, DATABASE_VERSION);
+                ssDead >> mapDeadBytes;
+            }
+            catch(const std::exception& e)
+            {
+                debug::error(FUNCTION, "failed to load sector dead bytes: ", e.what());
+                mapDeadBytes.clear();
+            }
+        }
+
         pTransaction = nullptr;
         fInitialized = true;
     }
@@ -164,38 +248,17 @@ namespace LLD
         SectorKey cKey;
         if(pSectorKeys->Get(vKey, cKey))
         {
+            /* Read the record from the sector file. */
+            if(!ReadSector(cKey, vData))
             {
-                LOCK(SECTOR_MUTEX);
-
-                /* Find the file stream for LRU cache. */
-                std::fstream* pstream;
-                if(!fileCache->Get(cKey.nSectorFile, pstream))
-                {
-                    /* Set the new stream pointer. */
-                    pstream = new std::fstream(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), cKey.nSectorFile), std::ios::in | std::ios::out | std::ios::binary);
-                    if(!pstream->is_open())
-                    {
-                        delete pstream;
-                        return debug::error(FUNCTION, "couldn't create stream file");
-                    }
-
-                    /* If file not found add to LRU cache. */
-                    fileCache->Put(cKey.nSectorFile, pstream);
-                }
-
-                /* Get compact size from record. */
-                uint64_t nSize = GetSizeOfCompactSize(cKey.nSectorSize);
-
-                /* Seek to the Sector Position on Disk. */
-                pstream->seekg(cKey.nSectorStart + nSize, std::ios::beg);
-
-                /* Resize for proper record length. */
-                vData.resize(cKey.nSectorSize - nSize);
-
-                /* Read the State and Size of Sector Header. */
-                if(!pstream->read((char*) &vData[0], vData.size()))
-                    return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vData.size(), " bytes read");
+                /* Retry once if the compactor moved the record while it was read. */
+                SectorKey cMoved;
+                if(!pSectorKeys->Get(vKey, cMoved) || (cMoved.nSectorFile == cKey.nSectorFile && cMoved.nSectorStart == cKey.nSectorStart))
+                    return false;
 
+                cKey = cMoved;
+                if(!ReadSector(cKey, vData))
+                    return false;
             }
 
             /* Add to cache */
@@ -218,17 +281,99 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Get(const SectorKey& cKey, std::vector<uint8_t>& vData)
     {
+        nBytesRead += static_cast<uint32_t>(cKey.vKey.size() + vData.size());
+
+        /* Check the cache pool for key first. */
+        if(cachePool->Get(cKey.vKey, vData))
+            return true;
+
+        /* Read the record from the sector file. */
+        if(!ReadSector(cKey, vData))
+            return false;
+
+        /* Verboe output. */
+        if(config::nVerbose >= 5)
+            debug::log(5, FUNCTION, "Current File: ", cKey.nSectorFile,
+                " | Current File Size: ", cKey.nSectorStart, "\n", HexStr(vData.begin(), vData.end(), true));
+
+        return true;
+    }
+
+
+    /*  Read a record's data from its sector file. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::ReadSector(const SectorKey& cKey, std::vector<uint8_t>& vData, const bool fDecode)
+    {
+        /* Get compact size from record. */
+        uint64_t nSize = GetSizeOfCompactSize(cKey.nSectorSize);
+
+        /* Resize for proper record length. */
+        vData.resize(cKey.nSectorSize - nSize);
+
+    #ifndef WIN32
+        /* Get the shared read descriptor, opening it on first use. */
+        int32_t nFile = pReadFiles[cKey.nSectorFile].load(std::memory_order_acquire);
+        if(nFile < 0)
         {
-            LOCK(SECTOR_MUTEX);
+            std::string strFile = debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), cKey.nSectorFile);
 
-            nBytesRead += static_cast<uint32_t>(cKey.vKey.size() + vData.size());
+            int32_t nOpen = ::open(strFile.c_str(), O_RDONLY);
+            if(nOpen < 0)
+                return debug::error(FUNCTION, "couldn't open sector file ", strFile);
 
-            /* Check the cache pool for key first. */
-            if(cachePool->Get(cKey.vKey, vData))
-                return true;
+            /* Another reader may have won the race to open it. */
+            nFile = -1;
+            if(pReadFiles[cKey.nSectorFile].compare_exchange_strong(nFile, nOpen, std::memory_order_acq_rel))
+                nFile = nOpen;
+            else
+                ::close(nOpen);
+        }
+
+        /* Read the record with positional reads, leaving no shared seek state. */
+        std::atomic<uint32_t>& nVersion = pSectorVersions[(cKey.nSectorFile ^ cKey.nSectorStart) % SECTOR_VERSIONS];
+        uint32_t nBegin = 0;
+        do
+        {
+            /* Wait for a rewrite in place to finish. */
+            nBegin = nVersion.load(std::memory_order_acquire);
+            if(nBegin & 1)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint64_t nRead = 0;
+            while(nRead < vData.size())
+            {
+                ssize_t nBytes = ::pread(nFile, (char*)&vData[nRead], vData.size() - nRead,
+                    static_cast<off_t>(cKey.nSectorStart + nSize + nRead));
+
+                /* Retry if interrupted by a signal. */
+                if(nBytes < 0 && errno == EINTR)
+                    continue;
+
+                /* A read past the end is a record of a file that was compacted since its key was read. */
+                if(nBytes == 0)
+                {
+                    debug::log(3, FUNCTION, "sector file ", cKey.nSectorFile, " has no record at ", cKey.nSectorStart);
+                    return false;
+                }
+
+                if(nBytes < 0)
+                    return debug::error(FUNCTION, "only ", nRead, "/", vData.size(), " bytes read");
+
+                nRead += nBytes;
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        while((nBegin & 1) || nVersion.load(std::memory_order_relaxed) != nBegin); //read again if the record was rewritten
+    #else
+        {
+            LOCK(SECTOR_MUTEX);
 
             /* Find the file stream for LRU cache. */
-            std::fstream *pstream;
+            std::fstream* pstream;
             if(!fileCache->Get(cKey.nSectorFile, pstream))
             {
                 /* Set the new stream pointer. */
@@ -236,58 +381,97 @@ namespace LLD
                 if(!pstream->is_open())
                 {
                     delete pstream;
-                    return false;
+                    return debug::error(FUNCTION, "couldn't create stream file");
                 }
 
                 /* If file not found add to LRU cache. */
                 fileCache->Put(cKey.nSectorFile, pstream);
             }
 
-            /* Get compact size from record. */
-            uint64_t nSize = GetSizeOfCompactSize(cKey.nSectorSize);
-
             /* Seek to the Sector Position on Disk. */
             pstream->seekg(cKey.nSectorStart + nSize, std::ios::beg);
 
-            /* Resize for proper record length. */
-            vData.resize(cKey.nSectorSize - nSize);
-
             /* Read the State and Size of Sector Header. */
             if(!pstream->read((char*) &vData[0], vData.size()))
                 return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vData.size(), " bytes read");
-
-            /* Verboe output. */
-            if(config::nVerbose >= 5)
-                debug::log(5, FUNCTION, "Current File: ", cKey.nSectorFile,
-                    " | Current File Size: ", cKey.nSectorStart, "\n", HexStr(vData.begin(), vData.end(), true));
         }
+    #endif
+
+        /* Decompress the record if it was written compressed. */
+        if(fDecode && !pCodec->Decode(vData))
+            return debug::error(FUNCTION, "failed to decompress record at ", cKey.nSectorFile, ":", cKey.nSectorStart);
+
+        return true;
+    }
+
 
+    /*  Flush a sector file's written data through to stable storage. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::Sync(const std::string& strFile)
+    {
+    #ifndef WIN32
+        int32_t nFile = ::open(strFile.c_str(), O_WRONLY);
+        if(nFile < 0)
+            return false;
+
+        /* fdatasync is not available on OSX. */
+    #ifdef MAC_OSX
+        bool fSynced = (::fsync(nFile) == 0);
+    #else
+        bool fSynced = (::fdatasync(nFile) == 0);
+    #endif
+
+        ::close(nFile);
+        return fSynced;
+    #else
         return true;
+    #endif
+    }
+
+
+    /*  Get the form of a record to store on disk. */
+    template<class KeychainType, class CacheType>
+    const std::vector<uint8_t>& SectorDatabase<KeychainType, CacheType>::Encode(const std::vector<uint8_t>& vData, std::vector<uint8_t>& vRecord)
+    {
+        /* Compress the record if the database is compressed and it gets smaller. */
+        if(nFlags & FLAGS::COMPRESS && pCodec->Encode(vData, vRecord))
+            return vRecord;
+
+        return vData;
     }
 
 
     /*  Update a record on disk. */
     template<class KeychainType, class CacheType>
-    bool SectorDatabase<KeychainType, CacheType>::Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
+    bool SectorDatabase<KeychainType, CacheType>::Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData, const std::vector<uint8_t>& vStored,
+                                                         const RecordIndex::Entry& entry, uint32_t &nFile)
     {
+        /* Lock sectors so the compactor can't move the record before it is written. */
+        LOCK(SECTOR_MUTEX);
+
         /* Check the keychain for key. */
         SectorKey key;
         if(!pSectorKeys->Get(vKey, key))
             return false;
 
         /* Get current size */
-        uint64_t nSize = vData.size() + GetSizeOfCompactSize(vData.size());
+        uint64_t nSize = vStored.size() + GetSizeOfCompactSize(vStored.size());
 
         /* Check data size constraints. */
         if(nSize != key.nSectorSize)
             return false;
 
+        /* Append records in a file that is being compacted, so the new record is repointed past the copy. */
+        if(key.nSectorFile == nCompactFile)
+            return false;
+
         /* Write the data into the memory cache. */
         cachePool->Put(key, vKey, vData, false);
 
-        {
-            LOCK(SECTOR_MUTEX);
+        /* Re-index the record, as its field may have changed. */
+        pRecordIndex->Add(key, entry);
 
+        {
             /* Find the file stream for LRU cache. */
             std::fstream* pstream;
             if(!fileCache->Get(key.nSectorFile, pstream))
@@ -304,21 +488,27 @@ namespace LLD
                 fileCache->Put(key.nSectorFile, pstream);
             }
 
+            /* Mark the record as being rewritten, for reads without the sector lock. */
+            std::atomic<uint32_t>& nVersion = pSectorVersions[(key.nSectorFile ^ key.nSectorStart) % SECTOR_VERSIONS];
+            nVersion.fetch_add(1, std::memory_order_acq_rel);
+
             /* If it is a New Sector, Assign a Binary Position. */
             pstream->seekp(key.nSectorStart, std::ios::beg);
 
             /* Write the size of record. */
-            WriteCompactSize(*pstream, vData.size());
+            WriteCompactSize(*pstream, vStored.size());
 
             /* Write the data record. */
-            if(!pstream->write((char*) &vData[0], vData.size()))
-                return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vData.size(), " bytes written");
-
+            bool fWritten = static_cast<bool>(pstream->write((char*) &vStored[0], vStored.size()));
             pstream->flush();
 
+            nVersion.fetch_add(1, std::memory_order_release);
+            if(!fWritten)
+                return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vStored.size(), " bytes written");
+
             /* Records flushed indicator. */
             ++nRecordsFlushed;
-            nBytesWrote += static_cast<uint32_t>(vData.size());
+            nBytesWrote += static_cast<uint32_t>(vStored.size());
 
             /* Verbose output. */
             if(config::nVerbose >= 5)
@@ -326,6 +516,8 @@ namespace LLD
                     " | Current File Size: ", key.nSectorStart, "\n", HexStr(vData.begin(), vData.end(), true));
         }
 
+        nFile = key.nSectorFile;
+
         return true;
     }
 
@@ -334,12 +526,25 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Force(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
     {
-        if(nFlags & FLAGS::APPEND || !Update(vKey, vData))
+        /* Compress and index the record before taking any locks. */
+        std::vector<uint8_t> vRecord;
+        const std::vector<uint8_t>& vStored = Encode(vData, vRecord);
+
+        RecordIndex::Entry entry;
+        pRecordIndex->Extract(vData, entry);
+
+        uint32_t nFile = 0;
+        if(nFlags & FLAGS::APPEND || !Update(vKey, vData, vStored, entry, nFile))
         {
+            /* The new sector key. */
+            SectorKey key;
 
             {
                 LOCK(SECTOR_MUTEX);
 
+                /* The key's previous record becomes dead space. */
+                MarkDead(vKey);
+
                 /* Create new file if above current file size. */
                 if(nCurrentFileSize > MAX_SECTOR_FILE_SIZE)
                 {
@@ -376,32 +581,35 @@ namespace LLD
                 pstream->seekp(nCurrentFileSize, std::ios::beg);
 
                 /* Write the size of record. */
-                WriteCompactSize(*pstream, vData.size());
+                WriteCompactSize(*pstream, vStored.size());
 
                 /* Write the data record. */
-                if(!pstream->write((char*) &vData[0], vData.size()))
-                    return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vData.size(), " bytes written");
+                if(!pstream->write((char*) &vStored[0], vStored.size()))
+                    return debug::error(FUNCTION, "only ", pstream->gcount(), "/", vStored.size(), " bytes written");
 
                 pstream->flush();
-            }
 
-            /* Get current size */
-            uint64_t nSize = vData.size() + GetSizeOfCompactSize(vData.size());
+                /* Get current size */
+                uint64_t nSize = vStored.size() + GetSizeOfCompactSize(vStored.size());
 
-            /* Create a new Sector Key. */
-            SectorKey key(STATE::READY, vKey, static_cast<uint16_t>(nCurrentFile),
-                            nCurrentFileSize, static_cast<uint32_t>(nSize));
+                /* Create a new Sector Key. */
+                key = SectorKey(STATE::READY, vKey, static_cast<uint16_t>(nCurrentFile),
+                                nCurrentFileSize, static_cast<uint32_t>(nSize));
 
-            /* Increment the current filesize */
-            nCurrentFileSize += static_cast<uint32_t>(nSize);
+                /* Increment the current filesize */
+                nCurrentFileSize += static_cast<uint32_t>(nSize);
 
-            /* Records flushed indicator. */
-            ++nRecordsFlushed;
-            nBytesWrote += static_cast<uint32_t>(nSize);
+                /* Records flushed indicator. */
+                ++nRecordsFlushed;
+                nBytesWrote += static_cast<uint32_t>(nSize);
+
+                /* Assign the Key to Keychain before the file can be compacted. */
+                if(!pSectorKeys->Put(key))
+                    return debug::error(FUNCTION, "failed to write key to keychain");
 
-            /* Assign the Key to Keychain. */
-            if(!pSectorKeys->Put(key))
-                return debug::error(FUNCTION, "failed to write key to keychain");
+                /* Index the new record. */
+                pRecordIndex->Add(key, entry);
+            }
 
             /* Write the data into the memory cache. */
             cachePool->Put(key, vKey, vData, false);
@@ -416,6 +624,195 @@ namespace LLD
     }
 
 
+    /*  Write a batch of records to disk as a group commit. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::Append(const std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> >& vRecords)
+    {
+        /* Update records in place where possible, collecting the rest for the append. */
+        std::vector<uint32_t> vAppend;
+        vAppend.reserve(vRecords.size());
+
+        /* The files of the records updated in place. */
+        std::set<uint32_t> setUpdated;
+
+        /* Compress and index the records before taking any locks. */
+        std::vector< std::vector<uint8_t> > vEncoded(vRecords.size());
+        std::vector< const std::vector<uint8_t>* > vStored(vRecords.size());
+        std::vector<RecordIndex::Entry> vEntries(vRecords.size());
+        for(uint32_t n = 0; n < vRecords.size(); ++n)
+        {
+            vStored[n] = &Encode(vRecords[n].second, vEncoded[n]);
+            pRecordIndex->Extract(vRecords[n].second, vEntries[n]);
+
+            uint32_t nFile = 0;
+            if(nFlags & FLAGS::APPEND || !Update(vRecords[n].first, vRecords[n].second, *vStored[n], vEntries[n], nFile))
+                vAppend.push_back(n);
+            else
+                setUpdated.insert(nFile);
+        }
+
+        /* Sync the records updated in place, which are only flushed, so the whole batch is durable on return. */
+        if(!setUpdated.empty())
+        {
+            LOCK(SECTOR_MUTEX);
+
+            for(const auto& nFile : setUpdated)
+            {
+                const std::string strFile = debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nFile);
+                if(!Sync(strFile))
+                    return debug::error(FUNCTION, "failed to sync ", strFile);
+            }
+        }
+
+        /* Check for records to append. */
+        if(vAppend.empty())
+            return true;
+
+        /* The keys for the appended records. */
+        std::vector<SectorKey> vKeys;
+        vKeys.reserve(vAppend.size());
+
+        /* Build the batch into one contiguous buffer. */
+        DataStream ssBatch(SER_LLD, DATABASE_VERSION);
+        for(const auto& n : vAppend)
+        {
+            const std::vector<uint8_t>& vData = *vStored[n];
+
+            /* Get current size */
+            uint64_t nSize = vData.size() + GetSizeOfCompactSize(vData.size());
+
+            /* Create a new Sector Key at this offset of the batch. */
+            vKeys.push_back(SectorKey(STATE::READY, vRecords[n].first, 0,
+                static_cast<uint32_t>(ssBatch.size()), static_cast<uint32_t>(nSize)));
+
+            /* Write the record with its size. */
+            WriteCompactSize(ssBatch, vData.size());
+            ssBatch.write((char*)&vData[0], vData.size());
+        }
+
+        {
+            LOCK(SECTOR_MUTEX);
+
+            /* Write and sync the whole batch before keys reference it. */
+            uint32_t nFile = 0, nStart = 0;
+            if(!WriteSectors(ssBatch, nFile, nStart))
+                return debug::error(FUNCTION, "failed to write ", vAppend.size(), " records");
+
+            /* The keys' previous records become dead space. */
+            for(const auto& n : vAppend)
+                MarkDead(vRecords[n].first);
+
+            /* Set the keys to where the batch was written. */
+            for(auto& key : vKeys)
+            {
+                key.nSectorFile   = static_cast<uint16_t>(nFile);
+                key.nSectorStart += nStart;
+            }
+
+            /* Records flushed indicator. */
+            nRecordsFlushed += static_cast<uint32_t>(vAppend.size());
+
+            /* Assign the Keys to Keychain before the file can be compacted. */
+            if(!pSectorKeys->Put(vKeys))
+                return debug::error(FUNCTION, "failed to write keys to keychain");
+
+            /* Index the new records. */
+            for(uint32_t n = 0; n < vAppend.size(); ++n)
+                pRecordIndex->Add(vKeys[n], vEntries[vAppend[n]]);
+        }
+
+        /* Write the data into the memory cache. */
+        for(uint32_t n = 0; n < vAppend.size(); ++n)
+            cachePool->Put(vKeys[n], vRecords[vAppend[n]].first, vRecords[vAppend[n]].second, false);
+
+        /* Verbose output. */
+        debug::log(5, FUNCTION, "Appended ", vAppend.size(), " Records to File ", nCurrentFile,
+            " | Current File Size: ", nCurrentFileSize);
+
+        return true;
+    }
+
+
+    /*  Write a buffer of serialized records to the end of the current sector file and sync it to disk. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::WriteSectors(const DataStream& ssBatch, uint32_t& nFile, uint32_t& nStart)
+    {
+        /* Create new file if above current file size. */
+        if(nCurrentFileSize > MAX_SECTOR_FILE_SIZE)
+        {
+            debug::log(4, FUNCTION, "allocating new sector file ", nCurrentFile + 1);
+
+            ++nCurrentFile;
+            nCurrentFileSize = 0;
+
+            std::ofstream stream
+            (
+                debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile),
+                std::ios::out | std::ios::binary | std::ios::trunc
+            );
+            stream.close();
+        }
+
+        /* Find the file stream for LRU cache. */
+        std::string strFile = debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile);
+        std::fstream* pstream;
+        if(!fileCache->Get(nCurrentFile, pstream))
+        {
+            /* Set the new stream pointer. */
+            pstream = new std::fstream(strFile, std::ios::in | std::ios::out | std::ios::binary);
+            if(!pstream->is_open())
+            {
+                delete pstream;
+                return false;
+            }
+
+            /* If file not found add to LRU cache. */
+            fileCache->Put(nCurrentFile, pstream);
+        }
+
+        /* Write the whole batch at the end of the current file. */
+        pstream->seekp(nCurrentFileSize, std::ios::beg);
+        if(!pstream->write((char*)&ssBatch.Bytes()[0], ssBatch.size()))
+            return debug::error(FUNCTION, "only ", pstream->gcount(), "/", ssBatch.size(), " bytes written");
+
+        pstream->flush();
+
+        /* Durability barrier for the batch. */
+        if(!Sync(strFile))
+            return debug::error(FUNCTION, "failed to sync ", strFile);
+
+        /* Return where the batch was written. */
+        nFile  = nCurrentFile;
+        nStart = nCurrentFileSize;
+
+        /* Increment the current filesize */
+        nCurrentFileSize += static_cast<uint32_t>(ssBatch.size());
+        nBytesWrote      += static_cast<uint32_t>(ssBatch.size());
+
+        return true;
+    }
+
+
+    /*  Account the current record of a key as dead space in its sector file. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::MarkDead(const std::vector<uint8_t>& vKey)
+    {
+        /* Check the keychain for the key's current record. */
+        SectorKey key;
+        if(!pSectorKeys->Get(vKey, key))
+            return;
+
+        /* Check that this key isn't a keychain only entry. */
+        if(key.nSectorSize == 0)
+            return;
+
+        mapDeadBytes[key.nSectorFile] += key.nSectorSize;
+
+        /* The record is no longer listed by type. */
+        pRecordIndex->Remove(key);
+    }
+
+
     /*  Write a record into the cache and disk buffer for flushing to disk. */
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Put(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
@@ -424,6 +821,10 @@ namespace LLD
         if(nFlags & FLAGS::FORCE)
             return Force(vKey, vData);
 
+        /* Don't acknowledge more writes while buffered writes are failing to reach disk. */
+        if(fFlushFailed.load())
+            return debug::error(FUNCTION, "buffered records are failing to flush to disk");
+
         /* Wait if the buffer is full. */
         if(nBufferBytes.load() >= MAX_SECTOR_BUFFER_SIZE)
         {
@@ -450,6 +851,9 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::Delete(const std::vector<uint8_t>& vKey)
     {
+        /* Lock sectors so the compactor can't move the record while it is deleted. */
+        LOCK(SECTOR_MUTEX);
+
         /* Check the keychain for key. */
         SectorKey key;
         if(!pSectorKeys->Get(vKey, key))
@@ -463,9 +867,11 @@ namespace LLD
         if(key.nSectorFile ==0 && key.nSectorSize == 0 && key.nSectorStart == 0)
             return true;
 
-        {
-            LOCK(SECTOR_MUTEX);
+        /* The deleted record becomes dead space. */
+        mapDeadBytes[key.nSectorFile] += key.nSectorSize;
+        pRecordIndex->Remove(key);
 
+        {
             /* Find the file stream for LRU cache. */
             std::fstream* pstream;
             if(!fileCache->Get(key.nSectorFile, pstream))
@@ -496,12 +902,19 @@ namespace LLD
             ssData << std::string("NONE");
             ssData.resize(nSize);
 
+            /* Mark the record as being rewritten, for reads without the sector lock. */
+            std::atomic<uint32_t>& nVersion = pSectorVersions[(key.nSectorFile ^ key.nSectorStart) % SECTOR_VERSIONS];
+            nVersion.fetch_add(1, std::memory_order_acq_rel);
+
             /* Write the data record. */
-            if(!pstream->write((char*)ssData.data(), ssData.size()))
-                return debug::error(FUNCTION, "only ", pstream->gcount(), " bytes written");
+            bool fWritten = static_cast<bool>(pstream->write((char*)ssData.data(), ssData.size()));
 
             /* Flush the rest of the write buffer in stream. */
             pstream->flush();
+
+            nVersion.fetch_add(1, std::memory_order_release);
+            if(!fWritten)
+                return debug::error(FUNCTION, "only ", pstream->gcount(), " bytes written");
         }
 
         return true;
@@ -528,6 +941,9 @@ namespace LLD
         }
 
 
+        /* Failed flushes in a row. */
+        uint32_t nFailures = 0;
+
         while(true)
         {
             /* Wait for buffer to empty before shutting down. */
@@ -547,29 +963,46 @@ namespace LLD
                 nBufferBytes = 0;
             }
 
-            /* Create a new file if the sector file size is over file size limits. */
-            if(nCurrentFileSize > MAX_SECTOR_FILE_SIZE)
+            /* Write the buffer to disk as one group commit. */
+            if(!Append(vIndexes))
             {
-                debug::log(0, FUNCTION, "allocating new sector file ", nCurrentFile + 1);
+                fFlushFailed.store(true);
 
-                /* Iterate the current file and reset current file sie. */
-                ++nCurrentFile;
-                nCurrentFileSize = 0;
+                /* Give up on shutdown once the writes have kept failing, as nothing else can flush them. */
+                if(fDestruct.load() && ++nFailures >= 3)
+                {
+                    debug::error(FUNCTION, "lost ", vIndexes.size(), " records that failed to flush");
+                    return;
+                }
 
-                /* Create a new file for next writes. */
-                std::fstream stream(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nCurrentFile), std::ios::out | std::ios::binary | std::ios::trunc);
-                stream.close();
+                debug::error(FUNCTION, "failed to flush ", vIndexes.size(), " records, trying again");
+
+                /* Put the records back ahead of any written since, so newer writes to the same keys still win. */
+                {
+                    LOCK(BUFFER_MUTEX);
+
+                    uint64_t nBytes = 0;
+                    for(const auto& vObj : vIndexes)
+                        nBytes += vObj.first.size() + vObj.second.size();
+
+                    vIndexes.insert(vIndexes.end(), vDiskBuffer.begin(), vDiskBuffer.end());
+                    vDiskBuffer.swap(vIndexes);
+
+                    nBufferBytes += static_cast<uint32_t>(nBytes);
+                }
+
+                CONDITION_LOCK.unlock();
+                runtime::sleep(1000);
+
+                continue;
             }
 
-            /* Iterate through buffer to queue disk writes. */
-            for(const auto& vObj : vIndexes)
-            {
-                /* Force write data. */
-                Force(vObj.first, vObj.second);
+            nFailures = 0;
+            fFlushFailed.store(false);
 
-                /* Set no longer reserved in cache pool. */
+            /* Set no longer reserved in cache pool. */
+            for(const auto& vObj : vIndexes)
                 cachePool->Reserve(vObj.first, false);
-            }
 
             /* Notify the condition. */
             CONDITION.notify_all();
@@ -619,6 +1052,19 @@ namespace LLD
                 "Reading ", RPS, " Kb/s | ",
                 "Records ", nRecordsFlushed.load());
 
+            /* Filter output to help with sizing. */
+            BloomFilter* pFilter = pSectorKeys->Filter();
+            if(pFilter)
+            {
+                debug::log(0,
+                    ANSI_COLOR_FUNCTION, strName, " LLD : ", ANSI_COLOR_RESET,
+                    "Filter ", pFilter->Elements(), " Keys | ",
+                    pFilter->Bytes() / 1024, " Kb | ",
+                    "False Positives ", pFilter->FalsePositiveRate() * 100.0, " %");
+
+                pFilter->ResetStats();
+            }
+
             TIMER.Reset();
             nBytesWrote.store(0);
             nBytesRead.store(0);
@@ -627,6 +1073,265 @@ namespace LLD
     }
 
 
+    /*  Compact the live records of a sector file into the current sector file. */
+    template<class KeychainType, class CacheType>
+    bool SectorDatabase<KeychainType, CacheType>::Compact(const uint32_t nFile)
+    {
+        /* Only compact full files, one at a time. */
+        {
+            LOCK(SECTOR_MUTEX);
+            if(nFile >= nCurrentFile || nCompactFile != COMPACT_NONE)
+                return false;
+
+            nCompactFile = nFile;
+        }
+
+        /* Get the size of the file, which is empty if already compacted. */
+        std::string strFile = debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), nFile);
+        std::ifstream stream(strFile, std::ios::in | std::ios::binary | std::ios::ate);
+        uint64_t nFileSize = stream.is_open() ? static_cast<uint64_t>(stream.tellg()) : 0;
+        stream.close();
+
+        if(nFileSize == 0)
+        {
+            LOCK(SECTOR_MUTEX);
+            nCompactFile = COMPACT_NONE;
+            mapDeadBytes.erase(nFile);
+
+            return true;
+        }
+
+        /* Find the live records in the file from the keys that point into it. */
+        std::vector< std::pair<uint64_t, SectorKey> > vKeys;
+        if(!pSectorKeys->Sectors(static_cast<uint16_t>(nFile), vKeys))
+        {
+            LOCK(SECTOR_MUTEX);
+            nCompactFile = COMPACT_NONE;
+
+            return debug::error(FUNCTION, "failed to scan keychain for sector file ", nFile);
+        }
+
+        std::map<uint32_t, uint32_t> mapLive;
+        for(const auto& slot : vKeys)
+            mapLive[slot.second.nSectorStart] = slot.second.nSectorSize;
+
+        /* Copy the live records forward in batches, holding the sector lock only for the writes. */
+        std::map<uint32_t, std::pair<uint16_t, uint32_t> > mapMoved;
+        uint64_t nLiveBytes = 0;
+
+        auto it = mapLive.begin();
+        while(it != mapLive.end() && !fDestruct.load())
+        {
+            /* Read a batch of records without locking. */
+            DataStream ssBatch(SER_LLD, DATABASE_VERSION);
+            std::vector< std::pair<uint32_t, uint32_t> > vOffsets;
+            for( ; it != mapLive.end() && ssBatch.size() < MAX_SECTOR_BUFFER_SIZE; ++it)
+            {
+                std::vector<uint8_t> vData;
+                if(!ReadSector(SectorKey(STATE::READY, std::vector<uint8_t>(), static_cast<uint16_t>(nFile), it->first, it->second), vData, false))
+                    break;
+
+                vOffsets.push_back(std::make_pair(it->first, static_cast<uint32_t>(ssBatch.size())));
+
+                WriteCompactSize(ssBatch, vData.size());
+                ssBatch.write((char*)&vData[0], vData.size());
+            }
+
+            /* Stop if a record couldn't be read. */
+            if(it != mapLive.end() && ssBatch.size() < MAX_SECTOR_BUFFER_SIZE)
+                break;
+
+            if(vOffsets.empty())
+                continue;
+
+            /* Write the batch to the current file. */
+            LOCK(SECTOR_MUTEX);
+
+            uint32_t nNewFile = 0, nNewStart = 0;
+            if(!WriteSectors(ssBatch, nNewFile, nNewStart))
+                break;
+
+            for(const auto& offset : vOffsets)
+                mapMoved[offset.first] = std::make_pair(static_cast<uint16_t>(nNewFile), nNewStart + offset.second);
+
+            nLiveBytes += ssBatch.size();
+        }
+
+        /* Copies that no key was repointed to are orphaned in the new files, so count them as dead space. */
+        std::map<uint32_t, std::pair<uint16_t, uint32_t> > mapRelocated;
+        auto fnRelease = [&]()
+        {
+            for(const auto& moved : mapMoved)
+            {
+                if(mapRelocated.count(moved.first))
+                    mapDeadBytes[nFile] += mapLive[moved.first];
+                else
+                    mapDeadBytes[moved.second.first] += mapLive[moved.first];
+            }
+
+            nCompactFile = COMPACT_NONE;
+        };
+
+        /* Check that every live record was copied. */
+        if(mapMoved.size() != mapLive.size())
+        {
+            LOCK(SECTOR_MUTEX);
+            fnRelease();
+
+            return debug::error(FUNCTION, "aborted compacting sector file ", nFile);
+        }
+
+        /* Repoint the keys from the scan in batches, so a key and its indexed record move together without
+         * locking out writers for the whole keychain. Records updated in the meantime were appended elsewhere. */
+        const uint32_t nBatch = 1024;
+        for(uint32_t nSlot = 0; nSlot < vKeys.size(); nSlot += nBatch)
+        {
+            const std::vector< std::pair<uint64_t, SectorKey> > vBatch(vKeys.begin() + nSlot,
+                vKeys.begin() + std::min(nSlot + nBatch, static_cast<uint32_t>(vKeys.size())));
+
+            LOCK(SECTOR_MUTEX);
+
+            std::map<uint32_t, std::pair<uint16_t, uint32_t> > mapBatch;
+            bool fRelocated = pSectorKeys->Relocate(static_cast<uint16_t>(nFile), vBatch, mapMoved, mapBatch);
+
+            /* Move the indexed records with their keys. */
+            pRecordIndex->Move(static_cast<uint16_t>(nFile), mapBatch);
+            mapRelocated.insert(mapBatch.begin(), mapBatch.end());
+
+            /* Keep the file, as keys may still point into it. */
+            if(!fRelocated)
+            {
+                fnRelease();
+
+                return debug::error(FUNCTION, "failed to relocate keys for sector file ", nFile);
+            }
+        }
+
+        /* Truncate the old file, keeping it so the sector file numbers stay contiguous. */
+        LOCK(SECTOR_MUTEX);
+
+        std::ofstream truncate(strFile, std::ios::out | std::ios::binary | std::ios::trunc);
+        truncate.close();
+
+        fnRelease();
+        mapDeadBytes.erase(nFile);
+
+        debug::log(0, FUNCTION, "Compacted sector file ", nFile, " moving ", mapMoved.size(), " records of ",
+            nLiveBytes, " bytes and reclaiming ", nFileSize - std::min(nFileSize, nLiveBytes), " bytes");
+
+        return true;
+    }
+
+
+    /*  Load the persisted record index, or rebuild it from the live records. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::BuildIndex()
+    {
+        /* Load the index persisted from a clean shutdown. */
+        std::string strIndex = strBaseLocation + "_sector.index";
+        bool fLoaded = pRecordIndex->Load(strIndex);
+
+        /* Remove the file, so a crash before the next shutdown forces a rebuild. */
+        filesystem::remove(strIndex);
+        if(fLoaded)
+        {
+            debug::log(0, FUNCTION, "Loaded Record Index of ", pRecordIndex->Types(), " types");
+            return;
+        }
+
+        /* Rebuild the index from the live records of each sector file. */
+        pRecordIndex->Clear();
+
+        uint32_t nRecords = 0;
+        for(uint32_t nFile = 0; nFile <= nCurrentFile; ++nFile)
+        {
+            /* Find the live records from the keys that point into the file. */
+            std::vector< std::pair<uint64_t, SectorKey> > vKeys;
+            if(!pSectorKeys->Sectors(static_cast<uint16_t>(nFile), vKeys))
+                continue;
+
+            std::map<uint32_t, uint32_t> mapLive;
+            for(const auto& slot : vKeys)
+                mapLive[slot.second.nSectorStart] = slot.second.nSectorSize;
+
+            /* Index each live record. */
+            for(const auto& live : mapLive)
+            {
+                SectorKey cKey(STATE::READY, std::vector<uint8_t>(), static_cast<uint16_t>(nFile), live.first, live.second);
+
+                std::vector<uint8_t> vData;
+                if(!ReadSector(cKey, vData))
+                    continue;
+
+                pRecordIndex->Add(cKey, vData);
+                ++nRecords;
+            }
+        }
+
+        debug::log(0, FUNCTION, "Rebuilt Record Index of ", pRecordIndex->Types(), " types from ", nRecords, " records");
+    }
+
+
+    /*  Compacts sector files with a high ratio of dead bytes in the background. */
+    template<class KeychainType, class CacheType>
+    void SectorDatabase<KeychainType, CacheType>::Compactor()
+    {
+        /* Wait for initialization. */
+        while(!fInitialized)
+            runtime::sleep(100);
+
+        /* Check if writing is enabled. */
+        if(nFlags & FLAGS::READONLY || !config::GetBoolArg("-compact", true))
+            return;
+
+        /* Compacting needs lock free sector reads. */
+    #ifdef WIN32
+        return;
+    #endif
+
+        /* The percentage of dead bytes that triggers compacting a file, and the seconds between checks. */
+        const uint64_t nRatio    = config::GetArg("-compactratio", 50);
+        const uint64_t nInterval = config::GetArg("-compactinterval", 60);
+
+        while(!fDestruct.load())
+        {
+            /* Sleep between checks, waking for shutdown. */
+            for(uint64_t n = 0; n < nInterval * 10 && !fDestruct.load(); ++n)
+                runtime::sleep(100);
+
+            /* Get the files with dead bytes. */
+            std::map<uint32_t, uint64_t> mapDead;
+            {
+                LOCK(SECTOR_MUTEX);
+                mapDead = mapDeadBytes;
+            }
+
+            /* Compact the files that are over the dead byte ratio. */
+            for(const auto& dead : mapDead)
+            {
+                if(fDestruct.load())
+                    break;
+
+                /* Get the file size. */
+                std::ifstream stream(debug::safe_printstr(strBaseLocation, "_block.", std::setfill('0'), std::setw(5), dead.first),
+                    std::ios::in | std::ios::binary | std::ios::ate);
+
+                if(!stream.is_open())
+                    continue;
+
+                uint64_t nFileSize = static_cast<uint64_t>(stream.tellg());
+                stream.close();
+
+                /* Check the ratio of dead bytes. */
+                if(nFileSize == 0 || dead.second * 100 < nFileSize * nRatio)
+                    continue;
+
+                Compact(dead.first);
+            }
+        }
+    }
+
+
     /*  Start a database transaction. */
     template<class KeychainType, class CacheType>
     void SectorDatabase<KeychainType, CacheType>::TxnBegin()
@@ -638,7 +1343,10 @@ namespace LLD
             delete pTransaction;
 
         /* Create the new Database Transaction Object. */
-        pTransaction = new SectorTransaction();
+        pTransaction = new SectorTransaction(nSpillSize);
+
+        /* Mark the start of the transaction in the journal. */
+        pJournal->Write(SectorJournal::BEGIN);
     }
 
 
@@ -653,17 +1361,12 @@ namespace LLD
             return false;
 
         /* Set commit message into journal. */
-        pTransaction->ssJournal << std::string("commit");
-
-        /* Create an append only stream. */
-        std::ofstream stream = std::ofstream(debug::safe_printstr(config::GetDataDir(), strName, "/journal.dat"), std::ios::app | std::ios::binary);
-        if(!stream.is_open())
-            return debug::error(FUNCTION, "failed to open journal file");
+        if(!pJournal->Write(SectorJournal::COMMIT))
+            return debug::error(FUNCTION, "failed to write commit to journal");
 
-        /* Write to the file.  */
-        const std::vector<uint8_t>& vBytes = pTransaction->ssJournal.Bytes();
-        stream.write((char*)&vBytes[0], vBytes.size());
-        stream.close();
+        /* The operations were streamed as they happened, so one sync makes the whole transaction durable. */
+        if(!pJournal->Sync())
+            return debug::error(FUNCTION, "failed to sync journal");
 
         return true;
     }
@@ -682,9 +1385,8 @@ namespace LLD
         /** Set the transaction pointer to null also acting like a flag **/
         pTransaction = nullptr;
 
-        /* Delete the transaction journal file. */
-        std::ofstream stream(debug::safe_printstr(config::GetDataDir(), strName, "/journal.dat"), std::ios::trunc);
-        stream.close();
+        /* Mark the transaction released in the journal so it is never replayed. */
+        pJournal->Release();
     }
 
 
@@ -699,15 +1401,56 @@ namespace LLD
             return false;
 
         /* Erase data set to be removed. */
-        for(const auto& item : pTransaction->setErasedData)
-            if(!pSectorKeys->Erase(item))
-                return debug::error(FUNCTION, "failed to erase from keychain");
+        {
+            LOCK(SECTOR_MUTEX);
+
+            for(const auto& item : pTransaction->setErasedData)
+            {
+                /* The erased record becomes dead space. */
+                MarkDead(item);
+
+                if(!pSectorKeys->Erase(item))
+                    return debug::error(FUNCTION, "failed to erase from keychain");
+            }
+        }
+
+        /* Commit the sector data as one group commit. */
+        std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> > vRecords;
+        vRecords.reserve(pTransaction->mapTransactions.size());
+        for(auto& item : pTransaction->mapTransactions)
+            vRecords.push_back(std::make_pair(item.first, std::move(item.second)));
+
+        if(!Append(vRecords))
+        {
+            /* Give the data back to the transaction, so it can still be read until it is aborted. */
+            for(auto& record : vRecords)
+                pTransaction->mapTransactions[record.first] = std::move(record.second);
+
+            return debug::error(FUNCTION, "failed to commit sector data");
+        }
+
+        /* Commit the sector data left in the journal, reading it back in batches. */
+        std::vector<uint64_t> vPos;
+        for(auto it = pTransaction->mapSpilled.begin(); it != pTransaction->mapSpilled.end(); )
+        {
+            vPos.push_back(it->second);
+            if(++it != pTransaction->mapSpilled.end() && vPos.size() < 1024)
+                continue;
+
+            std::vector<SectorJournal::Record> vSpilled;
+            if(!pJournal->Read(vPos, vSpilled))
+                return debug::error(FUNCTION, "failed to read sector data from journal");
+
+            vRecords.clear();
+            for(auto& record : vSpilled)
+                vRecords.push_back(std::make_pair(std::move(record.vKey), std::move(record.vData)));
 
-        /* Commit the sector data. */
-        for(const auto& item : pTransaction->mapTransactions)
-            if(!Force(item.first, item.second))
+            if(!Append(vRecords))
                 return debug::error(FUNCTION, "failed to commit sector data");
 
+            vPos.clear();
+        }
+
         /* Commit keychain entries. */
         for(const auto& item : pTransaction->setKeychain)
         {
@@ -716,7 +1459,9 @@ namespace LLD
                 return debug::error(FUNCTION, "failed to commit to keychain");
         }
 
-        /* Commit the index data. */
+        /* Commit the index data, locking sectors so the compactor can't move indexed records. */
+        LOCK2(SECTOR_MUTEX);
+
         std::map<std::vector<uint8_t>, SectorKey> mapIndex;
         for(const auto& item : pTransaction->mapIndex)
         {
@@ -750,100 +1495,77 @@ namespace LLD
     template<class KeychainType, class CacheType>
     bool SectorDatabase<KeychainType, CacheType>::TxnRecovery()
     {
-        /* Create an append only stream. */
-        std::ifstream stream(debug::safe_printstr(config::GetDataDir(), strName, "/journal.dat"), std::ios::in | std::ios::out | std::ios::binary);
-        if(!stream.is_open())
+        /* Read the last transaction of the journal. */
+        std::vector<SectorJournal::Record> vRecords;
+        if(!pJournal->Tail(vRecords, nSpillSize))
             return false;
 
-        /* Get the Binary Size. */
-        stream.ignore(std::numeric_limits<std::streamsize>::max());
-
-        /* Get the data buffer. */
-        uint32_t nSize = static_cast<uint32_t>(stream.gcount());
+        /* Check that the transaction was committed but never released. */
+        bool fCommitted = false;
+        for(const auto& record : vRecords)
+        {
+            if(record.nType == SectorJournal::RELEASE)
+                return false;
 
-        /* Check journal size for 0. */
-        if(nSize == 0)
-            return false;
+            if(record.nType == SectorJournal::COMMIT)
+                fCommitted = true;
+        }
 
-        /* Create buffer to read into. */
-        std::vector<uint8_t> vBuffer(nSize, 0);
+        if(!fCommitted)
+            return debug::error(FUNCTION, strName, " transaction journal never reached commit");
 
-        /* Read the keychain file. */
-        stream.seekg (0, std::ios::beg);
-        stream.read((char*) &vBuffer[0], vBuffer.size());
-        stream.close();
+        debug::log(0, FUNCTION, strName, " transaction journal detected of ", vRecords.size(), " records");
 
-        debug::log(0, FUNCTION, strName, " transaction journal detected of ", nSize, " bytes");
+        /* Create the transaction object without logging a new begin. */
+        LOCK(TRANSACTION_MUTEX);
+        if(pTransaction)
+            delete pTransaction;
 
-        /* Create the transaction object. */
-        TxnBegin();
+        pTransaction = new SectorTransaction(nSpillSize);
 
-        /* Serialize the key. */
-        const DataStream ssJournal(vBuffer, SER_LLD, DATABASE_VERSION);
-        while(!ssJournal.End())
+        /* Replay the records of the transaction. */
+        for(const auto& record : vRecords)
         {
-            /* Read the data entry type. */
-            std::string strType;
-            ssJournal >> strType;
-
             /* Check for Erase. */
-            if(strType == "erase")
+            if(record.nType == SectorJournal::ERASE)
             {
-                /* Get the key to erase. */
-                std::vector<uint8_t> vKey;
-                ssJournal >> vKey;
-
                 /* Erase the key. */
-                pTransaction->EraseTransaction(vKey);
+                pTransaction->EraseTransaction(record.vKey);
 
                 /* Debug output. */
-                debug::log(0, FUNCTION, "erasing key ", HexStr(vKey.begin(), vKey.end()).substr(0, 20));
+                debug::log(0, FUNCTION, "erasing key ", HexStr(record.vKey.begin(), record.vKey.end()).substr(0, 20));
             }
-            else if(strType == "key")
+            else if(record.nType == SectorJournal::KEY)
             {
-                /* Get the key to write. */
-                std::vector<uint8_t> vKey;
-                ssJournal >> vKey;
-
                 /* Write the key. */
-                pTransaction->setKeychain.insert(vKey);
+                pTransaction->setErasedData.erase(record.vKey);
+                pTransaction->setKeychain.insert(record.vKey);
 
                 /* Debug output. */
-                debug::log(0, FUNCTION, "writing keychain ", HexStr(vKey.begin(), vKey.end()).substr(0, 20));
+                debug::log(0, FUNCTION, "writing keychain ", HexStr(record.vKey.begin(), record.vKey.end()).substr(0, 20));
             }
-            else if(strType == "write")
+            else if(record.nType == SectorJournal::WRITE)
             {
-                /* Get the key to write. */
-                std::vector<uint8_t> vKey;
-                ssJournal >> vKey;
-
-                /* Get the data to write. */
-                std::vector<uint8_t> vData;
-                ssJournal >> vData;
-
-                /* Write the sector data. */
-                pTransaction->mapTransactions[vKey] = vData;
+                /* Write the sector data, which is left in the journal if it was too large to read. */
+                pTransaction->setErasedData.erase(record.vKey);
+                if(record.vData.empty())
+                    pTransaction->Spill(record.vKey, record.nPos);
+                else
+                    pTransaction->Write(record.vKey, record.vData);
 
                 /* Debug output. */
-                debug::log(0, FUNCTION, "writing data ", HexStr(vKey.begin(), vKey.end()).substr(0, 20));
+                debug::log(0, FUNCTION, "writing data ", HexStr(record.vKey.begin(), record.vKey.end()).substr(0, 20));
             }
-            else if(strType == "index")
+            else if(record.nType == SectorJournal::INDEX)
             {
-                /* Get the key to index. */
-                std::vector<uint8_t> vKey;
-                ssJournal >> vKey;
-
-                /* Get the data to index to. */
-                std::vector<uint8_t> vIndex;
-                ssJournal >> vIndex;
-
                 /* Set the indexing key. */
-                pTransaction->mapIndex[vKey] = vIndex;
+                pTransaction->setErasedData.erase(record.vKey);
+                pTransaction->mapIndex[record.vKey] = record.vData;
 
                 /* Debug output. */
-                debug::log(0, FUNCTION, "indexing key ", HexStr(vKey.begin(), vKey.end()).substr(0, 20));
+                debug::log(0, FUNCTION, "indexing key ", HexStr(record.vKey.begin(), record.vKey.end()).substr(0, 20));
             }
-            if(strType == "commit")
+            else if(record.nType == SectorJournal::COMMIT)
             {
                 debug::log(0, FUNCTION, strName, " transaction journal ready to be restored");
 
@@ -851,12 +1573,13 @@ namespace LLD
             }
         }
 
-        return debug::error(FUNCTION, strName, " transaction journal never reached commit");
+        return true;
     }
 
 
     /* Explicity instantiate all template instances needed for compiler. */
     template class SectorDatabase<BinaryHashMap,  BinaryLRU>;
+    template class SectorDatabase<BinaryHashMap,  BinaryCLOCK>;
     //template class SectorDatabase<ShardHashMap,   BinaryLRU>;
     //template class SectorDatabase<BinaryHashMap,  BinaryLFU>;
     //template class SectorDatabase<BinaryHashTree, BinaryLRU>;
@@ -0,0 +1,237 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLD_TEMPLATES_JOURNAL_H
+#define NEXUS_LLD_TEMPLATES_JOURNAL_H
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Util/templates/datastream.h>
+
+namespace LLD
+{
+
+    /** SectorJournal
+     *
+     *  Append only write ahead log of the transactions of a sector database. The operations of
+     *  a transaction are streamed to the log as they happen, and the log is synced once when the
+     *  transaction is committed. Each record is framed with its length and a checksum, so a
+     *  record torn by a crash ends the log rather than corrupting it.
+     *
+     *  A transaction is marked released once it has been applied or aborted. Only the last
+     *  transaction of a log can be unreleased, so the log is truncated as a checkpoint once it
+     *  grows past its checkpoint size, and recovery only replays the tail after the last begin.
+     *
+     **/
+    class SectorJournal
+    {
+    public:
+
+        /** The types of the log records. **/
+        enum RECORD : uint8_t
+        {
+            BEGIN   = 0x01,
+            WRITE   = 0x02,
+            ERASE   = 0x03,
+            KEY     = 0x04,
+            INDEX   = 0x05,
+            COMMIT  = 0x06,
+            RELEASE = 0x07
+        };
+
+
+        /** Record
+         *
+         *  An operation read back from the log.
+         *
+         **/
+        struct Record
+        {
+            uint8_t nType;
+            uint64_t nPos;
+            std::vector<uint8_t> vKey;
+            std::vector<uint8_t> vData;
+        };
+
+
+        /** The size of a record's frame of type, length and checksum. **/
+        static const uint32_t HEADER_SIZE = 9;
+
+
+    private:
+
+        /** Mutex for thread safety. **/
+        std::mutex MUTEX;
+
+
+        /** The file of the log. **/
+        std::string strPath;
+
+
+        /** The append stream of the log, opened on first use. **/
+        std::ofstream stream;
+
+
+        /** The current size of the log. **/
+        uint64_t nSize;
+
+
+        /** The size the log is truncated at once its transactions are released. **/
+        uint64_t nCheckpointSize;
+
+
+        /** Flag set when a record failed to write, until the next truncate. **/
+        bool fFailed;
+
+
+        /** Flag set while the last transaction of the log is not released. **/
+        bool fPending;
+
+
+    public:
+
+        /** Constructor
+         *
+         *  @param[in] strPathIn The file of the log.
+         *  @param[in] nCheckpointSizeIn The size the log is truncated at.
+         *
+         **/
+        SectorJournal(const std::string& strPathIn, const uint64_t nCheckpointSizeIn);
+
+
+        /** Copy Constructor. **/
+        SectorJournal(const SectorJournal& journal) = delete;
+
+
+        /** Copy Assignment Operator. **/
+        SectorJournal& operator=(const SectorJournal& journal) = delete;
+
+
+        /** Default Destructor. **/
+        ~SectorJournal();
+
+
+        /** Write
+         *
+         *  Append a record to the log. The record is buffered and not synced.
+         *
+         *  @param[in] nType The type of the record.
+         *  @param[in] vKey The binary data of the key of the operation.
+         *  @param[in] vData The binary data of the record or index of the operation.
+         *
+         *  @return True if the record was written.
+         *
+         **/
+        bool Write(const uint8_t nType, const std::vector<uint8_t>& vKey = std::vector<uint8_t>(),
+                   const std::vector<uint8_t>& vData = std::vector<uint8_t>());
+
+
+        /** Write
+         *
+         *  Append a record to the log, giving its position so it can be read back.
+         *
+         *  @param[in] nType The type of the record.
+         *  @param[in] vKey The binary data of the key of the operation.
+         *  @param[in] vData The binary data of the record or index of the operation.
+         *  @param[out] nPos The position of the record in the log.
+         *
+         *  @return True if the record was written.
+         *
+         **/
+        bool Write(const uint8_t nType, const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData, uint64_t& nPos);
+
+
+        /** Read
+         *
+         *  Read back records written by the pending transaction, checking each against its checksum.
+         *
+         *  @param[in] vPos The positions of the records in the log.
+         *  @param[out] vRecords The records read, in the order of their positions.
+         *
+         *  @return True if every record was read and verified.
+         *
+         **/
+        bool Read(const std::vector<uint64_t>& vPos, std::vector<Record>& vRecords);
+
+
+        /** Sync
+         *
+         *  Flush the log through to stable storage.
+         *
+         *  @return True if every record since the last truncate is durable.
+         *
+         **/
+        bool Sync();
+
+
+        /** Release
+         *
+         *  Mark the last transaction of the log as released, so it is never replayed, and
+         *  truncate the log as a checkpoint if it has grown past its checkpoint size.
+         *
+         **/
+        void Release();
+
+
+        /** Tail
+         *
+         *  Read the records of the last transaction in the log. Every record is checked against
+         *  its checksum before it is used, and the log ends at the first torn record. The data of
+         *  writes past the given size is left in the log, to be read back by its position.
+         *
+         *  @param[out] vRecords The records after the last begin.
+         *  @param[in] nMaxData The bytes of written data to read into memory.
+         *
+         *  @return True if the log has a transaction.
+         *
+         **/
+        bool Tail(std::vector<Record>& vRecords, const uint64_t nMaxData);
+
+
+    private:
+
+        /** open
+         *
+         *  Open the append stream if it isn't open. Must be called with MUTEX held.
+         *
+         *  @param[in] fTruncate Flag to truncate the log.
+         *
+         *  @return True if the stream is open.
+         *
+         **/
+        bool open(const bool fTruncate = false);
+
+
+        /** frame
+         *
+         *  Read a record of the log and check it wasn't torn. Must be called with MUTEX held.
+         *
+         *  @param[in] file The log opened for reading.
+         *  @param[in] nPos The position of the record.
+         *  @param[in] nFileSize The size of the log.
+         *  @param[out] nType The type of the record.
+         *  @param[out] ssRecord The serialized operation of the record.
+         *
+         *  @return True if the record is whole and matches its checksum.
+         *
+         **/
+        bool frame(std::ifstream& file, const uint64_t nPos, const uint64_t nFileSize, uint8_t& nType, DataStream& ssRecord);
+    };
+}
+
+#endif
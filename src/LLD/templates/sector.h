@@ -18,21 +18,29 @@ ________________________________________________________________________________
 
 #include <LLD/include/enum.h>
 #include <LLD/include/version.h>
+#include <LLD/templates/journal.h>
 #include <LLD/templates/key.h>
 #include <LLD/templates/transaction.h>
 
 #include <LLD/cache/template_lru.h>
+#include <LLD/compress/codec.h>
+#include <LLD/index/record.h>
 
+#include <Util/templates/bufferpool.h>
 #include <Util/templates/datastream.h>
+#include <Util/templates/readstream.h>
 #include <Util/include/runtime.h>
 #include <Util/include/debug.h>
 
 #include <string>
 #include <cstdint>
+#include <map>
+#include <set>
 #include <atomic>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
 
 namespace LLD
 {
@@ -50,6 +58,18 @@ namespace LLD
     const uint32_t MAX_SECTOR_BUFFER_SIZE = 1024 * 1024 * 4; //32 MB Max Disk Buffer
 
 
+    /* Maximum sector files addressable by a sector key. */
+    const uint32_t MAX_SECTOR_FILES = 1 << 16;
+
+
+    /* Stripes of the versions that guard records rewritten in place. */
+    const uint32_t SECTOR_VERSIONS = 1 << 10;
+
+
+    /* Marks that no sector file is being compacted. */
+    const uint32_t COMPACT_NONE = 0xffffffff;
+
+
     /** SectorDatabase
      *
      *  Base Template Class for a Sector Database.
@@ -88,9 +108,8 @@ namespace LLD
         std::condition_variable CONDITION;
 
     protected:
-        /* Mutex for Thread Synchronization.
-            TODO: Lock Mutex based on Read / Writes on a per Sector Basis.
-            Will allow higher efficiency for thread concurrency. */
+        /* Mutex for Thread Synchronization of sector writes.
+            Reads use positional reads on shared descriptors and take no lock. */
         std::mutex SECTOR_MUTEX;
         std::mutex BUFFER_MUTEX;
         std::mutex TRANSACTION_MUTEX;
@@ -109,6 +128,14 @@ namespace LLD
         SectorTransaction* pTransaction;
 
 
+        /* Write ahead log of the transactions. */
+        SectorJournal* pJournal;
+
+
+        /* The bytes of sector data a transaction holds in memory before it is left in the journal. */
+        uint64_t nSpillSize;
+
+
         /* Sector Keys Database. */
         KeychainType* pSectorKeys;
 
@@ -121,6 +148,23 @@ namespace LLD
         mutable TemplateLRU<uint32_t, std::fstream*>* fileCache;
 
 
+        /* Secondary index of live records by type. */
+        RecordIndex* pRecordIndex;
+
+
+        /* Compression of records, used for writes when the database is opened with FLAGS::COMPRESS. */
+        RecordCodec* pCodec;
+
+
+        /* Read only file descriptors shared by all reader threads, indexed by sector file. */
+        std::atomic<int32_t>* pReadFiles;
+
+
+        /* Versions of striped record locations, odd while a record is rewritten in place, so reads without
+         * the sector lock can detect a torn record and read it again. */
+        std::atomic<uint32_t>* pSectorVersions;
+
+
         /* The current File Position. */
         mutable uint32_t nCurrentFile;
         mutable uint32_t nCurrentFileSize;
@@ -134,6 +178,18 @@ namespace LLD
         std::thread MeterThread;
 
 
+        /* The compactor thread. */
+        std::thread CompactorThread;
+
+
+        /* Dead bytes in each sector file from overwritten and deleted records. Guarded by SECTOR_MUTEX. */
+        std::map<uint32_t, uint64_t> mapDeadBytes;
+
+
+        /* The sector file being compacted. Its records are appended rather than updated in place. */
+        uint32_t nCompactFile;
+
+
         /* Disk Buffer Vector. */
         std::vector< std::pair< std::vector<uint8_t>, std::vector<uint8_t> > > vDiskBuffer;
 
@@ -150,6 +206,10 @@ namespace LLD
         std::atomic<bool> fDestruct;
 
 
+        /* Set while the cache writer is failing to flush the disk buffer. */
+        std::atomic<bool> fFlushFailed;
+
+
         /* Initialize Flag. */
         std::atomic<bool> fInitialized;
 
@@ -191,7 +251,7 @@ namespace LLD
         bool Exists(const Key& key)
         {
             /* Serialize Key into Bytes. */
-            DataStream ssKey(SER_LLD, DATABASE_VERSION);
+            PooledStream ssKey(SER_LLD, DATABASE_VERSION);
             ssKey << key;
 
             /* Get reference of key. */
@@ -208,7 +268,7 @@ namespace LLD
                         return false;
 
                     /* Check if the new data is set in a transaction to ensure that the database knows what is in volatile memory. */
-                    if(pTransaction->mapTransactions.count(vKey))
+                    if(pTransaction->mapTransactions.count(vKey) || pTransaction->mapSpilled.count(vKey))
                         return true;
 
                     /* Check for keychain commits. */
@@ -247,7 +307,7 @@ namespace LLD
                 return debug::error("Erase called on database in read-only mode");
 
             /* Serialize Key into Bytes. */
-            DataStream ssKey(SER_LLD, DATABASE_VERSION);
+            PooledStream ssKey(SER_LLD, DATABASE_VERSION);
             ssKey << key;
 
             /* Remove the item from the cache pool. */
@@ -258,8 +318,8 @@ namespace LLD
                 LOCK(TRANSACTION_MUTEX);
                 if(pTransaction)
                 {
-                    /* Write to journal in memory. */
-                    pTransaction->ssJournal << std::string("erase") << ssKey.Bytes();
+                    /* Log the operation to the journal. */
+                    pJournal->Write(SectorJournal::ERASE, ssKey.Bytes());
 
                     /* Erase the transaction data. */
                     pTransaction->EraseTransaction(ssKey.Bytes());
@@ -286,11 +346,119 @@ namespace LLD
         template<typename Type>
         bool BatchRead(const std::string& strType, std::vector<Type>& vValues, int32_t nLimit = 1000)
         {
+            /* Read the records directly if their type is indexed. */
+            if(pRecordIndex->Indexed(strType))
+            {
+                std::vector<SectorKey> vKeys;
+                pRecordIndex->Get(strType, vKeys);
+
+                return ReadRecords(vKeys, strType, vValues, nLimit);
+            }
+
             /* The current file being read. */
             return GetBatch(0, 0, strType, vValues, nLimit);
         }
 
 
+        /** BatchReadField
+         *
+         *  Read the records of a type that were indexed with a given field.
+         *  If the type isn't indexed this reads every record of the type, so
+         *  callers should still check the field.
+         *
+         *  @param[in] strType The type specifier to read records from
+         *  @param[in] field The field value the records were indexed by.
+         *  @param[out] vValues The database entry value to read out.
+         *  @param[in] nLimit The total records to read.
+         *
+         *  @return True if the entry read, false otherwise.
+         *
+         **/
+        template<typename Field, typename Type>
+        bool BatchReadField(const std::string& strType, const Field& field, std::vector<Type>& vValues, int32_t nLimit = 1000)
+        {
+            /* Fall back to reading every record of the type. */
+            if(!pRecordIndex->Indexed(strType))
+                return GetBatch(0, 0, strType, vValues, nLimit);
+
+            /* Serialize the field into bytes. */
+            DataStream ssField(SER_LLD, DATABASE_VERSION);
+            ssField << field;
+
+            /* Get the records with the field. */
+            std::vector<SectorKey> vKeys;
+            pRecordIndex->Get(strType, ssField.Bytes(), vKeys);
+
+            return ReadRecords(vKeys, strType, vValues, nLimit);
+        }
+
+
+        /** HasIndex
+         *
+         *  Check if the records written with a type are indexed.
+         *
+         *  @param[in] strType The type specifier to check.
+         *
+         *  @return True if the type is indexed.
+         *
+         **/
+        bool HasIndex(const std::string& strType) const
+        {
+            return pRecordIndex->Indexed(strType);
+        }
+
+
+        /** AddIndex
+         *
+         *  Index the records written with a type, so BatchRead can list them without
+         *  scanning the sector files. Call BuildIndex once all types are added.
+         *
+         *  @param[in] strType The type specifier to index.
+         *
+         **/
+        void AddIndex(const std::string& strType)
+        {
+            pRecordIndex->Register(strType);
+        }
+
+
+        /** AddIndex
+         *
+         *  Index the records written with a type, and by a field of the record for BatchReadField.
+         *  Call BuildIndex once all types are added.
+         *
+         *  @param[in] strType The type specifier to index.
+         *  @param[in] fnField Gets the field to index by from a record.
+         *
+         **/
+        template<typename Type, typename Field>
+        void AddIndex(const std::string& strType, const std::function<Field(Type&)>& fnField)
+        {
+            pRecordIndex->Register(strType, [fnField](DataStream& ssData, std::vector<uint8_t>& vField)
+            {
+                try
+                {
+                    /* Get the record. */
+                    Type value;
+                    ssData >> value;
+
+                    /* Serialize the field. */
+                    DataStream ssField(SER_LLD, DATABASE_VERSION);
+                    ssField << fnField(value);
+
+                    vField = ssField.Bytes();
+                }
+                catch(const std::exception& e)
+                {
+                    /* Records without the field are only indexed by type. */
+                    return false;
+                }
+
+                return true;
+            });
+        }
+
+
         /** BatchRead
          *
          *  Sequential read from another key's position in datachain.
@@ -309,7 +477,7 @@ namespace LLD
             std::vector<Type>& vValues, int32_t nLimit = 1000, bool fExclude = true)
         {
             /* Serialize Key into Bytes. */
-            DataStream ssKey(SER_LLD, DATABASE_VERSION);
+            PooledStream ssKey(SER_LLD, DATABASE_VERSION);
             ssKey << key;
 
             /* Get the key. */
@@ -322,6 +490,65 @@ namespace LLD
         }
 
 
+        /** ReadRecords
+         *
+         *  Read the records of a type from a list of sectors.
+         *
+         *  @param[in] vKeys The sector keys of the records.
+         *  @param[in] strType The type specifier of the records
+         *  @param[out] vValues The database entry value to read out.
+         *  @param[in] nLimit The total records to read.
+         *
+         *  @return True if the entry read, false otherwise.
+         *
+         **/
+        template<typename Type>
+        bool ReadRecords(const std::vector<SectorKey>& vKeys, const std::string& strType,
+            std::vector<Type>& vValues, int32_t nLimit = 1000)
+        {
+            /* Clear any remaining data. */
+            vValues.clear();
+
+            for(const auto& cKey : vKeys)
+            {
+                /* Skip records moved since they were listed. */
+                std::vector<uint8_t> vData;
+                if(!ReadSector(cKey, vData))
+                    continue;
+
+                try
+                {
+                    /* Check the type. */
+                    DataStream ssData(vData, SER_LLD, DATABASE_VERSION);
+
+                    std::string strThis;
+                    ssData >> strThis;
+
+                    if(strType != strThis)
+                        continue;
+
+                    /* Get the value. */
+                    Type value;
+                    ssData >> value;
+
+                    /* Push next value. */
+                    vValues.push_back(value);
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "failed to read record: ", e.what());
+                    continue;
+                }
+
+                /* Check limits. */
+                if(nLimit != -1 && --nLimit == 0)
+                    break;
+            }
+
+            return (vValues.size() > 0);
+        }
+
+
         /** GetBatch
          *
          *  Sequential read from a specified binary position.
@@ -367,20 +594,16 @@ namespace LLD
                     DataStream ssData(SER_LLD, DATABASE_VERSION);
                     ssData.resize(nBufferSize);
 
-                    {
-                        LOCK(SECTOR_MUTEX);
-
-                        /* Seek stream to beginning. */
-                        stream.seekg(nStart, std::ios::beg);
+                    /* Seek stream to beginning. */
+                    stream.seekg(nStart, std::ios::beg);
 
-                        /* Read the data into the buffer. */
-                        stream.read((char*)ssData.data(), nBufferSize);
-                        if(!stream)
-                            ssData.resize(stream.gcount());
+                    /* Read the data into the buffer. */
+                    stream.read((char*)ssData.data(), nBufferSize);
+                    if(!stream)
+                        ssData.resize(stream.gcount());
 
-                        /* Iterate if meters are enabled. */
-                        nBytesRead += static_cast<uint32_t>(nBufferSize);
-                    }
+                    /* Iterate if meters are enabled. */
+                    nBytesRead += static_cast<uint32_t>(nBufferSize);
 
                     /* Read records. */
                     while(!ssData.End())
@@ -395,16 +618,29 @@ namespace LLD
                             if(nSize == 0) //reached end of current file
                                 break;
 
-                            /* Deserialize the String. */
+                            /* Copy out compressed records to decompress them. */
+                            bool fCompressed = (!ssData.End() && RecordCodec::Compressed(ssData.Bytes()[ssData.GetPos()]));
+
+                            DataStream ssRecord(SER_LLD, DATABASE_VERSION);
+                            if(fCompressed)
+                            {
+                                ssRecord.resize(nSize);
+                                ssData.read((char*)ssRecord.data(), nSize);
+                            }
+
+                            /* Deserialize the String, skipping records that fail to decompress. */
+                            const DataStream& ssThis = fCompressed ? ssRecord : ssData;
+
                             std::string strThis;
-                            ssData >> strThis;
+                            if(!fCompressed || pCodec->Decode(ssRecord.Bytes()))
+                                ssThis >> strThis;
 
                             /* Check the type. */
                             if(strType == strThis)
                             {
                                 /* Get the value. */
                                 Type value;
-                                ssData >> value;
+                                ssThis >> value;
 
                                 /* Push next value. */
                                 vValues.push_back(value);
@@ -454,12 +690,9 @@ namespace LLD
         bool Read(const Key& key, Type& value)
         {
             /* Serialize Key into Bytes. */
-            DataStream ssKey(SER_LLD, DATABASE_VERSION);
+            PooledStream ssKey(SER_LLD, DATABASE_VERSION);
             ssKey << key;
 
-            /* Get the Data from Sector Database. */
-            std::vector<uint8_t> vData;
-
             /* Get reference of key. */
             std::vector<uint8_t>& vKey = ssKey.Bytes();
 
@@ -477,13 +710,31 @@ namespace LLD
                         vKey = pTransaction->mapIndex[vKey];
 
                     /* Check if the new data is set in a transaction to ensure that the database knows what is in volatile memory. */
-                    if(pTransaction->mapTransactions.count(vKey))
+                    auto it = pTransaction->mapTransactions.find(vKey);
+                    if(it != pTransaction->mapTransactions.end())
                     {
-                        /* Get the data from the transction object. */
-                        vData = pTransaction->mapTransactions[vKey];
+                        /* Deserialize Value in place, since the transaction can't change while it is locked. */
+                        const ReadStream ssValue(it->second, SER_LLD, DATABASE_VERSION);
 
-                        /* Deserialize Value. */
-                        DataStream ssValue(vData, SER_LLD, DATABASE_VERSION);
+                        /* Deserialize the String. */
+                        std::string strType;
+                        ssValue >> strType;
+
+                        /* Deseriazlie the Value. */
+                        ssValue >> value;
+
+                        return true;
+                    }
+
+                    /* Read back new data that was left in the journal. */
+                    auto itSpilled = pTransaction->mapSpilled.find(vKey);
+                    if(itSpilled != pTransaction->mapSpilled.end())
+                    {
+                        std::vector<SectorJournal::Record> vRecords;
+                        if(!pJournal->Read(std::vector<uint64_t>(1, itSpilled->second), vRecords))
+                            return false;
+
+                        const ReadStream ssValue(vRecords[0].vData, SER_LLD, DATABASE_VERSION);
 
                         /* Deserialize the String. */
                         std::string strType;
@@ -497,13 +748,11 @@ namespace LLD
                 }
             }
 
-            /* Get the data from the database. */
-            if(!Get(vKey, vData))
+            /* Get the data from the database into a pooled buffer. */
+            PooledStream ssValue(SER_LLD, DATABASE_VERSION);
+            if(!Get(vKey, ssValue.Bytes()))
                 return false;
 
-            /* Deserialize Value. */
-            DataStream ssValue(vData, SER_LLD, DATABASE_VERSION);
-
             /* Deserialize the String. */
             std::string strType;
             ssValue >> strType;
@@ -529,11 +778,11 @@ namespace LLD
         bool Index(const Key& key, const Type& index)
         {
             /* Serialize Key into Bytes. */
-            DataStream ssKey(SER_LLD, DATABASE_VERSION);
+            PooledStream ssKey(SER_LLD, DATABASE_VERSION);
             ssKey << key;
 
             /* Serialize the index into bytes. */
-            DataStream ssIndex(SER_LLD, DATABASE_VERSION);
+            PooledStream ssIndex(SER_LLD, DATABASE_VERSION);
             ssIndex << index;
 
             /* Get reference of key and index. */
@@ -545,8 +794,8 @@ namespace LLD
                 LOCK(TRANSACTION_MUTEX);
                 if(pTransaction)
                 {
-                    /* Write to journal in memory. */
-                    pTransaction->ssJournal << std::string("index") << vKey << vIndex;
+                    /* Log the operation to the journal. */
+                    pJournal->Write(SectorJournal::INDEX, vKey, vIndex);
 
                     /* Check for erased data. */
                     pTransaction->setErasedData.erase(vKey);
@@ -558,6 +807,9 @@ namespace LLD
                 }
             }
 
+            /* Lock sectors so the compactor can't move the record while it is indexed. */
+            LOCK(SECTOR_MUTEX);
+
             /* Get the key. */
             SectorKey cKey;
             if(!pSectorKeys->Get(vIndex, cKey))
@@ -589,7 +841,7 @@ namespace LLD
                 return debug::error(FUNCTION, "Write called on database in read-only mode");
 
             /* Serialize Key into Bytes. */
-            DataStream ssKey(SER_LLD, DATABASE_VERSION);
+            PooledStream ssKey(SER_LLD, DATABASE_VERSION);
             ssKey << key;
 
             /* Get reference of key. */
@@ -601,8 +853,8 @@ namespace LLD
 
                 if(pTransaction)
                 {
-                    /* Write to journal in memory. */
-                    pTransaction->ssJournal << std::string("key") << vKey;
+                    /* Log the operation to the journal. */
+                    pJournal->Write(SectorJournal::KEY, vKey);
 
                     /* Check if data is in erase queue, if so remove it. */
                     pTransaction->setErasedData.erase(vKey);
@@ -637,11 +889,11 @@ namespace LLD
                 return debug::error(FUNCTION, "Write called on database in read-only mode");
 
             /* Serialize the Key. */
-            DataStream ssKey(SER_LLD, DATABASE_VERSION);
+            PooledStream ssKey(SER_LLD, DATABASE_VERSION);
             ssKey << key;
 
             /* Serialize the Value */
-            DataStream ssData(SER_LLD, DATABASE_VERSION);
+            PooledStream ssData(SER_LLD, DATABASE_VERSION);
             ssData << strType;
             ssData << value;
 
@@ -655,14 +907,18 @@ namespace LLD
 
                 if(pTransaction)
                 {
-                    /* Write to journal in memory. */
-                    pTransaction->ssJournal << std::string("write") << vKey << vData;
+                    /* Log the operation to the journal. */
+                    uint64_t nPos = 0;
+                    const bool fJournal = pJournal->Write(SectorJournal::WRITE, vKey, vData, nPos);
 
                     /* Check if data is in erase queue, if so remove it. */
                     pTransaction->setErasedData.erase(vKey);
 
-                    /* Set the transaction data. */
-                    pTransaction->mapTransactions[vKey] = vData;
+                    /* Set the transaction data, leaving it in the journal once the transaction is too large to hold. */
+                    if(fJournal && pTransaction->Full(vData.size()))
+                        pTransaction->Spill(vKey, nPos);
+                    else
+                        pTransaction->Write(vKey, vData);
 
                     return true;
                 }
@@ -699,17 +955,62 @@ namespace LLD
         bool Get(const SectorKey& cKey, std::vector<uint8_t>& vData);
 
 
+        /** ReadSector
+         *
+         *  Read a record's data from its sector file. Uses a positional read on a shared
+         *  read only descriptor so that concurrent readers do not need to lock.
+         *
+         *  @param[in] cKey The sector key of the record to read.
+         *  @param[out] vData The binary data of the record read.
+         *  @param[in] fDecode Flag to decompress the record, or read it as stored.
+         *
+         *  @return True if the record was read successfully.
+         *
+         **/
+        bool ReadSector(const SectorKey& cKey, std::vector<uint8_t>& vData, const bool fDecode = true);
+
+
+        /** Sync
+         *
+         *  Flush a sector file's written data through to stable storage.
+         *
+         *  @param[in] strFile The path of the sector file to sync.
+         *
+         *  @return True if the sync was successful.
+         *
+         **/
+        bool Sync(const std::string& strFile);
+
+
+        /** Encode
+         *
+         *  Get the form of a record to store on disk, compressing it if the database
+         *  was opened with FLAGS::COMPRESS.
+         *
+         *  @param[in] vData The binary data of the record.
+         *  @param[out] vRecord The buffer to compress the record into.
+         *
+         *  @return The record to write, which is either vData or vRecord.
+         *
+         **/
+        const std::vector<uint8_t>& Encode(const std::vector<uint8_t>& vData, std::vector<uint8_t>& vRecord);
+
+
         /** Update
          *
          *  Update a record on disk.
          *
          *  @param[in] vKey The binary data of the key to flush
          *  @param[in] vData The binary data of the record to flush
+         *  @param[in] vStored The record as it is written to disk.
+         *  @param[in] entry The record index entry of the record.
+         *  @param[out] nFile The sector file the record was written to.
          *
          *  @return True if the flush was successful.
          *
          **/
-        bool Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData);
+        bool Update(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData, const std::vector<uint8_t>& vStored,
+                    const RecordIndex::Entry& entry, uint32_t &nFile);
 
 
         /** Force
@@ -725,6 +1026,47 @@ namespace LLD
         bool Force(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData);
 
 
+        /** Append
+         *
+         *  Write a batch of records to disk as a group commit. Records that fit their
+         *  old sector are rewritten in place, and the rest with a single contiguous
+         *  write. Every file written is synced before any of their keys are committed
+         *  to the keychain, and before returning.
+         *
+         *  @param[in] vRecords The key and record pairs to write.
+         *
+         *  @return True if the batch was written successfully.
+         *
+         **/
+        bool Append(const std::vector< std::pair<std::vector<uint8_t>, std::vector<uint8_t>> >& vRecords);
+
+
+        /** WriteSectors
+         *
+         *  Write a buffer of serialized records to the end of the current sector file
+         *  and sync it to disk. Must be called with SECTOR_MUTEX held.
+         *
+         *  @param[in] ssBatch The records to write, each prefixed with its compact size.
+         *  @param[out] nFile The sector file the records were written to.
+         *  @param[out] nStart The position in the sector file of the first record.
+         *
+         *  @return True if the records were written and synced.
+         *
+         **/
+        bool WriteSectors(const DataStream& ssBatch, uint32_t& nFile, uint32_t& nStart);
+
+
+        /** MarkDead
+         *
+         *  Account the current record of a key as dead space in its sector file,
+         *  before the key is moved to a new record. Must be called with SECTOR_MUTEX held.
+         *
+         *  @param[in] vKey The binary data of the key being moved.
+         *
+         **/
+        void MarkDead(const std::vector<uint8_t>& vKey);
+
+
         /** Put
          *
          *  Write a record into the cache and disk buffer for flushing to disk.
@@ -767,6 +1109,37 @@ namespace LLD
         void Meter();
 
 
+        /** Compact
+         *
+         *  Copy the live records of a sector file forward into the current sector file,
+         *  repoint their keys, and truncate the old file to reclaim its space.
+         *  The database stays online while a file is compacted.
+         *
+         *  @param[in] nFile The sector file to compact.
+         *
+         *  @return True if the file was compacted.
+         *
+         **/
+        bool Compact(const uint32_t nFile);
+
+
+        /** BuildIndex
+         *
+         *  Load the record index persisted at shutdown, or rebuild it by reading
+         *  the live records of every sector file.
+         *
+         **/
+        void BuildIndex();
+
+
+        /** Compactor
+         *
+         *  Compacts sector files with a high ratio of dead bytes in the background.
+         *
+         **/
+        void Compactor();
+
+
         /** TxnBegin
          *
          *  Start a database transaction.
@@ -777,7 +1150,8 @@ namespace LLD
 
         /** TxnCheckpoint
          *
-         *  Write the transaction commitment message.
+         *  Write the transaction commitment message, and sync the journal once for the
+         *  whole transaction.
          *
          **/
         bool TxnCheckpoint();
@@ -785,7 +1159,8 @@ namespace LLD
 
         /** TxnRelease
          *
-         *  Release the transaction checkpoint.
+         *  Release the transaction checkpoint, truncating the journal once it has grown
+         *  past its checkpoint size.
          *
          **/
         void TxnRelease();
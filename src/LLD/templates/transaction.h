@@ -67,6 +67,9 @@ namespace LLD
         /** New Data to be Added. **/
         std::map< std::vector<uint8_t>, std::vector<uint8_t> > mapTransactions;
 
+        /** Positions in the journal of new data too large to hold in memory. **/
+        std::map< std::vector<uint8_t>, uint64_t > mapSpilled;
+
         /** Keychain items to commit. */
         std::set< std::vector<uint8_t> > setKeychain;
 
@@ -76,13 +79,28 @@ namespace LLD
         /** Vector to hold the keys of transactions to be erased. **/
         std::set< std::vector<uint8_t> > setErasedData;
 
-        /** Binary stream with data to be written. **/
-        DataStream ssJournal;
+    private:
+
+        /** The bytes of new data held in memory. **/
+        uint64_t nBytes;
+
+        /** The bytes of new data to hold in memory before spilling to the journal. **/
+        uint64_t nMaxBytes;
+
+    public:
 
         /** Default Constructor **/
         SectorTransaction();
 
 
+        /** Constructor
+         *
+         *  @param[in] nMaxBytesIn The bytes of new data to hold in memory before spilling to the journal.
+         *
+         **/
+        SectorTransaction(const uint64_t nMaxBytesIn);
+
+
         /** Default Destructor **/
         ~SectorTransaction();
 
@@ -97,6 +115,40 @@ namespace LLD
          *
          **/
         bool EraseTransaction(const std::vector<uint8_t> &vKey);
+
+
+        /** Write
+         *
+         *  Hold new data of a key in memory.
+         *
+         *  @param[in] vKey The key in binary.
+         *  @param[in] vData The data in binary.
+         *
+         **/
+        void Write(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData);
+
+
+        /** Spill
+         *
+         *  Leave new data of a key in the journal, to be read back when it is committed.
+         *
+         *  @param[in] vKey The key in binary.
+         *  @param[in] nPos The position of the data's record in the journal.
+         *
+         **/
+        void Spill(const std::vector<uint8_t>& vKey, const uint64_t nPos);
+
+
+        /** Full
+         *
+         *  Check if new data would take the transaction past the bytes it holds in memory.
+         *
+         *  @param[in] nSize The size of the new data.
+         *
+         *  @return True if the new data should be spilled.
+         *
+         **/
+        bool Full(const uint64_t nSize) const;
     };
 }
 
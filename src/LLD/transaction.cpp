@@ -14,16 +14,33 @@ ________________________________________________________________________________
 #include <LLD/templates/transaction.h>
 #include <LLD/include/version.h>
 
+#include <limits>
+
 namespace LLD
 {
 
     /* Default Constructor */
     SectorTransaction::SectorTransaction()
     : mapTransactions()
+    , mapSpilled()
+    , setKeychain()
+    , mapIndex()
+    , setErasedData()
+    , nBytes(0)
+    , nMaxBytes(std::numeric_limits<uint64_t>::max())
+    {
+    }
+
+
+    /* Constructor */
+    SectorTransaction::SectorTransaction(const uint64_t nMaxBytesIn)
+    : mapTransactions()
+    , mapSpilled()
     , setKeychain()
     , mapIndex()
     , setErasedData()
-    , ssJournal(SER_LLD, DATABASE_VERSION)
+    , nBytes(0)
+    , nMaxBytes(nMaxBytesIn)
     {
     }
 
@@ -41,8 +58,15 @@ namespace LLD
         setErasedData.insert(vKey);
 
         /* Delete from transactions map if exists. */
-        if(mapTransactions.count(vKey))
-            mapTransactions.erase(vKey);
+        auto it = mapTransactions.find(vKey);
+        if(it != mapTransactions.end())
+        {
+            nBytes -= it->second.size();
+            mapTransactions.erase(it);
+        }
+
+        /* Delete from the spilled data if exists. */
+        mapSpilled.erase(vKey);
 
         /* Delete from keychain if exists. */
         if(setKeychain.count(vKey))
@@ -55,4 +79,39 @@ namespace LLD
         return true;
     }
 
+
+    /* Hold new data of a key in memory. */
+    void SectorTransaction::Write(const std::vector<uint8_t>& vKey, const std::vector<uint8_t>& vData)
+    {
+        /* Data written again replaces what was spilled. */
+        mapSpilled.erase(vKey);
+
+        std::vector<uint8_t>& vValue = mapTransactions[vKey];
+        nBytes -= vValue.size();
+        nBytes += vData.size();
+
+        vValue = vData;
+    }
+
+
+    /* Leave new data of a key in the journal. */
+    void SectorTransaction::Spill(const std::vector<uint8_t>& vKey, const uint64_t nPos)
+    {
+        /* Data spilled replaces what was held in memory. */
+        auto it = mapTransactions.find(vKey);
+        if(it != mapTransactions.end())
+        {
+            nBytes -= it->second.size();
+            mapTransactions.erase(it);
+        }
+
+        mapSpilled[vKey] = nPos;
+    }
+
+
+    /* Check if new data would take the transaction past the bytes it holds in memory. */
+    bool SectorTransaction::Full(const uint64_t nSize) const
+    {
+        return nBytes + nSize > nMaxBytes;
+    }
 }
@@ -18,7 +18,7 @@ ________________________________________________________________________________
 #include <LLC/types/uint1024.h>
 
 #include <LLD/templates/sector.h>
-#include <LLD/cache/binary_lru.h>
+#include <LLD/cache/binary_clock.h>
 #include <LLD/keychain/hashmap.h>
 
 #include <TAO/Operation/types/contract.h>
@@ -72,7 +72,7 @@ namespace LLD
      *  The database class for the Ledger Layer.
      *
      **/
-    class LedgerDB : public SectorDatabase<BinaryHashMap, BinaryLRU>
+    class LedgerDB : public SectorDatabase<BinaryHashMap, BinaryCLOCK>
     {
 
         /** Mutex to lock internall when accessing memory mode. **/
@@ -18,7 +18,7 @@ ________________________________________________________________________________
 #include <LLC/types/uint1024.h>
 
 #include <LLD/templates/sector.h>
-#include <LLD/cache/binary_lru.h>
+#include <LLD/cache/binary_clock.h>
 #include <LLD/keychain/hashmap.h>
 
 #include <TAO/Register/types/state.h>
@@ -52,7 +52,7 @@ namespace LLD
      *  The database class for the Register Layer.
      *
      **/
-    class RegisterDB : public SectorDatabase<BinaryHashMap, BinaryLRU>
+    class RegisterDB : public SectorDatabase<BinaryHashMap, BinaryCLOCK>
     {
         
         /** Memory mutex to lock when accessing internal memory states. **/
@@ -192,6 +192,71 @@ namespace LLD
         bool EraseTrust(const uint256_t& hashGenesis);
 
 
+        /** IndexOwner
+         *
+         *  Index a register to the genesis that owns it, or has transferred it and not had it claimed yet.
+         *
+         *  @param[in] hashGenesis The genesis-id of the owner.
+         *  @param[in] hashRegister The register address.
+         *
+         *  @return True if write was successful, false otherwise.
+         *
+         **/
+        bool IndexOwner(const uint256_t& hashGenesis, const uint256_t& hashRegister);
+
+
+        /** EraseOwner
+         *
+         *  Erase a register from the owner index of a genesis.
+         *
+         *  @param[in] hashGenesis The genesis-id of the owner.
+         *  @param[in] hashRegister The register address.
+         *
+         *  @return True if erase was successful, false otherwise.
+         *
+         **/
+        bool EraseOwner(const uint256_t& hashGenesis, const uint256_t& hashRegister);
+
+
+        /** ListOwned
+         *
+         *  List the registers indexed to a genesis. The index can hold registers
+         *  that have since been transferred away, so callers should check the owner of each register.
+         *  Nothing is listed if the record index is disabled, see HasIndex.
+         *
+         *  @param[in] hashGenesis The genesis-id of the owner.
+         *  @param[out] vRegisters The register addresses.
+         *
+         *  @return True if any registers were listed.
+         *
+         **/
+        bool ListOwned(const uint256_t& hashGenesis, std::vector<uint256_t>& vRegisters);
+
+
+        /** WriteOwnerIndexed
+         *
+         *  Mark that the registers of a genesis from before the owner index have been added to it.
+         *
+         *  @param[in] hashGenesis The genesis-id of the owner.
+         *
+         *  @return True if write was successful, false otherwise.
+         *
+         **/
+        bool WriteOwnerIndexed(const uint256_t& hashGenesis);
+
+
+        /** HasOwnerIndexed
+         *
+         *  Check if the registers of a genesis from before the owner index have been added to it.
+         *
+         *  @param[in] hashGenesis The genesis-id of the owner.
+         *
+         *  @return True if the genesis has been indexed.
+         *
+         **/
+        bool HasOwnerIndexed(const uint256_t& hashGenesis);
+
+
         /** HasState
          *
          *  Determines if a state exists in the register database.
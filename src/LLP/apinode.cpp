@@ -23,6 +23,8 @@ ________________________________________________________________________________
 #include <Util/include/config.h>
 #include <Util/include/base64.h>
 
+#include <ostream>
+
 namespace LLP
 {
 
@@ -30,12 +32,20 @@ namespace LLP
     /** Default Constructor **/
     APINode::APINode()
     : HTTPNode()
+    , jsonStream   ( )
+    , nStreamIndex (0)
+    , strStreamEnd ( )
+    , fStreaming   (false)
     {
     }
 
     /** Constructor **/
     APINode::APINode(const LLP::Socket &SOCKET_IN, LLP::DDOS_Filter* DDOS_IN, bool fDDOSIn)
     : HTTPNode(SOCKET_IN, DDOS_IN, fDDOSIn)
+    , jsonStream   ( )
+    , nStreamIndex (0)
+    , strStreamEnd ( )
+    , fStreaming   (false)
     {
     }
 
@@ -43,6 +53,10 @@ namespace LLP
     /** Constructor **/
     APINode::APINode(LLP::DDOS_Filter* DDOS_IN, bool fDDOSIn)
     : HTTPNode(DDOS_IN, fDDOSIn)
+    , jsonStream   ( )
+    , nStreamIndex (0)
+    , strStreamEnd ( )
+    , fStreaming   (false)
     {
     }
 
@@ -68,12 +82,25 @@ namespace LLP
 
             return;
         }
+
+        /* Carry on streaming once the socket has drained. */
+        if(EVENT == EVENTS::WRITABLE)
+        {
+            /* The client can't tell a response was cut short, so drop the connection if it failed. */
+            if(fStreaming && !Draining() && !stream())
+                Disconnect();
+
+            return;
+        }
     }
 
 
     /** Main message handler once a packet is recieved. **/
     bool APINode::ProcessPacket()
     {
+        /* Responses are sent in order, so a request can't be taken while one is streamed. */
+        if(fStreaming)
+            return debug::error(FUNCTION, "API request from ", this->addr.ToString(), " before the streamed response was sent");
 
         if(!Authorized(INCOMING.mapHeaders))
         {
@@ -273,6 +300,53 @@ namespace LLP
             fKeepAlive = true;
         }
 
+        /* Stream large lists in chunks, so they are serialized as the socket drains rather than dumped in one piece. */
+        bool fStream = false;
+        if(INCOMING.strVersion == "HTTP/1.1" && ret.count("result"))
+        {
+            /* Lists given a cursor are in the results of an object. */
+            const json::json& jsonResult = ret.at("result");
+            const json::json& jsonList   = (jsonResult.is_object() && jsonResult.count("results")) ? jsonResult.at("results") : jsonResult;
+
+            fStream = (jsonList.is_array() && jsonList.size() >= STREAM_THRESHOLD);
+        }
+
+        if(fStream)
+        {
+            RESPONSE.mapHeaders["Transfer-Encoding"] = "chunked";
+            RESPONSE.mapHeaders["Content-Type"]      = "application/json";
+
+            /* Write the header. */
+            this->WritePacket(RESPONSE);
+
+            /* Split the response around the list, which is written an element at a time. */
+            json::json& jsonResult = ret.at("result");
+            std::string strBegin = "{\"result\":[";
+            if(jsonResult.is_array())
+            {
+                jsonStream   = std::move(jsonResult);
+                strStreamEnd = "]}";
+            }
+            else
+            {
+                jsonStream = std::move(jsonResult.at("results"));
+                jsonResult.erase("results");
+
+                /* The other fields follow the list. */
+                const std::string strFields = jsonResult.dump();
+                strBegin     = "{\"result\":{\"results\":[";
+                strStreamEnd = "]" + (jsonResult.empty() ? std::string("") : "," + strFields.substr(1, strFields.size() - 2)) + "}}";
+            }
+
+            /* Write the start of the response, then the list as the socket drains. */
+            nStreamIndex = 0;
+            fStreaming   = true;
+            if(!WriteChunk(strBegin.data(), strBegin.size()) || !stream())
+                return false;
+
+            return fKeepAlive;
+        }
+
         /* Add content. */
         RESPONSE.strContent = ret.dump();
             
@@ -283,6 +357,48 @@ namespace LLP
     }
 
 
+    /* Write the elements of the list being streamed until the socket has enough to send. */
+    bool APINode::stream()
+    {
+        ChunkedBuffer buffer(this);
+        std::ostream ssContent(&buffer);
+
+        /* Chunks are written every CHUNK_SIZE bytes, which is when the socket can fill up. */
+        while(nStreamIndex < jsonStream.size() && !Draining())
+        {
+            if(nStreamIndex > 0)
+                ssContent << ',';
+
+            ssContent << jsonStream[nStreamIndex++];
+        }
+
+        /* End the response after the last element. */
+        bool fSuccess = true;
+        if(nStreamIndex == jsonStream.size())
+        {
+            ssContent << strStreamEnd;
+            fSuccess = buffer.Close();
+
+            fStreaming = false;
+        }
+
+        /* Otherwise write what is left of the last chunk, so it isn't held until the next event. */
+        else if(buffer.pubsync() != 0)
+            fSuccess = false;
+
+        /* The client can't tell a response was cut short, so the rest is dropped with the connection. */
+        if(!fSuccess || !fStreaming)
+        {
+            fStreaming = false;
+
+            jsonStream = json::json();
+            strStreamEnd.clear();
+        }
+
+        return fSuccess;
+    }
+
+
     bool APINode::Authorized(std::map<std::string, std::string>& mapHeaders)
     {
         /* Check for apiauth settings. */
@@ -321,7 +437,7 @@ namespace LLP
 
         /* list of keywords that are acceptale parameters for a /list/xxx method.  Parameters not in this list will be converted
            into a `where` array */
-        std::vector<std::string> vKeywords = {"genesis", "username", "verbose", "page", "limit", "sort", "order", "where"};
+        std::vector<std::string> vKeywords = {"genesis", "username", "verbose", "page", "limit", "sort", "order", "where", "cursor"};
 
         /* Parse out the form entries by char '&' */
         std::vector<std::string> vParams;
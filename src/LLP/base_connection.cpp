@@ -191,8 +191,16 @@ namespace LLP
     template <class PacketType>
     void BaseConnection<PacketType>::WritePacket(const PacketType& PACKET)
     {
-        /* Get the bytes of the packet. */
-        const std::vector<uint8_t> vBytes = PACKET.GetBytes();
+        /* Encode the packet into a buffer of its own. */
+        WritePacket(std::make_shared<const std::vector<uint8_t>>(PACKET.GetBytes()));
+    }
+
+
+    /*  Write a packet that was already encoded to the TCP stream. */
+    template <class PacketType>
+    void BaseConnection<PacketType>::WritePacket(const SharedBuffer& pBuffer)
+    {
+        const std::vector<uint8_t>& vBytes = *pBuffer;
 
         /* Stop sending packets if send buffer is full. */
         uint64_t nMaxSendBuffer = config::GetArg("-maxsendbuffer", MAX_SEND_BUFFER);
@@ -207,7 +215,7 @@ namespace LLP
                 PrintHex(vBytes);
 
             /* Write the packet to socket buffer. */
-            Write(vBytes, vBytes.size());
+            Write(pBuffer);
 
             /* Update packet count. */
             ++PACKETS;
@@ -23,17 +23,45 @@ ________________________________________________________________________________
 #include <LLP/types/miner.h>
 #include <LLP/types/p2p.h>
 
+#include <LLP/include/timer_wheel.h>
+
 #include <Util/include/hex.h>
 
+#include <algorithm>
+#include <map>
+#include <limits>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
 
 namespace LLP
 {
 
+    /* The most packets read from one connection before moving on to the next ready connection. */
+    const uint32_t MAX_READY_PACKETS = 64;
+
+
+    /* The most times a connection is flushed before moving on to the next connection. */
+    const uint32_t MAX_FLUSH_WRITES = 64;
+
+
+    /* The milliseconds covered by each slot of the timer wheel. */
+    const uint32_t TIMER_RESOLUTION = 50;
+
+
+    /* The epoll event data of the wakeup descriptor. */
+    const uint64_t WAKEUP_EVENT = std::numeric_limits<uint64_t>::max();
+
+
     /** Default Constructor **/
     template <class ProtocolType>
     DataThread<ProtocolType>::DataThread(uint32_t nID, bool ffDDOSIn,
                                          uint32_t rScore, uint32_t cScore,
-                                         uint32_t nTimeout, bool fMeter)
+                                         uint32_t nTimeout, bool fMeter, uint32_t nGenericInterval)
     : SLOT_MUTEX      ( )
     , fDDOS           (ffDDOSIn)
     , fMETER          (fMeter)
@@ -46,6 +74,18 @@ namespace LLP
     , DDOS_cSCORE     (cScore)
     , CONNECTIONS     (memory::atomic_ptr< std::vector<memory::atomic_ptr<ProtocolType>> >(new std::vector<memory::atomic_ptr<ProtocolType>>()))
     , RELAY           (memory::atomic_ptr< std::queue<std::pair<typename ProtocolType::message_t, DataStream>> >(new std::queue<std::pair<typename ProtocolType::message_t, DataStream>>()))
+    , GENERIC_INTERVAL(std::max(nGenericInterval, TIMER_RESOLUTION))
+#ifdef __linux__
+    , fEPOLL          (config::GetBoolArg("-llpepoll", true))
+#else
+    , fEPOLL          (false)
+#endif
+    , nEpoll          (-1)
+    , nWakeup         (-1)
+    , vPending        ( )
+    , setFlush        ( )
+    , setWritable     ( )
+    , FLUSH_MUTEX     ( )
     , CONDITION       ( )
     , DATA_THREAD     (std::bind(&DataThread::Thread, this))
     , FLUSH_CONDITION ( )
@@ -60,6 +100,7 @@ namespace LLP
     {
         fDestruct = true;
         CONDITION.notify_all();
+        wake();
         if(DATA_THREAD.joinable())
             DATA_THREAD.join();
 
@@ -95,6 +136,177 @@ namespace LLP
      *  LLP Messaging Thread. */
     template <class ProtocolType>
     void DataThread<ProtocolType>::Thread()
+    {
+        /* Use the event loop when epoll is available. */
+        if(fEPOLL)
+            event_loop();
+        else
+            poll_loop();
+    }
+
+
+    /*  Thread to handle flushing write buffers. */
+    template <class ProtocolType>
+    void DataThread<ProtocolType>::Flush()
+    {
+        /* The mutex for the condition. */
+        std::mutex CONDITION_MUTEX;
+
+        /* The main connection handler loop. */
+        while(!fDestruct.load() && !config::fShutdown.load())
+        {
+            /* Keep data threads waiting for work.
+             * Will wait until have one or more connections, DataThread is disposed, or system shutdown
+             * While loop catches potential for spurious wakeups. Also has the effect of skipping the wait() call after connections established.
+             */
+            std::unique_lock<std::mutex> CONDITION_LOCK(CONDITION_MUTEX);
+            FLUSH_CONDITION.wait(CONDITION_LOCK,
+                [this]{
+
+                    /* Break on shutdown or destructor. */
+                    if(fDestruct.load() || config::fShutdown.load())
+                        return true;
+
+                    /* Check for data in the queue. */
+                    if(!RELAY->empty())
+                        return true;
+
+                    /* The event loop tells us which connections to flush. */
+                    if(fEPOLL)
+                    {
+                        LOCK(FLUSH_MUTEX);
+                        return !setFlush.empty();
+                    }
+
+                    /* Check for buffered connection. */
+                    for(uint32_t nIndex = 0; nIndex < CONNECTIONS->size(); ++nIndex)
+                    {
+                        try
+                        {
+                            /* Check for buffered connection. */
+                            if(CONNECTIONS->at(nIndex)->Buffered())
+                                return true;
+                        }
+                        catch(const std::exception& e) { }
+                    }
+
+                    return false;
+                });
+
+            /* Check for close. */
+            if(fDestruct.load() || config::fShutdown.load())
+                return;
+
+            /* Pair to store the relay from the queue. */
+            std::pair<typename ProtocolType::message_t, DataStream> qRelay =
+                std::make_pair(typename ProtocolType::message_t(), DataStream(SER_NETWORK, MIN_PROTO_VERSION));
+
+            /* Grab data from queue. */
+            bool fRelay = false;
+            if(!RELAY->empty())
+            {
+                /* Make a copy of the relay data. */
+                qRelay = RELAY->front();
+                RELAY->pop();
+
+                fRelay = true;
+            }
+
+            /* The packets encoded for this relay, by the payload left after each connection's filter. */
+            std::map<std::vector<uint8_t>, SharedBuffer> mapEncoded;
+
+            /* Check all connections for data and packets. */
+            uint32_t nSize = CONNECTIONS->size();
+            for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
+            {
+                /* The event loop only needs a pass over every connection to relay. */
+                if(fEPOLL && !fRelay)
+                    break;
+
+                try
+                {
+                    /* Reset stream read position. */
+                    qRelay.second.Reset();
+
+                    /* Get atomic pointer to reduce locking around CONNECTIONS scope. */
+                    memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS->at(nIndex);
+
+                    /* Relay if there are active subscriptions. */
+                    const DataStream ssRelay = CONNECTION->RelayFilter(qRelay.first, qRelay.second);
+                    if(ssRelay.size() != 0)
+                    {
+                        /* Encode the packet once for all the connections with the same filtered payload. */
+                        SharedBuffer& pBuffer = mapEncoded[ssRelay.Bytes()];
+                        if(!pBuffer)
+                        {
+                            /* Build the sender packet. */
+                            typename ProtocolType::packet_t PACKET = typename ProtocolType::packet_t(qRelay.first);
+                            PACKET.SetData(ssRelay);
+
+                            pBuffer = std::make_shared<const std::vector<uint8_t>>(PACKET.GetBytes());
+                        }
+
+                        /* Queue the shared packet on the socket. */
+                        CONNECTION->WritePacket(pBuffer);
+                    }
+
+                    /* Data left buffered by a full socket is flushed once epoll signals it is writable. */
+                    if(fEPOLL)
+                        continue;
+
+                    /* Attempt to flush data when buffer is available. */
+                    if(CONNECTION->Buffered() && CONNECTION->Flush() < 0)
+                        runtime::sleep(std::min(5u, CONNECTION->nConsecutiveErrors.load() / 1000)); //we want to sleep when we have periodic failures
+                }
+                catch(const std::exception& e) { }
+            }
+
+            /* Flush the connections the event loop found writable. */
+            if(fEPOLL)
+            {
+                std::set<uint32_t> setReady;
+                {
+                    LOCK(FLUSH_MUTEX);
+                    setReady.swap(setFlush);
+                }
+
+                for(const uint32_t nIndex : setReady)
+                {
+                    try
+                    {
+                        memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS->at(nIndex);
+
+                        /* Flush until the socket would block, a bounded number of times to be fair to the others. */
+                        int32_t nSent = 0;
+                        for(uint32_t nWrites = 0; nWrites < MAX_FLUSH_WRITES && CONNECTION->Buffered(); ++nWrites)
+                        {
+                            nSent = CONNECTION->Flush();
+                            if(nSent <= 0)
+                                break;
+                        }
+
+                        /* Come back to connections that still have data for a socket that isn't full. */
+                        LOCK(FLUSH_MUTEX);
+                        if(nSent > 0 && CONNECTION->Buffered())
+                            setFlush.insert(nIndex);
+
+                        /* Tell the event loop the connection can write more. */
+                        setWritable.insert(nIndex);
+                    }
+                    catch(const std::exception& e) { }
+                }
+
+                /* Wake the event loop for the writable events. */
+                if(!setReady.empty())
+                    wake();
+            }
+        }
+    }
+
+
+    /*  Poll every connection on each pass, checking timeouts and reading packets. */
+    template <class ProtocolType>
+    void DataThread<ProtocolType>::poll_loop()
     {
         /* Cache sleep time if applicable. */
         uint32_t nSleep = config::GetArg("-llpsleep", 0);
@@ -208,197 +420,457 @@ namespace LLP
                         continue;
                     }
 
-                    /* Remove Connection if it has Timed out or had any read/write Errors. */
-                    if(CONNECTION->Errors())
+                    /* Disconnect if pollin signaled with no data (This happens on Linux). */
+                    if((POLLFDS.at(nIndex).revents & POLLIN)
+                    && CONNECTION->Available() == 0 && !CONNECTION->IsSSL())
                     {
-                        disconnect_remove_event(nIndex, DISCONNECT::ERRORS);
+                        disconnect_remove_event(nIndex, DISCONNECT::POLL_EMPTY);
                         continue;
                     }
 
                     /* Remove Connection if it has Timed out or had any Errors. */
-                    if(CONNECTION->Timeout(TIMEOUT * 1000, Socket::READ))
+                    if(!check(nIndex, CONNECTION))
+                        continue;
+
+                    /* Generic event for Connection. */
+                    CONNECTION->Event(EVENTS::GENERIC);
+
+                    /* The flush thread drains every connection, so any of them can write more. */
+                    CONNECTION->Event(EVENTS::WRITABLE);
+
+                    /* Work on Reading a Packet. **/
+                    CONNECTION->ReadPacket();
+
+                    /* If a Packet was received successfully, increment request count [and DDOS count if enabled]. */
+                    if(CONNECTION->PacketComplete())
+                        process(nIndex, CONNECTION);
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "Data Connection: ", e.what());
+                    disconnect_remove_event(nIndex, DISCONNECT::ERRORS);
+                }
+            }
+        }
+    }
+
+
+    /*  Wait on epoll for ready connections only, reading each until its socket is drained. */
+    template <class ProtocolType>
+    void DataThread<ProtocolType>::event_loop()
+    {
+    #ifdef __linux__
+        /* Create the epoll descriptor and the event descriptor to wake it with. */
+        nEpoll.store(epoll_create1(EPOLL_CLOEXEC));
+        nWakeup.store(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+        if(nEpoll.load() < 0 || nWakeup.load() < 0)
+        {
+            debug::error(FUNCTION, ProtocolType::Name(), " failed to create epoll descriptor: ", strerror(errno));
+            return;
+        }
+
+        epoll_event evWakeup;
+        evWakeup.events   = EPOLLIN;
+        evWakeup.data.u64 = WAKEUP_EVENT;
+        epoll_ctl(nEpoll.load(), EPOLL_CTL_ADD, nWakeup.load(), &evWakeup);
+
+        /* The timer of each connection checks its timeouts and fires its generic event. */
+        TimerWheel WHEEL(1024, TIMER_RESOLUTION, runtime::timestamp(true));
+
+        /* Slots are reused, so events and timers carry the sequence of the connection they were for. */
+        std::vector<uint32_t> vSequence;
+
+        /* Connections that had more packets than they could read in one turn, with no events of their own. */
+        std::vector< std::pair<uint64_t, uint32_t> > vReady;
+
+        /* The events returned by epoll. */
+        std::vector<epoll_event> vEvents(256);
+
+        /* The main connection handler loop. */
+        while(!fDestruct.load() && !config::fShutdown.load())
+        {
+            /* Register the connections added since the last pass. */
+            std::vector<uint32_t> vAdded;
+            {
+                LOCK(SLOT_MUTEX);
+                vAdded.swap(vPending);
+            }
+
+            const uint64_t nNow = runtime::timestamp(true);
+            for(const uint32_t nSlot : vAdded)
+            {
+                try
+                {
+                    ProtocolType* CONNECTION = CONNECTIONS->at(nSlot).load();
+                    if(!CONNECTION)
+                        continue;
+
+                    if(vSequence.size() <= nSlot)
+                        vSequence.resize(nSlot + 1, 0);
+
+                    const uint64_t nEvent = (uint64_t(nSlot) << 32) | ++vSequence[nSlot];
+
+                    /* Edge triggered, so we are only woken when new data arrives or the send buffer drains. */
+                    epoll_event evConnection;
+                    evConnection.events   = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+                    evConnection.data.u64 = nEvent;
+
+                    /* A slot queued twice is still registered, so update it. */
+                    if(epoll_ctl(nEpoll.load(), EPOLL_CTL_ADD, CONNECTION->fd, &evConnection) < 0
+                    && (errno != EEXIST || epoll_ctl(nEpoll.load(), EPOLL_CTL_MOD, CONNECTION->fd, &evConnection) < 0))
                     {
-                        disconnect_remove_event(nIndex, DISCONNECT::TIMEOUT);
+                        debug::error(FUNCTION, ProtocolType::Name(), " failed to register connection: ", strerror(errno));
+                        disconnect_remove_event(nSlot, DISCONNECT::POLL_ERROR);
+
                         continue;
                     }
 
-                    /* Disconnect if pollin signaled with no data (This happens on Linux). */
-                    if((POLLFDS.at(nIndex).revents & POLLIN)
-                    && CONNECTION->Available() == 0 && !CONNECTION->IsSSL())
+                    WHEEL.Schedule(nEvent, nNow + GENERIC_INTERVAL);
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "Data Connection: ", e.what());
+                }
+            }
+
+            /* Don't wait if connections are still waiting to be read, otherwise wake for the next timer tick. */
+            const int32_t nTimeout = vReady.empty() ? (WHEEL.Size() > 0 ? WHEEL.Resolution() : 1000) : 0;
+            const int32_t nEvents  = epoll_wait(nEpoll.load(), &vEvents[0], vEvents.size(), nTimeout);
+            if(nEvents < 0 && errno != EINTR)
+            {
+                debug::error(FUNCTION, ProtocolType::Name(), " epoll_wait failed: ", strerror(errno));
+                runtime::sleep(1);
+
+                continue;
+            }
+
+            /* Check for close. */
+            if(fDestruct.load() || config::fShutdown.load())
+                break;
+
+            /* Gather the connections to read, starting with those left over from the last pass. */
+            std::vector< std::pair<uint64_t, uint32_t> > vRead;
+            vRead.swap(vReady);
+
+            for(int32_t nEvent = 0; nEvent < nEvents; ++nEvent)
+            {
+                const epoll_event& evReady = vEvents[nEvent];
+
+                /* Clear the wakeup descriptor. */
+                if(evReady.data.u64 == WAKEUP_EVENT)
+                {
+                    uint64_t nCount = 0;
+                    if(read(nWakeup.load(), &nCount, sizeof(nCount)) < 0)
+                        nCount = 0;
+
+                    continue;
+                }
+
+                /* Skip events for connections that have since left the slot. */
+                const uint32_t nSlot = static_cast<uint32_t>(evReady.data.u64 >> 32);
+                if(nSlot >= vSequence.size() || vSequence[nSlot] != static_cast<uint32_t>(evReady.data.u64))
+                    continue;
+
+                try
+                {
+                    ProtocolType* CONNECTION = CONNECTIONS->at(nSlot).load();
+                    if(!CONNECTION || !CONNECTION->Connected())
+                        continue;
+
+                    /* Disconnect if there was a polling error */
+                    if(evReady.events & EPOLLERR)
                     {
-                        disconnect_remove_event(nIndex, DISCONNECT::POLL_EMPTY);
+                        disconnect_remove_event(nSlot, DISCONNECT::POLL_ERROR);
                         continue;
                     }
 
-                    /* Disconnect if buffer is full and remote host isn't reading at all. */
-                    if(CONNECTION->Buffered()
-                    && CONNECTION->Timeout(15000, Socket::WRITE))
+                    /* Disconnect if the socket was disconnected by peer. */
+                    if(evReady.events & EPOLLHUP)
                     {
-                        disconnect_remove_event(nIndex, DISCONNECT::TIMEOUT_WRITE);
+                        disconnect_remove_event(nSlot, DISCONNECT::PEER);
                         continue;
                     }
 
-                    /* Check that write buffers aren't overflowed. */
-                    if(CONNECTION->Buffered() > config::GetArg("-maxsendbuffer", MAX_SEND_BUFFER))
+                    /* Hand buffered data to the flush thread once the socket can take it. */
+                    if((evReady.events & EPOLLOUT) && CONNECTION->Buffered())
                     {
-                        disconnect_remove_event(nIndex, DISCONNECT::BUFFER);
-                        continue;
+                        {
+                            LOCK(FLUSH_MUTEX);
+                            setFlush.insert(nSlot);
+                        }
+
+                        FLUSH_CONDITION.notify_all();
                     }
 
-                    /* Handle any DDOS Filters. */
-                    if(fDDOS && CONNECTION->DDOS)
+                    /* Read the connections with data, or that the peer has closed. */
+                    if(evReady.events & (EPOLLIN | EPOLLRDHUP))
+                        vRead.push_back(std::make_pair(evReady.data.u64, evReady.events));
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "Data Connection: ", e.what());
+                    disconnect_remove_event(nSlot, DISCONNECT::ERRORS);
+                }
+            }
+
+            /* Read the ready connections until their sockets are drained. */
+            for(const auto& pairRead : vRead)
+            {
+                const uint64_t nEvent  = pairRead.first;
+                const uint32_t nEvents = pairRead.second;
+
+                const uint32_t nSlot = static_cast<uint32_t>(nEvent >> 32);
+                if(vSequence[nSlot] != static_cast<uint32_t>(nEvent))
+                    continue;
+
+                try
+                {
+                    ProtocolType* CONNECTION = CONNECTIONS->at(nSlot).load();
+                    if(!CONNECTION || !CONNECTION->Connected())
+                        continue;
+
+                    /* Remove Connection if it had any Errors. */
+                    if(!check(nSlot, CONNECTION))
+                        continue;
+
+                    /* Epoll is edge triggered, so keep reading until no more data arrives. An edge can be
+                     * signalled for data a previous pass already read, so no data isn't a closed socket here. */
+                    bool fActive = true;
+                    for(uint32_t nPackets = 0; fActive; )
                     {
-                        /* Ban a node if it has too many Requests per Second. **/
-                        if(CONNECTION->DDOS->rSCORE.Score() > DDOS_rSCORE
-                        || CONNECTION->DDOS->cSCORE.Score() > DDOS_cSCORE)
-                            CONNECTION->DDOS->Ban();
+                        const uint32_t nAvailable = CONNECTION->Available();
+                        if(nAvailable == 0)
+                        {
+                            /* Disconnect once everything the peer sent before closing has been read. */
+                            if(nEvents & EPOLLRDHUP)
+                                disconnect_remove_event(nSlot, DISCONNECT::PEER);
+
+                            break;
+                        }
+
+                        /* Give the other ready connections a turn. */
+                        if(nPackets == MAX_READY_PACKETS)
+                        {
+                            vReady.push_back(std::make_pair(nEvent, 0));
+                            break;
+                        }
+
+                        /* Work on Reading a Packet. **/
+                        CONNECTION->ReadPacket();
 
-                        /* Remove a connection if it was banned by DDOS Protection. */
-                        if(CONNECTION->DDOS->Banned())
+                        /* If a Packet was received successfully, increment request count [and DDOS count if enabled]. */
+                        if(CONNECTION->PacketComplete())
                         {
-                            debug::log(0, ProtocolType::Name(), " BANNED: ", CONNECTION->GetAddress().ToString());
-                            disconnect_remove_event(nIndex, DISCONNECT::DDOS);
+                            fActive = process(nSlot, CONNECTION);
+                            ++nPackets;
+
                             continue;
                         }
+
+                        /* Wait for the rest of a packet that has only partly arrived. */
+                        if(CONNECTION->Available() == nAvailable)
+                            break;
                     }
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "Data Connection: ", e.what());
+                    disconnect_remove_event(nSlot, DISCONNECT::ERRORS);
+                }
+            }
 
-                    /* Generic event for Connection. */
-                    CONNECTION->Event(EVENTS::GENERIC);
+            /* Fire the writable events of the connections the flush thread has sent data for. */
+            std::set<uint32_t> setFlushed;
+            {
+                LOCK(FLUSH_MUTEX);
+                setFlushed.swap(setWritable);
+            }
 
-                    /* Work on Reading a Packet. **/
-                    CONNECTION->ReadPacket();
+            for(const uint32_t nSlot : setFlushed)
+            {
+                try
+                {
+                    ProtocolType* CONNECTION = CONNECTIONS->at(nSlot).load();
+                    if(!CONNECTION || !CONNECTION->Connected())
+                        continue;
 
-                    /* If a Packet was received successfully, increment request count [and DDOS count if enabled]. */
-                    if(CONNECTION->PacketComplete())
-                    {
-                        /* Debug dump of message type. */
-                        if(config::nVerbose.load() >= 4)
-                            debug::log(4, FUNCTION, "Received Message (", CONNECTION->INCOMING.GetBytes().size(), " bytes)");
+                    CONNECTION->Event(EVENTS::WRITABLE);
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "Data Connection: ", e.what());
+                    disconnect_remove_event(nSlot, DISCONNECT::ERRORS);
+                }
+            }
+
+            /* Check the timeouts and fire the generic events of connections whose timers expired. */
+            std::vector<uint64_t> vExpired;
+            WHEEL.Expire(runtime::timestamp(true), vExpired);
+
+            for(const uint64_t nEvent : vExpired)
+            {
+                const uint32_t nSlot = static_cast<uint32_t>(nEvent >> 32);
+                if(nSlot >= vSequence.size() || vSequence[nSlot] != static_cast<uint32_t>(nEvent))
+                    continue;
 
-                        /* Debug dump of packet data. */
-                        if(config::nVerbose.load() >= 5)
-                            PrintHex(CONNECTION->INCOMING.GetBytes());
+                try
+                {
+                    ProtocolType* CONNECTION = CONNECTIONS->at(nSlot).load();
+                    if(!CONNECTION || !CONNECTION->Connected())
+                        continue;
 
-                        /* Handle Meters and DDOS. */
-                        if(fMETER)
-                            ++ProtocolType::REQUESTS;
+                    /* Remove Connection if it has Timed out or had any Errors. */
+                    if(!check(nSlot, CONNECTION))
+                        continue;
 
-                        /* Increment rScore. */
-                        if(fDDOS && CONNECTION->DDOS)
-                            CONNECTION->DDOS->rSCORE += 1;
+                    /* Generic event for Connection. */
+                    CONNECTION->Event(EVENTS::GENERIC);
 
-                        /* Packet Process return value of False will flag Data Thread to Disconnect. */
-                        if(!CONNECTION->ProcessPacket())
+                    /* Catch buffered data a missed edge would otherwise leave waiting. */
+                    if(CONNECTION->Buffered())
+                    {
                         {
-                            disconnect_remove_event(nIndex, DISCONNECT::FORCE);
-                            continue;
+                            LOCK(FLUSH_MUTEX);
+                            setFlush.insert(nSlot);
                         }
 
-                        /* Run procssed event for connection triggers. */
-                        CONNECTION->Event(EVENTS::PROCESSED);
-                        CONNECTION->ResetPacket();
+                        FLUSH_CONDITION.notify_all();
                     }
+
+                    WHEEL.Schedule(nEvent, runtime::timestamp(true) + GENERIC_INTERVAL);
                 }
                 catch(const std::exception& e)
                 {
                     debug::error(FUNCTION, "Data Connection: ", e.what());
-                    disconnect_remove_event(nIndex, DISCONNECT::ERRORS);
+                    disconnect_remove_event(nSlot, DISCONNECT::ERRORS);
                 }
             }
         }
+
+        /* Close the descriptors. */
+        const int32_t nWakeupFd = nWakeup.exchange(-1);
+        const int32_t nEpollFd  = nEpoll.exchange(-1);
+
+        close(nWakeupFd);
+        close(nEpollFd);
+    #endif
     }
 
 
-    /*  Thread that handles all the Reading / Writing of Data from Sockets.
-     *  Creates a Packet QUEUE on this connection to be processed by an
-     *  LLP Messaging Thread. */
+    /*  Queue a new connection to be registered by the event loop. */
     template <class ProtocolType>
-    void DataThread<ProtocolType>::Flush()
+    void DataThread<ProtocolType>::activate(const uint32_t nSlot)
     {
-        /* The mutex for the condition. */
-        std::mutex CONDITION_MUTEX;
+        if(!fEPOLL)
+            return;
 
-        /* The main connection handler loop. */
-        while(!fDestruct.load() && !config::fShutdown.load())
-        {
-            /* Keep data threads waiting for work.
-             * Will wait until have one or more connections, DataThread is disposed, or system shutdown
-             * While loop catches potential for spurious wakeups. Also has the effect of skipping the wait() call after connections established.
-             */
-            std::unique_lock<std::mutex> CONDITION_LOCK(CONDITION_MUTEX);
-            FLUSH_CONDITION.wait(CONDITION_LOCK,
-                [this]{
+        vPending.push_back(nSlot);
+        wake();
+    }
 
-                    /* Break on shutdown or destructor. */
-                    if(fDestruct.load() || config::fShutdown.load())
-                        return true;
 
-                    /* Check for data in the queue. */
-                    if(!RELAY->empty())
-                        return true;
+    /*  Wake the event loop from waiting on epoll. */
+    template <class ProtocolType>
+    void DataThread<ProtocolType>::wake()
+    {
+    #ifdef __linux__
+        const int32_t nWakeupFd = nWakeup.load();
+        if(nWakeupFd < 0)
+            return;
+
+        const uint64_t nCount = 1;
+        if(write(nWakeupFd, &nCount, sizeof(nCount)) < 0)
+            debug::log(3, FUNCTION, "failed to wake event loop: ", strerror(errno));
+    #endif
+    }
 
-                    /* Check for buffered connection. */
-                    for(uint32_t nIndex = 0; nIndex < CONNECTIONS->size(); ++nIndex)
-                    {
-                        try
-                        {
-                            /* Check for buffered connection. */
-                            if(CONNECTIONS->at(nIndex)->Buffered())
-                                return true;
-                        }
-                        catch(const std::exception& e) { }
-                    }
 
-                    return false;
-                });
+    /*  Check a connection for errors, timeouts, full buffers and DDOS, disconnecting it if any fail. */
+    template <class ProtocolType>
+    bool DataThread<ProtocolType>::check(const uint32_t nIndex, ProtocolType* CONNECTION)
+    {
+        /* Remove Connection if it has Timed out or had any read/write Errors. */
+        if(CONNECTION->Errors())
+        {
+            disconnect_remove_event(nIndex, DISCONNECT::ERRORS);
+            return false;
+        }
 
-            /* Check for close. */
-            if(fDestruct.load() || config::fShutdown.load())
-                return;
+        /* Remove Connection if it has Timed out or had any Errors. */
+        if(CONNECTION->Timeout(TIMEOUT * 1000, Socket::READ))
+        {
+            disconnect_remove_event(nIndex, DISCONNECT::TIMEOUT);
+            return false;
+        }
 
-            /* Pair to store the relay from the queue. */
-            std::pair<typename ProtocolType::message_t, DataStream> qRelay =
-                std::make_pair(typename ProtocolType::message_t(), DataStream(SER_NETWORK, MIN_PROTO_VERSION));
+        /* Disconnect if buffer is full and remote host isn't reading at all. */
+        if(CONNECTION->Buffered()
+        && CONNECTION->Timeout(15000, Socket::WRITE))
+        {
+            disconnect_remove_event(nIndex, DISCONNECT::TIMEOUT_WRITE);
+            return false;
+        }
 
-            /* Grab data from queue. */
-            if(!RELAY->empty())
+        /* Check that write buffers aren't overflowed. */
+        if(CONNECTION->Buffered() > config::GetArg("-maxsendbuffer", MAX_SEND_BUFFER))
+        {
+            disconnect_remove_event(nIndex, DISCONNECT::BUFFER);
+            return false;
+        }
+
+        /* Handle any DDOS Filters. */
+        if(fDDOS && CONNECTION->DDOS)
+        {
+            /* Ban a node if it has too many Requests per Second. **/
+            if(CONNECTION->DDOS->rSCORE.Score() > DDOS_rSCORE
+            || CONNECTION->DDOS->cSCORE.Score() > DDOS_cSCORE)
+                CONNECTION->DDOS->Ban();
+
+            /* Remove a connection if it was banned by DDOS Protection. */
+            if(CONNECTION->DDOS->Banned())
             {
-                /* Make a copy of the relay data. */
-                qRelay = RELAY->front();
-                RELAY->pop();
+                debug::log(0, ProtocolType::Name(), " BANNED: ", CONNECTION->GetAddress().ToString());
+                disconnect_remove_event(nIndex, DISCONNECT::DDOS);
+                return false;
             }
+        }
 
-            /* Check all connections for data and packets. */
-            uint32_t nSize = CONNECTIONS->size();
-            for(uint32_t nIndex = 0; nIndex < nSize; ++nIndex)
-            {
-                try
-                {
-                    /* Reset stream read position. */
-                    qRelay.second.Reset();
+        return true;
+    }
 
-                    /* Get atomic pointer to reduce locking around CONNECTIONS scope. */
-                    memory::atomic_ptr<ProtocolType>& CONNECTION = CONNECTIONS->at(nIndex);
 
-                    /* Relay if there are active subscriptions. */
-                    const DataStream ssRelay = CONNECTION->RelayFilter(qRelay.first, qRelay.second);
-                    if(ssRelay.size() != 0)
-                    {
-                        /* Build the sender packet. */
-                        typename ProtocolType::packet_t PACKET = typename ProtocolType::packet_t(qRelay.first);
-                        PACKET.SetData(ssRelay);
+    /*  Process a complete packet on a connection. */
+    template <class ProtocolType>
+    bool DataThread<ProtocolType>::process(const uint32_t nIndex, ProtocolType* CONNECTION)
+    {
+        /* Debug dump of message type. */
+        if(config::nVerbose.load() >= 4)
+            debug::log(4, FUNCTION, "Received Message (", CONNECTION->INCOMING.GetBytes().size(), " bytes)");
 
-                        /* Write packet to socket. */
-                        CONNECTION->WritePacket(PACKET);
-                    }
+        /* Debug dump of packet data. */
+        if(config::nVerbose.load() >= 5)
+            PrintHex(CONNECTION->INCOMING.GetBytes());
 
-                    /* Attempt to flush data when buffer is available. */
-                    if(CONNECTION->Buffered() && CONNECTION->Flush() < 0)
-                        runtime::sleep(std::min(5u, CONNECTION->nConsecutiveErrors.load() / 1000)); //we want to sleep when we have periodic failures
-                }
-                catch(const std::exception& e) { }
-            }
+        /* Handle Meters and DDOS. */
+        if(fMETER)
+            ++ProtocolType::REQUESTS;
+
+        /* Increment rScore. */
+        if(fDDOS && CONNECTION->DDOS)
+            CONNECTION->DDOS->rSCORE += 1;
+
+        /* Packet Process return value of False will flag Data Thread to Disconnect. */
+        if(!CONNECTION->ProcessPacket())
+        {
+            disconnect_remove_event(nIndex, DISCONNECT::FORCE);
+            return false;
         }
+
+        /* Run procssed event for connection triggers. */
+        CONNECTION->Event(EVENTS::PROCESSED);
+        CONNECTION->ResetPacket();
+
+        return true;
     }
 
 
@@ -456,6 +928,13 @@ namespace LLP
         else
             --nOutbound;
 
+    #ifdef __linux__
+        /* Stop watching the socket before it is closed. */
+        const int32_t nEpollFd = nEpoll.load();
+        if(nEpollFd >= 0 && CONNECTIONS->at(nIndex)->fd != INVALID_SOCKET)
+            epoll_ctl(nEpollFd, EPOLL_CTL_DEL, CONNECTIONS->at(nIndex)->fd, nullptr);
+    #endif
+
         /* Free the memory. */
         CONNECTIONS->at(nIndex).free();
         CONDITION.notify_all();
@@ -126,6 +126,9 @@ namespace LLP
         /* The timeout value (default: 30 seconds). */
         config.nTimeout = static_cast<uint32_t>(config::GetArg(std::string("-miningtimeout"), 30));
 
+        /* Miners learn of new rounds on generic events, so check for them every 100ms. */
+        config.nGenericInterval = 100;
+
         /* The DDOS if enabled. */
         config.fDDOS = config::GetBoolArg(std::string("-miningddos"), false);
 
@@ -14,9 +14,11 @@ ________________________________________________________________________________
 #include <LLP/types/httpnode.h>
 #include <LLP/templates/ddos.h>
 
+#include <Util/include/args.h>
 #include <Util/include/string.h>
 
 #include <algorithm>
+#include <sstream>
 
 namespace LLP
 {
@@ -177,4 +179,103 @@ namespace LLP
         }
     }
 
+
+    /* Writes a chunk of a response sent with chunked transfer encoding. */
+    bool HTTPNode::WriteChunk(const char* pData, const uint32_t nSize)
+    {
+        /* Check the client is still there. */
+        if(!Connected())
+            return debug::error(FUNCTION, "connection closed with ", Buffered(), " bytes to send");
+
+        /* Encode the chunk with its size in hex. */
+        std::ostringstream ssSize;
+        ssSize << std::hex << nSize << "\r\n";
+
+        const std::string strSize = ssSize.str();
+
+        std::vector<uint8_t> vChunk;
+        vChunk.reserve(strSize.size() + nSize + 2);
+        vChunk.insert(vChunk.end(), strSize.begin(), strSize.end());
+        vChunk.insert(vChunk.end(), (uint8_t*)pData, (uint8_t*)pData + nSize);
+        vChunk.push_back('\r');
+        vChunk.push_back('\n');
+
+        this->WritePacket(std::make_shared<const std::vector<uint8_t>>(std::move(vChunk)));
+
+        return true;
+    }
+
+
+    /* Check if enough is buffered that more chunks should wait for the socket to drain. */
+    bool HTTPNode::Draining() const
+    {
+        /* Keep the buffered data well under the send buffer limit, so no chunk is dropped. */
+        const uint64_t nMaxBuffered = std::min(uint64_t(1024 * 1024), uint64_t(config::GetArg("-maxsendbuffer", MAX_SEND_BUFFER)) / 2);
+
+        return Buffered() > nMaxBuffered;
+    }
+
+
+    /* Constructor. */
+    ChunkedBuffer::ChunkedBuffer(HTTPNode* pNodeIn)
+    : std::streambuf ( )
+    , pNode          (pNodeIn)
+    , vBuffer        (CHUNK_SIZE)
+    , fFailed        (false)
+    {
+        setp(vBuffer.data(), vBuffer.data() + vBuffer.size());
+    }
+
+
+    /* Write the last chunk and end the response. */
+    bool ChunkedBuffer::Close()
+    {
+        if(!write())
+            return false;
+
+        return pNode->WriteChunk(nullptr, 0);
+    }
+
+
+    /* Write the full chunk and start the next one with a character. */
+    ChunkedBuffer::int_type ChunkedBuffer::overflow(int_type ch)
+    {
+        if(!write())
+            return traits_type::eof();
+
+        if(ch != traits_type::eof())
+        {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+
+        return traits_type::not_eof(ch);
+    }
+
+
+    /* Write the chunk being filled. */
+    int ChunkedBuffer::sync()
+    {
+        return write() ? 0 : -1;
+    }
+
+
+    /* Write the chunk being filled to the node. */
+    bool ChunkedBuffer::write()
+    {
+        if(fFailed)
+            return false;
+
+        /* Empty chunks would end the response. */
+        const uint32_t nSize = static_cast<uint32_t>(pptr() - pbase());
+        if(nSize > 0 && !pNode->WriteChunk(pbase(), nSize))
+        {
+            fFailed = true;
+            return false;
+        }
+
+        setp(vBuffer.data(), vBuffer.data() + vBuffer.size());
+
+        return true;
+    }
 }
@@ -66,6 +66,10 @@ namespace LLP
         uint32_t nTimeout;
 
 
+        /** The interval (in milliseconds) between generic events and timeout checks of each connection **/
+        uint32_t nGenericInterval;
+
+
         /** Indicates if meter statistics should be logged **/
         bool fMeter;
 
@@ -0,0 +1,371 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLP_INCLUDE_SYNC_SCHEDULER_H
+#define NEXUS_LLP_INCLUDE_SYNC_SCHEDULER_H
+
+#include <LLC/types/uint1024.h>
+
+#include <TAO/Ledger/types/block.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace LLP
+{
+
+    /** SyncScheduler
+     *
+     *  Schedules the initial synchronization of blocks across many peers. The headers of the best
+     *  chain are downloaded first from the sync node, and the heights they cover are split into
+     *  windows that are requested from several peers at once. Only the header that ends each window
+     *  is kept, and a window's blocks are checked against it by their links once all of them have
+     *  arrived. Blocks are then handed back strictly in height order, so they can be processed as if
+     *  they came from a single stream. Windows that stop making progress are given to another peer.
+     *
+     **/
+    class SyncScheduler
+    {
+        /** A range of heights requested from one peer. **/
+        struct Window
+        {
+            /** The height of the first block. **/
+            uint32_t nStart;
+
+
+            /** The session the window is requested from, 0 if unassigned. **/
+            uint64_t nSession;
+
+
+            /** The session the window was last taken away from, after stalling or sending blocks that don't link. **/
+            uint64_t nStalled;
+
+
+            /** The time in milliseconds of the request or the last block received. **/
+            uint64_t nLastProgress;
+
+
+            /** The total blocks received. **/
+            uint32_t nReceived;
+
+
+            /** The blocks received, by height from the start. **/
+            std::vector<std::unique_ptr<TAO::Ledger::Block>> vBlocks;
+
+
+            /** The hashes of the blocks received, by height from the start. **/
+            std::vector<uint1024_t> vHashes;
+        };
+
+
+        /** Throughput of one peer. **/
+        struct PeerStats
+        {
+            /** The total blocks received. **/
+            uint64_t nBlocks;
+
+
+            /** The total bytes received. **/
+            uint64_t nBytes;
+
+
+            /** The time in milliseconds of the first request. **/
+            uint64_t nFirst;
+
+
+            /** The time in milliseconds of the last block received. **/
+            uint64_t nLast;
+
+
+            /** The total windows completed. **/
+            uint32_t nWindows;
+
+
+            /** The total windows taken away after stalling. **/
+            uint32_t nStalls;
+        };
+
+
+        /** Mutex for thread synchronization. **/
+        mutable std::mutex MUTEX;
+
+
+        /** The total blocks in a window. **/
+        const uint32_t nWindowSize;
+
+
+        /** The maximum windows buffered at once. **/
+        const uint32_t nMaxWindows;
+
+
+        /** The milliseconds without progress before a window is given to another peer. **/
+        const uint64_t nStallTimeout;
+
+
+        /** Flag to tell if a synchronization is running. **/
+        bool fActive;
+
+
+        /** Flag to tell if all of the headers have been received. **/
+        bool fHeadersComplete;
+
+
+        /** The height of the block the headers start after. **/
+        uint32_t nBaseHeight;
+
+
+        /** The height of the last header received. **/
+        uint32_t nLastHeader;
+
+
+        /** The hash of the last header received. **/
+        uint1024_t hashLastHeader;
+
+
+        /** The hashes of the headers that end each window not yet processed, by height, starting with the base. **/
+        std::map<uint32_t, uint1024_t> mapBoundaries;
+
+
+        /** The windows that haven't been processed yet, by starting height. **/
+        std::map<uint32_t, Window> mapWindows;
+
+
+        /** The starting height of the next window to create. **/
+        uint32_t nNextWindow;
+
+
+        /** The height of the next block to hand back for processing. **/
+        uint32_t nNextProcess;
+
+
+        /** The throughput of each peer by session. **/
+        std::map<uint64_t, PeerStats> mapPeers;
+
+
+        /** window_hash
+         *
+         *  Get the hash of a block of a window that was received, or of the header before the window.
+         *
+         **/
+        uint1024_t window_hash(const Window& window, const uint32_t nHeight) const;
+
+
+        /** verify
+         *
+         *  Check that the blocks of a complete window link up to the header that ends it, dropping
+         *  the blocks that don't so they are requested again.
+         *
+         *  @return true if every block of the window is on the chain of the headers.
+         *
+         **/
+        bool verify(Window& window);
+
+
+        /** next_missing
+         *
+         *  Get the height of the first block of a window that hasn't been received.
+         *
+         **/
+        uint32_t next_missing(const Window& window) const;
+
+
+    public:
+
+        /** Constructor
+         *
+         *  @param[in] nWindowSizeIn The total blocks in a window.
+         *  @param[in] nMaxWindowsIn The maximum windows buffered at once.
+         *  @param[in] nStallTimeoutIn The milliseconds without progress before a window is reassigned.
+         *
+         **/
+        SyncScheduler(const uint32_t nWindowSizeIn, const uint32_t nMaxWindowsIn, const uint64_t nStallTimeoutIn);
+
+
+        /** Start
+         *
+         *  Start a new synchronization, with headers after a block that is already in the chain.
+         *
+         *  @param[in] hashBase The hash of the block the headers start after.
+         *  @param[in] nHeight The height of the block the headers start after.
+         *
+         **/
+        void Start(const uint1024_t& hashBase, const uint32_t nHeight);
+
+
+        /** Stop
+         *
+         *  Stop the synchronization, dropping any blocks that haven't been processed.
+         *
+         **/
+        void Stop();
+
+
+        /** Active
+         *
+         *  Check if a synchronization is running.
+         *
+         **/
+        bool Active() const;
+
+
+        /** AddHeader
+         *
+         *  Add the next header of the chain.
+         *
+         *  @param[in] hash The hash of the header.
+         *  @param[in] hashPrev The hash of the previous header.
+         *  @param[in] nHeight The height of the header.
+         *
+         *  @return true if the header extends the chain, or is already known.
+         *
+         **/
+        bool AddHeader(const uint1024_t& hash, const uint1024_t& hashPrev, const uint32_t nHeight);
+
+
+        /** LastHeader
+         *
+         *  Get the hash of the last header received.
+         *
+         **/
+        uint1024_t LastHeader() const;
+
+
+        /** FinishHeaders
+         *
+         *  Flag that all of the headers have been received, so the last window can be short.
+         *
+         **/
+        void FinishHeaders();
+
+
+        /** HeadersComplete
+         *
+         *  Check if all of the headers have been received.
+         *
+         **/
+        bool HeadersComplete() const;
+
+
+        /** Assign
+         *
+         *  Give a peer the next window to download, being a window nobody has or one taken away
+         *  from a stalled peer.
+         *
+         *  @param[in] nSession The session of the peer.
+         *  @param[in] nPeerHeight The best height of the peer.
+         *  @param[in] nMaxPerPeer The maximum windows a peer can have at once.
+         *  @param[out] hashFrom The hash of the block before the window.
+         *  @param[out] hashTo The hash of the last block of the window.
+         *
+         *  @return true if a window was assigned.
+         *
+         **/
+        bool Assign(const uint64_t nSession, const uint32_t nPeerHeight, const uint32_t nMaxPerPeer,
+                    uint1024_t &hashFrom, uint1024_t &hashTo);
+
+
+        /** Continue
+         *
+         *  Get the rest of a window a peer stopped sending part way, such as when its send buffer
+         *  filled up.
+         *
+         *  @param[in] nSession The session of the peer.
+         *  @param[in] hashLast The last index the peer sent for the window.
+         *  @param[out] hashFrom The hash of the last block received in order.
+         *  @param[out] hashTo The hash of the last block of the window.
+         *
+         *  @return true if the last index is in a window of the peer that isn't complete.
+         *
+         **/
+        bool Continue(const uint64_t nSession, const uint1024_t& hashLast, uint1024_t &hashFrom, uint1024_t &hashTo) const;
+
+
+        /** Requested
+         *
+         *  Check if a peer was given windows, so its blocks aren't unsolicited. This includes late
+         *  blocks for windows that were given to another peer after stalling.
+         *
+         *  @param[in] nSession The session of the peer.
+         *
+         **/
+        bool Requested(const uint64_t nSession) const;
+
+
+        /** Deliver
+         *
+         *  Add a block to the window it belongs to.
+         *
+         *  @param[in] nSession The session of the peer that sent it.
+         *  @param[in] block The block that was received.
+         *  @param[in] nBytes The size of the message it was received in.
+         *
+         *  @return true if the block belongs to a window, including blocks already received.
+         *
+         **/
+        bool Deliver(const uint64_t nSession, const TAO::Ledger::Block& block, const uint32_t nBytes);
+
+
+        /** Ready
+         *
+         *  Take the blocks that can be processed, in height order, from windows that are complete.
+         *
+         *  @param[out] vReady The blocks to be processed.
+         *
+         **/
+        void Ready(std::vector<std::unique_ptr<TAO::Ledger::Block>> &vReady);
+
+
+        /** Release
+         *
+         *  Take all windows away from a peer, such as when it disconnects.
+         *
+         *  @param[in] nSession The session of the peer.
+         *
+         **/
+        void Release(const uint64_t nSession);
+
+
+        /** Stalled
+         *
+         *  Take windows away from peers that haven't made progress within the stall timeout.
+         *
+         *  @param[in] nTime The current time in milliseconds.
+         *
+         *  @return the total windows that were released.
+         *
+         **/
+        uint32_t Stalled(const uint64_t nTime);
+
+
+        /** Complete
+         *
+         *  Check if every block of the headers has been handed back for processing.
+         *
+         **/
+        bool Complete() const;
+
+
+        /** LogPeers
+         *
+         *  Log the throughput of each peer.
+         *
+         **/
+        void LogPeers() const;
+    };
+}
+
+#endif
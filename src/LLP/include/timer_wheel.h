@@ -0,0 +1,112 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_LLP_INCLUDE_TIMER_WHEEL_H
+#define NEXUS_LLP_INCLUDE_TIMER_WHEEL_H
+
+#include <cstdint>
+#include <vector>
+
+namespace LLP
+{
+
+    /** TimerWheel
+     *
+     *  Hashed timer wheel for connection timeouts. Timers are kept in a ring of slots by the tick
+     *  of their deadline, so scheduling is constant time and expiring only touches the slots the
+     *  clock has passed, rather than every connection. Deadlines more than a revolution away stay
+     *  in their slot until the clock reaches them.
+     *
+     *  Not thread safe, it is meant to be owned by a single data thread.
+     *
+     **/
+    class TimerWheel
+    {
+        /** A timer waiting in a slot. **/
+        struct Timer
+        {
+            uint64_t nID;
+            uint64_t nDeadline;
+        };
+
+
+        /** The ring of slots. **/
+        std::vector< std::vector<Timer> > vSlots;
+
+
+        /** The milliseconds covered by each slot. **/
+        uint32_t nResolution;
+
+
+        /** The next tick to expire. **/
+        uint64_t nTick;
+
+
+        /** The total timers in the wheel. **/
+        uint64_t nTimers;
+
+
+    public:
+
+        /** Constructor
+         *
+         *  @param[in] nSlotsIn The number of slots in the ring.
+         *  @param[in] nResolutionIn The milliseconds covered by each slot.
+         *  @param[in] nTime The current time in milliseconds.
+         *
+         **/
+        TimerWheel(const uint32_t nSlotsIn, const uint32_t nResolutionIn, const uint64_t nTime);
+
+
+        /** Schedule
+         *
+         *  Add a timer to the wheel. Timers aren't cancelled, the owner should ignore the ID of a
+         *  timer that has become stale.
+         *
+         *  @param[in] nID The identifier returned when the timer expires.
+         *  @param[in] nDeadline The time in milliseconds the timer expires at.
+         *
+         **/
+        void Schedule(const uint64_t nID, const uint64_t nDeadline);
+
+
+        /** Expire
+         *
+         *  Advance the clock, removing the timers that have expired.
+         *
+         *  @param[in] nTime The current time in milliseconds.
+         *  @param[out] vExpired The identifiers of the expired timers.
+         *
+         **/
+        void Expire(const uint64_t nTime, std::vector<uint64_t>& vExpired);
+
+
+        /** Size
+         *
+         *  Get the total timers in the wheel.
+         *
+         **/
+        uint64_t Size() const;
+
+
+        /** Resolution
+         *
+         *  Get the milliseconds covered by each slot.
+         *
+         **/
+        uint32_t Resolution() const;
+    };
+}
+
+#endif
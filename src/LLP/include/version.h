@@ -23,7 +23,7 @@ namespace LLP
     /* The current Protocol Version. */
     #define PROTOCOL_MAJOR       3
     #define PROTOCOL_MINOR       0
-    #define PROTOCOL_REVISION    0
+    #define PROTOCOL_REVISION    1
     #define PROTOCOL_BUILD       0
 
 
@@ -44,6 +44,10 @@ namespace LLP
     const uint32_t MIN_TRITIUM_VERSION = 3000000;
 
 
+    /* Used to determine if a node can relay compact blocks. */
+    const uint32_t MIN_COMPACT_VERSION = 3000100;
+
+
     /* The name that will be shared with other nodes. */
     const std::string strProtocolName = "Tritium";
 
@@ -10,9 +10,12 @@
             "ad vocem populi" - To the Voice of the People
 ____________________________________________________________________________________________*/
 
+#include <LLC/hash/SK.h>
+
 #include <LLD/include/global.h>
 
 #include <LLP/include/global.h>
+#include <LLP/include/version.h>
 #include <LLP/types/miner.h>
 #include <LLP/templates/events.h>
 #include <LLP/templates/ddos.h>
@@ -32,6 +35,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/process.h>
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Ledger/types/sigchain.h>
+#include <TAO/Ledger/types/template_engine.h>
 #include <TAO/Ledger/types/transaction.h>
 #include <TAO/Ledger/types/tritium.h>
 
@@ -43,6 +47,7 @@ ________________________________________________________________________________
 #include <Util/include/config.h>
 #include <Util/include/convert.h>
 #include <Util/include/args.h>
+#include <Util/templates/datastream.h>
 
 
 namespace LLP
@@ -832,11 +837,24 @@ namespace LLP
         /* Allocate memory for the new block. */
         TAO::Ledger::TritiumBlock *pBlock = new TAO::Ledger::TritiumBlock();
 
-        /* Lock this user's sigchain. */
-        LOCK(session.CREATE_MUTEX);
+        /* Key the shared template by the sigchain and coinbase recipients it pays. */
+        DataStream ssKey(SER_GETHASH, LLP::PROTOCOL_VERSION);
+        ssKey << pSigChain->Genesis() << CoinbaseTx.WalletReward() << CoinbaseTx.Outputs();
+
+        const uint512_t hashKey = LLC::SK512(ssKey.begin(), ssKey.end());
 
-        /* Create a new block and loop for prime channel if minimum bit target length isn't met */
-        while(TAO::Ledger::CreateBlock(pSigChain, PIN, nChannel.load(), *pBlock, ++nBlockIterator, &CoinbaseTx))
+        /* Templates are created under this user's sigchain lock. */
+        const uint32_t nCreateChannel = nChannel.load();
+        TAO::Ledger::TemplateFunction xCreate = [&](TAO::Ledger::TritiumBlock& block, const uint64_t nExtraNonce)
+        {
+            LOCK(session.CREATE_MUTEX);
+
+            return TAO::Ledger::CreateBlock(pSigChain, PIN, nCreateChannel, block, nExtraNonce, &CoinbaseTx);
+        };
+
+        /* Get a new block and loop for prime channel if minimum bit target length isn't met */
+        TAO::Ledger::TemplateEngine& engine = TAO::Ledger::TemplateEngine::GetInstance(nCreateChannel);
+        while(engine.New(hashKey, xCreate, *pBlock))
         {
             /* Break out of loop when block is ready for prime mod. */
             if(is_prime_mod(nBitMask, pBlock))
@@ -905,13 +923,14 @@ namespace LLP
                 return debug::error(FUNCTION, "Couldn't get the unlocked sigchain");
 
             /* Sign the submitted block */
-            TAO::Ledger::Transaction txProducer;
-            if(pBlock->nVersion < 9)
-                txProducer = pBlock->producer;
-            else
-                txProducer = pBlock->vProducer.back();
+            TAO::Ledger::Transaction& txProducer = (pBlock->nVersion < 9 ? pBlock->producer : pBlock->vProducer.back());
+            uint512_t hashSecret = pSigChain->Generate(txProducer.nSequence, PIN);
+
+            /* Sign the producer, since blocks from a shared template only change its coinbase. */
+            if(!txProducer.Sign(hashSecret))
+                return debug::error(FUNCTION, "Failed to sign producer for ", hashMerkleRoot.SubString());
 
-            std::vector<uint8_t> vBytes = pSigChain->Generate(txProducer.nSequence, PIN).GetBytes();
+            std::vector<uint8_t> vBytes = hashSecret.GetBytes();
 
             LLC::CSecret vchSecret(vBytes.begin(), vBytes.end());
 
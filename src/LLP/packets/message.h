@@ -60,6 +60,14 @@ namespace LLP
         std::vector<uint8_t> DATA;
 
 
+        /** The largest payload of a valid packet. **/
+        static const uint32_t MAX_LENGTH = 1024 * 1024 * 2;
+
+
+        /** The most of a payload reserved before its bytes are received. **/
+        static const uint32_t MAX_RESERVE = 1024 * 64;
+
+
         /** Default Constructor **/
         MessagePacket()
         : MESSAGE (0)
@@ -215,6 +223,20 @@ namespace LLP
         }
 
 
+        /** SetData
+         *
+         *  Set the Packet Data, taking the bytes of the datastream without copying them.
+         *
+         *  @param[in] ssData The datastream with the data to set.
+         *
+         **/
+        void SetData(DataStream&& ssData)
+        {
+            LENGTH = static_cast<uint32_t>(ssData.size());
+            DATA   = std::move(ssData.Bytes());
+        }
+
+
         /** IsValid
          *
          *  Check the Validity of the Packet.
@@ -227,7 +249,7 @@ namespace LLP
                 return false;
 
             /* Make sure Packet length is within bounds. (Max 2 MB Packet Size) */
-            if(LENGTH > (1024 * 1024 * 2))
+            if(LENGTH > MAX_LENGTH)
                 return debug::error("Tritium Packet (", MESSAGE, ", ", LENGTH, " bytes) : Message too Large");
 
             return true;
@@ -243,13 +265,14 @@ namespace LLP
          **/
         std::vector<uint8_t> GetBytes() const
         {
-            DataStream ssHeader(SER_NETWORK, MIN_PROTO_VERSION);
-            ssHeader << *this;
+            /* Reserve the whole packet, so the bytes are only allocated once. */
+            DataStream ssPacket(SER_NETWORK, MIN_PROTO_VERSION);
+            ssPacket.reserve(GetSerializeSize(SER_NETWORK, MIN_PROTO_VERSION) + DATA.size());
 
-            std::vector<uint8_t> vBytes(ssHeader.begin(), ssHeader.end());
-            vBytes.insert(vBytes.end(), DATA.begin(), DATA.end());
+            ssPacket << *this;
+            ssPacket.write((char*)DATA.data(), DATA.size());
 
-            return vBytes;
+            return std::move(ssPacket.Bytes());
         }
     };
 }
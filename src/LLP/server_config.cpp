@@ -30,6 +30,7 @@ namespace LLP
     , nMaxConnections(std::numeric_limits<uint32_t>::max())
     , nMaxThreads   (1)
     , nTimeout      (30)
+    , nGenericInterval(1000)
     , fMeter        (false)
     , fDDOS         (false)
     , nDDOSCScore   (0)
@@ -24,6 +24,7 @@ ________________________________________________________________________________
 #ifndef WIN32
 #include <arpa/inet.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #endif
 
 #include <openssl/ssl.h>
@@ -42,7 +43,9 @@ namespace LLP
     , nLastSend          (0)
     , nLastRecv          (0)
     , nError             (0)
-    , vBuffer            ( )
+    , qBuffer            ( )
+    , nBufferOffset      (0)
+    , nBuffered          (0)
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
     , addr               ( )
@@ -64,7 +67,9 @@ namespace LLP
     , nLastSend          (socket.nLastSend.load())
     , nLastRecv          (socket.nLastRecv.load())
     , nError             (socket.nError.load())
-    , vBuffer            (socket.vBuffer)
+    , qBuffer            (socket.qBuffer)
+    , nBufferOffset      (socket.nBufferOffset)
+    , nBuffered          (socket.nBuffered.load())
     , fBufferFull        (socket.fBufferFull.load())
     , nConsecutiveErrors (socket.nConsecutiveErrors.load())
     , addr               (socket.addr)
@@ -98,7 +103,9 @@ namespace LLP
     , nLastSend          (0)
     , nLastRecv          (0)
     , nError             (0)
-    , vBuffer            ( )
+    , qBuffer            ( )
+    , nBufferOffset      (0)
+    , nBuffered          (0)
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
     , addr               (addrIn)
@@ -215,7 +222,9 @@ namespace LLP
     , nLastSend          (0)
     , nLastRecv          (0)
     , nError             (0)
-    , vBuffer            ( )
+    , qBuffer            ( )
+    , nBufferOffset      (0)
+    , nBuffered          (0)
     , fBufferFull        (false)
     , nConsecutiveErrors (0)
     , addr               ( )
@@ -752,99 +761,103 @@ namespace LLP
     /* Write data into the socket buffer non-blocking */
     int32_t Socket::Write(const std::vector<uint8_t>& vData, size_t nBytes)
     {
-        int32_t nSent = 0;
-
-        {
-            LOCK(DATA_MUTEX);
-
-            /* Check overflow buffer. */
-            if(vBuffer.size() > 0)
-            {
-                debug::log(3, FUNCTION, "vBuffer ", vBuffer.size(), " bytes");
-
-                vBuffer.insert(vBuffer.end(), vData.begin(), vData.end());
-
-                return static_cast<int32_t>(nBytes);
-            }
-        }
-
-        /* Write the packet. */
-        {
-            LOCK(SOCKET_MUTEX);
+        if(nBytes == 0 || vData.empty())
+            return 0;
 
-            if(pSSL)
-                nSent = static_cast<int32_t>(SSL_write(pSSL, (int8_t*)&vData[0], nBytes));
-            else
-            {
-            #ifdef WIN32
-                nSent = static_cast<int32_t>(send(fd, (char*)&vData[0], nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
-            #else
-                nSent = static_cast<int32_t>(send(fd, (int8_t*)&vData[0], nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
-            #endif
-            }
-        }
+        return write(&vData[0], std::min(nBytes, vData.size()), SharedBuffer());
+    }
 
 
-        /* Handle for error state. */
-        if(nSent < 0)
-        {
-            if(pSSL)
-                nError = SSL_get_error(pSSL, nSent);
-            else
-                nError = WSAGetLastError();
-        }
-
-        /* If not all data was sent non-blocking, recurse until it is complete. */
-        else if(nSent != vData.size())
-        {
-            LOCK(DATA_MUTEX);
-            vBuffer.insert(vBuffer.end(), vData.begin() + nSent, vData.end());
-        }
-        else //don't update last sent unless all the data was written to the buffer
-            nLastSend = runtime::timestamp(true);
+    /* Write a shared buffer into the socket buffer non-blocking. */
+    int32_t Socket::Write(const SharedBuffer& pBuffer)
+    {
+        if(!pBuffer || pBuffer->empty())
+            return 0;
 
-        return nSent;
+        return write(&(*pBuffer)[0], pBuffer->size(), pBuffer);
     }
 
 
     /* Flushes data out of the overflow buffer */
     int Socket::Flush()
     {
-        int32_t nSent   = 0;
-        uint32_t nBytes = 0;
-        uint32_t nSize  = 0;
-
-        {
-            LOCK(DATA_MUTEX);
-            nSize = static_cast<uint32_t>(vBuffer.size());
-        }
-
         /* Don't flush if buffer doesn't have any data. */
-        if(nSize == 0)
+        if(nBuffered.load() == 0)
             return 0;
 
         /* maximum transmission unit. */
         const uint32_t MTU = 16384;
 
         /* Set the maximum bytes to flush to 2^16 or maximum socket buffers. */
-        nBytes = std::min(nSize, std::min((uint32_t)config::GetArg("-maxsendsize", MTU), MTU));
+        const uint64_t nMaxBytes = std::min((uint32_t)config::GetArg("-maxsendsize", MTU), MTU);
 
         /* If there were any errors, handle them gracefully. */
+        int32_t nSent = 0;
         {
             LOCK2(DATA_MUTEX);
             LOCK(SOCKET_MUTEX);
 
+            if(qBuffer.empty())
+                return 0;
+
+            /* SSL records can't be gathered, so write what is left of the front buffer. */
+            const SharedBuffer& pFront = qBuffer.front();
+            const uint32_t nFront = static_cast<uint32_t>(std::min(uint64_t(pFront->size() - nBufferOffset), nMaxBytes));
             if(pSSL)
-                nSent = static_cast<int32_t>(SSL_write(pSSL, (int8_t *)&vBuffer[0], nBytes));
+                nSent = static_cast<int32_t>(SSL_write(pSSL, (int8_t *)&(*pFront)[nBufferOffset], nFront));
             else
             {
             #ifdef WIN32
-                nSent = static_cast<int32_t>(send(fd, (char*)&vBuffer[0], nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
+                nSent = static_cast<int32_t>(send(fd, (char*)&(*pFront)[nBufferOffset], nFront, MSG_NOSIGNAL | MSG_DONTWAIT));
             #else
-                nSent = static_cast<int32_t>(send(fd, (int8_t*)&vBuffer[0], nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
+
+                /* Gather as many of the queued buffers as fit into one write. */
+                const uint32_t MAX_IOV = 64;
+
+                struct iovec vIOV[MAX_IOV];
+                uint32_t nIOV   = 0;
+                uint64_t nBytes = 0;
+                for(auto it = qBuffer.begin(); it != qBuffer.end() && nIOV < MAX_IOV && nBytes < nMaxBytes; ++it)
+                {
+                    const uint64_t nOffset = (nIOV == 0 ? nBufferOffset : 0);
+                    const uint64_t nLength = std::min(uint64_t((*it)->size() - nOffset), nMaxBytes - nBytes);
+
+                    vIOV[nIOV].iov_base = (void*)&(**it)[nOffset];
+                    vIOV[nIOV].iov_len  = nLength;
+
+                    nBytes += nLength;
+                    ++nIOV;
+                }
+
+                struct msghdr msg = { };
+                msg.msg_iov    = vIOV;
+                msg.msg_iovlen = nIOV;
+
+                nSent = static_cast<int32_t>(sendmsg(fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT));
             #endif
             }
 
+            /* Release the buffers that were sent in full. */
+            if(nSent > 0)
+            {
+                uint64_t nRemaining = static_cast<uint64_t>(nSent);
+                while(nRemaining > 0)
+                {
+                    const uint64_t nLeft = qBuffer.front()->size() - nBufferOffset;
+                    if(nRemaining < nLeft)
+                    {
+                        nBufferOffset += nRemaining;
+                        break;
+                    }
+
+                    nRemaining -= nLeft;
+                    nBufferOffset = 0;
+
+                    qBuffer.pop_front();
+                }
+
+                nBuffered -= static_cast<uint64_t>(nSent);
+            }
         }
 
         /* Handle errors on flush. */
@@ -858,15 +871,9 @@ namespace LLP
             ++nConsecutiveErrors;
         }
 
-        /* If not all data was sent non-blocking, recurse until it is complete. */
+        /* Update socket timers. */
         else if(nSent > 0)
         {
-            LOCK(DATA_MUTEX);
-
-            /* Erase from current buffer. */
-            vBuffer.erase(vBuffer.begin(), vBuffer.begin() + nSent);
-
-            /* Update socket timers. */
             nLastSend          = runtime::timestamp(true);
             nConsecutiveErrors = 0;
 
@@ -897,7 +904,7 @@ namespace LLP
     /* Check that the socket has data that is buffered. */
     uint64_t Socket::Buffered() const
     {
-        return vBuffer.size();
+        return nBuffered.load();
     }
 
 
@@ -978,4 +985,76 @@ namespace LLP
         return false;
     }
 
+
+    /* Write bytes into the socket buffer non-blocking, queuing what couldn't be sent. */
+    int32_t Socket::write(const uint8_t* pData, const size_t nBytes, const SharedBuffer& pBuffer)
+    {
+        int32_t nSent = 0;
+
+        {
+            LOCK(DATA_MUTEX);
+
+            /* Check overflow buffer. */
+            if(!qBuffer.empty())
+            {
+                debug::log(3, FUNCTION, "qBuffer ", nBuffered.load(), " bytes");
+
+                qBuffer.push_back(pBuffer ? pBuffer : std::make_shared<const std::vector<uint8_t>>(pData, pData + nBytes));
+                nBuffered += nBytes;
+
+                return static_cast<int32_t>(nBytes);
+            }
+        }
+
+        /* Write the packet. */
+        {
+            LOCK(SOCKET_MUTEX);
+
+            if(pSSL)
+                nSent = static_cast<int32_t>(SSL_write(pSSL, (int8_t*)pData, nBytes));
+            else
+            {
+            #ifdef WIN32
+                nSent = static_cast<int32_t>(send(fd, (char*)pData, nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
+            #else
+                nSent = static_cast<int32_t>(send(fd, (int8_t*)pData, nBytes, MSG_NOSIGNAL | MSG_DONTWAIT));
+            #endif
+            }
+        }
+
+
+        /* Handle for error state. */
+        if(nSent < 0)
+        {
+            if(pSSL)
+                nError = SSL_get_error(pSSL, nSent);
+            else
+                nError = WSAGetLastError();
+
+            /* A full socket isn't an error, so the whole packet waits for the next flush. */
+            if(error_code() == 0)
+                nSent = 0;
+        }
+
+        /* If not all data was sent non-blocking, queue the rest for the flush. */
+        if(nSent >= 0 && static_cast<size_t>(nSent) != nBytes)
+        {
+            LOCK(DATA_MUTEX);
+
+            /* A shared buffer can be queued as is when it is at the front of the queue. */
+            if(pBuffer && qBuffer.empty())
+            {
+                qBuffer.push_back(pBuffer);
+                nBufferOffset = nSent;
+            }
+            else
+                qBuffer.push_back(std::make_shared<const std::vector<uint8_t>>(pData + nSent, pData + nBytes));
+
+            nBuffered += (nBytes - nSent);
+        }
+        else if(nSent > 0) //don't update last sent unless all the data was written to the buffer
+            nLastSend = runtime::timestamp(true);
+
+        return nSent;
+    }
 }
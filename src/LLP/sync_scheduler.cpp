@@ -0,0 +1,482 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLP/include/sync_scheduler.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+
+#include <algorithm>
+
+namespace LLP
+{
+
+    /* Constructor. */
+    SyncScheduler::SyncScheduler(const uint32_t nWindowSizeIn, const uint32_t nMaxWindowsIn, const uint64_t nStallTimeoutIn)
+    : MUTEX            ( )
+    , nWindowSize      (std::max(nWindowSizeIn, 1u))
+    , nMaxWindows      (std::max(nMaxWindowsIn, 1u))
+    , nStallTimeout    (nStallTimeoutIn)
+    , fActive          (false)
+    , fHeadersComplete (false)
+    , nBaseHeight      (0)
+    , nLastHeader      (0)
+    , hashLastHeader   (0)
+    , mapBoundaries    ( )
+    , mapWindows       ( )
+    , nNextWindow      (0)
+    , nNextProcess     (0)
+    , mapPeers         ( )
+    {
+    }
+
+
+    /* Start a new synchronization, with headers after a block that is already in the chain. */
+    void SyncScheduler::Start(const uint1024_t& hashBase, const uint32_t nHeight)
+    {
+        LOCK(MUTEX);
+
+        fActive          = true;
+        fHeadersComplete = false;
+        nBaseHeight      = nHeight;
+        nLastHeader      = nHeight;
+        hashLastHeader   = hashBase;
+        nNextWindow      = nHeight + 1;
+        nNextProcess     = nHeight + 1;
+
+        mapBoundaries.clear();
+        mapWindows.clear();
+        mapPeers.clear();
+
+        /* The base is the first header, so the chain of headers and the first window can link to it. */
+        mapBoundaries[nHeight] = hashBase;
+    }
+
+
+    /* Stop the synchronization, dropping any blocks that haven't been processed. */
+    void SyncScheduler::Stop()
+    {
+        LOCK(MUTEX);
+
+        fActive        = false;
+        hashLastHeader = 0;
+
+        mapBoundaries.clear();
+        mapWindows.clear();
+    }
+
+
+    /* Check if a synchronization is running. */
+    bool SyncScheduler::Active() const
+    {
+        LOCK(MUTEX);
+
+        return fActive;
+    }
+
+
+    /* Add the next header of the chain. */
+    bool SyncScheduler::AddHeader(const uint1024_t& hash, const uint1024_t& hashPrev, const uint32_t nHeight)
+    {
+        LOCK(MUTEX);
+
+        if(!fActive)
+            return false;
+
+        /* Headers can overlap when a list is requested again, but can't disagree with a window's end. */
+        if(nHeight <= nLastHeader)
+        {
+            auto it = mapBoundaries.find(nHeight);
+            if(it != mapBoundaries.end() && it->second != hash)
+                return debug::error(FUNCTION, "header ", hash.SubString(), " at height ", nHeight, " doesn't match ", it->second.SubString());
+
+            return true;
+        }
+
+        /* Check that the header extends the chain. */
+        if(hashPrev != hashLastHeader || nHeight != nLastHeader + 1)
+            return debug::error(FUNCTION, "header ", hash.SubString(), " at height ", nHeight, " doesn't extend ", hashLastHeader.SubString());
+
+        hashLastHeader = hash;
+        nLastHeader    = nHeight;
+
+        /* Only the headers that end a window are kept. */
+        if((nHeight - nBaseHeight) % nWindowSize == 0)
+            mapBoundaries[nHeight] = hash;
+
+        return true;
+    }
+
+
+    /* Get the hash of the last header received. */
+    uint1024_t SyncScheduler::LastHeader() const
+    {
+        LOCK(MUTEX);
+
+        return hashLastHeader;
+    }
+
+
+    /* Flag that all of the headers have been received, so the last window can be short. */
+    void SyncScheduler::FinishHeaders()
+    {
+        LOCK(MUTEX);
+
+        fHeadersComplete = true;
+
+        /* The last header ends the last window, which can be short. */
+        if(fActive)
+            mapBoundaries[nLastHeader] = hashLastHeader;
+    }
+
+
+    /* Check if all of the headers have been received. */
+    bool SyncScheduler::HeadersComplete() const
+    {
+        LOCK(MUTEX);
+
+        return fHeadersComplete;
+    }
+
+
+    /* Give a peer the next window to download. */
+    bool SyncScheduler::Assign(const uint64_t nSession, const uint32_t nPeerHeight, const uint32_t nMaxPerPeer,
+                               uint1024_t &hashFrom, uint1024_t &hashTo)
+    {
+        LOCK(MUTEX);
+
+        if(!fActive)
+            return false;
+
+        /* Check how many windows the peer is still downloading. */
+        uint32_t nAssigned = 0;
+        for(const auto& pair : mapWindows)
+            if(pair.second.nSession == nSession && pair.second.nReceived < pair.second.vBlocks.size())
+                ++nAssigned;
+
+        if(nAssigned >= nMaxPerPeer)
+            return false;
+
+        /* Windows that nobody has come first, lowest height first, since everything after them waits for them. */
+        Window* pWindow = nullptr;
+        for(auto& pair : mapWindows)
+        {
+            Window& window = pair.second;
+            if(window.nSession != 0 || window.nStalled == nSession)
+                continue;
+
+            if(window.nStart + window.vBlocks.size() - 1 > nPeerHeight)
+                continue;
+
+            pWindow = &window;
+            break;
+        }
+
+        /* Otherwise create a new window, if the headers cover it. */
+        if(!pWindow)
+        {
+            if(mapWindows.size() >= nMaxWindows || nNextWindow > nLastHeader)
+                return false;
+
+            /* Only the last window can be short, and only once all headers are known. */
+            const uint32_t nEnd = std::min(nNextWindow + nWindowSize - 1, nLastHeader);
+            if(nEnd - nNextWindow + 1 < nWindowSize && !fHeadersComplete)
+                return false;
+
+            if(nEnd > nPeerHeight)
+                return false;
+
+            Window& window = mapWindows[nNextWindow];
+            window.nStart    = nNextWindow;
+            window.nSession  = 0;
+            window.nStalled  = 0;
+            window.nReceived = 0;
+            window.vBlocks.resize(nEnd - nNextWindow + 1);
+            window.vHashes.resize(nEnd - nNextWindow + 1);
+
+            nNextWindow = nEnd + 1;
+            pWindow = &window;
+        }
+
+        /* Assign the window, picking up after any blocks that were already received. */
+        const uint64_t nTime = runtime::timestamp(true);
+        pWindow->nSession      = nSession;
+        pWindow->nLastProgress = nTime;
+
+        hashFrom = window_hash(*pWindow, next_missing(*pWindow) - 1);
+        hashTo   = window_hash(*pWindow, pWindow->nStart + pWindow->vBlocks.size() - 1);
+
+        PeerStats& stats = mapPeers[nSession];
+        if(stats.nFirst == 0)
+            stats.nFirst = nTime;
+
+        debug::log(2, FUNCTION, "window ", pWindow->nStart, " to ", pWindow->nStart + pWindow->vBlocks.size() - 1, " assigned to session ", nSession);
+
+        return true;
+    }
+
+
+    /* Get the rest of a window a peer stopped sending part way. */
+    bool SyncScheduler::Continue(const uint64_t nSession, const uint1024_t& hashLast, uint1024_t &hashFrom, uint1024_t &hashTo) const
+    {
+        LOCK(MUTEX);
+
+        /* Find the window the last index was sent for, which can be the block before it. */
+        for(const auto& pair : mapWindows)
+        {
+            const Window& window = pair.second;
+            if(window.nSession != nSession || window.nReceived == window.vBlocks.size())
+                continue;
+
+            if(hashLast != window_hash(window, window.nStart - 1)
+            && std::find(window.vHashes.begin(), window.vHashes.end(), hashLast) == window.vHashes.end())
+                continue;
+
+            hashFrom = window_hash(window, next_missing(window) - 1);
+            hashTo   = window_hash(window, window.nStart + window.vBlocks.size() - 1);
+
+            return true;
+        }
+
+        return false;
+    }
+
+
+    /* Check if a peer was given windows, so its blocks aren't unsolicited. */
+    bool SyncScheduler::Requested(const uint64_t nSession) const
+    {
+        LOCK(MUTEX);
+
+        /* Peers keep their stats until the next synchronization, so late blocks are ignored rather than unsolicited. */
+        return mapPeers.count(nSession);
+    }
+
+
+    /* Add a block to the window it belongs to. */
+    bool SyncScheduler::Deliver(const uint64_t nSession, const TAO::Ledger::Block& block, const uint32_t nBytes)
+    {
+        LOCK(MUTEX);
+
+        if(!fActive)
+            return false;
+
+        /* Check that the block is within the headers, and hasn't been processed yet. */
+        const uint32_t nHeight = block.nHeight;
+        if(nHeight < nNextProcess || nHeight > nLastHeader)
+            return false;
+
+        /* Find the window with the height. */
+        auto itWindow = mapWindows.upper_bound(nHeight);
+        if(itWindow == mapWindows.begin())
+            return false;
+
+        Window& window = (--itWindow)->second;
+        if(nHeight >= window.nStart + window.vBlocks.size())
+            return false;
+
+        /* Keep the first copy of each block. */
+        std::unique_ptr<TAO::Ledger::Block>& pBlock = window.vBlocks[nHeight - window.nStart];
+        if(pBlock)
+            return true;
+
+        /* The last block of a window is checked against its header right away. */
+        const uint1024_t hash = block.GetHash();
+        if(nHeight == window.nStart + window.vBlocks.size() - 1 && hash != window_hash(window, nHeight))
+            return false;
+
+        pBlock.reset(block.Clone());
+        window.vHashes[nHeight - window.nStart] = hash;
+        ++window.nReceived;
+
+        /* Track the progress of the window and the throughput of the peer. */
+        const uint64_t nTime = runtime::timestamp(true);
+        if(window.nSession == nSession)
+            window.nLastProgress = nTime;
+
+        PeerStats& stats = mapPeers[nSession];
+        stats.nBlocks += 1;
+        stats.nBytes  += nBytes;
+        stats.nLast    = nTime;
+
+        if(window.nReceived == window.vBlocks.size())
+        {
+            /* Request the window again from another peer if its blocks don't link up. */
+            if(!verify(window))
+            {
+                debug::log(0, FUNCTION, "window ", window.nStart, " from session ", window.nSession, " doesn't link to its headers");
+
+                window.nStalled = window.nSession;
+                window.nSession = 0;
+
+                return true;
+            }
+
+            ++stats.nWindows;
+
+            debug::log(2, FUNCTION, "window ", window.nStart, " to ", window.nStart + window.vBlocks.size() - 1,
+                " completed by session ", nSession);
+        }
+
+        return true;
+    }
+
+
+    /* Take the blocks that can be processed, in height order. */
+    void SyncScheduler::Ready(std::vector<std::unique_ptr<TAO::Ledger::Block>> &vReady)
+    {
+        LOCK(MUTEX);
+
+        while(!mapWindows.empty())
+        {
+            /* Blocks can only be processed from the lowest window, once it is complete and checked. */
+            auto it = mapWindows.begin();
+            Window& window = it->second;
+            if(window.nReceived < window.vBlocks.size())
+                break;
+
+            for(auto& pBlock : window.vBlocks)
+                vReady.push_back(std::move(pBlock));
+
+            nNextProcess = window.nStart + window.vBlocks.size();
+            mapWindows.erase(it);
+        }
+
+        /* Keep only the header the next window links to. */
+        mapBoundaries.erase(mapBoundaries.begin(), mapBoundaries.lower_bound(nNextProcess - 1));
+    }
+
+
+    /* Take all windows away from a peer. */
+    void SyncScheduler::Release(const uint64_t nSession)
+    {
+        LOCK(MUTEX);
+
+        for(auto& pair : mapWindows)
+            if(pair.second.nSession == nSession)
+                pair.second.nSession = 0;
+    }
+
+
+    /* Take windows away from peers that haven't made progress within the stall timeout. */
+    uint32_t SyncScheduler::Stalled(const uint64_t nTime)
+    {
+        LOCK(MUTEX);
+
+        uint32_t nStalled = 0;
+        for(auto& pair : mapWindows)
+        {
+            Window& window = pair.second;
+            if(window.nSession == 0 || window.nReceived == window.vBlocks.size())
+                continue;
+
+            if(nTime < window.nLastProgress + nStallTimeout)
+                continue;
+
+            debug::log(0, FUNCTION, "window ", window.nStart, " stalled on session ", window.nSession,
+                " with ", window.nReceived, "/", window.vBlocks.size(), " blocks");
+
+            ++mapPeers[window.nSession].nStalls;
+
+            window.nStalled = window.nSession;
+            window.nSession = 0;
+
+            ++nStalled;
+        }
+
+        return nStalled;
+    }
+
+
+    /* Check if every block of the headers has been handed back for processing. */
+    bool SyncScheduler::Complete() const
+    {
+        LOCK(MUTEX);
+
+        return fActive && fHeadersComplete && nNextProcess == nLastHeader + 1;
+    }
+
+
+    /* Log the throughput of each peer. */
+    void SyncScheduler::LogPeers() const
+    {
+        LOCK(MUTEX);
+
+        for(const auto& pair : mapPeers)
+        {
+            const PeerStats& stats = pair.second;
+
+            /* Get the time from the first request to the last block, at least a millisecond. */
+            const uint64_t nElapsed = std::max(stats.nLast, stats.nFirst + 1) - stats.nFirst;
+
+            debug::log(0, FUNCTION, "session ", pair.first, ": ", stats.nBlocks, " blocks, ", stats.nBytes / 1024, " Kb in ",
+                nElapsed, " ms [", (stats.nBlocks * 1000) / nElapsed, " blocks/s, ", stats.nBytes / nElapsed, " Kb/s] ",
+                stats.nWindows, " windows, ", stats.nStalls, " stalls");
+        }
+    }
+
+
+    /* Get the hash of a block of a window that was received, or of the header before the window. */
+    uint1024_t SyncScheduler::window_hash(const Window& window, const uint32_t nHeight) const
+    {
+        /* The last block's hash comes from its header, so it is known before the block arrives. */
+        if(nHeight < window.nStart || nHeight == window.nStart + window.vBlocks.size() - 1)
+        {
+            auto it = mapBoundaries.find(nHeight);
+            if(it != mapBoundaries.end())
+                return it->second;
+        }
+
+        if(nHeight < window.nStart)
+            return 0;
+
+        return window.vHashes[nHeight - window.nStart];
+    }
+
+
+    /* Check that the blocks of a complete window link up to the header that ends it. */
+    bool SyncScheduler::verify(Window& window)
+    {
+        /* Walk back from the last header, since every block links to the one before it. */
+        uint32_t nLinked = window.vBlocks.size();
+        uint1024_t hash  = window_hash(window, window.nStart + nLinked - 1);
+        while(nLinked > 0 && window.vHashes[nLinked - 1] == hash)
+            hash = window.vBlocks[--nLinked]->hashPrevBlock;
+
+        /* The first block has to link to the header before the window. */
+        if(nLinked == 0 && hash == window_hash(window, window.nStart - 1))
+            return true;
+
+        /* Drop the blocks that aren't linked to the last header, since they can't be trusted. */
+        const uint32_t nDrop = (nLinked == 0 ? window.vBlocks.size() : nLinked);
+        for(uint32_t n = 0; n < nDrop; ++n)
+        {
+            window.vBlocks[n].reset();
+            window.vHashes[n] = 0;
+        }
+
+        window.nReceived -= nDrop;
+
+        return false;
+    }
+
+
+    /* Get the height of the first block of a window that hasn't been received. */
+    uint32_t SyncScheduler::next_missing(const Window& window) const
+    {
+        uint32_t nMissing = 0;
+        while(nMissing < window.vBlocks.size() && window.vBlocks[nMissing])
+            ++nMissing;
+
+        return window.nStart + nMissing;
+    }
+}
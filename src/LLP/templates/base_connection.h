@@ -283,6 +283,17 @@ namespace LLP
         void WritePacket(const PacketType& PACKET);
 
 
+        /** WritePacket
+         *
+         *  Write a packet that was already encoded to the TCP stream. The buffer is queued by
+         *  reference, so the same packet can be relayed to many connections without copies.
+         *
+         *  @param[in] pBuffer The encoded bytes of the packet.
+         *
+         **/
+        void WritePacket(const SharedBuffer& pBuffer);
+
+
         /** ReadPacket
          *
          *  Non-Blocking Packet reader to build a packet from TCP Connection.
@@ -33,6 +33,7 @@ ________________________________________________________________________________
 #include <cstdint>
 #include <queue>
 #include <condition_variable>
+#include <set>
 
 namespace LLP
 {
@@ -93,6 +94,35 @@ namespace LLP
         memory::atomic_ptr< std::queue<std::pair<typename ProtocolType::message_t, DataStream>> > RELAY;
 
 
+        /** The milliseconds between generic events and timeout checks of a connection. **/
+        uint32_t GENERIC_INTERVAL;
+
+
+        /** Flag to use the epoll event loop rather than polling every connection. **/
+        const bool fEPOLL;
+
+
+        /** The epoll descriptor, and the event descriptor that wakes the event loop. **/
+        std::atomic<int32_t> nEpoll;
+        std::atomic<int32_t> nWakeup;
+
+
+        /** Slots of new connections for the event loop to register, guarded by SLOT_MUTEX. **/
+        std::vector<uint32_t> vPending;
+
+
+        /** Slots of connections with buffered data the socket is ready to take. **/
+        std::set<uint32_t> setFlush;
+
+
+        /** Slots of connections flushed since the last pass, for the event loop to tell they can write more. **/
+        std::set<uint32_t> setWritable;
+
+
+        /** Mutex to guard the flush and writable slots. **/
+        std::mutex FLUSH_MUTEX;
+
+
         /** The condition for thread sleeping. **/
         std::condition_variable CONDITION;
 
@@ -113,7 +143,7 @@ namespace LLP
          *
          **/
         DataThread<ProtocolType>(uint32_t nID, bool ffDDOSIn, uint32_t rScore, uint32_t cScore,
-                                 uint32_t nTimeout, bool fMeter = false);
+                                 uint32_t nTimeout, bool fMeter = false, uint32_t nGenericInterval = 1000);
 
 
         /** Default Destructor
@@ -170,6 +200,9 @@ namespace LLP
                         ++nIncoming;
                     else
                         ++nOutbound;
+
+                    /* Hand the connection to the event loop. */
+                    activate(nSlot);
                 }
 
                 /* Notify data thread to wake up. */
@@ -238,6 +271,9 @@ namespace LLP
                         ++nIncoming;
                     else
                         ++nOutbound;
+
+                    /* Hand the connection to the event loop. */
+                    activate(nSlot);
                 }
 
                 /* Notify data thread to wake up. */
@@ -276,7 +312,8 @@ namespace LLP
 
         /** Flush
          *
-         *  Thread to handle flushing write buffers.
+         *  Thread to handle flushing write buffers. With the event loop, only connections whose
+         *  socket signalled it can take more data are flushed.
          *
          **/
         void Flush();
@@ -336,6 +373,69 @@ namespace LLP
       private:
 
 
+        /** poll_loop
+         *
+         *  Poll every connection on each pass, checking timeouts and reading packets.
+         *
+         **/
+        void poll_loop();
+
+
+        /** event_loop
+         *
+         *  Wait on epoll for ready connections only, reading each until its socket is drained.
+         *  Timeouts and generic events are driven by a timer wheel, and connections that can be
+         *  written to again are handed to the flush thread, which hands them back for a writable
+         *  event once flushed.
+         *
+         **/
+        void event_loop();
+
+
+        /** activate
+         *
+         *  Queue a new connection to be registered by the event loop. Must be called with SLOT_MUTEX held.
+         *
+         *  @param[in] nSlot The data thread index of the connection.
+         *
+         **/
+        void activate(const uint32_t nSlot);
+
+
+        /** wake
+         *
+         *  Wake the event loop from waiting on epoll.
+         *
+         **/
+        void wake();
+
+
+        /** check
+         *
+         *  Check a connection for errors, timeouts, full buffers and DDOS, disconnecting it if any fail.
+         *
+         *  @param[in] nIndex The data thread index of the connection.
+         *  @param[in] CONNECTION The connection to check.
+         *
+         *  @return True if the connection is still active.
+         *
+         **/
+        bool check(const uint32_t nIndex, ProtocolType* CONNECTION);
+
+
+        /** process
+         *
+         *  Process a complete packet on a connection.
+         *
+         *  @param[in] nIndex The data thread index of the connection.
+         *  @param[in] CONNECTION The connection with the complete packet.
+         *
+         *  @return True if the connection is still active.
+         *
+         **/
+        bool process(const uint32_t nIndex, ProtocolType* CONNECTION);
+
+
         /** disconnect_remove_event
          *
          *  Fires off a Disconnect event with the given disconnect reason
@@ -30,6 +30,7 @@ namespace LLP
             GENERIC        = 4,
             FAILED         = 5,
             PROCESSED      = 6,
+            WRITABLE       = 7,
         };
     }
 
@@ -397,9 +397,12 @@ namespace LLP
         template<typename MessageType, typename... Args>
         void Relay(const MessageType& message, Args&&... args)
         {
+            /* Serialize the message once, rather than once for each data thread. */
+            DataStream ssData(SER_NETWORK, MIN_PROTO_VERSION);
+            message_args(ssData, std::forward<Args>(args)...);
+
             /* Relay message to each data thread, which will relay message to each connection of each data thread */
-            for(uint16_t nThread = 0; nThread < MAX_THREADS; ++nThread)
-                DATA_THREADS[nThread]->Relay(message, args...);
+            _Relay(message, ssData);
         }
 
 
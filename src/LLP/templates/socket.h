@@ -19,6 +19,8 @@ ________________________________________________________________________________
 #include <LLP/include/base_address.h>
 
 #include <vector>
+#include <deque>
+#include <memory>
 #include <cstdint>
 #include <mutex>
 #include <atomic>
@@ -34,6 +36,15 @@ namespace LLP
     const uint64_t MAX_SEND_BUFFER = 3 * 1024 * 1024; //3MB max send buffer
 
 
+    /** SharedBuffer
+     *
+     *  Immutable bytes of an encoded packet. A relayed packet is encoded once and the same buffer
+     *  is queued on the send buffer of every socket it goes to, rather than a copy for each.
+     *
+     **/
+    typedef std::shared_ptr<const std::vector<uint8_t>> SharedBuffer;
+
+
     /** Socket
      *
      *  Base Template class to handle outgoing / incoming LLP data for both
@@ -68,8 +79,16 @@ namespace LLP
         std::atomic<int32_t> nError;
 
 
-        /** Oversize buffer for large packets. **/
-        std::vector<uint8_t> vBuffer;
+        /** Queue of buffers that couldn't be sent yet, which may be shared with other sockets. **/
+        std::deque<SharedBuffer> qBuffer;
+
+
+        /** The bytes of the buffer at the front of the queue that have been sent. **/
+        uint64_t nBufferOffset;
+
+
+        /** The total bytes waiting in the queue. **/
+        std::atomic<uint64_t> nBuffered;
 
 
         /** Flag to catch if buffer write failed. **/
@@ -205,9 +224,23 @@ namespace LLP
         int32_t Write(const std::vector<uint8_t>& vData, size_t nBytes);
 
 
+        /** Write
+         *
+         *  Write a shared buffer into the socket buffer non-blocking. Anything that can't be sent
+         *  right away is queued by reference instead of being copied.
+         *
+         *  @param[in] pBuffer The shared buffer to be written
+         *
+         *  @return the total bytes that were written
+         *
+         **/
+        int32_t Write(const SharedBuffer& pBuffer);
+
+
         /** Flush
          *
-         *  Flushes data out of the overflow buffer
+         *  Flushes data out of the overflow buffer, gathering the queued buffers into a single
+         *  write where the platform supports it.
          *
          *  @return the total bytes that were written
          *
@@ -287,6 +320,20 @@ namespace LLP
          **/
         int32_t error_code() const;
 
+
+        /** write
+         *
+         *  Write bytes into the socket buffer non-blocking, queuing what couldn't be sent.
+         *
+         *  @param[in] pData The bytes to be written
+         *  @param[in] nBytes The total bytes to write
+         *  @param[in] pBuffer The shared buffer holding the bytes to queue, or null to queue a copy
+         *
+         *  @return the total bytes that were written
+         *
+         **/
+        int32_t write(const uint8_t* pData, const size_t nBytes, const SharedBuffer& pBuffer);
+
     };
 
 }
@@ -0,0 +1,89 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLP/include/timer_wheel.h>
+
+#include <algorithm>
+
+namespace LLP
+{
+
+    /* Constructor. */
+    TimerWheel::TimerWheel(const uint32_t nSlotsIn, const uint32_t nResolutionIn, const uint64_t nTime)
+    : vSlots      (std::max(nSlotsIn, 1u))
+    , nResolution (std::max(nResolutionIn, 1u))
+    , nTick       (nTime / nResolution)
+    , nTimers     (0)
+    {
+    }
+
+
+    /* Add a timer to the wheel. */
+    void TimerWheel::Schedule(const uint64_t nID, const uint64_t nDeadline)
+    {
+        /* Deadlines in the past go in the next slot to expire. */
+        const uint64_t nSlot = std::max(nDeadline / nResolution, nTick);
+
+        Timer timer;
+        timer.nID       = nID;
+        timer.nDeadline = nDeadline;
+
+        vSlots[nSlot % vSlots.size()].push_back(timer);
+        ++nTimers;
+    }
+
+
+    /* Advance the clock, removing the timers that have expired. */
+    void TimerWheel::Expire(const uint64_t nTime, std::vector<uint64_t>& vExpired)
+    {
+        const uint64_t nNow = nTime / nResolution;
+        if(nNow < nTick)
+            return;
+
+        /* Visit each slot the clock passed, and no slot twice if it has passed a whole revolution. */
+        const uint64_t nPassed = std::min(nNow - nTick + 1, uint64_t(vSlots.size()));
+        for(uint64_t n = 0; n < nPassed; ++n)
+        {
+            std::vector<Timer>& vSlot = vSlots[(nTick + n) % vSlots.size()];
+
+            /* Keep the timers due on a later revolution. */
+            uint32_t nKeep = 0;
+            for(uint32_t i = 0; i < vSlot.size(); ++i)
+            {
+                if(vSlot[i].nDeadline / nResolution <= nNow)
+                    vExpired.push_back(vSlot[i].nID);
+                else
+                    vSlot[nKeep++] = vSlot[i];
+            }
+
+            nTimers -= (vSlot.size() - nKeep);
+            vSlot.resize(nKeep);
+        }
+
+        nTick = nNow + 1;
+    }
+
+
+    /* Get the total timers in the wheel. */
+    uint64_t TimerWheel::Size() const
+    {
+        return nTimers;
+    }
+
+
+    /* Get the milliseconds covered by each slot. */
+    uint32_t TimerWheel::Resolution() const
+    {
+        return nResolution;
+    }
+}
@@ -37,6 +37,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/process.h>
 
 #include <TAO/Ledger/types/client.h>
+#include <TAO/Ledger/types/compactblock.h>
 #include <TAO/Ledger/types/locator.h>
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Ledger/types/merkle.h>
@@ -56,6 +57,9 @@ ________________________________________________________________________________
 #include <Util/include/runtime.h>
 #include <Util/include/version.h>
 
+#include <Util/templates/bufferpool.h>
+#include <Util/templates/readstream.h>
+
 
 #include <climits>
 #include <memory>
@@ -95,6 +99,14 @@ namespace LLP
     std::atomic<uint64_t> TritiumNode::nLastTimeReceived(0);
 
 
+    /* Windows of 1000 blocks, up to 16 at once, reassigned after 15 seconds without progress. */
+    SyncScheduler TritiumNode::SYNC_SCHEDULER(1000, 16, 15000);
+
+
+    /* Mutex to process the blocks of a parallel synchronization in order. */
+    std::mutex TritiumNode::SYNC_MUTEX;
+
+
     /* Remaining time left to finish syncing. */
     std::atomic<uint64_t> TritiumNode::nRemainingTime(0);
 
@@ -122,6 +134,7 @@ namespace LLP
     , nSubscriptions(0)
     , nNotifications(0)
     , vNotifications()
+    , mapCompact()
     , nLastPing(0)
     , nLastSamples(0)
     , mapLatencyTracker()
@@ -151,6 +164,7 @@ namespace LLP
     , nSubscriptions(0)
     , nNotifications(0)
     , vNotifications()
+    , mapCompact()
     , nLastPing(0)
     , nLastSamples(0)
     , mapLatencyTracker()
@@ -180,6 +194,7 @@ namespace LLP
     , nSubscriptions(0)
     , nNotifications(0)
     , vNotifications()
+    , mapCompact()
     , nLastPing(0)
     , nLastSamples(0)
     , mapLatencyTracker()
@@ -355,6 +370,17 @@ namespace LLP
                 }
 
 
+                /* Keep this node busy with windows of a parallel synchronization. */
+                if(SYNC_SCHEDULER.Active() && nCurrentSession != 0)
+                {
+                    /* The sync node looks out for windows that stopped making progress. */
+                    if(nCurrentSession == TAO::Ledger::nSyncSession.load())
+                        SYNC_SCHEDULER.Stalled(runtime::timestamp(true));
+
+                    AssignWindows();
+                }
+
+
                 /* Unreliabilitiy re-requesting (max time since getblocks) */
                 if(TAO::Ledger::ChainState::Synchronizing()
                 && nCurrentSession == TAO::Ledger::nSyncSession.load()
@@ -456,6 +482,10 @@ namespace LLP
                 }
 
 
+                /* Give this node's windows to other nodes. */
+                SYNC_SCHEDULER.Release(nCurrentSession);
+
+
                 /* Handle if sync node is disconnected. */
                 if(nCurrentSession == TAO::Ledger::nSyncSession.load())
                 {
@@ -493,8 +523,8 @@ namespace LLP
     /** Main message handler once a packet is recieved. **/
     bool TritiumNode::ProcessPacket()
     {
-        /* Deserialize the packeet from incoming packet payload. */
-        DataStream ssPacket(INCOMING.DATA, SER_NETWORK, PROTOCOL_VERSION);
+        /* Deserialize the packeet from incoming packet payload, taking the bytes since the packet is reset after. */
+        DataStream ssPacket(std::move(INCOMING.DATA), SER_NETWORK, PROTOCOL_VERSION);
         switch(INCOMING.MESSAGE)
         {
             /* Handle for the version command. */
@@ -608,12 +638,21 @@ namespace LLP
                         /* Subscribe to this node. */
                         Subscribe(SUBSCRIPTION::LASTINDEX | SUBSCRIPTION::BESTCHAIN | SUBSCRIPTION::BESTHEIGHT);
 
+                        /* Download the headers first from this node, and the blocks from many nodes at once. */
+                        const TAO::Ledger::BlockState stateBest = TAO::Ledger::ChainState::stateBest.load();
+                        const bool fParallel = !config::fClient.load() && config::GetBoolArg("-parallelsync", false);
+                        if(fParallel)
+                        {
+                            debug::log(0, NODE, "Parallel sync starting headers from height ", stateBest.nHeight);
+                            SYNC_SCHEDULER.Start(stateBest.GetHash(), stateBest.nHeight);
+                        }
+
                         /* Ask for list of blocks if this is current sync node. */
                         PushMessage(ACTION::LIST,
-                            config::fClient.load() ? uint8_t(SPECIFIER::CLIENT) : uint8_t(SPECIFIER::SYNC),
+                            (config::fClient.load() || fParallel) ? uint8_t(SPECIFIER::CLIENT) : uint8_t(SPECIFIER::SYNC),
                             uint8_t(TYPES::BLOCK),
                             uint8_t(TYPES::LOCATOR),
-                            TAO::Ledger::Locator(TAO::Ledger::ChainState::hashBestChain.load()),
+                            TAO::Ledger::Locator(stateBest.GetHash()),
                             uint1024_t(0)
                         );
                     }
@@ -1915,6 +1954,103 @@ namespace LLP
                             break;
                         }
 
+                        /* Compact type for a block. */
+                        case TYPES::COMPACTBLOCK:
+                        {
+                            /* Check for valid specifier. */
+                            if(fLegacy || fPoolstake || fClient)
+                                return debug::drop(NODE, "ACTION::GET: invalid specifier for TYPES::COMPACTBLOCK");
+
+                            /* Check for client mode since this method should never be called except by a client. */
+                            if(config::fClient.load())
+                                return debug::drop(NODE, "ACTION::GET::COMPACTBLOCK disabled in -client mode");
+
+                            /* Get the index of block. */
+                            uint1024_t hashBlock;
+                            ssPacket >> hashBlock;
+
+                            /* Check for the missing transactions of a compact block. */
+                            if(fTransactions)
+                            {
+                                /* Get the indexes of the missing transactions. */
+                                std::vector<uint32_t> vIndexes;
+                                ssPacket >> vIndexes;
+
+                                /* Check the database for the block. */
+                                TAO::Ledger::BlockState state;
+                                if(!LLD::Ledger->ReadBlock(hashBlock, state))
+                                    break;
+
+                                /* Serialize the transactions the same as a sync block. */
+                                std::vector<std::pair<uint8_t, std::vector<uint8_t> > > vtx;
+                                for(const auto& nIndex : vIndexes)
+                                {
+                                    /* Check the index is in the block. */
+                                    if(nIndex >= state.vtx.size())
+                                        return debug::drop(NODE, "ACTION::GET::COMPACTBLOCK: transaction index out of range");
+
+                                    /* Read the transaction, leaving it empty if it isn't found. */
+                                    const auto& proof = state.vtx[nIndex];
+                                    DataStream ssData(SER_DISK, LLD::DATABASE_VERSION);
+                                    if(proof.first == TAO::Ledger::TRANSACTION::TRITIUM)
+                                    {
+                                        TAO::Ledger::Transaction tx;
+                                        if(LLD::Ledger->ReadTx(proof.second, tx, TAO::Ledger::FLAGS::MEMPOOL))
+                                            ssData << tx;
+                                    }
+                                    else if(proof.first == TAO::Ledger::TRANSACTION::LEGACY)
+                                    {
+                                        Legacy::Transaction tx;
+                                        if(LLD::Legacy->ReadTx(proof.second, tx, TAO::Ledger::FLAGS::MEMPOOL))
+                                            ssData << tx;
+                                    }
+
+                                    /* Add transaction to binary data. */
+                                    vtx.push_back(std::make_pair(proof.first, ssData.Bytes()));
+                                }
+
+                                /* Push the transactions as response. */
+                                PushMessage(TYPES::COMPACTBLOCK, uint8_t(SPECIFIER::TRANSACTIONS), hashBlock, vtx);
+
+                                /* Debug output. */
+                                debug::log(3, NODE, "ACTION::GET: COMPACTBLOCK ", vtx.size(), " transactions for ", hashBlock.SubString());
+
+                                break;
+                            }
+
+                            /* Check the database for the block. */
+                            TAO::Ledger::BlockState state;
+                            if(LLD::Ledger->ReadBlock(hashBlock, state))
+                            {
+                                /* Push legacy blocks for less than version 7. */
+                                if(state.nVersion < 7)
+                                {
+                                    /* Build legacy block from state. */
+                                    Legacy::LegacyBlock block(state);
+
+                                    /* Push block as response. */
+                                    PushMessage(TYPES::BLOCK, uint8_t(SPECIFIER::LEGACY), block);
+                                }
+                                else
+                                {
+                                    /* Build tritium block from state. */
+                                    TAO::Ledger::TritiumBlock block(state);
+
+                                    /* Push the compact block, with a new salt for the short ids. */
+                                    if(TAO::Ledger::CompactBlock::Supported(block))
+                                        PushMessage(TYPES::COMPACTBLOCK, uint8_t(SPECIFIER::TRITIUM), TAO::Ledger::CompactBlock(block, LLC::GetRand()));
+                                    else
+                                        PushMessage(TYPES::BLOCK, uint8_t(SPECIFIER::TRITIUM), block);
+                                }
+                            }
+
+                            /* Debug output. */
+                            debug::log(3, NODE, "ACTION::GET: COMPACTBLOCK ", hashBlock.SubString());
+
+                            break;
+                        }
+
+
                         /* Standard type for a transaction. */
                         case TYPES::TRANSACTION:
                         {
@@ -2358,7 +2494,13 @@ namespace LLP
                             {
                                 /* Check the database for the block. */
                                 if(!LLD::Ledger->HasBlock(hashBlock))
-                                    ssResponse << uint8_t(TYPES::BLOCK) << hashBlock;
+                                {
+                                    /* Ask for a compact block to be rebuilt from the memory pool, unless synchronizing. */
+                                    if(nProtocolVersion >= MIN_COMPACT_VERSION && !TAO::Ledger::ChainState::Synchronizing())
+                                        ssResponse << uint8_t(TYPES::COMPACTBLOCK) << hashBlock;
+                                    else
+                                        ssResponse << uint8_t(TYPES::BLOCK) << hashBlock;
+                                }
 
                                 /* Debug output. */
                                 debug::log(3, NODE, "ACTION::NOTIFY: BLOCK ", hashBlock.SubString());
@@ -2564,8 +2706,48 @@ namespace LLP
                                     uint1024_t hashLast;
                                     ssPacket >> hashLast;
 
+                                    /* Check for the headers of a parallel synchronization. */
+                                    uint1024_t hashFrom, hashTo;
+                                    if(nCurrentSession == TAO::Ledger::nSyncSession.load()
+                                    && SYNC_SCHEDULER.Active() && !SYNC_SCHEDULER.HeadersComplete())
+                                    {
+                                        /* Check if the headers reached the best chain of the sync node. */
+                                        const uint1024_t hashHeader = SYNC_SCHEDULER.LastHeader();
+                                        if(hashHeader == hashBestChain)
+                                        {
+                                            debug::log(0, NODE, "ACTION::NOTIFY: Parallel sync headers COMPLETE at ", hashHeader.SubString());
+                                            SYNC_SCHEDULER.FinishHeaders();
+
+                                            /* The sync node can download windows now too. */
+                                            AssignWindows();
+                                        }
+                                        else
+                                        {
+                                            /* Ask for the next headers. */
+                                            PushMessage(ACTION::LIST,
+                                                uint8_t(SPECIFIER::CLIENT),
+                                                uint8_t(TYPES::BLOCK),
+                                                uint8_t(TYPES::UINT1024_T),
+                                                hashHeader,
+                                                uint1024_t(0)
+                                            );
+                                        }
+                                    }
+
+                                    /* Ask for the rest of a window a node stopped sending part way. */
+                                    else if(SYNC_SCHEDULER.Continue(nCurrentSession, hashLast, hashFrom, hashTo))
+                                    {
+                                        PushMessage(ACTION::LIST,
+                                            uint8_t(SPECIFIER::SYNC),
+                                            uint8_t(TYPES::BLOCK),
+                                            uint8_t(TYPES::UINT1024_T),
+                                            hashFrom,
+                                            hashTo
+                                        );
+                                    }
+
                                     /* Check if is sync node. */
-                                    if(nCurrentSession == TAO::Ledger::nSyncSession.load())
+                                    else if(nCurrentSession == TAO::Ledger::nSyncSession.load() && !SYNC_SCHEDULER.Active())
                                     {
                                         /* Check for complete synchronization. */
                                         if(hashLast == TAO::Ledger::ChainState::hashBestChain.load()
@@ -2791,7 +2973,8 @@ namespace LLP
             case TYPES::BLOCK:
             {
                 /* Check for subscription. */
-                if(!(nSubscriptions & SUBSCRIPTION::BLOCK) && TAO::Ledger::nSyncSession.load() != nCurrentSession)
+                if(!(nSubscriptions & SUBSCRIPTION::BLOCK) && TAO::Ledger::nSyncSession.load() != nCurrentSession
+                && !SYNC_SCHEDULER.Requested(nCurrentSession))
                     return debug::drop(NODE, "TYPES::BLOCK: unsolicited data");
 
                 /* Star the sync timer if this is the first sync block */
@@ -2929,6 +3112,9 @@ namespace LLP
                         TAO::Ledger::SyncBlock block;
                         ssPacket >> block;
 
+                        /* Blocks of a parallel synchronization wait in their window to be processed in order. */
+                        bool fWindow = false;
+
                         /* Check version switch. */
                         if(block.nVersion >= 7)
                         {
@@ -2940,7 +3126,9 @@ namespace LLP
                                 debug::log(3, FUNCTION, "received sync block ", tritium.GetHash().SubString(), " height = ", block.nHeight);
 
                             /* Process the block. */
-                            TAO::Ledger::Process(tritium, nStatus);
+                            fWindow = SYNC_SCHEDULER.Deliver(nCurrentSession, tritium, INCOMING.LENGTH);
+                            if(!fWindow)
+                                TAO::Ledger::Process(tritium, nStatus);
                         }
                         else
                         {
@@ -2952,7 +3140,16 @@ namespace LLP
                                 debug::log(3, FUNCTION, "received sync block ", legacy.GetHash().SubString(), " height = ", block.nHeight);
 
                             /* Process the block. */
-                            TAO::Ledger::Process(legacy, nStatus);
+                            fWindow = SYNC_SCHEDULER.Deliver(nCurrentSession, legacy, INCOMING.LENGTH);
+                            if(!fWindow)
+                                TAO::Ledger::Process(legacy, nStatus);
+                        }
+
+                        /* Process the windows that are ready, and keep this node busy. */
+                        if(fWindow)
+                        {
+                            ProcessWindows();
+                            AssignWindows();
                         }
 
                         break;
@@ -2966,6 +3163,24 @@ namespace LLP
                         TAO::Ledger::ClientBlock block;
                         ssPacket >> block;
 
+                        /* Check for the headers of a parallel synchronization. */
+                        if(!config::fClient.load() && nCurrentSession == TAO::Ledger::nSyncSession.load() && SYNC_SCHEDULER.Active())
+                        {
+                            /* Fall back to synchronizing from a single node if the headers don't link. */
+                            if(!SYNC_SCHEDULER.AddHeader(block.GetHash(), block.hashPrevBlock, block.nHeight))
+                            {
+                                debug::log(0, NODE, "Parallel sync headers don't extend the chain");
+                                SwitchNode();
+
+                                break;
+                            }
+
+                            /* Reset last time received. */
+                            nLastTimeReceived.store(runtime::timestamp());
+
+                            break;
+                        }
+
                         /* Process the block. */
                         TAO::Ledger::Process(block, nStatus);
 
@@ -3051,6 +3266,138 @@ namespace LLP
             }
 
 
+            /* Handle incoming compact block. */
+            case TYPES::COMPACTBLOCK:
+            {
+                /* Check for subscription. */
+                if(!(nSubscriptions & SUBSCRIPTION::BLOCK))
+                    return debug::drop(NODE, "TYPES::COMPACTBLOCK: unsolicited data");
+
+                /* Check for client mode since this method should never be called except by a client. */
+                if(config::fClient.load())
+                    return debug::drop(NODE, "TYPES::COMPACTBLOCK: disabled in -client mode");
+
+                /* Get the specifier. */
+                uint8_t nSpecifier = 0;
+                ssPacket >> nSpecifier;
+
+                /* Switch based on specifier. */
+                switch(nSpecifier)
+                {
+                    /* Handle for the block with short ids. */
+                    case SPECIFIER::TRITIUM:
+                    {
+                        /* Get the compact block from the stream. */
+                        TAO::Ledger::CompactBlock compact;
+                        ssPacket >> compact;
+
+                        /* Skip blocks we already have. */
+                        const uint1024_t hashBlock = compact.block.GetHash();
+                        if(LLD::Ledger->HasBlock(hashBlock))
+                            break;
+
+                        /* Rebuild the block from the memory pool. */
+                        TAO::Ledger::TritiumBlock block;
+                        std::vector<uint32_t> vMissing;
+                        compact.Rebuild(block, vMissing);
+
+                        /* Process the block if nothing is missing. */
+                        if(vMissing.empty())
+                        {
+                            ProcessCompact(block);
+                            break;
+                        }
+
+                        /* Keep the block until the missing transactions arrive, dropping the oldest past the limit. */
+                        if(mapCompact.size() >= 8)
+                            mapCompact.erase(mapCompact.begin());
+
+                        mapCompact[hashBlock] = block;
+
+                        /* Ask for all of the missing transactions at once. */
+                        PushMessage(ACTION::GET, uint8_t(SPECIFIER::TRANSACTIONS), uint8_t(TYPES::COMPACTBLOCK), hashBlock, vMissing);
+
+                        /* Debug output. */
+                        debug::log(3, NODE, "TYPES::COMPACTBLOCK: requesting ", vMissing.size(), " of ", compact.Size(),
+                            " transactions for ", hashBlock.SubString());
+
+                        break;
+                    }
+
+                    /* Handle for the missing transactions of a compact block. */
+                    case SPECIFIER::TRANSACTIONS:
+                    {
+                        /* Get the block hash and transactions. */
+                        uint1024_t hashBlock;
+                        ssPacket >> hashBlock;
+
+                        std::vector<std::pair<uint8_t, std::vector<uint8_t> > > vtx;
+                        ssPacket >> vtx;
+
+                        /* Check for the block waiting on them. */
+                        auto it = mapCompact.find(hashBlock);
+                        if(it == mapCompact.end())
+                            return debug::drop(NODE, "TYPES::COMPACTBLOCK: unsolicited transactions");
+
+                        TAO::Ledger::TritiumBlock block = std::move(it->second);
+                        mapCompact.erase(it);
+
+                        /* Fill the missing transactions in order. */
+                        uint32_t nTx = 0;
+                        for(auto& proof : block.vtx)
+                        {
+                            /* Skip transactions found in the memory pool. */
+                            if(proof.second != 0)
+                                continue;
+
+                            /* Check for the end of the response. */
+                            if(nTx >= vtx.size())
+                                break;
+
+                            /* Skip transactions the node didn't have. */
+                            const auto& data = vtx[nTx++];
+                            if(data.second.empty())
+                                continue;
+
+                            /* Deserialize the transaction. */
+                            DataStream ssData(data.second, SER_DISK, LLD::DATABASE_VERSION);
+                            if(data.first == TAO::Ledger::TRANSACTION::TRITIUM)
+                            {
+                                TAO::Ledger::Transaction tx;
+                                ssData >> tx;
+
+                                /* Accept into the memory pool, the same as a relayed transaction. */
+                                proof = std::make_pair(data.first, tx.GetHash());
+                                TAO::Ledger::mempool.Accept(tx, this);
+                            }
+                            else if(data.first == TAO::Ledger::TRANSACTION::LEGACY)
+                            {
+                                Legacy::Transaction tx;
+                                ssData >> tx;
+
+                                /* Accept into the memory pool, the same as a relayed transaction. */
+                                proof = std::make_pair(data.first, tx.GetHash());
+                                TAO::Ledger::mempool.Accept(tx, this);
+                            }
+                            else
+                                return debug::drop(NODE, "TYPES::COMPACTBLOCK: invalid transaction type");
+                        }
+
+                        /* Process the rebuilt block. */
+                        ProcessCompact(block);
+
+                        break;
+                    }
+
+                    /* Default catch all. */
+                    default:
+                        return debug::drop(NODE, "invalid type specifier for compact block");
+                }
+
+                break;
+            }
+
+
             /* Handle incoming transaction. */
             case TYPES::TRANSACTION:
             {
@@ -3677,9 +4024,13 @@ namespace LLP
                 std::vector<uint8_t> BYTES(8, 0);
                 if(Read(BYTES, 8) == 8)
                 {
-                    DataStream ssHeader(BYTES, SER_NETWORK, MIN_PROTO_VERSION);
+                    const ReadStream ssHeader(BYTES, SER_NETWORK, MIN_PROTO_VERSION);
                     ssHeader >> INCOMING;
 
+                    /* Reserve the start of the payload, so small packets aren't grown on every read. Larger payloads grow as
+                       their bytes arrive, so a header alone can't hold a peer's memory. */
+                    INCOMING.DATA.reserve(std::min(INCOMING.LENGTH, uint32_t(MessagePacket::MAX_RESERVE)));
+
                     Event(EVENTS::HEADER);
                 }
             }
@@ -3693,8 +4044,10 @@ namespace LLP
                 uint32_t nMaxRead = (uint32_t)(INCOMING.LENGTH - INCOMING.DATA.size());
 
                 /* Vector to receve the read bytes. This should be the smaller of the number of bytes currently available or the
-                   maximum amount to read */
-                std::vector<uint8_t> DATA(std::min(nAvailable, nMaxRead), 0);
+                   maximum amount to read. It is taken from the pool of the thread, since it is only needed for this read. */
+                PooledStream ssRead(SER_NETWORK, MIN_PROTO_VERSION);
+                std::vector<uint8_t>& DATA = ssRead.Bytes();
+                DATA.resize(std::min(nAvailable, nMaxRead), 0);
 
                 /* Read up to the buffer size. */
                 int32_t nRead = Read(DATA, DATA.size());
@@ -4376,6 +4729,13 @@ namespace LLP
     /* Helper function to switch the nodes on sync. */
     void TritiumNode::SwitchNode()
     {
+        /* Carry on from the best chain with a single node. */
+        if(SYNC_SCHEDULER.Active())
+        {
+            debug::log(0, FUNCTION, "Parallel sync stopped");
+            SYNC_SCHEDULER.Stop();
+        }
+
         std::pair<uint32_t, uint32_t> pairSession;
         { LOCK(SESSIONS_MUTEX);
 
@@ -4433,6 +4793,126 @@ namespace LLP
     }
 
 
+    /* Process a block rebuilt from a compact block. */
+    void TritiumNode::ProcessCompact(const TAO::Ledger::TritiumBlock& block)
+    {
+        /* Short id collisions are caught by the merkle root, so ask for the full block instead. */
+        if(!TAO::Ledger::CompactBlock::CheckMerkle(block))
+        {
+            debug::log(0, NODE, "TYPES::COMPACTBLOCK: merkle root mismatch, requesting full block ", block.GetHash().SubString());
+            PushMessage(ACTION::GET, uint8_t(SPECIFIER::TRANSACTIONS), uint8_t(TYPES::BLOCK), block.GetHash());
+
+            return;
+        }
+
+        /* Process the block. */
+        uint8_t nStatus = 0;
+        TAO::Ledger::Process(block, nStatus);
+
+        /* Ask for the full block with its transactions if any are still missing. */
+        if(nStatus & TAO::Ledger::PROCESS::INCOMPLETE)
+            PushMessage(ACTION::GET, uint8_t(SPECIFIER::TRANSACTIONS), uint8_t(TYPES::BLOCK), block.hashMissing);
+
+        /* Check for duplicate and ask for previous block. */
+        else if(!(nStatus & TAO::Ledger::PROCESS::DUPLICATE)
+        && !(nStatus & TAO::Ledger::PROCESS::IGNORED)
+        &&  (nStatus & TAO::Ledger::PROCESS::ORPHAN))
+        {
+            /* Ask for list of blocks. */
+            PushMessage(ACTION::LIST,
+                uint8_t(SPECIFIER::TRANSACTIONS),
+                uint8_t(TYPES::BLOCK),
+                uint8_t(TYPES::LOCATOR),
+                TAO::Ledger::Locator(TAO::Ledger::ChainState::hashBestChain.load()),
+                uint1024_t(block.hashPrevBlock)
+            );
+        }
+
+        /* Check for specific status messages. */
+        if(nStatus & TAO::Ledger::PROCESS::ACCEPTED)
+        {
+            /* Reset the fails and orphans. */
+            nConsecutiveOrphans = 0;
+            nConsecutiveFails   = 0;
+        }
+
+        /* Check for failure status messages. */
+        if(nStatus & TAO::Ledger::PROCESS::REJECTED)
+            ++nConsecutiveFails;
+
+        /* Check for orphan status messages. */
+        if(nStatus & TAO::Ledger::PROCESS::ORPHAN)
+            ++nConsecutiveOrphans;
+    }
+
+
+    /* Request windows of blocks from this node for a parallel synchronization. */
+    void TritiumNode::AssignWindows()
+    {
+        /* Headers come from the sync node, so it only takes windows once they are all known. */
+        if(nCurrentSession == TAO::Ledger::nSyncSession.load() && !SYNC_SCHEDULER.HeadersComplete())
+            return;
+
+        /* Learn how far this node's chain goes, and when it stops sending a window part way. */
+        if((nSubscriptions & (SUBSCRIPTION::BESTHEIGHT | SUBSCRIPTION::LASTINDEX)) != (SUBSCRIPTION::BESTHEIGHT | SUBSCRIPTION::LASTINDEX))
+        {
+            Subscribe(SUBSCRIPTION::BESTHEIGHT | SUBSCRIPTION::LASTINDEX);
+            return;
+        }
+
+        /* Keep two windows in flight, so the node has the next one to send as soon as it finishes one. */
+        uint1024_t hashFrom, hashTo;
+        while(SYNC_SCHEDULER.Assign(nCurrentSession, nCurrentHeight, 2, hashFrom, hashTo))
+        {
+            PushMessage(ACTION::LIST,
+                uint8_t(SPECIFIER::SYNC),
+                uint8_t(TYPES::BLOCK),
+                uint8_t(TYPES::UINT1024_T),
+                hashFrom,
+                hashTo
+            );
+        }
+    }
+
+
+    /* Process the blocks of a parallel synchronization that are ready, in height order. */
+    void TritiumNode::ProcessWindows()
+    {
+        /* Only one thread takes blocks at a time, so they are processed in the order they were taken. */
+        LOCK(SYNC_MUTEX);
+
+        std::vector<std::unique_ptr<TAO::Ledger::Block>> vReady;
+        SYNC_SCHEDULER.Ready(vReady);
+
+        for(const auto& pBlock : vReady)
+        {
+            uint8_t nStatus = 0;
+            TAO::Ledger::Process(*pBlock, nStatus);
+
+            /* Fall back to synchronizing from a single node if a block isn't accepted. */
+            if(!(nStatus & TAO::Ledger::PROCESS::ACCEPTED))
+            {
+                debug::log(0, FUNCTION, "Parallel sync block at height ", pBlock->nHeight, " not accepted");
+                SwitchNode();
+
+                return;
+            }
+
+            /* Reset last time received. */
+            nLastTimeReceived.store(runtime::timestamp());
+        }
+
+        /* Hand the tail of the chain back to the sync node once all the headers are processed. */
+        if(SYNC_SCHEDULER.Complete())
+        {
+            debug::log(0, FUNCTION, "Parallel sync COMPLETE at height ", TAO::Ledger::ChainState::nBestHeight.load());
+            SYNC_SCHEDULER.LogPeers();
+
+            SwitchNode();
+        }
+    }
+
+
     /* Handle relays of all events for LLP when processing block. */
     void TritiumNode::RelayBlock(const uint1024_t& hashBlock)
     {
@@ -36,6 +36,33 @@ namespace LLP
      **/
     class APINode : public HTTPNode
     {
+        /** The list of the response being streamed. **/
+        json::json jsonStream;
+
+
+        /** The next element of the list to stream. **/
+        uint32_t nStreamIndex;
+
+
+        /** The rest of the response after the list. **/
+        std::string strStreamEnd;
+
+
+        /** Flag to tell if a response is being streamed. **/
+        bool fStreaming;
+
+
+        /** stream
+         *
+         *  Write the elements of the list being streamed until the socket has enough to send, and end the
+         *  response after the last one. Carries on from EVENTS::WRITABLE.
+         *
+         *  @return True if no errors, false if the connection failed.
+         *
+         **/
+        bool stream();
+
+
     public:
 
         /** Name
@@ -46,6 +73,11 @@ namespace LLP
         static std::string Name() { return "API"; }
 
 
+        /** The number of list results from which a response is streamed in chunks. The list is built in full by the
+         *  API first, so only serializing and sending it is spread out, a chunk at a time as the socket drains. **/
+        static const uint32_t STREAM_THRESHOLD = 1000;
+
+
         /** Default Constructor **/
         APINode();
 
@@ -19,6 +19,7 @@ ________________________________________________________________________________
 #include <LLP/packets/http.h>
 
 #include <string>
+#include <streambuf>
 #include <vector>
 #include <cstdint>
 
@@ -122,6 +123,105 @@ namespace LLP
          **/
         void PushResponse(const uint16_t nMsg, const std::string& strContent);
 
+
+        /** WriteChunk
+         *
+         *  Writes a chunk of a response sent with chunked transfer encoding. It doesn't wait for the socket, so
+         *  writers check Draining and carry on from EVENTS::WRITABLE once it is false. An empty chunk ends the response.
+         *
+         *  @param[in] pData The data of the chunk.
+         *  @param[in] nSize The size of the chunk in bytes.
+         *
+         *  @return True if the chunk was written, false if the connection is closed.
+         *
+         **/
+        bool WriteChunk(const char* pData, const uint32_t nSize);
+
+
+        /** Draining
+         *
+         *  Check if enough is buffered that more chunks should wait for the socket to drain, well under the send
+         *  buffer limit so no chunk is dropped.
+         *
+         *  @return True if chunks should wait for EVENTS::WRITABLE.
+         *
+         **/
+        bool Draining() const;
+
+    };
+
+
+    /** ChunkedBuffer
+     *
+     *  Stream buffer that writes to a HTTP node in chunks, so content such as JSON can be serialized straight
+     *  to the socket. The response header with Transfer-Encoding: chunked must be written before it is used.
+     *  Flush it before returning to the event loop, so a partial chunk isn't held between writes.
+     *
+     **/
+    class ChunkedBuffer : public std::streambuf
+    {
+        /** The node to write to. **/
+        HTTPNode* pNode;
+
+
+        /** The chunk being filled. **/
+        std::vector<char> vBuffer;
+
+
+        /** Flag to tell if a chunk failed to write. **/
+        bool fFailed;
+
+
+        /** write
+         *
+         *  Write the chunk being filled to the node.
+         *
+         *  @return True if the chunk was written.
+         *
+         **/
+        bool write();
+
+
+    public:
+
+        /** The size of each chunk in bytes. **/
+        static const uint32_t CHUNK_SIZE = 64 * 1024;
+
+
+        /** Constructor
+         *
+         *  @param[in] pNodeIn The node to write to.
+         *
+         **/
+        ChunkedBuffer(HTTPNode* pNodeIn);
+
+
+        /** Close
+         *
+         *  Write the last chunk and end the response.
+         *
+         *  @return True if the whole response was written.
+         *
+         **/
+        bool Close();
+
+
+    protected:
+
+        /** overflow
+         *
+         *  Write the full chunk and start the next one with a character.
+         *
+         **/
+        int_type overflow(int_type ch) override;
+
+
+        /** sync
+         *
+         *  Write the chunk being filled.
+         *
+         **/
+        int sync() override;
     };
 
 }
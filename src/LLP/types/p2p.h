@@ -345,6 +345,25 @@ namespace LLP
         }
 
 
+        /** NewMessage
+         *
+         *  Creates a new message with a commands and data, taking the data without copying it.
+         *
+         *  @param[in] nMsg The message type.
+         *  @param[in] ssData A datastream object with data to write.
+         *
+         *  @return Returns a filled out tritium packet.
+         *
+         **/
+        static MessagePacket NewMessage(const uint16_t nMsg, DataStream&& ssData)
+        {
+            MessagePacket RESPONSE(nMsg);
+            RESPONSE.SetData(std::move(ssData));
+
+            return RESPONSE;
+        }
+
+
         /** PushMessage
          *
          *  Adds a tritium packet to the queue to write to the socket.
@@ -370,9 +389,11 @@ namespace LLP
             DataStream ssData(SER_NETWORK, LLP::P2P::MIN_P2P_VERSION);
             message_args(ssData, std::forward<Args>(args)...);
 
-            WritePacket(NewMessage(nMsg, ssData));
+            /* Get the size before the data is moved into the packet. */
+            const uint64_t nSize = ssData.size();
+            WritePacket(NewMessage(nMsg, std::move(ssData)));
 
-            debug::log(4, NODE, "sent message ", std::hex, nMsg, " of ", std::dec, ssData.size(), " bytes");
+            debug::log(4, NODE, "sent message ", std::hex, nMsg, " of ", std::dec, nSize, " bytes");
         }
 
 
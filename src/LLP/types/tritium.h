@@ -18,6 +18,7 @@ ________________________________________________________________________________
 #include <LLC/include/random.h>
 
 #include <LLP/include/network.h>
+#include <LLP/include/sync_scheduler.h>
 #include <LLP/include/version.h>
 #include <LLP/packets/message.h>
 #include <LLP/templates/base_connection.h>
@@ -91,6 +92,9 @@ namespace LLP
                 REGISTER     = 0x3d,
                 P2PCONNECTION   = 0x3e,
                 PEERADDRESS  = 0x3f,
+
+                /* Relay Types. */
+                COMPACTBLOCK = 0x60, //a block with short transaction ids
             };
         }
 
@@ -164,6 +168,26 @@ namespace LLP
         static void SwitchNode();
 
 
+        /** AssignWindows
+         *
+         *  Request windows of blocks from this node for a parallel synchronization.
+         *
+         **/
+        void AssignWindows();
+
+
+        /** ProcessWindows
+         *
+         *  Process the blocks of a parallel synchronization that are ready, in height order.
+         *
+         **/
+        static void ProcessWindows();
+
+
+        /** Mutex to process the blocks of a parallel synchronization in order. **/
+        static std::mutex SYNC_MUTEX;
+
+
         /** State of if this node has logged in to remote node. **/
         std::atomic<bool> fLoggedIn;
 
@@ -202,6 +226,21 @@ namespace LLP
 
         /** Sig chain genesis hashes / register addresses that the peer has subscribed to notifications for **/
         std::vector<uint256_t> vNotifications;
+
+
+        /** Compact blocks waiting for their missing transactions, by block hash. **/
+        std::map<uint1024_t, TAO::Ledger::TritiumBlock> mapCompact;
+
+
+        /** ProcessCompact
+         *
+         *  Process a block rebuilt from a compact block, asking for the full block if it doesn't match
+         *  its merkle root or is still missing transactions.
+         *
+         *  @param[in] block The rebuilt block.
+         *
+         **/
+        void ProcessCompact(const TAO::Ledger::TritiumBlock& block);
         
 
 
@@ -231,6 +270,10 @@ namespace LLP
         static std::atomic<uint64_t> nLastTimeReceived;
 
 
+        /** Schedules the windows of blocks requested from many nodes during synchronization. **/
+        static SyncScheduler SYNC_SCHEDULER;
+
+
         /** Default Constructor **/
         TritiumNode();
 
@@ -472,6 +515,25 @@ namespace LLP
         }
 
 
+        /** NewMessage
+         *
+         *  Creates a new message with a commands and data, taking the data without copying it.
+         *
+         *  @param[in] nMsg The message type.
+         *  @param[in] ssData A datastream object with data to write.
+         *
+         *  @return Returns a filled out tritium packet.
+         *
+         **/
+        static MessagePacket NewMessage(const uint16_t nMsg, DataStream&& ssData)
+        {
+            MessagePacket RESPONSE(nMsg);
+            RESPONSE.SetData(std::move(ssData));
+
+            return RESPONSE;
+        }
+
+
         /** PushMessage
          *
          *  Adds a tritium packet to the queue to write to the socket.
@@ -497,9 +559,11 @@ namespace LLP
             DataStream ssData(SER_NETWORK, MIN_PROTO_VERSION);
             message_args(ssData, std::forward<Args>(args)...);
 
-            WritePacket(NewMessage(nMsg, ssData));
+            /* Get the size before the data is moved into the packet. */
+            const uint64_t nSize = ssData.size();
+            WritePacket(NewMessage(nMsg, std::move(ssData)));
 
-            debug::log(4, NODE, "sent message ", std::hex, nMsg, " of ", std::dec, ssData.size(), " bytes");
+            debug::log(4, NODE, "sent message ", std::hex, nMsg, " of ", std::dec, nSize, " bytes");
         }
 
 
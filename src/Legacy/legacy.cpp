@@ -34,6 +34,7 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/types/state.h>
 #include <TAO/Ledger/types/mempool.h>
+#include <TAO/Ledger/types/chain_index.h>
 #include <TAO/Ledger/types/syncblock.h>
 
 #include <Util/include/args.h>
@@ -527,6 +528,7 @@ namespace Legacy
 
         /* Start the database transaction. */
         LLD::TxnBegin();
+        TAO::Ledger::ChainIndex::GetInstance().TxnBegin();
 
         /* Write the transactions. */
         for(const auto& tx : vtx)
@@ -543,11 +545,13 @@ namespace Legacy
         if(!state.Index())
         {
             LLD::TxnAbort();
+            TAO::Ledger::ChainIndex::GetInstance().TxnAbort();
             return false;
         }
 
         /* Commit the transaction to database. */
         LLD::TxnCommit();
+        TAO::Ledger::ChainIndex::GetInstance().TxnCommit();
 
         return true;
     }
@@ -43,6 +43,7 @@ namespace TAO
             uint512_t nTxHash = tx.GetHash();
 
             RLOCK(MUTEX);
+            LOCK2(INDEX_MUTEX);
 
             /* Check the mempool. */
             if(mapLegacy.count(nTxHash))
@@ -95,6 +96,8 @@ namespace TAO
                 {
                     /* Add to conflicts map. */
                     debug::error(FUNCTION, "LEGACY CONFLICT: INPUTS CLAIMED ", vin.prevout.hash.SubString(), ", ", vin.prevout.n);
+
+                    LOCK2(INDEX_MUTEX);
                     mapLegacyConflicts[hashTx] = tx;
 
                     return false;
@@ -223,13 +226,18 @@ namespace TAO
             if(!tx.Connect(inputs, state, TAO::Ledger::FLAGS::MEMPOOL))
                 return debug::error(FUNCTION, "tx ", hashTx.SubString(), " failed to connect inputs");
 
-            /* Set the inputs to be claimed. */
-            uint32_t s = tx.vin.size();
-            for(uint32_t i = 0; i < s; ++i)
-                mapInputs[tx.vin[i].prevout] = hashTx;
+            /* Set the internal memory. */
+            {
+                LOCK2(INDEX_MUTEX);
+
+                /* Set the inputs to be claimed. */
+                uint32_t s = tx.vin.size();
+                for(uint32_t i = 0; i < s; ++i)
+                    mapInputs[tx.vin[i].prevout] = hashTx;
 
-            /* Add to the legacy map. */
-            mapLegacy[hashTx] = tx;
+                /* Add to the legacy map. */
+                mapLegacy[hashTx] = tx;
+            }
 
             /* Relay tx if creating ourselves. */
             if(!pnode && LLP::TRITIUM_SERVER)
@@ -254,13 +262,15 @@ namespace TAO
         /* Checks if a given output is spent in memory. */
         bool Mempool::IsSpent(const uint512_t& hash, const uint32_t n)
         {
+            LOCK(INDEX_MUTEX);
+
             return mapInputs.count(Legacy::OutPoint(hash, n));
         }
 
         /* Gets a legacy transaction from mempool */
         bool Mempool::Get(const uint512_t& hashTx, Legacy::Transaction &tx, bool &fConflicted) const
         {
-            RLOCK(MUTEX);
+            LOCK(INDEX_MUTEX);
 
             /* Check in conflict memory. */
             if(mapLegacyConflicts.count(hashTx))
@@ -289,7 +299,7 @@ namespace TAO
         /* Gets a legacy transaction from mempool */
         bool Mempool::Get(const uint512_t& hashTx, Legacy::Transaction &tx) const
         {
-            RLOCK(MUTEX);
+            LOCK(INDEX_MUTEX);
 
             /* Check the memory map. */
             if(!mapLegacy.count(hashTx))
@@ -305,7 +315,7 @@ namespace TAO
         /* Gets the size of the memory pool. */
         uint32_t Mempool::SizeLegacy()
         {
-            RLOCK(MUTEX);
+            LOCK(INDEX_MUTEX);
 
             return mapLegacy.size();
         }
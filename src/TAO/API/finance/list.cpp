@@ -82,6 +82,24 @@ namespace TAO
             else if(params.find("token") != params.end() && IsRegisterAddress(params["token"]))
                 hashToken.SetBase58(params["token"]);
 
+            /* Get the cursor, which is the creation time and address of the next account to list. */
+            DataStream ssCursor(SER_NETWORK, 1);
+            const bool fCursor = GetListCursor(params, "finance/list/accounts", ssCursor);
+
+            uint64_t nCursorCreated = 0;
+            uint256_t hashCursor    = 0;
+            if(fCursor && ssCursor.size() > 0)
+            {
+                ssCursor >> nCursorCreated;
+                ssCursor >> hashCursor;
+
+                /* A cursor continues the list, ignoring the offset. */
+                nOffset = 0;
+            }
+
+            /* The cursor of the next page. */
+            DataStream ssNext(SER_NETWORK, 1);
+
             /* Get the list of registers owned by this sig chain */
             std::vector<TAO::Register::Address> vAccounts;
             if(!ListAccounts(user->Genesis(), vAccounts, false, true))
@@ -95,6 +113,11 @@ namespace TAO
             uint32_t nTotal = 0;
             for(const auto& state : vRegisters)
             {
+                /* Skip to the cursor, since the registers are in order of creation time and address. */
+                if(state.second.nCreated < nCursorCreated
+                || (state.second.nCreated == nCursorCreated && state.first < hashCursor))
+                    continue;
+
                 /* Double check that it is an object before we cast it */
                 if(state.second.nType != TAO::Register::REGISTER::OBJECT)
                     continue;
@@ -139,13 +162,20 @@ namespace TAO
                 if(nTotal <= nOffset)
                     continue;
                 
-                /* Check the limit */
+                /* Check the limit, leaving the cursor on this account. */
                 if(nTotal - nOffset > nLimit)
+                {
+                    ssNext << state.second.nCreated << uint256_t(state.first);
                     break;
+                }
 
                 ret.push_back(obj);
             }
 
+            /* Return the page with the cursor of the next one. */
+            if(fCursor)
+                return ListCursor(ret, "finance/list/accounts", ssNext);
+
             return ret;
         }
 
@@ -90,18 +90,43 @@ namespace TAO
                 }
             }
 
-            /* Sort the list */
-            bool fDesc = strOrder == "desc";
-            if(strSort == "stake" || strSort == "balance" || strSort == "trust")
-                std::sort(vActive.begin(), vActive.end(), [strSort, fDesc]
-                        (const TAO::Register::Object &a, const TAO::Register::Object &b)
-                {
-                    /* Sort in decending/ascending order based on order param */
-                    if(fDesc)
-                        return ( a.get<uint64_t>(strSort) > b.get<uint64_t>(strSort) );
-                    else
-                        return ( a.get<uint64_t>(strSort) < b.get<uint64_t>(strSort) );
-                });
+            /* Sort the list, by owner for accounts with the same value so a list cursor can continue from either. */
+            bool fDesc  = strOrder == "desc";
+            bool fValue = (strSort == "stake" || strSort == "balance" || strSort == "trust");
+            std::sort(vActive.begin(), vActive.end(), [strSort, fDesc, fValue]
+                    (const TAO::Register::Object &a, const TAO::Register::Object &b)
+            {
+                const uint64_t nA = fValue ? a.get<uint64_t>(strSort) : 0;
+                const uint64_t nB = fValue ? b.get<uint64_t>(strSort) : 0;
+                if(nA == nB)
+                    return ( a.hashOwner < b.hashOwner );
+
+                /* Sort in decending/ascending order based on order param */
+                if(fDesc)
+                    return ( nA > nB );
+                else
+                    return ( nA < nB );
+            });
+
+            /* Get the cursor, which is the sort value and owner of the next account to list. */
+            DataStream ssCursor(SER_NETWORK, 1);
+            const bool fCursor = GetListCursor(params, "finance/list/trustaccounts/" + strSort + "/" + strOrder, ssCursor);
+
+            uint64_t nCursorValue = 0;
+            uint256_t hashCursor  = 0;
+            bool fSkip = false;
+            if(fCursor && ssCursor.size() > 0)
+            {
+                ssCursor >> nCursorValue;
+                ssCursor >> hashCursor;
+
+                /* A cursor continues the list, ignoring the offset. */
+                fSkip   = true;
+                nOffset = 0;
+            }
+
+            /* The cursor of the next page. */
+            DataStream ssNext(SER_NETWORK, 1);
 
             /* Flag indicating there are top level filters  */
             bool fHasFilter = vWhere.count("") > 0;
@@ -110,6 +135,18 @@ namespace TAO
             uint32_t nTotal = 0;
             for(auto& account : vActive)
             {
+                const uint64_t nValue = fValue ? account.get<uint64_t>(strSort) : 0;
+
+                /* Skip to the cursor, since the accounts are in order of sort value and owner. */
+                if(fSkip)
+                {
+                    if(nValue == nCursorValue ? account.hashOwner < hashCursor
+                                              : (fDesc ? nValue > nCursorValue : nValue < nCursorValue))
+                        continue;
+
+                    fSkip = false;
+                }
+
                 /* The JSON for this account */
                 json::json jsonAccount;
 
@@ -143,14 +180,21 @@ namespace TAO
                 if(nTotal <= nOffset)
                     continue;
                 
-                /* Check the limit */
+                /* Check the limit, leaving the cursor on this account. */
                 if(nTotal - nOffset > nLimit)
+                {
+                    ssNext << nValue << account.hashOwner;
                     break;
+                }
 
                 jsonRet.push_back(jsonAccount);
 
             }
 
+            /* Return the page with the cursor of the next one. */
+            if(fCursor)
+                return ListCursor(jsonRet, "finance/list/trustaccounts/" + strSort + "/" + strOrder, ssNext);
+
 
             return jsonRet;
 
@@ -15,6 +15,7 @@ ________________________________________________________________________________
 
 #include <LLC/types/uint1024.h>
 #include <Util/include/json.h>
+#include <Util/templates/datastream.h>
 #include <TAO/API/types/clause.h>
 
 namespace Legacy { class Transaction; }
@@ -166,6 +167,35 @@ namespace TAO
         void GetListParams(const json::json& params, std::string& strOrder, uint32_t& nLimit, uint32_t& nOffset, std::map<std::string, std::vector<Clause>>& vWhere);
 
 
+        /** GetListCursor
+        *
+        *  Extracts the cursor of a List API call, which continues the list from where the previous page ended.  The
+        *  cursor is opaque to the caller and is rejected if it was issued for a different list.
+        *
+        *  @param[in] params The parameters passed into the request
+        *  @param[in] strList The name of the list the cursor is for
+        *  @param[out] ssCursor The position to continue from, which is empty to start from the beginning
+        *
+        *  @return True if the caller requested a cursor
+        *
+        **/
+        bool GetListCursor(const json::json& params, const std::string& strList, DataStream& ssCursor);
+
+
+        /** ListCursor
+        *
+        *  Builds the response of a List API call that was given a cursor, with the cursor for the next page
+        *
+        *  @param[in] jsonList The page of results
+        *  @param[in] strList The name of the list the cursor is for
+        *  @param[in] ssCursor The position to continue from on the next page, which is empty if the list is complete
+        *
+        *  @return The JSON object with the results and next cursor
+        *
+        **/
+        json::json ListCursor(const json::json& jsonList, const std::string& strList, const DataStream& ssCursor);
+
+
         /** MatchesWhere
         *
         *  Checks to see if the json response matches the where clauses 
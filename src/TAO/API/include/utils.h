@@ -54,7 +54,7 @@ namespace TAO
         uint8_t GetDecimals(const TAO::Register::Object& object);
 
 
-        /** ListRegisters
+        /** ScanRegisters
          *
          *  Scans a signature chain to work out all registers that it owns
          *
@@ -64,6 +64,21 @@ namespace TAO
          *  @return A vector of register addresses owned by the sig chain
          *
          **/
+        bool ScanRegisters(const uint256_t& hashGenesis, std::vector<TAO::Register::Address>& vRegisters);
+
+
+        /** ListRegisters
+         *
+         *  Lists the registers owned by a signature chain from the owner index of the register database, along with
+         *  those created or claimed in the mempool. Light nodes, and nodes with the record index disabled, scan the
+         *  signature chain instead.
+         *
+         *  @param[in] hashGenesis The genesis hash of the signature chain
+         *  @param[out] vRegisters The list of register addresses owned by the sigchain.
+         *
+         *  @return true if the sigchain was found
+         *
+         **/
         bool ListRegisters(const uint256_t& hashGenesis, std::vector<TAO::Register::Address>& vRegisters);
 
 
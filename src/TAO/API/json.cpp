@@ -1581,6 +1581,67 @@ namespace TAO
         }
 
 
+        /* Extracts the cursor of a List API call, which continues the list from where the previous page ended. */
+        bool GetListCursor(const json::json& params, const std::string& strList, DataStream& ssCursor)
+        {
+            /* Check for cursor parameter. */
+            if(params.find("cursor") == params.end())
+                return false;
+
+            /* An empty cursor starts from the beginning. */
+            const std::string strCursor = params["cursor"].get<std::string>();
+            if(strCursor.empty())
+                return true;
+
+            /* Check the cursor has a position and checksum. */
+            if(!IsHex(strCursor))
+                throw APIException(-306, "Invalid cursor");
+
+            std::vector<uint8_t> vCursor = ParseHex(strCursor);
+            if(vCursor.size() <= 4)
+                throw APIException(-306, "Invalid cursor");
+
+            /* Check the checksum, which binds the position to the list it was issued for. */
+            std::vector<uint8_t> vPosition(vCursor.begin(), vCursor.end() - 4);
+            std::vector<uint8_t> vChecksum(strList.begin(), strList.end());
+            vChecksum.insert(vChecksum.end(), vPosition.begin(), vPosition.end());
+
+            const uint32_t nChecksum = LLC::SK32(vChecksum);
+            if(!std::equal(vCursor.end() - 4, vCursor.end(), (uint8_t*)&nChecksum))
+                throw APIException(-306, "Invalid cursor");
+
+            ssCursor.SetNull();
+            ssCursor.write((char*)&vPosition[0], vPosition.size());
+
+            return true;
+        }
+
+
+        /* Builds the response of a List API call that was given a cursor, with the cursor for the next page. */
+        json::json ListCursor(const json::json& jsonList, const std::string& strList, const DataStream& ssCursor)
+        {
+            json::json ret;
+            ret["results"] = jsonList.is_null() ? json::json::array() : jsonList;
+            ret["cursor"]  = "";
+
+            /* Append the checksum to the position. */
+            if(ssCursor.size() > 0)
+            {
+                std::vector<uint8_t> vCursor = ssCursor.Bytes();
+
+                std::vector<uint8_t> vChecksum(strList.begin(), strList.end());
+                vChecksum.insert(vChecksum.end(), vCursor.begin(), vCursor.end());
+
+                const uint32_t nChecksum = LLC::SK32(vChecksum);
+                vCursor.insert(vCursor.end(), (uint8_t*)&nChecksum, (uint8_t*)&nChecksum + 4);
+
+                ret["cursor"] = HexStr(vCursor.begin(), vCursor.end());
+            }
+
+            return ret;
+        }
+
+
         /* Checks to see if the json response matches the where clauses  */
         bool MatchesWhere(const json::json& obj, const std::vector<Clause>& vWhere, const std::vector<std::string>& vIgnore)
         {
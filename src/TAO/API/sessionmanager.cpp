@@ -19,6 +19,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/create.h>
+#include <TAO/Ledger/types/event_queue.h>
 #include <TAO/Ledger/types/sigchain.h>
 #include <TAO/Ledger/types/transaction.h>
 
@@ -93,6 +94,9 @@ namespace TAO
             /* Initialize the session instance */
             mapSessions[nSession].Initialize(strUsername, strPassword, strPin, nSession);
 
+            /* Queue the events of the sigchain while it has a session. */
+            TAO::Ledger::EventQueue::GetInstance().Track(mapSessions[nSession].GetAccount()->Genesis());
+
             /* Return the session instance */
             return mapSessions[nSession];
         }
@@ -106,7 +110,17 @@ namespace TAO
             if(mapSessions.count(sessionID) == 0)
                 throw APIException(-11, "User not logged in");
 
+            const uint256_t hashGenesis = mapSessions[sessionID].GetAccount()->Genesis();
             mapSessions.erase(sessionID);
+
+            /* Stop queueing the events of the sigchain once no session uses it. */
+            for(const auto& session : mapSessions)
+            {
+                if(session.second.GetAccount()->Genesis() == hashGenesis)
+                    return;
+            }
+
+            TAO::Ledger::EventQueue::GetInstance().Untrack(hashGenesis);
         }
 
         /* Returns a session instance by session id */
@@ -151,6 +165,11 @@ namespace TAO
         void SessionManager::Clear()
         {
             LOCK(MUTEX);
+
+            /* Stop queueing the events of every sigchain. */
+            for(const auto& session : mapSessions)
+                TAO::Ledger::EventQueue::GetInstance().Untrack(session.second.GetAccount()->Genesis());
+
             mapSessions.clear();
         }
 
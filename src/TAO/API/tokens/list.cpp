@@ -275,8 +275,8 @@ namespace TAO
             /* The vector of token accounts for the token being filtered*/
             std::vector<std::pair<TAO::Register::Address, TAO::Register::Object>> vTokenAccounts;
 
-            /* Batch read up to 100,000 */
-            if(LLD::Register->BatchRead("account", vAccounts, 100000))
+            /* Batch read up to 100,000 accounts indexed by the token */
+            if(LLD::Register->BatchReadField("account", uint256_t(hashToken), vAccounts, 100000))
             {
                 /* Check that the account belongs to the token being filtered on */
                 for(auto& account : vAccounts)
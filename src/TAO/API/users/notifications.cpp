@@ -28,6 +28,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/create.h>
 
+#include <TAO/Ledger/types/event_queue.h>
 #include <TAO/Ledger/types/transaction.h>
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Ledger/types/sigchain.h>
@@ -213,6 +214,37 @@ namespace TAO
             /* Counter of consecutive processed events. */
             uint32_t nConsecutive = 0;
 
+            /* Check the event queue for the pending events once the sigchain is tracked. */
+            TAO::Ledger::EventQueue& queue = TAO::Ledger::EventQueue::GetInstance();
+
+            std::vector<uint32_t> vSequences;
+            if(queue.Pending(hashGenesis, vSequences))
+            {
+                for(const auto& nSequence : vSequences)
+                {
+                    /* Drop events that are no longer in the ledger. */
+                    if(!LLD::Ledger->ReadEvent(hashGenesis, nSequence, tx))
+                    {
+                        queue.Remove(hashGenesis, nSequence);
+                        continue;
+                    }
+
+                    /* Keep immature events until they can be processed. */
+                    if(!LLD::Ledger->ReadMature(tx.GetHash()))
+                        continue;
+
+                    /* Drop events with nothing left to process. */
+                    if(!get_event(hashGenesis, tx, setUnique, vContracts, nConsecutive))
+                        queue.Remove(hashGenesis, nSequence);
+                }
+
+                return true;
+            }
+
+            /* Queue the events of sigchains with a session before scanning, so events written during the scan are queued.
+               Other sigchains are only scanned, so looking them up doesn't fill the queue. */
+            const bool fQueue = queue.Begin(hashGenesis);
+
             /* The event sequence number */
             uint32_t nSequence = 0;
 
@@ -230,148 +262,170 @@ namespace TAO
                 if(nConsecutive >= config::GetArg("-eventsdepth", 100))
                     break;
 
-                /* Check that the transaction is mature */
-                if(!LLD::Ledger->ReadMature(tx.GetHash()))
-                {
-                    /* If not, decrement the sequence id and continue to the next event. */
-                    --nSequence;
-                    continue;
-                }
+                /* Queue the events that are immature or have contracts to process. */
+                const bool fPending = !LLD::Ledger->ReadMature(tx.GetHash())
+                                   || get_event(hashGenesis, tx, setUnique, vContracts, nConsecutive);
 
-                /* Loop through transaction contracts. */
-                uint32_t nContracts = tx.Size();
-                for(uint32_t nContract = 0; nContract < nContracts; ++nContract)
-                {
-                    /* Reference to contract to check */
-                    const TAO::Operation::Contract& contract = tx[nContract];
+                if(fPending && fQueue)
+                    queue.Push(hashGenesis, nSequence);
 
-                    /* The proof to check for this contract */
-                    uint256_t hashProof = 0;
+                /* Iterate the sequence id backwards. */
+                --nSequence;
+            }
 
-                    /* Reset the contract to the position of the primitive. */
-                    contract.SeekToPrimitive();
+            return true;
+        }
 
-                    /* The operation */
-                    uint8_t nOP;
-                    contract >> nOP;
 
-                    /* Check for that the debit is meant for us. */
-                    switch(nOP)
-                    {
-                        /* Check for debit events. */
-                        case TAO::Operation::OP::DEBIT:
-                        {
-                            /* Get the source address which is the proof for the debit */
-                            contract >> hashProof;
+        /* Get the outstanding debits and transfers of an event transaction. */
+        bool Users::get_event(const uint256_t& hashGenesis, const TAO::Ledger::Transaction& tx,
+                std::set<std::pair<uint512_t, uint32_t>> &setUnique,
+                std::vector<std::tuple<TAO::Operation::Contract, uint32_t, uint256_t>> &vContracts,
+                uint32_t &nConsecutive)
+        {
+            /* Flag to tell if any contract is not yet processed in a block. */
+            bool fPending = false;
 
-                            /* Get the recipient account */
-                            uint256_t hashTo;
-                            contract >> hashTo;
+            /* Loop through transaction contracts. */
+            const uint512_t hashTx = tx.GetHash();
+            uint32_t nContracts = tx.Size();
+            for(uint32_t nContract = 0; nContract < nContracts; ++nContract)
+            {
+                /* Reference to contract to check */
+                const TAO::Operation::Contract& contract = tx[nContract];
 
-                            /* Retrieve the account. */
-                            TAO::Register::State state;
-                            if(!LLD::Register->ReadState(hashTo, state))
-                                continue;
+                /* The proof to check for this contract */
+                uint256_t hashProof = 0;
 
-                            /* Check owner that we are the owner of the recipient account  */
-                            if(state.hashOwner != hashGenesis)
-                                continue;
+                /* Reset the contract to the position of the primitive. */
+                contract.SeekToPrimitive();
 
-                            break;
-                        }
+                /* The operation */
+                uint8_t nOP;
+                contract >> nOP;
 
-                        /* Check for transfer events. */
-                        case TAO::Operation::OP::TRANSFER:
-                        {
-                            /* The register address being transferred */
-                            uint256_t hashRegister;
-                            contract >> hashRegister;
+                /* Check for that the debit is meant for us. */
+                switch(nOP)
+                {
+                    /* Check for debit events. */
+                    case TAO::Operation::OP::DEBIT:
+                    {
+                        /* Get the source address which is the proof for the debit */
+                        contract >> hashProof;
 
-                            /* Get recipient genesis hash */
-                            contract >> hashProof;
+                        /* Get the recipient account */
+                        uint256_t hashTo;
+                        contract >> hashTo;
 
-                            /* Read the force transfer flag */
-                            uint8_t nType = 0;
-                            contract >> nType;
+                        /* Retrieve the account. */
+                        TAO::Register::State state;
+                        if(!LLD::Register->ReadState(hashTo, state))
+                            continue;
 
-                            /* Ensure this wasn't a forced transfer (which requires no Claim) */
-                            if(nType == TAO::Operation::TRANSFER::FORCE)
-                                continue;
+                        /* Check owner that we are the owner of the recipient account  */
+                        if(state.hashOwner != hashGenesis)
+                            continue;
 
-                            /* Check that we are the recipient */
-                            if(hashGenesis != hashProof)
-                                continue;
+                        break;
+                    }
 
-                            /* Check that the sender has not claimed it back (voided).  We can skip this in client mode and just 
-                               rely on whether a proof exists for it instead. */
-                            if(!config::fClient.load())
-                            {
-                                TAO::Register::State state;
-                                if(!LLD::Register->ReadState(hashRegister, state))
-                                    continue;
+                    /* Check for transfer events. */
+                    case TAO::Operation::OP::TRANSFER:
+                    {
+                        /* The register address being transferred */
+                        uint256_t hashRegister;
+                        contract >> hashRegister;
 
-                                /* Make sure the register claim is in SYSTEM pending from a transfer.  */
-                                if(state.hashOwner.GetType() != TAO::Ledger::GENESIS::SYSTEM)
-                                    continue;
-                            }
+                        /* Get recipient genesis hash */
+                        contract >> hashProof;
 
-                            /* Make sure we haven't already claimed it */
-                            if(LLD::Ledger->HasProof(hashRegister, tx.GetHash(), nContract, TAO::Ledger::FLAGS::MEMPOOL))
-                            {
-                                nConsecutive++;
-                                continue;
-                            }
+                        /* Read the force transfer flag */
+                        uint8_t nType = 0;
+                        contract >> nType;
 
-                            break;
-                        }
+                        /* Ensure this wasn't a forced transfer (which requires no Claim) */
+                        if(nType == TAO::Operation::TRANSFER::FORCE)
+                            continue;
 
-                        /* Check for coinbase events. */
-                        case TAO::Operation::OP::COINBASE:
-                        {
-                            /* Unpack the miners genesis from the contract */
-                            contract >> hashProof;
+                        /* Check that we are the recipient */
+                        if(hashGenesis != hashProof)
+                            continue;
 
-                            /* Check that we mined it */
-                            if(hashGenesis != hashProof)
+                        /* Check that the sender has not claimed it back (voided).  We can skip this in client mode and just 
+                           rely on whether a proof exists for it instead. */
+                        if(!config::fClient.load())
+                        {
+                            TAO::Register::State state;
+                            if(!LLD::Register->ReadState(hashRegister, state))
                                 continue;
 
-                            break;
+                            /* Make sure the register claim is in SYSTEM pending from a transfer.  */
+                            if(state.hashOwner.GetType() != TAO::Ledger::GENESIS::SYSTEM)
+                                continue;
                         }
 
-                        /* Default continue. */
-                        default:
+                        /* Make sure we haven't already claimed it */
+                        if(LLD::Ledger->HasProof(hashRegister, hashTx, nContract, TAO::Ledger::FLAGS::MEMPOOL))
+                        {
+                            /* Keep the event until the claim is in a block. */
+                            if(!LLD::Ledger->HasProof(hashRegister, hashTx, nContract))
+                                fPending = true;
+
+                            nConsecutive++;
                             continue;
-                    }
+                        }
 
-                    /* Check to see if we have already credited this debit. */
-                    uint512_t hashTx = tx.GetHash();
-                    if(LLD::Ledger->HasProof(hashProof, hashTx, nContract, TAO::Ledger::FLAGS::MEMPOOL))
-                    {
-                        nConsecutive++;
-                        continue;
+                        break;
                     }
 
-                    /* Check that we haven't already added this contract to the vContracts list.  Since events are written by 
-                       transaction hash only, if two or more contracts exist in the same transaction for the same sig chain, then
-                       there will be duplicate events written for the same transaction. */
-                    if(setUnique.count(std::make_pair(hashTx, nContract)) == 0)
+                    /* Check for coinbase events. */
+                    case TAO::Operation::OP::COINBASE:
                     {
-                        setUnique.insert(std::make_pair(hashTx, nContract));
+                        /* Unpack the miners genesis from the contract */
+                        contract >> hashProof;
 
-                        /* Add the contract to the list. */
-                        vContracts.push_back(std::make_tuple(contract, nContract, 0));
+                        /* Check that we mined it */
+                        if(hashGenesis != hashProof)
+                            continue;
 
-                        /* Reset the consecutive counter since this has not been processed */
-                        nConsecutive = 0;
+                        break;
                     }
 
+                    /* Default continue. */
+                    default:
+                        continue;
                 }
 
-                /* Iterate the sequence id backwards. */
-                --nSequence;
+                /* Check to see if we have already credited this debit. */
+                if(LLD::Ledger->HasProof(hashProof, hashTx, nContract, TAO::Ledger::FLAGS::MEMPOOL))
+                {
+                    /* Keep the event until the credit is in a block. */
+                    if(!LLD::Ledger->HasProof(hashProof, hashTx, nContract))
+                        fPending = true;
+
+                    nConsecutive++;
+                    continue;
+                }
+
+                /* The contract is still to be processed. */
+                fPending = true;
+
+                /* Check that we haven't already added this contract to the vContracts list.  Since events are written by 
+                   transaction hash only, if two or more contracts exist in the same transaction for the same sig chain, then
+                   there will be duplicate events written for the same transaction. */
+                if(setUnique.count(std::make_pair(hashTx, nContract)) == 0)
+                {
+                    setUnique.insert(std::make_pair(hashTx, nContract));
+
+                    /* Add the contract to the list. */
+                    vContracts.push_back(std::make_tuple(contract, nContract, 0));
+
+                    /* Reset the consecutive counter since this has not been processed */
+                    nConsecutive = 0;
+                }
             }
 
-            return true;
+            return fPending;
         }
 
         /* Get the outstanding legacy UTXO to register transactions. */
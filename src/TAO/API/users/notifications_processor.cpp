@@ -114,5 +114,17 @@ namespace TAO
             /* Not found so return null */
             return nullptr;
         }
+
+
+        /* Notifies the processor threads that a sigchain has new events, so its sessions are processed. */
+        void NotificationsProcessor::NotifyEvent(const uint256_t& hashGenesis)
+        {
+            /* lock the notifications mutex so we can access the threads */
+            LOCK(MUTEX);
+
+            /* Each thread checks whether it processes a session for the sigchain */
+            for(uint16_t nIndex = 0; nIndex < NOTIFICATIONS_THREADS.size(); ++nIndex)
+                NOTIFICATIONS_THREADS[nIndex]->NotifyEvent(hashGenesis);
+        }
     }
 }
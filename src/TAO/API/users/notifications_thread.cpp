@@ -21,6 +21,8 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/chainstate.h>
 
+#include <Util/include/runtime.h>
+
 #include <functional>
 
 namespace TAO
@@ -31,8 +33,11 @@ namespace TAO
         NotificationsThread::NotificationsThread()
         : SESSIONS()
         , fEvent(false)
+        , fAllSessions(false)
         , fShutdown(false)
         , NOTIFICATIONS_MUTEX()
+        , EVENTS_MUTEX()
+        , setEvents()
         , CONDITION()
         , NOTIFICATIONS_THREAD(std::bind(&NotificationsThread::Thread, this))
         {
@@ -96,6 +101,9 @@ namespace TAO
             /** The interval between processing notifications in milliseconds, defaults to 5s if not specified in config **/
             uint64_t nInterval = config::GetArg("-notificationsinterval", 5) * 1000;
 
+            /* The time of the last pass over all sessions, in milliseconds. */
+            uint64_t nLastPass = 0;
+
             /* Loop the events processing thread until shutdown. */
             while(!fShutdown.load())
             {
@@ -119,6 +127,20 @@ namespace TAO
                 if(TAO::Ledger::ChainState::Synchronizing())
                     continue;
 
+                /* Process all sessions on the interval, for coinbases and maturing events, otherwise only the sessions
+                   whose sigchains have new events. */
+                const uint64_t nNow  = runtime::timestamp(true);
+                const bool fAll      = (fAllSessions.exchange(false) || nNow >= nLastPass + nInterval);
+                if(fAll)
+                    nLastPass = nNow;
+
+                /* Get the sigchains with new events. */
+                std::set<uint256_t> setGenesis;
+                {
+                    LOCK(EVENTS_MUTEX);
+                    setGenesis.swap(setEvents);
+                }
+
                 /* Iterate through all sessions */
                 for(const auto nSession : SESSIONS)
                 {
@@ -128,6 +150,9 @@ namespace TAO
                         if(GetSessionManager().Has(nSession))
                         { 
                             Session& session = GetSessionManager().Get(nSession, false);
+                            if(!fAll && !setGenesis.count(session.GetAccount()->Genesis()))
+                                continue;
+
                             if(!session.Locked() && session.CanProcessNotifications())
                                 auto_process_notifications(session.ID());
                         }
@@ -218,6 +243,20 @@ namespace TAO
          *  can check and update it's state. */
         void NotificationsThread::NotifyEvent()
         {
+            fAllSessions = true;
+            fEvent = true;
+            CONDITION.notify_one();
+        }
+
+
+        /* Notifies the processor that a sigchain has new events, so its session is processed. */
+        void NotificationsThread::NotifyEvent(const uint256_t& hashGenesis)
+        {
+            {
+                LOCK(EVENTS_MUTEX);
+                setEvents.insert(hashGenesis);
+            }
+
             fEvent = true;
             CONDITION.notify_one();
         }
@@ -94,38 +94,65 @@ namespace TAO
             /* Get the params to apply to the response. */
             GetListParams(params, strOrder, nLimit, nOffset, vWhere);
 
+            /* Get the cursor, which is the next transaction of the sigchain to read. */
+            DataStream ssCursor(SER_NETWORK, 1);
+            const bool fCursor = GetListCursor(params, "users/list/transactions", ssCursor);
+            if(fCursor && strOrder == "asc")
+                throw APIException(-307, "Cursor is only supported for descending order");
+
             /* Get the last transaction. */
             uint512_t hashLast = 0;
             if(!LLD::Ledger->ReadLast(hashGenesis, hashLast, TAO::Ledger::FLAGS::MEMPOOL))
                 throw APIException(-144, "No transactions found");
 
-            /* Loop until genesis, storing all tx into a vector (these will be in descending order). */
-            std::vector<TAO::Ledger::Transaction> vtx;
+            /* A cursor continues the walk, ignoring the offset. */
+            if(fCursor && ssCursor.size() > 0)
+            {
+                ssCursor >> hashLast;
+                nOffset = 0;
+            }
 
-            while(hashLast != 0)
+            /* Transactions are read in descending order, so only ascending needs the whole sigchain first. */
+            std::vector<TAO::Ledger::Transaction> vtx;
+            if(strOrder == "asc")
             {
-                /* Get the transaction from disk. */
-                TAO::Ledger::Transaction tx;
-                if(!LLD::Ledger->ReadTx(hashLast, tx, TAO::Ledger::FLAGS::MEMPOOL))
-                    throw APIException(-108, "Failed to read transaction");
+                while(hashLast != 0)
+                {
+                    /* Get the transaction from disk. */
+                    TAO::Ledger::Transaction tx;
+                    if(!LLD::Ledger->ReadTx(hashLast, tx, TAO::Ledger::FLAGS::MEMPOOL))
+                        throw APIException(-108, "Failed to read transaction");
 
-                /* Set the next last. */
-                hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
+                    /* Set the next last. */
+                    hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
 
-                vtx.push_back(tx);
-            }
+                    vtx.push_back(tx);
+                }
 
-            /* Transactions sorted in descending order. Reverse the order if ascending requested. */
-            if(strOrder == "asc")
                 std::reverse(vtx.begin(), vtx.end());
+            }
 
             uint32_t nTotal = 0;
 
             /* Flag indicating there are top level filters  */
             bool fHasFilter = vWhere.count("") > 0;
 
-            for(auto tx : vtx)
+            for(uint32_t nIndex = 0; strOrder == "asc" ? nIndex < vtx.size() : hashLast != 0; ++nIndex)
             {
+                /* Get the next transaction, reading it from disk in descending order. */
+                TAO::Ledger::Transaction tx;
+                if(strOrder == "asc")
+                    tx = vtx[nIndex];
+                else
+                {
+                    if(!LLD::Ledger->ReadTx(hashLast, tx, TAO::Ledger::FLAGS::MEMPOOL))
+                        throw APIException(-108, "Failed to read transaction");
+
+                    /* Check a cursor hasn't moved to another sigchain. */
+                    if(tx.hashGenesis != hashGenesis)
+                        throw APIException(-306, "Invalid cursor");
+                }
+
                 /* Read the block state from the the ledger DB using the transaction hash index */
                 TAO::Ledger::BlockState blockState;
                 LLD::Ledger->ReadBlock(tx.GetHash(), blockState);
@@ -134,30 +161,45 @@ namespace TAO
                 json::json obj = TAO::API::TransactionToJSON(hashCaller, tx, blockState, nVerbose, hashGenesis, vWhere);
 
                 /* Check to see whether the transaction has had all children filtered out */
-                if(obj.empty())
-                    continue;
+                bool fMatch = !obj.empty();
 
                 /* Check to see that it matches the where clauses */
-                if(fHasFilter)
+                if(fMatch && fHasFilter)
                 {
                     /* Skip this top level record if not all of the filters were matched */
-                    if(!MatchesWhere(obj, vWhere[""]))
-                        continue;
+                    fMatch = MatchesWhere(obj, vWhere[""]);
+                }
+
+                if(fMatch)
+                {
+                    ++nTotal;
+
+                    /* Check the limit, leaving the cursor on this transaction. */
+                    if(nTotal > nOffset && nTotal - nOffset > nLimit)
+                        break;
                 }
 
-                ++nTotal;
+                /* Set the next last. */
+                if(strOrder != "asc")
+                    hashLast = !tx.IsFirst() ? tx.hashPrevTx : 0;
 
                 /* Check the offset. */
-                if(nTotal <= nOffset)
+                if(!fMatch || nTotal <= nOffset)
                     continue;
-                
-                /* Check the limit */
-                if(nTotal - nOffset > nLimit)
-                    break;
 
                 ret.push_back(obj);
             }
 
+            /* Return the page with the cursor of the next one. */
+            if(fCursor)
+            {
+                DataStream ssNext(SER_NETWORK, 1);
+                if(hashLast != 0)
+                    ssNext << hashLast;
+
+                return ListCursor(ret, "users/list/transactions", ssNext);
+            }
+
             return ret;
         }
     }
@@ -77,6 +77,16 @@ namespace TAO
              * 
              **/
             NotificationsThread* FindThread(const uint256_t& nSession) const;
+
+
+            /** NotifyEvent
+             *
+             *  Notifies the processor threads that a sigchain has new events, so its sessions are processed.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain with new events.
+             *
+             **/
+            void NotifyEvent(const uint256_t& hashGenesis);
  
 
           private:
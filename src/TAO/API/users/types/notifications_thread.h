@@ -30,6 +30,7 @@ ________________________________________________________________________________
 #include <condition_variable>
 #include <thread>
 #include <atomic>
+#include <set>
 #include <vector>
 
 
@@ -63,11 +64,22 @@ namespace TAO
             /** NotifyEvent
              *
              *  Notifies the processor that an event has occurred so it can check and update it's state.
+             *  All sessions are processed on the next pass.
              *
              **/
             void NotifyEvent();
 
 
+            /** NotifyEvent
+             *
+             *  Notifies the processor that a sigchain has new events, so its session is processed.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain with new events.
+             *
+             **/
+            void NotifyEvent(const uint256_t& hashGenesis);
+
+
             /** Add
              *
              *  Adds a session ID to be processed by this thread
@@ -109,6 +121,10 @@ namespace TAO
             std::atomic<bool> fEvent;
 
 
+            /** the flag to process all sessions on the next pass, rather than those with new events. **/
+            std::atomic<bool> fAllSessions;
+
+
             /** the shutdown flag for gracefully shutting down events thread. **/
             std::atomic<bool> fShutdown;
 
@@ -117,6 +133,14 @@ namespace TAO
             mutable std::mutex NOTIFICATIONS_MUTEX;
 
 
+            /** The mutex for the sigchains with new events. **/
+            std::mutex EVENTS_MUTEX;
+
+
+            /** The sigchains with new events since the last pass. **/
+            std::set<uint256_t> setEvents;
+
+
             /** The condition variable to awaken sleeping notification thread. **/
             std::condition_variable CONDITION;
             
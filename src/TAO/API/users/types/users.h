@@ -31,6 +31,7 @@ ________________________________________________________________________________
 #include <condition_variable>
 #include <thread>
 #include <atomic>
+#include <set>
 #include <vector>
 
 
@@ -617,6 +618,25 @@ namespace TAO
                 std::vector<std::tuple<TAO::Operation::Contract, uint32_t, uint256_t>> &vContracts);
 
 
+            /** get_event
+             *
+             *  Get the outstanding debits and transfers of an event transaction.
+             *
+             *  @param[in] hashGenesis The genesis hash for the sig chain owner.
+             *  @param[in] tx The event transaction.
+             *  @param[out] setUnique The contracts already added, to skip duplicate events.
+             *  @param[out] vContracts The array of outstanding contracts.
+             *  @param[out] nConsecutive The counter of consecutive processed contracts.
+             *
+             *  @return true if the event has contracts not yet processed in a block.
+             *
+             **/
+            static bool get_event(const uint256_t& hashGenesis, const TAO::Ledger::Transaction& tx,
+                std::set<std::pair<uint512_t, uint32_t>> &setUnique,
+                std::vector<std::tuple<TAO::Operation::Contract, uint32_t, uint256_t>> &vContracts,
+                uint32_t &nConsecutive);
+
+
             /** get_events
              *
              *  Get the outstanding legacy UTXO to register transactions.
@@ -24,6 +24,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/create.h>
+#include <TAO/Ledger/include/dispatch.h>
 #include <TAO/Ledger/types/sigchain.h>
 #include <TAO/Ledger/types/stake_minter.h>
 #include <TAO/Ledger/types/transaction.h>
@@ -55,7 +56,16 @@ namespace TAO
 
             /* Initialize the notifications processor if configured */
             if(config::fProcessNotifications)
+            {
                 NOTIFICATIONS_PROCESSOR = new NotificationsProcessor(config::GetArg("-notificationsthreads", 1));
+
+                /* Wake the notifications processor when sigchains get new events. */
+                TAO::Ledger::Dispatch::GetInstance().SubscribeEvent([](const uint256_t& hashGenesis)
+                {
+                    if(TAO::API::users && TAO::API::users->NOTIFICATIONS_PROCESSOR)
+                        TAO::API::users->NOTIFICATIONS_PROCESSOR->NotifyEvent(hashGenesis);
+                });
+            }
         }
 
 
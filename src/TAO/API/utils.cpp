@@ -135,7 +135,7 @@ namespace TAO
          * Similarly if we find a transfer transaction for a register before any other transaction
          * then we must know we currently to NOT own it.
          */
-        bool ListRegisters(const uint256_t& hashGenesis, std::vector<TAO::Register::Address>& vRegisters)
+        bool ScanRegisters(const uint256_t& hashGenesis, std::vector<TAO::Register::Address>& vRegisters)
         {
             /* LRU register cache by genesis hash.  This caches the vector of register addresses along with the last txid of the
                sig chain, so that we can determine whether any new transactions have been added, invalidating the cache.  */
@@ -353,6 +353,120 @@ namespace TAO
         }
 
 
+        /* Lists the registers owned by a signature chain from the owner index of the register database. */
+        bool ListRegisters(const uint256_t& hashGenesis, std::vector<TAO::Register::Address>& vRegisters)
+        {
+            /* Light nodes don't have the states of registers owned by other chains to index, so scan the sigchain.
+             * Do the same if the owner index is disabled, rather than reading every owner record. */
+            if(config::fClient.load() || !LLD::Register->HasIndex("owner"))
+                return ScanRegisters(hashGenesis, vRegisters);
+
+            /* Get the last transaction, including the mempool. */
+            uint512_t hashLast = 0;
+            if(!LLD::Ledger->ReadLast(hashGenesis, hashLast, TAO::Ledger::FLAGS::MEMPOOL))
+                return false;
+
+            /* Index the registers of sigchains from before the owner index the first time they are listed. */
+            if(!LLD::Register->HasOwnerIndexed(hashGenesis))
+            {
+                std::vector<TAO::Register::Address> vScanned;
+                if(!ScanRegisters(hashGenesis, vScanned))
+                    return false;
+
+                /* Registers that were since transferred away are removed when they are checked below. */
+                for(const auto& hashAddress : vScanned)
+                {
+                    if(!LLD::Register->IndexOwner(hashGenesis, hashAddress))
+                        return debug::error(FUNCTION, "failed to index owner");
+                }
+
+                if(!LLD::Register->WriteOwnerIndexed(hashGenesis))
+                    return debug::error(FUNCTION, "failed to write owner indexed");
+            }
+
+            /* A register transferred by this sigchain is still listed until it is claimed. */
+            uint256_t hashTransferred = hashGenesis;
+            hashTransferred.SetType(TAO::Ledger::GENESIS::SYSTEM);
+
+            /* Get the registers created or claimed in the mempool, which are indexed when they are in a block. */
+            std::vector<uint256_t> vCandidates;
+
+            uint512_t hashConfirmed = 0;
+            LLD::Ledger->ReadLast(hashGenesis, hashConfirmed);
+
+            uint512_t hashPrev = hashLast;
+            while(hashPrev != 0 && hashPrev != hashConfirmed)
+            {
+                TAO::Ledger::Transaction tx;
+                if(!LLD::Ledger->ReadTx(hashPrev, tx, TAO::Ledger::FLAGS::MEMPOOL))
+                    break;
+
+                hashPrev = !tx.IsFirst() ? tx.hashPrevTx : 0;
+
+                for(uint32_t nContract = 0; nContract < tx.Size(); ++nContract)
+                {
+                    const TAO::Operation::Contract& contract = tx[nContract];
+                    contract.Reset();
+                    contract.SeekToPrimitive();
+
+                    uint8_t nOP = 0;
+                    contract >> nOP;
+
+                    /* Seek past the txid and contract number being claimed. */
+                    if(nOP == TAO::Operation::OP::CLAIM)
+                        contract.Seek(68);
+                    else if(nOP != TAO::Operation::OP::CREATE)
+                        continue;
+
+                    uint256_t hashAddress = 0;
+                    contract >> hashAddress;
+
+                    vCandidates.push_back(hashAddress);
+                }
+            }
+
+            /* Get the indexed registers. */
+            const uint32_t nMempool = vCandidates.size();
+
+            std::vector<uint256_t> vOwned;
+            LLD::Register->ListOwned(hashGenesis, vOwned);
+            vCandidates.insert(vCandidates.end(), vOwned.rbegin(), vOwned.rend());
+
+            /* Check the owner of each register, dropping index records that are no longer owned. */
+            std::unordered_set<uint256_t> setUnique;
+            for(uint32_t n = 0; n < vCandidates.size(); ++n)
+            {
+                const uint256_t& hashAddress = vCandidates[n];
+                if(setUnique.count(hashAddress))
+                    continue;
+
+                /* Check the latest state, including the mempool. */
+                TAO::Register::State state;
+                if(LLD::Register->ReadState(hashAddress, state, TAO::Ledger::FLAGS::MEMPOOL)
+                && (state.hashOwner == hashGenesis || state.hashOwner == hashTransferred))
+                {
+                    setUnique.insert(hashAddress);
+                    vRegisters.push_back(hashAddress);
+
+                    continue;
+                }
+
+                /* Only erase records the chain disagrees with, so a transfer in the mempool doesn't drop them. */
+                if(n < nMempool)
+                    continue;
+
+                if(LLD::Register->ReadState(hashAddress, state)
+                && (state.hashOwner == hashGenesis || state.hashOwner == hashTransferred))
+                    continue;
+
+                if(!LLD::Register->EraseOwner(hashGenesis, hashAddress))
+                    return debug::error(FUNCTION, "failed to erase owner index");
+            }
+
+            return true;
+        }
+
+
         /* Scans a signature chain to work out all assets that it owns */
         bool ListObjects(const uint256_t& hashGenesis, std::vector<TAO::Register::Address>& vObjects)
         {
@@ -1324,6 +1438,10 @@ namespace TAO
                 [](const std::pair<TAO::Register::Address, TAO::Register::State> &a,
                 const std::pair<TAO::Register::Address, TAO::Register::State> &b)
                 {
+                    /* Registers created together are ordered by address, so a list cursor can continue from either. */
+                    if(a.second.nCreated == b.second.nCreated)
+                        return ( a.first < b.first );
+
                     return ( a.second.nCreated < b.second.nCreated );
                 });
 
@@ -293,24 +293,40 @@ namespace TAO
         {
             /* Build the in memory cache of merkle tree. */
             vMerkleTree.clear();
+            vMerkleTree.reserve(vtx.size() * 2);
             for(const auto& hash : vtx)
                 vMerkleTree.push_back(hash);
 
-            /* Compute the merkle root. */
+            /* Compute the merkle root, hashing each level as a batch. */
+            std::vector<std::pair<const uint8_t*, uint64_t> > vLeaves;
+            std::vector<uint512_t> vLevel;
+
+            uint512_t hashOdd[2];
             uint32_t i = 0;
             uint32_t j = 0;
             for(uint32_t nSize = static_cast<uint32_t>(vtx.size()); nSize > 1; nSize = (nSize + 1) >> 1)
             {
+                vLeaves.clear();
                 for(i = 0; i < nSize; i += 2)
                 {
-                    /* get the references to the left and right leaves in the merkle tree */
-                    const uint512_t& hashLeft  = vMerkleTree[j + i];
-                    const uint512_t& hashRight = vMerkleTree[j + std::min(i + 1, nSize - 1)];
-
-                    vMerkleTree.push_back(LLC::SK512(BEGIN(hashLeft),  END(hashLeft),
-                                                     BEGIN(hashRight), END(hashRight)));
+                    /* The left and right leaves are next to each other in the merkle tree. */
+                    if(i + 1 < nSize)
+                        vLeaves.push_back(std::make_pair(UBEGIN(vMerkleTree[j + i]), uint64_t(2 * sizeof(uint512_t))));
+
+                    /* The last leaf of an odd level is hashed with itself. */
+                    else
+                    {
+                        hashOdd[0] = vMerkleTree[j + i];
+                        hashOdd[1] = vMerkleTree[j + i];
+
+                        vLeaves.push_back(std::make_pair(UBEGIN(hashOdd[0]), uint64_t(2 * sizeof(uint512_t))));
+                    }
                 }
 
+                /* Hash the level before adding it, since adding can move the leaves. */
+                LLC::SK512Batch(vLeaves, vLevel);
+                vMerkleTree.insert(vMerkleTree.end(), vLevel.begin(), vLevel.end());
+
                 j += nSize;
             }
 
@@ -321,30 +337,13 @@ namespace TAO
         /* Generate the Merkle Tree from uint512_t hashes. */
         uint512_t Block::BuildMerkleTree(const std::vector<std::pair<uint8_t, uint512_t> >& vtx) const
         {
-            /* Build the in memory cache of merkle tree. */
-            vMerkleTree.clear();
+            /* Get the hashes without their types. */
+            std::vector<uint512_t> vHashes;
+            vHashes.reserve(vtx.size());
             for(const auto& hash : vtx)
-                vMerkleTree.push_back(hash.second);
+                vHashes.push_back(hash.second);
 
-            /* Compute the merkle root. */
-            uint32_t i = 0;
-            uint32_t j = 0;
-            for(uint32_t nSize = static_cast<uint32_t>(vtx.size()); nSize > 1; nSize = (nSize + 1) / 2)
-            {
-                for(i = 0; i < nSize; i += 2)
-                {
-                    /* get the references to the left and right leaves in the merkle tree */
-                    const uint512_t& hashLeft  = vMerkleTree[j + i];
-                    const uint512_t& hashRight = vMerkleTree[j + std::min(i + 1, nSize - 1)];
-
-                    vMerkleTree.push_back(LLC::SK512(BEGIN(hashLeft),  END(hashLeft),
-                                                     BEGIN(hashRight), END(hashRight)));
-                }
-
-                j += nSize;
-            }
-
-            return (vMerkleTree.empty() ? 0 : vMerkleTree.back());
+            return BuildMerkleTree(vHashes);
         }
 
 
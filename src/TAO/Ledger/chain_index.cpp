@@ -0,0 +1,540 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/types/chain_index.h>
+#include <TAO/Ledger/types/state.h>
+
+#include <LLD/include/global.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+#include <Util/include/runtime.h>
+
+#include <algorithm>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Default Constructor. */
+        BlockIndex::BlockIndex()
+        : hashBlock     (0)
+        , nHeight       (0)
+        , nChannel      (0)
+        , nTime         (0)
+        , nBits         (0)
+        , nChainTrust   (0)
+        {
+        }
+
+
+        /* Constructor. */
+        BlockIndex::BlockIndex(const BlockState& state)
+        : hashBlock     (state.GetHash())
+        , nHeight       (state.nHeight)
+        , nChannel      (state.nChannel)
+        , nTime         (state.nTime)
+        , nBits         (state.nBits)
+        , nChainTrust   (state.nChainTrust)
+        {
+        }
+
+
+        /* Default Constructor. */
+        ChainIndex::ChainIndex()
+        : MUTEX      ( )
+        , vChain     ( )
+        , mapHeights ( )
+        , vJournal   ( )
+        , vPending   ( )
+        , fReady     (false)
+        , fRebuild   (false)
+        , fBuilding  (false)
+        , BUILD_THREAD ( )
+        {
+        }
+
+
+        /* Default Destructor. */
+        ChainIndex::~ChainIndex()
+        {
+            Stop();
+        }
+
+
+        /* Singleton instance for the main chain. */
+        ChainIndex& ChainIndex::GetInstance()
+        {
+            static ChainIndex ret;
+
+            return ret;
+        }
+
+
+        /* Build the index by reading back from the best block to genesis, then apply the blocks since. */
+        bool ChainIndex::Initialize(const BlockState& stateBest)
+        {
+            /* Runtime calculations. */
+            runtime::timer timer;
+            timer.Start();
+
+            /* Read the headers back to genesis. */
+            std::vector<BlockIndex> vHeaders;
+            vHeaders.reserve(stateBest.nHeight + 1);
+            vHeaders.push_back(BlockIndex(stateBest));
+
+            BlockState state = stateBest;
+            while(state.hashPrevBlock != 0)
+            {
+                /* Stop building if shutting down. */
+                if(config::fShutdown.load())
+                {
+                    Clear();
+                    return debug::error(FUNCTION, "cancelled at height ", state.nHeight);
+                }
+
+                /* Read the previous block. */
+                const uint1024_t hashPrevBlock = state.hashPrevBlock;
+                if(!LLD::Ledger->ReadBlock(hashPrevBlock, state))
+                {
+                    Clear();
+                    return debug::error(FUNCTION, "failed to read block ", hashPrevBlock.SubString());
+                }
+
+                /* Check the heights are in order. */
+                if(state.nHeight + 1 != vHeaders.back().nHeight)
+                {
+                    Clear();
+                    return debug::error(FUNCTION, "block ", hashPrevBlock.SubString(), " out of order at height ", state.nHeight);
+                }
+
+                vHeaders.push_back(BlockIndex(state));
+
+                /* Log the progress. */
+                if(vHeaders.size() % 100000 == 0)
+                    debug::log(0, FUNCTION, "indexed ", vHeaders.size(), " of ", stateBest.nHeight + 1, " blocks");
+            }
+
+            /* Put the headers in order of height. */
+            std::reverse(vHeaders.begin(), vHeaders.end());
+            if(vHeaders[0].nHeight != 0)
+            {
+                Clear();
+                return debug::error(FUNCTION, "chain doesn't start at genesis");
+            }
+
+            uint32_t nBlocks = 0;
+            {
+                LOCK(MUTEX);
+
+                vChain = std::move(vHeaders);
+
+                mapHeights.clear();
+                mapHeights.reserve(vChain.size());
+                for(const auto& index : vChain)
+                    mapHeights.emplace(index.hashBlock.Get64(), index.nHeight);
+
+                /* Apply the blocks of the transactions committed while the index was built. */
+                bool fValid = true, fApplied = false;
+                for(const auto& entry : vPending)
+                    fValid = fValid && apply(entry, fApplied);
+
+                /* Then the blocks of the transaction in progress, journaling the ones applied so an abort undoes them. */
+                std::vector<std::pair<bool, BlockIndex>> vApplied;
+                for(const auto& entry : vJournal)
+                {
+                    fValid = fValid && apply(entry, fApplied);
+                    if(fValid && fApplied)
+                        vApplied.push_back(entry);
+                }
+
+                vJournal  = std::move(vApplied);
+                vPending.clear();
+                fRebuild  = false;
+                fBuilding = false;
+
+                /* Blocks that don't fit the index leave it empty. */
+                if(!fValid)
+                {
+                    reset();
+                    return debug::error(FUNCTION, "blocks since ", stateBest.GetHash().SubString(), " don't fit the chain index");
+                }
+
+                nBlocks = vChain.size();
+                fReady  = true;
+            }
+
+            debug::log(0, FUNCTION, "indexed ", nBlocks, " blocks in ", timer.Elapsed(), " seconds");
+
+            return true;
+        }
+
+
+        /* Empty the index, so lookups fall back to the ledger database. */
+        void ChainIndex::Clear()
+        {
+            LOCK(MUTEX);
+
+            reset();
+            fBuilding = false;
+        }
+
+
+        /* Check if the index is built. */
+        bool ChainIndex::Ready() const
+        {
+            return fReady.load();
+        }
+
+
+        /* Start journaling the blocks connected and disconnected, along with a database transaction. */
+        void ChainIndex::TxnBegin()
+        {
+            LOCK(MUTEX);
+
+            vJournal.clear();
+        }
+
+
+        /* Wait for the index to finish building, before the ledger database is shut down. */
+        void ChainIndex::Stop()
+        {
+            /* Building stops early when shutting down. */
+            if(BUILD_THREAD.joinable())
+                BUILD_THREAD.join();
+        }
+
+
+        /* Keep the blocks connected and disconnected since the database transaction began. */
+        void ChainIndex::TxnCommit()
+        {
+            {
+                LOCK(MUTEX);
+
+                /* Keep the blocks for when the index is built. */
+                if(fBuilding)
+                    vPending.insert(vPending.end(), vJournal.begin(), vJournal.end());
+
+                vJournal.clear();
+            }
+
+            rebuild();
+        }
+
+
+        /* Undo the blocks connected and disconnected since the database transaction began. */
+        void ChainIndex::TxnAbort()
+        {
+            {
+                LOCK(MUTEX);
+
+                /* Undo in reverse, so each block is at the end of the chain again. Blocks kept while the index is
+                   built were never applied. */
+                for(auto it = vJournal.rbegin(); it != vJournal.rend() && !fBuilding; ++it)
+                {
+                    if(it->first)
+                        pop();
+                    else
+                        push(it->second);
+                }
+
+                vJournal.clear();
+            }
+
+            rebuild();
+        }
+
+
+        /* Add a block connected to the end of the main chain. */
+        void ChainIndex::Connect(const BlockState& state)
+        {
+            const BlockIndex index(state);
+            {
+                LOCK(MUTEX);
+
+                /* Keep the block for when the index is built. */
+                if(fBuilding)
+                {
+                    vJournal.emplace_back(true, index);
+                    return;
+                }
+
+                if(!fReady.load())
+                    return;
+
+                /* Check the block follows the end of the chain. */
+                if(!vChain.empty() && vChain.back().hashBlock == state.hashPrevBlock && vChain.back().nHeight + 1 == index.nHeight)
+                {
+                    push(index);
+                    vJournal.emplace_back(true, index);
+
+                    return;
+                }
+
+                /* Empty the index, keeping the blocks from here on until it is built again. */
+                reset();
+                fRebuild  = true;
+                fBuilding = true;
+            }
+
+            debug::error(FUNCTION, "block ", index.hashBlock.SubString(), " doesn't follow the chain index");
+        }
+
+
+        /* Remove a block disconnected from the end of the main chain. */
+        void ChainIndex::Disconnect(const BlockState& state)
+        {
+            const BlockIndex index(state);
+            {
+                LOCK(MUTEX);
+
+                /* Keep the block for when the index is built. */
+                if(fBuilding)
+                {
+                    vJournal.emplace_back(false, index);
+                    return;
+                }
+
+                if(!fReady.load())
+                    return;
+
+                /* Check the block is the end of the chain, keeping genesis. */
+                if(vChain.size() > 1 && vChain.back().hashBlock == index.hashBlock)
+                {
+                    vJournal.emplace_back(false, vChain.back());
+                    pop();
+
+                    return;
+                }
+
+                /* Empty the index, keeping the blocks from here on until it is built again. */
+                reset();
+                fRebuild  = true;
+                fBuilding = true;
+            }
+
+            debug::error(FUNCTION, "block ", index.hashBlock.SubString(), " isn't the end of the chain index");
+        }
+
+
+        /* Check if a block is in the main chain. */
+        bool ChainIndex::Has(const uint1024_t& hashBlock) const
+        {
+            LOCK(MUTEX);
+
+            uint32_t nHeight = 0;
+            return fReady.load() && find(hashBlock, nHeight);
+        }
+
+
+        /* Get the header of a block in the main chain. */
+        bool ChainIndex::Get(const uint1024_t& hashBlock, BlockIndex &index) const
+        {
+            LOCK(MUTEX);
+
+            /* Check the index has the block. */
+            uint32_t nHeight = 0;
+            if(!fReady.load() || !find(hashBlock, nHeight))
+                return false;
+
+            index = vChain[nHeight];
+
+            return true;
+        }
+
+
+        /* Get the header of the block in the main chain at a height. */
+        bool ChainIndex::Get(const uint32_t nHeight, BlockIndex &index) const
+        {
+            LOCK(MUTEX);
+
+            /* Check the index reaches the height. */
+            if(!fReady.load() || nHeight >= vChain.size())
+                return false;
+
+            index = vChain[nHeight];
+
+            return true;
+        }
+
+
+        /* Get the header of the last block of a channel, searching back from a block in the main chain. */
+        bool ChainIndex::Last(const uint1024_t& hashBlock, const uint32_t nChannel, BlockIndex &index) const
+        {
+            LOCK(MUTEX);
+
+            /* Check the index has the starting block. */
+            uint32_t nHeight = 0;
+            if(!fReady.load() || !find(hashBlock, nHeight))
+                return false;
+
+            /* Search back to genesis. */
+            while(nHeight > 0 && vChain[nHeight].nChannel != nChannel)
+                --nHeight;
+
+            index = vChain[nHeight];
+
+            return true;
+        }
+
+
+        /* Get the header of the last block of a channel, searching back from a height in the main chain. */
+        bool ChainIndex::Last(const uint32_t nHeight, const uint32_t nChannel, BlockIndex &index) const
+        {
+            LOCK(MUTEX);
+
+            /* Check the index reaches the height. */
+            if(!fReady.load() || nHeight >= vChain.size())
+                return false;
+
+            /* Search back to genesis. */
+            uint32_t nSearch = nHeight;
+            while(nSearch > 0 && vChain[nSearch].nChannel != nChannel)
+                --nSearch;
+
+            index = vChain[nSearch];
+
+            return true;
+        }
+
+
+        /* Find the height of a block in the main chain. */
+        bool ChainIndex::find(const uint1024_t& hashBlock, uint32_t &nHeight) const
+        {
+            /* Blocks can share the first 64 bits of their hash, so check the full hash of each. */
+            const auto range = mapHeights.equal_range(hashBlock.Get64());
+            for(auto it = range.first; it != range.second; ++it)
+            {
+                if(vChain[it->second].hashBlock == hashBlock)
+                {
+                    nHeight = it->second;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+
+        /* Add a header to the end of the chain. */
+        void ChainIndex::push(const BlockIndex& index)
+        {
+            vChain.push_back(index);
+            mapHeights.emplace(index.hashBlock.Get64(), index.nHeight);
+        }
+
+
+        /* Remove the header at the end of the chain. */
+        void ChainIndex::pop()
+        {
+            const auto range = mapHeights.equal_range(vChain.back().hashBlock.Get64());
+            for(auto it = range.first; it != range.second; ++it)
+            {
+                if(it->second == vChain.back().nHeight)
+                {
+                    mapHeights.erase(it);
+                    break;
+                }
+            }
+
+            vChain.pop_back();
+        }
+
+
+        /* Apply a block connected or disconnected while the index was built. */
+        bool ChainIndex::apply(const std::pair<bool, BlockIndex>& entry, bool &fApplied)
+        {
+            fApplied = false;
+
+            /* Check if the index has the block from the best block it was built from. */
+            const BlockIndex& index = entry.second;
+
+            uint32_t nHeight = 0;
+            const bool fHas = find(index.hashBlock, nHeight);
+
+            /* Connected blocks not in the index have to follow the end. */
+            if(entry.first)
+            {
+                if(fHas)
+                    return true;
+
+                if(vChain.empty() || vChain.back().nHeight + 1 != index.nHeight)
+                    return false;
+
+                push(index);
+            }
+
+            /* Disconnected blocks in the index have to be the end, keeping genesis. */
+            else
+            {
+                if(!fHas)
+                    return true;
+
+                if(vChain.size() <= 1 || vChain.back().hashBlock != index.hashBlock)
+                    return false;
+
+                pop();
+            }
+
+            fApplied = true;
+
+            return true;
+        }
+
+
+        /* Empty the index. */
+        void ChainIndex::reset()
+        {
+            fReady = false;
+
+            vChain.clear();
+            mapHeights.clear();
+            vJournal.clear();
+            vPending.clear();
+        }
+
+
+        /* Start building the index again from the best block if it was cleared by a block out of order. */
+        void ChainIndex::rebuild()
+        {
+            {
+                LOCK(MUTEX);
+
+                if(!fRebuild)
+                    return;
+
+                /* Only try once, so a failed build doesn't read the chain again for every block. */
+                fRebuild = false;
+            }
+
+            /* The last build is done, since the index was built before it was cleared again. */
+            Stop();
+
+            /* Build from the best block now, on a thread so blocks aren't held up reading back to genesis. Blocks
+               connected and disconnected from here on are kept, and applied when it is built. */
+            const BlockState stateBest = ChainState::stateBest.load();
+
+            debug::log(0, FUNCTION, "building the chain index again from ", stateBest.GetHash().SubString());
+            BUILD_THREAD = std::thread([this, stateBest]()
+            {
+                Initialize(stateBest);
+            });
+        }
+    }
+}
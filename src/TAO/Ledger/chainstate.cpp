@@ -21,6 +21,8 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/create.h>
 #include <TAO/Ledger/include/timelocks.h>
 
+#include <TAO/Ledger/types/chain_index.h>
+
 /* Global TAO namespace. */
 namespace TAO
 {
@@ -200,6 +202,10 @@ namespace TAO
                 LLD::TxnCommit();
             }
 
+            /* Build the chain index of block headers. */
+            if(config::GetBoolArg("-chainindex", true))
+                ChainIndex::GetInstance().Initialize(stateBest.load());
+
             /* Fill out the best chain stats. */
             nBestHeight     = stateBest.load().nHeight;
             nBestChainTrust = stateBest.load().nChainTrust;
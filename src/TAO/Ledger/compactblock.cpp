@@ -0,0 +1,154 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/hash/xxh3.h>
+
+#include <TAO/Ledger/include/enum.h>
+
+#include <TAO/Ledger/types/compactblock.h>
+#include <TAO/Ledger/types/mempool.h>
+
+#include <map>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Get the short ID of a transaction. */
+        uint64_t ShortID(const uint512_t& hashTx, const uint64_t nSalt)
+        {
+            /* Hash the transaction hash keyed by the salt. */
+            const std::vector<uint8_t> vHash = hashTx.GetBytes();
+            const uint64_t nHash = XXH64(&vHash[0], vHash.size(), nSalt);
+
+            /* Keep the low bytes. */
+            return nHash & ((uint64_t(1) << (SHORTID_SIZE * 8)) - 1);
+        }
+
+
+        /* The default constructor. */
+        CompactBlock::CompactBlock()
+        : block     ( )
+        , nSalt     (0)
+        , vShortIDs ( )
+        {
+        }
+
+
+        /* Constructor. */
+        CompactBlock::CompactBlock(const TritiumBlock& blockIn, const uint64_t nSaltIn)
+        : block     (blockIn)
+        , nSalt     (nSaltIn)
+        , vShortIDs ( )
+        {
+            /* The transactions are sent as short IDs instead. */
+            block.vtx.clear();
+
+            /* Pack the short IDs. */
+            vShortIDs.reserve(blockIn.vtx.size() * SHORTID_SIZE);
+            for(const auto& proof : blockIn.vtx)
+            {
+                const uint64_t nShortID = ShortID(proof.second, nSalt);
+                for(uint32_t n = 0; n < SHORTID_SIZE; ++n)
+                    vShortIDs.push_back(static_cast<uint8_t>(nShortID >> (n * 8)));
+            }
+        }
+
+
+        /* Check if a block can be relayed as a compact block. */
+        bool CompactBlock::Supported(const TritiumBlock& blockIn)
+        {
+            /* Only transactions from the memory pool can be rebuilt. */
+            for(const auto& proof : blockIn.vtx)
+            {
+                if(proof.first != TRANSACTION::TRITIUM && proof.first != TRANSACTION::LEGACY)
+                    return false;
+            }
+
+            return true;
+        }
+
+
+        /* Get the total transactions in the block. */
+        uint32_t CompactBlock::Size() const
+        {
+            return vShortIDs.size() / SHORTID_SIZE;
+        }
+
+
+        /* Get the short ID of a transaction by its index. */
+        uint64_t CompactBlock::GetShortID(const uint32_t nIndex) const
+        {
+            /* Unpack the little endian bytes. */
+            uint64_t nShortID = 0;
+            for(uint32_t n = 0; n < SHORTID_SIZE; ++n)
+                nShortID |= uint64_t(vShortIDs[nIndex * SHORTID_SIZE + n]) << (n * 8);
+
+            return nShortID;
+        }
+
+
+        /* Rebuild the block from the memory pool. */
+        void CompactBlock::Rebuild(TritiumBlock& blockOut, std::vector<uint32_t> &vMissing) const
+        {
+            /* Get the transactions of the memory pool by short ID. */
+            std::map<uint64_t, std::pair<uint8_t, uint512_t>> mapShortIDs;
+            mempool.ShortIDs(nSalt, mapShortIDs);
+
+            /* Fill in the transactions that were found. */
+            blockOut = block;
+            blockOut.vtx.clear();
+
+            const uint32_t nSize = Size();
+            for(uint32_t n = 0; n < nSize; ++n)
+            {
+                /* Check for missing or ambiguous short IDs. */
+                auto it = mapShortIDs.find(GetShortID(n));
+                if(it == mapShortIDs.end() || it->second.second == 0)
+                {
+                    blockOut.vtx.push_back(std::make_pair(uint8_t(TRANSACTION::TRITIUM), uint512_t(0)));
+                    vMissing.push_back(n);
+
+                    continue;
+                }
+
+                blockOut.vtx.push_back(it->second);
+            }
+        }
+
+
+        /* Check the transactions of a rebuilt block against its merkle root. */
+        bool CompactBlock::CheckMerkle(const TritiumBlock& blockIn)
+        {
+            /* Get the hashes in the same order as the block check. */
+            std::vector<uint512_t> vHashes;
+            for(const auto& proof : blockIn.vtx)
+                vHashes.push_back(proof.second);
+
+            /* Add the producers. */
+            if(blockIn.nVersion < 9)
+                vHashes.push_back(blockIn.producer.GetHash());
+            else
+            {
+                for(const auto& txProducer : blockIn.vProducer)
+                    vHashes.push_back(txProducer.GetHash());
+            }
+
+            return blockIn.hashMerkleRoot == blockIn.BuildMerkleTree(vHashes);
+        }
+    }
+}
@@ -41,6 +41,7 @@ namespace TAO
         : DISPATCH_MUTEX ( )
         , vBlockDispatch ( )
         , vTransactionDispatch ( )
+        , vEventDispatch ( )
         {
 
         }
@@ -52,6 +53,7 @@ namespace TAO
             LOCK(DISPATCH_MUTEX);
             vBlockDispatch.clear();
             vTransactionDispatch.clear();
+            vEventDispatch.clear();
         }
 
 
@@ -85,6 +87,17 @@ namespace TAO
         }
 
 
+        /* Adds a subscripton for new sigchain events. */
+        void Dispatch::SubscribeEvent(const EventDispatchFunction& function)
+        {
+            /* Lock the mutex  */
+            LOCK(DISPATCH_MUTEX);
+
+            /* Add the function callback to our internal list */
+            vEventDispatch.push_back(function);
+        }
+
+
         /* Notify all subscribers of a new block.*/
         void Dispatch::DispatchBlock(const uint1024_t& hashBlock)
         {
@@ -122,5 +135,17 @@ namespace TAO
 
         }
 
+
+        /* Notify all subscribers of new events for a sigchain. */
+        void Dispatch::DispatchEvent(const uint256_t& hashGenesis)
+        {
+            /* Lock the mutex to synchronize access to the function pointer list */
+            LOCK(DISPATCH_MUTEX);
+
+            /* Call each one in turn, since they only wake their own threads. */
+            for(const auto& pEventDispatch : vEventDispatch)
+                pEventDispatch(hashGenesis);
+        }
+
     }
 }
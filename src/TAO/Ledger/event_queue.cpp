@@ -0,0 +1,143 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/Ledger/types/event_queue.h>
+
+#include <Util/include/mutex.h>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Default Constructor. */
+        EventQueue::EventQueue()
+        : MUTEX      ( )
+        , setTracked ( )
+        , mapPending ( )
+        , setSignal  ( )
+        {
+        }
+
+
+        /* Singleton instance. */
+        EventQueue& EventQueue::GetInstance()
+        {
+            static EventQueue ret;
+
+            return ret;
+        }
+
+
+        /* Allow the events of a sigchain to be queued, once they are scanned. */
+        void EventQueue::Track(const uint256_t& hashGenesis)
+        {
+            LOCK(MUTEX);
+
+            setTracked.insert(hashGenesis);
+        }
+
+
+        /* Start queueing the events of a tracked sigchain, before its events are scanned. */
+        bool EventQueue::Begin(const uint256_t& hashGenesis)
+        {
+            LOCK(MUTEX);
+
+            /* Check the sigchain is tracked. */
+            if(!setTracked.count(hashGenesis))
+                return false;
+
+            mapPending[hashGenesis];
+
+            return true;
+        }
+
+
+        /* Stop queueing the events of a sigchain and drop its pending events. */
+        void EventQueue::Untrack(const uint256_t& hashGenesis)
+        {
+            LOCK(MUTEX);
+
+            setTracked.erase(hashGenesis);
+            mapPending.erase(hashGenesis);
+            setSignal.erase(hashGenesis);
+        }
+
+
+        /* Drop the queued events of every sigchain, so they are all scanned again. */
+        void EventQueue::Clear()
+        {
+            LOCK(MUTEX);
+
+            mapPending.clear();
+            setSignal.clear();
+        }
+
+
+        /* Add an event written to the ledger database, if its sigchain is queued. */
+        void EventQueue::Push(const uint256_t& hashGenesis, const uint32_t nSequence)
+        {
+            LOCK(MUTEX);
+
+            /* Check the events of the sigchain are queued. */
+            auto it = mapPending.find(hashGenesis);
+            if(it == mapPending.end())
+                return;
+
+            it->second.insert(nSequence);
+            setSignal.insert(hashGenesis);
+        }
+
+
+        /* Remove an event that has been processed. */
+        void EventQueue::Remove(const uint256_t& hashGenesis, const uint32_t nSequence)
+        {
+            LOCK(MUTEX);
+
+            auto it = mapPending.find(hashGenesis);
+            if(it != mapPending.end())
+                it->second.erase(nSequence);
+        }
+
+
+        /* Get the pending events of a sigchain, newest first. */
+        bool EventQueue::Pending(const uint256_t& hashGenesis, std::vector<uint32_t> &vSequences) const
+        {
+            LOCK(MUTEX);
+
+            /* Check the events of the sigchain are queued. */
+            auto it = mapPending.find(hashGenesis);
+            if(it == mapPending.end())
+                return false;
+
+            vSequences.assign(it->second.rbegin(), it->second.rend());
+
+            return true;
+        }
+
+
+        /* Get the tracked sigchains with events written since the last signal. */
+        std::vector<uint256_t> EventQueue::Signal()
+        {
+            LOCK(MUTEX);
+
+            std::vector<uint256_t> vGenesis(setSignal.begin(), setSignal.end());
+            setSignal.clear();
+
+            return vGenesis;
+        }
+    }
+}
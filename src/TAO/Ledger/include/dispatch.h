@@ -36,6 +36,9 @@ namespace TAO
         /** Function prototype for methods wanting to be notified of transactions **/
         typedef std::function<void(const uint512_t&, bool)> TransactionDispatchFunction;
 
+        /** Function prototype for methods wanting to be notified of new events for a sigchain **/
+        typedef std::function<void(const uint256_t&)> EventDispatchFunction;
+
         class Dispatch
         {
             /** Mutex to protect the queue. **/
@@ -48,6 +51,9 @@ namespace TAO
             /** List of subscribers to transaction events  **/
             std::vector<TransactionDispatchFunction> vTransactionDispatch;
 
+            /** List of subscribers to sigchain events  **/
+            std::vector<EventDispatchFunction> vEventDispatch;
+
 
         public:
 
@@ -83,6 +89,16 @@ namespace TAO
             void SubscribeTransaction(const TransactionDispatchFunction& notify);
 
 
+            /** SubscribeEvent
+             *
+             *  Adds a subscripton for new sigchain events.
+             *
+             *  @param[in] notify The function to call for new event notifications.
+             *
+             **/
+            void SubscribeEvent(const EventDispatchFunction& notify);
+
+
             /** DispatchBlock
              *
              *  Notify all subscribers of a new block .
@@ -104,6 +120,17 @@ namespace TAO
             void DispatchTransaction(const uint512_t& hashTx, bool fConnect);
 
 
+            /** DispatchEvent
+             *
+             *  Notify all subscribers of new events for a sigchain. Subscribers are called directly, so they should
+             *  only wake whoever processes the events.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain with new events.
+             *
+             **/
+            void DispatchEvent(const uint256_t& hashGenesis);
+
+
         };
 
     }
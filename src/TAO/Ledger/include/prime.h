@@ -17,6 +17,8 @@ ________________________________________________________________________________
 
 #include <LLC/types/uint1024.h>
 
+#include <vector>
+
 /* Global TAO namespace. */
 namespace TAO
 {
@@ -114,6 +116,20 @@ namespace TAO
         uint1024_t FermatTest(const uint1024_t& hashTest);
 
 
+        /** PrimeSieve
+         *
+         *  Find the nonces in a range whose base plus nonce is a probable prime. Multiples of the primes below 2^16
+         *  are crossed out first, and the Fermat tests of the rest run together in batches.
+         *
+         *  @param[in] hashBase The base number being mined, which must be above 2^16.
+         *  @param[in] nNonce The first nonce of the range.
+         *  @param[in] nRange The total nonces in the range.
+         *  @param[out] vNonces The nonces of the probable primes, added in order.
+         *
+         **/
+        void PrimeSieve(const uint1024_t& hashBase, const uint64_t nNonce, const uint32_t nRange, std::vector<uint64_t>& vNonces);
+
+
         /** MillerRabin
          *
          *  Wrapper for is_prime from OpenSSL
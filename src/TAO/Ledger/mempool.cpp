@@ -26,10 +26,14 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/constants.h>
 #include <TAO/Ledger/include/timelocks.h>
 #include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/types/compactblock.h>
 #include <TAO/Ledger/types/mempool.h>
 
 #include <TAO/Ledger/include/create.h>
 
+#include <algorithm>
+#include <limits>
+
 
 /* Global TAO namespace. */
 namespace TAO
@@ -43,6 +47,7 @@ namespace TAO
         /** Default Constructor. **/
         Mempool::Mempool()
         : MUTEX              ( )
+        , INDEX_MUTEX        ( )
         , mapLegacy          ( )
         , mapLegacyConflicts ( )
         , mapLedger          ( )
@@ -51,6 +56,9 @@ namespace TAO
         , mapClaimed         ( )
         , mapInputs          ( )
         , setOrphansByIndex  ( )
+        , mapGenesis         ( )
+        , mapFees            ( )
+        , setPriority        ( )
         {
         }
 
@@ -68,13 +76,14 @@ namespace TAO
             uint512_t hashTx = tx.GetHash();
 
             RLOCK(MUTEX);
+            LOCK2(INDEX_MUTEX);
 
             /* Check the mempool. */
             if(mapLedger.count(hashTx))
                 return false;
 
-            /* Add to the map. */
-            mapLedger[hashTx] = tx;
+            /* Add to the indexes. */
+            index(hashTx, tx);
 
             return true;
         }
@@ -144,6 +153,8 @@ namespace TAO
                 {
                     /* Add to conflicts map. */
                     debug::error(FUNCTION, "CONFLICT: prev tx ", (mapClaimed.count(tx.hashPrevTx) ? "CLAIMED " : "CONFLICTED "), tx.hashPrevTx.SubString());
+
+                    LOCK2(INDEX_MUTEX);
                     mapConflicts[hashTx] = tx;
 
                     return false;
@@ -159,6 +170,8 @@ namespace TAO
                 {
                     /* Add to conflicts map. */
                     debug::error(FUNCTION, "CONFLICT: hash last mismatch ", tx.hashPrevTx.SubString());
+
+                    LOCK2(INDEX_MUTEX);
                     mapConflicts[hashTx] = tx;
 
                     return false;
@@ -183,11 +196,14 @@ namespace TAO
             LLD::TxnCommit(FLAGS::MEMPOOL);
 
             /* Set the internal memory. */
-            mapLedger[hashTx] = tx;
+            {
+                LOCK2(INDEX_MUTEX);
+                index(hashTx, tx);
 
-            /* Update map claimed if not first tx. */
-            if(!tx.IsFirst())
-                mapClaimed[tx.hashPrevTx] = hashTx;
+                /* Update map claimed if not first tx. */
+                if(!tx.IsFirst())
+                    mapClaimed[tx.hashPrevTx] = hashTx;
+            }
 
             /* Debug output. */
             debug::log(3, FUNCTION, "tx ", hashTx.SubString(), " ACCEPTED in ", std::dec, time.ElapsedMilliseconds(), " ms");
@@ -254,7 +270,7 @@ namespace TAO
         /* Gets a transaction from mempool */
         bool Mempool::Get(const uint512_t& hashTx, TAO::Ledger::Transaction &tx, bool &fConflicted) const
         {
-            RLOCK(MUTEX);
+            LOCK(INDEX_MUTEX);
 
             /* Check in conflict memory. */
             if(mapConflicts.count(hashTx))
@@ -283,7 +299,7 @@ namespace TAO
         /* Gets a transaction from mempool */
         bool Mempool::Get(const uint512_t& hashTx, TAO::Ledger::Transaction &tx) const
         {
-            RLOCK(MUTEX);
+            LOCK(INDEX_MUTEX);
 
             /* Check in ledger memory. */
             if(mapLedger.count(hashTx))
@@ -300,41 +316,15 @@ namespace TAO
         /* Get by genesis. */
         bool Mempool::Get(const uint256_t& hashGenesis, std::vector<TAO::Ledger::Transaction> &vtx) const
         {
-            RLOCK(MUTEX);
-
-            /* Check through the ledger map for the genesis. */
-            for(const auto& tx : mapLedger)
-            {
-                /* Check for non-conflicted genesis-id's. */
-                if(tx.second.hashGenesis == hashGenesis)
-                    vtx.push_back(tx.second);
-            }
+            LOCK(INDEX_MUTEX);
 
-            /* Check that a transaction was found. */
-            if(vtx.size() == 0)
-                return false;
+            /* Get the sigchain from the genesis index. */
+            std::vector<uint512_t> vHashes;
+            chain(hashGenesis, vHashes);
 
-            /* Sort the list by sequence numbers. */
-            std::sort(vtx.begin(), vtx.end());
-
-            /* Check that the mempool transactions are in correct order. */
-            uint512_t hashLast = vtx[0].GetHash();
-            for(uint32_t n = 1; n < vtx.size(); ++n)
-            {
-                /* Check that transaction is in sequence. */
-                if(vtx[n].hashPrevTx != hashLast)
-                {
-                    debug::log(0, FUNCTION, "Last hash mismatch");
-
-                    /* Resize to forget about mismatched sequences. */
-                    vtx.resize(n);
-
-                    break;
-                }
-
-                /* Set last hash. */
-                hashLast = vtx[n].GetHash();
-            }
+            /* Copy the transactions in sequence. */
+            for(const auto& hashTx : vHashes)
+                vtx.push_back(mapLedger.at(hashTx));
 
             return (vtx.size() > 0);
         }
@@ -343,13 +333,18 @@ namespace TAO
         /* Gets a transaction by genesis. */
         bool Mempool::Get(const uint256_t& hashGenesis, TAO::Ledger::Transaction &tx) const
         {
-            /* Get the list of transactions by genesis. */
-            std::vector<TAO::Ledger::Transaction> vtx;
-            if(!Get(hashGenesis, vtx))
+            LOCK(INDEX_MUTEX);
+
+            /* Get the sigchain from the genesis index. */
+            std::vector<uint512_t> vHashes;
+            chain(hashGenesis, vHashes);
+
+            /* Check that a transaction was found. */
+            if(vHashes.empty())
                 return false;
 
             /* Return last item in list (newest). */
-            tx = vtx.back();
+            tx = mapLedger.at(vHashes.back());
 
             return true;
         }
@@ -358,7 +353,7 @@ namespace TAO
         /* Checks if a transaction exists. */
         bool Mempool::Has(const uint512_t& hashTx) const
         {
-            RLOCK(MUTEX);
+            LOCK(INDEX_MUTEX);
 
             return mapLedger.count(hashTx) || mapLegacy.count(hashTx) || mapConflicts.count(hashTx);
         }
@@ -367,14 +362,9 @@ namespace TAO
         /* Checks if a genesis exists. */
         bool Mempool::Has(const uint256_t& hashGenesis) const
         {
-            RLOCK(MUTEX);
+            LOCK(INDEX_MUTEX);
 
-            /* Check through the ledger map for the genesis. */
-            for(const auto& tx : mapLedger)
-                if(tx.second.hashGenesis == hashGenesis)
-                    return true;
-
-            return false;
+            return mapGenesis.count(hashGenesis);
         }
 
 
@@ -382,6 +372,7 @@ namespace TAO
         bool Mempool::Remove(const uint512_t& hashTx)
         {
             RLOCK(MUTEX);
+            LOCK2(INDEX_MUTEX);
 
             /* Erase from conflicted memory. */
             if(mapConflicts.count(hashTx))
@@ -398,13 +389,13 @@ namespace TAO
             /* Find the transaction in pool. */
             if(mapLedger.count(hashTx))
             {
-                /* Get a reference from the map. */
-                const TAO::Ledger::Transaction& tx = mapLedger[hashTx];
+                /* Get the previous hash from the map. */
+                const uint512_t hashPrevTx = mapLedger.at(hashTx).hashPrevTx;
 
                 /* Erase from the memory map. */
-                mapClaimed.erase(tx.hashPrevTx);
-                mapOrphans.erase(tx.hashPrevTx);
-                mapLedger.erase(hashTx);
+                mapClaimed.erase(hashPrevTx);
+                mapOrphans.erase(hashPrevTx);
+                unindex(hashTx);
 
                 return true;
             }
@@ -433,21 +424,15 @@ namespace TAO
 
             //TODO: evict conflicted transctions from mempool
 
-            /* Create map of transactions by genesis. */
+            /* Copy the transactions by genesis, since removing them changes the indexes. Only writers change the
+             * indexes, so they can be read here without INDEX_MUTEX. */
             std::map<uint256_t, std::vector<TAO::Ledger::Transaction> > mapTransactions;
-
-            /* Loop through all the transactions. */
-            for(const auto& tx : mapLedger)
+            for(const auto& list : mapGenesis)
             {
-                /* Cache the genesis. */
-                const uint256_t& hashGenesis = tx.second.hashGenesis;
-
-                /* Check in map for push back. */
-                if(!mapTransactions.count(hashGenesis))
-                    mapTransactions[hashGenesis] = std::vector<TAO::Ledger::Transaction>();
-
-                /* Push to back of map. */
-                mapTransactions[hashGenesis].push_back(tx.second);
+                /* Copy the transactions in sequence. */
+                std::vector<TAO::Ledger::Transaction>& vtx = mapTransactions[list.first];
+                for(const auto& hashTx : list.second)
+                    vtx.push_back(mapLedger.at(hashTx));
             }
 
             /* Loop transctions map by genesis. */
@@ -456,9 +441,6 @@ namespace TAO
                 /* Get reference of the vector. */
                 std::vector<TAO::Ledger::Transaction>& vtx = list.second;
 
-                /* Sort the list by sequence numbers. */
-                std::sort(vtx.begin(), vtx.end());
-
                 /* Add the hashes into list. */
                 uint512_t hashLast = 0;
 
@@ -497,8 +479,9 @@ namespace TAO
                                 debug::log(0, "DELETED ", tx->GetHash().SubString());
 
                                 /* Erase from the memory map. */
+                                LOCK2(INDEX_MUTEX);
                                 mapClaimed.erase(tx->hashPrevTx);
-                                mapLedger.erase(tx->GetHash());
+                                unindex(tx->GetHash());
                             }
                         }
 
@@ -571,91 +554,62 @@ namespace TAO
         /* List transactions in memory pool. */
         bool Mempool::List(std::vector<uint512_t> &vHashes, uint32_t nCount, bool fLegacy)
         {
-            RLOCK(MUTEX);
-
-            //TODO: need to check dependant transactions and sequence them properly otherwise this will fail
-
             /* If legacy flag set, skip over getting tritium transactions. */
             if(!fLegacy)
             {
-                /* Create map of transactions by genesis. */
-                std::map<uint256_t, std::vector<TAO::Ledger::Transaction> > mapTransactions;
-
-                /* Loop through all the transactions. */
-                for(const auto& tx : mapLedger)
+                /* Copy the sigchains by priority with their first transaction, so the disk isn't read under the lock. */
+                std::vector<std::pair<TAO::Ledger::Transaction, std::vector<uint512_t> > > vChains;
                 {
-                    /* Check that this transaction isn't conflicted. */
-                    //if(mapConflicts.count(tx.first))
-                    //    continue;
-
-                    /* Cache the genesis. */
-                    const uint256_t& hashGenesis = tx.second.hashGenesis;
+                    LOCK(INDEX_MUTEX);
 
-                    /* Check in map for push back. */
-                    if(!mapTransactions.count(hashGenesis))
-                        mapTransactions[hashGenesis] = std::vector<TAO::Ledger::Transaction>();
+                    vChains.reserve(setPriority.size());
+                    for(const auto& key : setPriority)
+                    {
+                        /* Get the transactions that are in sequence. */
+                        std::vector<uint512_t> vChain;
+                        chain(std::get<2>(key), vChain);
 
-                    /* Push to back of map. */
-                    mapTransactions[hashGenesis].push_back(tx.second);
+                        vChains.push_back(std::make_pair(mapLedger.at(vChain[0]), vChain));
+                    }
                 }
 
-                /* Loop transctions map by genesis. */
-                for(auto& list : mapTransactions)
+                /* Loop the sigchains in order of priority. */
+                for(const auto& list : vChains)
                 {
-                    /* Get reference of the vector. */
-                    std::vector<TAO::Ledger::Transaction>& vtx = list.second;
-
-                    /* Sort the list by sequence numbers. */
-                    std::sort(vtx.begin(), vtx.end());
-
-                    /* Add the hashes into list. */
-                    uint512_t hashLast = 0;
-
                     /* Check last hash for valid transactions. */
-                    if(!vtx[0].IsFirst())
+                    const TAO::Ledger::Transaction& txFirst = list.first;
+                    if(!txFirst.IsFirst())
                     {
                         /* Read last index from disk. */
-                        if(!LLD::Ledger->ReadLast(list.first, hashLast))
-                            break; //NOTE: this may need an error
+                        uint512_t hashLast = 0;
+                        if(!LLD::Ledger->ReadLast(txFirst.hashGenesis, hashLast))
+                            continue;
 
                         /* Check the last hash. */
-                        if(vtx[0].hashPrevTx != hashLast)
-                            break;
+                        if(txFirst.hashPrevTx != hashLast)
+                            continue;
                     }
 
-                    /* Set last from next transaction. */
-                    hashLast = vtx[0].GetHash();
-
-                    /* Loop through transaction by genesis. */
-                    for(uint32_t n = 1; n <= vtx.size(); ++n)
+                    /* Add the sigchain to the output queue. */
+                    for(const auto& hashTx : list.second)
                     {
-                        /* Add to the output queue. */
-                        vHashes.push_back(hashLast);
-
-                        /* Check for end of index. */
-                        if(n == vtx.size())
-                            break;
+                        vHashes.push_back(hashTx);
 
                         /* Check count. */
                         if(--nCount == 0)
                             return true;
-
-                        /* Check that transaction is in sequence. */
-                        if(vtx[n].hashPrevTx != hashLast)
-                            break; //SKIP ANY ORPHANS FOUND
-
-                        /* Set last hash. */
-                        hashLast = vtx[n].GetHash();
                     }
                 }
             }
             else
             {
+                LOCK(INDEX_MUTEX);
+
                 /* Loop transctions map by genesis. */
                 for(const auto& list : mapLegacy)
                 {
                     /* Push legacy transactions last. */
-                    vHashes.push_back(list.first);;
+                    vHashes.push_back(list.first);
 
                     /* Check for end of line. */
                     if(--nCount == 0)
@@ -667,12 +621,151 @@ namespace TAO
         }
 
 
+        /* Get the transactions in memory pool by their short ID for a compact block. */
+        void Mempool::ShortIDs(const uint64_t nSalt, std::map<uint64_t, std::pair<uint8_t, uint512_t>> &mapShortIDs) const
+        {
+            LOCK(INDEX_MUTEX);
+
+            /* Add the tritium transactions. */
+            for(const auto& tx : mapLedger)
+            {
+                /* Short IDs that match more than one transaction can't be used. */
+                const uint64_t nShortID = ShortID(tx.first, nSalt);
+                if(mapShortIDs.count(nShortID))
+                    mapShortIDs[nShortID].second = 0;
+                else
+                    mapShortIDs[nShortID] = std::make_pair(uint8_t(TRANSACTION::TRITIUM), tx.first);
+            }
+
+            /* Add the legacy transactions. */
+            for(const auto& tx : mapLegacy)
+            {
+                /* Short IDs that match more than one transaction can't be used. */
+                const uint64_t nShortID = ShortID(tx.first, nSalt);
+                if(mapShortIDs.count(nShortID))
+                    mapShortIDs[nShortID].second = 0;
+                else
+                    mapShortIDs[nShortID] = std::make_pair(uint8_t(TRANSACTION::LEGACY), tx.first);
+            }
+        }
+
+
         /* Gets the size of the memory pool. */
         uint32_t Mempool::Size()
         {
-            RLOCK(MUTEX);
+            LOCK(INDEX_MUTEX);
 
             return static_cast<uint32_t>(mapLedger.size() + mapLegacy.size());
         }
+
+
+        /* Get the priority key of a sigchain in the ledger memory pool from its total fees. */
+        std::tuple<uint64_t, uint64_t, uint256_t> Mempool::priority(const uint256_t& hashGenesis) const
+        {
+            /* Higher fees sort first, then the oldest sigchains. */
+            return std::make_tuple(std::numeric_limits<uint64_t>::max() - mapFees.at(hashGenesis),
+                                   mapLedger.at(mapGenesis.at(hashGenesis)[0]).nTimestamp, hashGenesis);
+        }
+
+
+        /* Get the fees of a transaction, where malformed contracts count as having no fees. */
+        uint64_t Mempool::fees(const TAO::Ledger::Transaction& tx)
+        {
+            try
+            {
+                return tx.Fees();
+            }
+            catch(const std::exception& e)
+            {
+            }
+
+            return 0;
+        }
+
+
+        /* Add a transaction to the ledger memory pool and its indexes. */
+        void Mempool::index(const uint512_t& hashTx, const TAO::Ledger::Transaction& tx)
+        {
+            /* Take the sigchain out of the priority index while it changes. */
+            std::vector<uint512_t>& vHashes = mapGenesis[tx.hashGenesis];
+            if(!vHashes.empty())
+                setPriority.erase(priority(tx.hashGenesis));
+
+            /* Add to the hash index. */
+            mapLedger[hashTx] = tx;
+
+            /* Insert in order of sequence, which is the end of the sigchain for accepted transactions. */
+            auto it = vHashes.end();
+            while(it != vHashes.begin() && mapLedger.at(*(it - 1)).nSequence > tx.nSequence)
+                --it;
+
+            vHashes.insert(it, hashTx);
+
+            /* Add the fees to the sigchain's total, and put it back by its new priority. */
+            mapFees[tx.hashGenesis] += fees(tx);
+            setPriority.insert(priority(tx.hashGenesis));
+        }
+
+
+        /* Remove a transaction from the ledger memory pool and its indexes. */
+        void Mempool::unindex(const uint512_t& hashTx)
+        {
+            /* Find the transaction in the hash index. */
+            auto itTx = mapLedger.find(hashTx);
+            if(itTx == mapLedger.end())
+                return;
+
+            /* Remove from the sigchain, taking it out of the priority index while it changes. */
+            const uint256_t hashGenesis = itTx->second.hashGenesis;
+            auto itChain = mapGenesis.find(hashGenesis);
+            if(itChain != mapGenesis.end())
+            {
+                setPriority.erase(priority(hashGenesis));
+
+                std::vector<uint512_t>& vHashes = itChain->second;
+                vHashes.erase(std::remove(vHashes.begin(), vHashes.end(), hashTx), vHashes.end());
+
+                mapFees[hashGenesis] -= fees(itTx->second);
+            }
+
+            /* Erase from the hash index. */
+            mapLedger.erase(itTx);
+
+            /* Put the rest of the sigchain back by its new priority. */
+            if(itChain != mapGenesis.end())
+            {
+                if(itChain->second.empty())
+                {
+                    mapGenesis.erase(itChain);
+                    mapFees.erase(hashGenesis);
+                }
+                else
+                    setPriority.insert(priority(hashGenesis));
+            }
+        }
+
+
+        /* Get the transactions of a sigchain in the ledger memory pool that are in sequence. */
+        void Mempool::chain(const uint256_t& hashGenesis, std::vector<uint512_t> &vHashes) const
+        {
+            /* Find the sigchain. */
+            auto it = mapGenesis.find(hashGenesis);
+            if(it == mapGenesis.end())
+                return;
+
+            /* Check that the mempool transactions are in correct order. */
+            const std::vector<uint512_t>& vChain = it->second;
+            for(uint32_t n = 0; n < vChain.size(); ++n)
+            {
+                /* Check that transaction is in sequence. */
+                if(n > 0 && mapLedger.at(vChain[n]).hashPrevTx != vChain[n - 1])
+                {
+                    debug::log(0, FUNCTION, "Last hash mismatch");
+                    break;
+                }
+
+                vHashes.push_back(vChain[n]);
+            }
+        }
     }
 }
@@ -90,6 +90,9 @@ namespace TAO
             vchPubKey     = tx.vchPubKey;
             vchSig        = tx.vchSig;
 
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
+
             hashBlock     = tx.hashBlock;
             vMerkleBranch = tx.vMerkleBranch;
             nIndex        = tx.nIndex;
@@ -114,6 +117,9 @@ namespace TAO
             vchPubKey     = std::move(tx.vchPubKey);
             vchSig        = std::move(tx.vchSig);
 
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
+
             hashBlock     = std::move(tx.hashBlock);
             vMerkleBranch = std::move(tx.vMerkleBranch);
             nIndex        = std::move(tx.nIndex);
@@ -138,6 +144,9 @@ namespace TAO
             vchPubKey     = tx.vchPubKey;
             vchSig        = tx.vchSig;
 
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
+
             return *this;
         }
 
@@ -158,6 +167,9 @@ namespace TAO
             vchPubKey     = std::move(tx.vchPubKey);
             vchSig        = std::move(tx.vchSig);
 
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
+
             return *this;
         }
 
@@ -12,6 +12,7 @@
 ____________________________________________________________________________________________*/
 
 #include <TAO/Ledger/include/prime.h>
+#include <LLC/include/fermat.h>
 #include <LLC/types/bignum.h>
 #include <openssl/bn.h>
 
@@ -29,6 +30,40 @@ namespace TAO
 
         static const uint16_t nSmallPrimes[11] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31 };
 
+
+        /* Get the odd primes below 2^16 used to cross out candidates in the sieve. */
+        static const std::vector<uint16_t>& SievePrimes()
+        {
+            static const std::vector<uint16_t> vPrimes = []()
+            {
+                std::vector<bool> vComposite(1 << 16, false);
+                std::vector<uint16_t> vList;
+                for(uint32_t n = 3; n < vComposite.size(); n += 2)
+                {
+                    if(vComposite[n])
+                        continue;
+
+                    vList.push_back(n);
+                    for(uint32_t m = n * n; m < vComposite.size(); m += n << 1)
+                        vComposite[m] = true;
+                }
+
+                return vList;
+            }();
+
+            return vPrimes;
+        }
+
+
+        /* Breaks the remainder of a composite into an integer, given its Fermat remainder. */
+        static uint32_t FractionalDifficulty(const uint1024_t& hashComposite, const uint1024_t& hashRemainder)
+        {
+            uint1056_t a(hashComposite);
+            uint1056_t b(hashRemainder);
+
+            return ((a - b << 24) / a).getuint32();
+        }
+
         /* Convert Double to unsigned int Representative. */
         uint32_t SetBits(double nDiff)
         {
@@ -43,8 +78,8 @@ namespace TAO
         /* Determines the difficulty of the Given Prime Number. */
         double GetPrimeDifficulty(const uint1024_t& hashPrime, const std::vector<uint8_t>& vOffsets, const bool fVerify)
         {
-            /* Return 0 if base is not prime. */
-            if(fVerify && !PrimeCheck(hashPrime))
+            /* Return 0 if base is not prime. The tritium version tests it along with the rest of the cluster. */
+            if(fVerify && vOffsets.empty() && !PrimeCheck(hashPrime))
                 return 0.0;
 
             /* Keep track of the cluster size. */
@@ -55,6 +90,7 @@ namespace TAO
             if(!vOffsets.empty())
             {
                 /* Loop through offsets pattern. */
+                std::vector<uint1024_t> vCluster(1, hashPrime);
                 uint32_t nSize = vOffsets.size();
                 for(uint32_t n = 0; n < nSize - 4; ++n)
                 {
@@ -67,20 +103,49 @@ namespace TAO
 
                     /* Set the next offset position. */
                     hashNext += nOffset;
-
-                    /* Check prime at offset. */
-                    if(!fVerify || PrimeCheck(hashNext))
-                        ++nClusterSize;
-
+                    vCluster.push_back(hashNext);
                 }
 
                 /* Get fractional difficulty. */
                 uint32_t nFraction = 0;
                 std::copy((uint8_t*)&vOffsets[nSize - 4], (uint8_t*)&vOffsets[nSize - 1], (uint8_t*)&nFraction);
 
-                /* If verifying check the fractional difficulty. */
-                if(fVerify && GetFractionalDifficulty(hashNext + 14) != nFraction)
-                    return 0.0;
+                /* Without verifying, every offset counts towards the cluster. */
+                if(!fVerify)
+                    nClusterSize = vCluster.size();
+                else
+                {
+                    /* The base has to pass the small divisors to be prime. */
+                    if(!SmallDivisors(hashPrime))
+                        return 0.0;
+
+                    /* Run the Fermat tests of the cluster together, with the composite after it last. */
+                    std::vector<uint1024_t> vTests;
+                    for(const auto& hashTest : vCluster)
+                    {
+                        if(SmallDivisors(hashTest))
+                            vTests.push_back(hashTest);
+                    }
+                    vTests.push_back(hashNext + 14);
+
+                    std::vector<uint1024_t> vRemainders;
+                    LLC::FermatBatch(vTests, vRemainders);
+
+                    /* Return 0 if base is not prime. */
+                    if(vRemainders[0] != 1)
+                        return 0.0;
+
+                    /* Check prime at each offset. */
+                    for(uint32_t n = 1; n < vTests.size() - 1; ++n)
+                    {
+                        if(vRemainders[n] == 1)
+                            ++nClusterSize;
+                    }
+
+                    /* Check the fractional difficulty. */
+                    if(FractionalDifficulty(vTests.back(), vRemainders.back()) != nFraction)
+                        return 0.0;
+                }
 
                 /* Calculate the rarity of cluster from proportion of fermat remainder of last prime + 2. */
                 cv::softdouble nRemainder = cv::softdouble(1000000.0) / cv::softdouble(nFraction);
@@ -159,13 +224,7 @@ namespace TAO
         /* Breaks the remainder of last composite in Prime Cluster into an integer. */
         uint32_t GetFractionalDifficulty(const uint1024_t& hashComposite)
     	{
-            //LLC::CBigNum a(nComposite);
-            //LLC::CBigNum b(FermatTest(nComposite));
-
-            uint1056_t a(hashComposite);
-            uint1056_t b(FermatTest(hashComposite));
-
-            return ((a - b << 24) / a).getuint32();
+            return FractionalDifficulty(hashComposite, FermatTest(hashComposite));
     	}
 
 
@@ -187,16 +246,48 @@ namespace TAO
         /* Used after Miller-Rabin and Divisor tests to verify primality. */
         uint1024_t FermatTest(const uint1024_t& hashTest)
         {
-            LLC::CAutoBN_CTX pctx;
+            return LLC::FermatTest(hashTest);
+        }
 
-            LLC::CBigNum bnPrime(hashTest);
-            LLC::CBigNum bnBase(2);
-            LLC::CBigNum bnExp = bnPrime - 1;
 
-            LLC::CBigNum bnResult;
-            BN_mod_exp(bnResult.getBN(), bnBase.getBN(), bnExp.getBN(), bnPrime.getBN(), pctx);
+        /* Find the nonces in a range whose base plus nonce is a probable prime. */
+        void PrimeSieve(const uint1024_t& hashBase, const uint64_t nNonce, const uint32_t nRange, std::vector<uint64_t>& vNonces)
+        {
+            /* Cross out the multiples of the small primes in the range. */
+            const uint1024_t hashStart = hashBase + nNonce;
+            std::vector<bool> vComposite(nRange, false);
+            for(uint32_t n = hashStart % 2; n < nRange; n += 2)
+                vComposite[n] = true;
+
+            for(const uint16_t nPrime : SievePrimes())
+            {
+                /* Get the first multiple of this prime in the range. */
+                const uint32_t nRemainder = hashStart % nPrime;
+                for(uint32_t n = (nRemainder == 0 ? 0 : nPrime - nRemainder); n < nRange; n += nPrime)
+                    vComposite[n] = true;
+            }
+
+            /* Run the Fermat tests of the survivors together. */
+            std::vector<uint1024_t> vTests;
+            std::vector<uint32_t> vIndex;
+            for(uint32_t n = 0; n < nRange; ++n)
+            {
+                if(vComposite[n])
+                    continue;
+
+                vTests.push_back(hashStart + n);
+                vIndex.push_back(n);
+            }
 
-            return bnResult.getuint1024();
+            std::vector<uint1024_t> vRemainders;
+            LLC::FermatBatch(vTests, vRemainders);
+
+            /* Add the nonces of the probable primes. */
+            for(uint32_t n = 0; n < vTests.size(); ++n)
+            {
+                if(vRemainders[n] == 1)
+                    vNonces.push_back(nNonce + vIndex[n]);
+            }
         }
 
 
@@ -19,6 +19,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/retarget.h>
 #include <TAO/Ledger/include/constants.h>
 
+#include <TAO/Ledger/types/chain_index.h>
 #include <TAO/Ledger/types/state.h>
 
 #include <Util/include/softfloat.h>
@@ -47,6 +48,34 @@ namespace TAO
         {
             uint64_t nIterator = 0, nWeightedAverage = 0;
 
+            /* Walk the chain index when the block is in it, since only the block times are needed. */
+            BlockIndex firstIndex;
+            if(ChainIndex::GetInstance().Get(state.GetHash(), firstIndex))
+            {
+                for(int32_t nIndex = nDepth; nIndex > 0; --nIndex)
+                {
+                    /* Find the previous block. */
+                    BlockIndex lastIndex;
+                    if(firstIndex.nHeight == 0
+                    || !ChainIndex::GetInstance().Last(firstIndex.nHeight - 1, state.GetChannel(), lastIndex)
+                    || lastIndex.nHeight == 0)
+                        break;
+
+                    /* Calculate the time. */
+                    uint64_t nTime = std::max(firstIndex.nTime - lastIndex.nTime, uint64_t(1)) * nIndex * 3;
+                    firstIndex = lastIndex;
+
+                    /* Weight the iterator based on the weight constant. */
+                    nIterator += (nIndex * 3);
+                    nWeightedAverage += nTime;
+                }
+
+                /* Calculate the weighted average. */
+                nWeightedAverage /= nIterator;
+
+                return nWeightedAverage;
+            }
+
             /* Find the introductory block. */
             BlockState first = state;
             for(int32_t nIndex = nDepth; nIndex > 0; --nIndex)
@@ -42,9 +42,12 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/timelocks.h>
 #include <TAO/Ledger/include/retarget.h>
 
+#include <TAO/Ledger/types/chain_index.h>
+#include <TAO/Ledger/types/event_queue.h>
 #include <TAO/Ledger/types/genesis.h>
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Ledger/types/client.h>
+#include <TAO/Ledger/types/validation_pool.h>
 
 #include <Util/include/string.h>
 
@@ -75,6 +78,12 @@ namespace TAO
                 if(state.GetChannel() == nChannel)
                     return true;
 
+                /* Search the chain index when the previous block is in it, so only the block found is read. */
+                BlockIndex index;
+                if(ChainIndex::GetInstance().Last(state.hashPrevBlock, nChannel, index)
+                && LLD::Ledger->ReadBlock(index.hashBlock, state))
+                    return (index.nHeight != 0);
+
                 /* Iterate backwards. */
                 state = state.Prev();
                 if(!state)
@@ -1051,6 +1060,10 @@ namespace TAO
                 {
                     /* Notify subscribers of new block. */
                     Dispatch::GetInstance().DispatchBlock(hash);
+
+                    /* Notify subscribers of tracked sigchains with new events. */
+                    for(const auto& hashGenesis : EventQueue::GetInstance().Signal())
+                        Dispatch::GetInstance().DispatchEvent(hashGenesis);
                 }
                 else
                     debug::log(3, FUNCTION, "Skipping relay until chain is done synchronizing");
@@ -1072,9 +1085,36 @@ namespace TAO
             uint64_t nPoolFeeTotal = 0;
             uint512_t hashBlockFinder = vtx.back().second; //block finder is last in vtx
 
+            /* Read the tritium transactions and their register pre-states across the validation threads,
+             * so connecting them in order below works from memory. */
+            const uint32_t nSize = vtx.size();
+            std::vector<TAO::Ledger::Transaction> vTritium(nSize);
+            bool fPrepared = ValidationPool::GetInstance().ForEach(nSize, [this, &vTritium](const uint32_t n)
+            {
+                /* Only tritium transactions have register pre-states. */
+                if(vtx[n].first != TRANSACTION::TRITIUM)
+                    return true;
+
+                /* Make sure the transaction is on disk. */
+                TAO::Ledger::Transaction& tx = vTritium[n];
+                if(!LLD::Ledger->ReadTx(vtx[n].second, tx))
+                    return debug::error(FUNCTION, "transaction not on disk");
+
+                /* Read the registers the contracts will be verified against. */
+                tx.Prefetch(FLAGS::BLOCK);
+
+                return true;
+            });
+
+            /* Check that every transaction could be read. */
+            if(!fPrepared)
+                return false;
+
             /* Check through all the transactions. */
-            for(const auto& proof : vtx)
+            for(uint32_t n = 0; n < nSize; ++n)
             {
+                const auto& proof = vtx[n];
+
                 /* Only work on tritium transactions for now. */
                 if(proof.first == TRANSACTION::TRITIUM)
                 {
@@ -1088,11 +1128,8 @@ namespace TAO
                     if(LLD::Ledger->HasIndex(hash))
                         return debug::error(FUNCTION, "transaction overwrites not allowed");
 
-                    /* Make sure the transaction is on disk. */
-                    TAO::Ledger::Transaction tx;
-                    if(!LLD::Ledger->ReadTx(hash, tx))
-                        return debug::error(FUNCTION, "transaction not on disk");
-
+                    /* Get the transaction read ahead. */
+                    const TAO::Ledger::Transaction& tx = vTritium[n];
                     if(config::nVerbose >= 3)
                         tx.print();
 
@@ -1229,6 +1266,9 @@ namespace TAO
             if(config::GetBoolArg("-indexheight"))
                 LLD::Ledger->IndexBlock(nHeight, GetHash());
 
+            /* Add the block to the chain index. */
+            ChainIndex::GetInstance().Connect(*this);
+
             /* Update chain pointer for previous block. */
             if(!prev.IsNull())
             {
@@ -1295,6 +1335,12 @@ namespace TAO
             if(config::GetBoolArg("-indexheight"))
                 LLD::Ledger->EraseIndex(nHeight);
 
+            /* Remove the block from the chain index. */
+            ChainIndex::GetInstance().Disconnect(*this);
+
+            /* Scan the events again, since processed events may be outstanding once more. */
+            EventQueue::GetInstance().Clear();
+
             /* Update the previous state's next pointer. */
             BlockState prev = Prev();
             if(!prev.IsNull())
@@ -1451,6 +1497,10 @@ namespace TAO
         /* Function to determine if this block has been connected into the main chain. */
         bool BlockState::IsInMainChain() const
         {
+            /* Check the chain index when it is built, since this state's next pointer can be stale. */
+            if(ChainIndex::GetInstance().Ready())
+                return ChainIndex::GetInstance().Has(GetHash());
+
             return (hashNextBlock != 0 || GetHash() == ChainState::hashBestChain.load());
         }
 
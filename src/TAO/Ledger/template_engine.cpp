@@ -0,0 +1,188 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/Ledger/types/template_engine.h>
+
+#include <LLC/hash/SK.h>
+#include <LLC/hash/macro.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/types/mempool.h>
+
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+#include <Util/include/runtime.h>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Default Constructor. */
+        TemplateEngine::TemplateEngine()
+        : MUTEX         ( )
+        , blockTemplate ( )
+        , vBranch       ( )
+        , nLeaves       (0)
+        , hashKey       (0)
+        , hashBest      (0)
+        , nMempool      (0)
+        , nCreated      (0)
+        , nExtraNonce   (0)
+        , fValid        (false)
+        {
+        }
+
+
+        /* Get the shared engine of a channel. */
+        TemplateEngine& TemplateEngine::GetInstance(const uint32_t nChannel)
+        {
+            static TemplateEngine vEngines[4];
+
+            return vEngines[nChannel % 4];
+        }
+
+
+        /* Drop the template, so the next block creates a new one. */
+        void TemplateEngine::Clear()
+        {
+            LOCK(MUTEX);
+
+            fValid = false;
+        }
+
+
+        /* Get a block with unique work from the template, creating the template first if it is stale. */
+        bool TemplateEngine::New(const uint512_t& hashKeyIn, const TemplateFunction& xCreate, TritiumBlock &block)
+        {
+            LOCK(MUTEX);
+
+            /* Create the template again if the key, best block or memory pool changed, or it is too old. */
+            if(!fValid || hashKey != hashKeyIn || hashBest != ChainState::hashBestChain.load()
+            || nMempool != mempool.Size() || runtime::unifiedtimestamp() >= nCreated + TEMPLATE_LIFETIME)
+            {
+                if(!create(hashKeyIn, xCreate))
+                    return false;
+            }
+
+            /* Copy the template with the next extra nonce. */
+            block = blockTemplate;
+            block.vMerkleTree.clear();
+
+            Transaction& txProducer = (block.nVersion < 9 ? block.producer : block.vProducer.back());
+            if(!SetExtraNonce(txProducer, ++nExtraNonce))
+            {
+                /* Producers without a coinbase are created for every block. */
+                fValid = false;
+
+                return xCreate(block, nExtraNonce);
+            }
+
+            /* Hash the producer up its branch. It is the last node of every level, so it is hashed with itself when
+             * it has no left neighbour. */
+            uint512_t hashMerkle = txProducer.GetHash();
+            uint32_t nIndex = nLeaves - 1;
+            for(const auto& hashLeaf : vBranch)
+            {
+                if(nIndex & 1)
+                    hashMerkle = LLC::SK512(BEGIN(hashLeaf), END(hashLeaf), BEGIN(hashMerkle), END(hashMerkle));
+                else
+                    hashMerkle = LLC::SK512(BEGIN(hashMerkle), END(hashMerkle), BEGIN(hashMerkle), END(hashMerkle));
+
+                nIndex >>= 1;
+            }
+
+            block.hashMerkleRoot = hashMerkle;
+            block.UpdateTime();
+
+            return true;
+        }
+
+
+        /* Set the extra nonce of a producer's coinbase. */
+        bool TemplateEngine::SetExtraNonce(Transaction &txProducer, const uint64_t nExtraNonceIn)
+        {
+            /* Check for a contract. */
+            if(txProducer.Size() == 0)
+                return false;
+
+            /* Read the coinbase. */
+            TAO::Operation::Contract& contract = txProducer[0];
+            contract.Reset();
+
+            uint8_t nOP = 0;
+            contract >> nOP;
+            if(nOP != TAO::Operation::OP::COINBASE)
+                return false;
+
+            uint256_t hashGenesis = 0;
+            uint64_t nCredit      = 0;
+            contract >> hashGenesis;
+            contract >> nCredit;
+
+            /* Write it back with the new extra nonce. */
+            contract.Clear(TAO::Operation::Contract::OPERATIONS);
+            contract << uint8_t(TAO::Operation::OP::COINBASE) << hashGenesis << nCredit << nExtraNonceIn;
+
+            /* The contract was written through a reference, so hash the producer again. */
+            txProducer.invalidate();
+
+            return true;
+        }
+
+
+        /* Create a new template and its producer's merkle branch. */
+        bool TemplateEngine::create(const uint512_t& hashKeyIn, const TemplateFunction& xCreate)
+        {
+            /* Get what the template depends on before creating it, so changes while creating make it stale. */
+            fValid   = false;
+            hashKey  = hashKeyIn;
+            hashBest = ChainState::hashBestChain.load();
+            nMempool = mempool.Size();
+            nCreated = runtime::unifiedtimestamp();
+
+            /* Create the template. */
+            TritiumBlock blockNew;
+            if(!xCreate(blockNew, ++nExtraNonce))
+                return debug::error(FUNCTION, "failed to create block template");
+
+            /* Check for a producer. */
+            if(blockNew.nVersion >= 9 && blockNew.vProducer.empty())
+                return debug::error(FUNCTION, "block template has no producer");
+
+            const Transaction& txProducer = (blockNew.nVersion < 9 ? blockNew.producer : blockNew.vProducer.back());
+
+            /* Get the merkle branch of the producer, which is the last leaf. */
+            std::vector<uint512_t> vHashes;
+            vHashes.reserve(blockNew.vtx.size() + 1);
+            for(const auto& tx : blockNew.vtx)
+                vHashes.push_back(tx.second);
+
+            vHashes.push_back(txProducer.GetHash());
+
+            blockNew.BuildMerkleTree(vHashes);
+            vBranch = blockNew.GetMerkleBranch(vHashes, vHashes.size() - 1);
+            nLeaves = vHashes.size();
+
+            blockTemplate = blockNew;
+            fValid        = true;
+
+            return true;
+        }
+    }
+}
@@ -61,7 +61,12 @@ namespace TAO
 
         /* Default Constructor. */
         Transaction::Transaction()
-        : vContracts   ( )
+        : CACHE_MUTEX  ( )
+        , fCached      (false)
+        , hashCached   (0)
+        , nCachedSize  (0)
+        , headerCached ( )
+        , vContracts   ( )
         , nVersion     (TAO::Ledger::CurrentTransactionVersion())
         , nSequence    (0)
         , nTimestamp   (runtime::unifiedtimestamp())
@@ -79,7 +84,12 @@ namespace TAO
 
         /* Copy constructor. */
         Transaction::Transaction(const Transaction& tx)
-        : vContracts   (tx.vContracts)
+        : CACHE_MUTEX  ( )
+        , fCached      (false)
+        , hashCached   (0)
+        , nCachedSize  (0)
+        , headerCached ( )
+        , vContracts   (tx.vContracts)
         , nVersion     (tx.nVersion)
         , nSequence    (tx.nSequence)
         , nTimestamp   (tx.nTimestamp)
@@ -92,12 +102,19 @@ namespace TAO
         , vchPubKey    (tx.vchPubKey)
         , vchSig       (tx.vchSig)
         {
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
         }
 
 
         /* Move constructor. */
         Transaction::Transaction(Transaction&& tx) noexcept
-        : vContracts   (std::move(tx.vContracts))
+        : CACHE_MUTEX  ( )
+        , fCached      (false)
+        , hashCached   (0)
+        , nCachedSize  (0)
+        , headerCached ( )
+        , vContracts   (std::move(tx.vContracts))
         , nVersion     (std::move(tx.nVersion))
         , nSequence    (std::move(tx.nSequence))
         , nTimestamp   (std::move(tx.nTimestamp))
@@ -110,12 +127,19 @@ namespace TAO
         , vchPubKey    (std::move(tx.vchPubKey))
         , vchSig       (std::move(tx.vchSig))
         {
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
         }
 
 
         /* Copy constructor. */
         Transaction::Transaction(const MerkleTx& tx)
-        : vContracts   (tx.vContracts)
+        : CACHE_MUTEX  ( )
+        , fCached      (false)
+        , hashCached   (0)
+        , nCachedSize  (0)
+        , headerCached ( )
+        , vContracts   (tx.vContracts)
         , nVersion     (tx.nVersion)
         , nSequence    (tx.nSequence)
         , nTimestamp   (tx.nTimestamp)
@@ -128,12 +152,19 @@ namespace TAO
         , vchPubKey    (tx.vchPubKey)
         , vchSig       (tx.vchSig)
         {
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
         }
 
 
         /* Move constructor. */
         Transaction::Transaction(MerkleTx&& tx) noexcept
-        : vContracts   (std::move(tx.vContracts))
+        : CACHE_MUTEX  ( )
+        , fCached      (false)
+        , hashCached   (0)
+        , nCachedSize  (0)
+        , headerCached ( )
+        , vContracts   (std::move(tx.vContracts))
         , nVersion     (std::move(tx.nVersion))
         , nSequence    (std::move(tx.nSequence))
         , nTimestamp   (std::move(tx.nTimestamp))
@@ -146,6 +177,8 @@ namespace TAO
         , vchPubKey    (std::move(tx.vchPubKey))
         , vchSig       (std::move(tx.vchSig))
         {
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
         }
 
 
@@ -165,6 +198,9 @@ namespace TAO
             vchPubKey    = tx.vchPubKey;
             vchSig       = tx.vchSig;
 
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
+
             return *this;
         }
 
@@ -185,6 +221,9 @@ namespace TAO
             vchPubKey    = std::move(tx.vchPubKey);
             vchSig       = std::move(tx.vchSig);
 
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
+
             return *this;
         }
 
@@ -205,6 +244,9 @@ namespace TAO
             vchPubKey    = tx.vchPubKey;
             vchSig       = tx.vchSig;
 
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
+
             return *this;
         }
 
@@ -225,6 +267,9 @@ namespace TAO
             vchPubKey    = std::move(tx.vchPubKey);
             vchSig       = std::move(tx.vchSig);
 
+            /* The data is the same, so the cache is too. */
+            copy_cache(tx);
+
             return *this;
         }
 
@@ -277,6 +322,9 @@ namespace TAO
             /* Bind this transaction. */
             vContracts[n].Bind(this);
 
+            /* The contract can be changed through the reference, so drop the hash cached while binding. */
+            invalidate();
+
             return vContracts[n];
         }
 
@@ -505,6 +553,21 @@ namespace TAO
         }
 
 
+        /* Read the registers the contracts are verified against. */
+        void Transaction::Prefetch(const uint8_t nFlags) const
+        {
+            /* Run through all the contracts. */
+            for(const auto& contract : vContracts)
+            {
+                /* Bind the contract to this transaction. */
+                contract.Bind(this);
+
+                /* Read the register pre-state. */
+                TAO::Register::Prefetch(contract, nFlags);
+            }
+        }
+
+
         /* Check the trust score that is claimed is correct. */
         bool Transaction::CheckTrust(BlockState* pblock, uint64_t& nPoolFeeTotal, const bool fBlockFinder) const
         {
@@ -805,6 +868,9 @@ namespace TAO
         /* Build the transaction contracts. */
         bool Transaction::Build()
         {
+            /* Building sets the pre-states of the contracts. */
+            invalidate();
+
             /* Create a temporary map for pre-states. */
             std::map<uint256_t, TAO::Register::State> mapStates;
 
@@ -833,6 +899,9 @@ namespace TAO
                 }
             }
 
+            /* The pre-states may have been hashed while building. */
+            invalidate();
+
 
             //skip proof of work for unit tests
             #ifndef UNIT_TESTS
@@ -1269,16 +1338,91 @@ namespace TAO
         /* Gets the hash of the transaction object. */
         uint512_t Transaction::GetHash() const
         {
-            DataStream ss(SER_GETHASH, nVersion);
-            ss << *this;
+            LOCK(CACHE_MUTEX);
+            cache();
 
-            /* Get the hash. */
-            uint512_t hash = LLC::SK512(ss.begin(), ss.end());
+            return hashCached;
+        }
 
-            /* Type of 0xff designates tritium tx. */
-            hash.SetType(TAO::Ledger::TRITIUM);
 
-            return hash;
+        /* Gets the serialized size of the transaction, including the public key and signature. */
+        uint64_t Transaction::GetSize() const
+        {
+            /* Get the size of the hashed data. */
+            uint64_t nSize = 0;
+            {
+                LOCK(CACHE_MUTEX);
+                cache();
+
+                nSize = nCachedSize;
+            }
+
+            /* The public key and signature aren't hashed. */
+            nSize += GetSizeOfCompactSize(vchPubKey.size()) + vchPubKey.size();
+            nSize += GetSizeOfCompactSize(vchSig.size()) + vchSig.size();
+
+            return nSize;
+        }
+
+
+        /* Gets the hashes of many transactions, hashed as a batch. */
+        void Transaction::GetHashes(const std::vector<Transaction>& vtx, std::vector<uint512_t> &vHashes)
+        {
+            vHashes.resize(vtx.size());
+
+            /* Serialize the transactions that aren't cached the same as GetHash. */
+            std::vector<uint32_t> vIndex;
+            std::vector<Header> vHeaders;
+            std::vector<std::vector<uint8_t> > vData;
+            for(uint32_t n = 0; n < vtx.size(); ++n)
+            {
+                const Transaction& tx = vtx[n];
+                {
+                    LOCK(tx.CACHE_MUTEX);
+
+                    /* Use the cached hash if it is current. */
+                    const Header header = tx.header();
+                    if(tx.fCached && tx.headerCached == header)
+                    {
+                        vHashes[n] = tx.hashCached;
+                        continue;
+                    }
+
+                    vHeaders.push_back(header);
+                }
+
+                DataStream ss(SER_GETHASH, tx.nVersion);
+                ss << tx;
+
+                vIndex.push_back(n);
+                vData.push_back(std::move(ss.Bytes()));
+            }
+
+            /* Check that there is anything left to hash. */
+            if(vData.empty())
+                return;
+
+            /* Hash them together. */
+            std::vector<uint512_t> vBatch;
+            LLC::SK512Batch(vData, vBatch);
+
+            /* Cache the new hashes. */
+            for(uint32_t n = 0; n < vIndex.size(); ++n)
+            {
+                /* Type of 0xff designates tritium tx. */
+                vBatch[n].SetType(TAO::Ledger::TRITIUM);
+                vHashes[vIndex[n]] = vBatch[n];
+
+                const Transaction& tx = vtx[vIndex[n]];
+                {
+                    LOCK(tx.CACHE_MUTEX);
+
+                    tx.fCached      = true;
+                    tx.hashCached   = vBatch[n];
+                    tx.nCachedSize  = vData[n].size();
+                    tx.headerCached = vHeaders[n];
+                }
+            }
         }
 
 
@@ -1348,6 +1492,9 @@ namespace TAO
         /* Sets the Next Hash from the key */
         void Transaction::NextHash(const uint512_t& hashSecret, const uint8_t nType)
         {
+            /* The next hash is changed below. */
+            invalidate();
+
             /* Get the secret from new key. */
             std::vector<uint8_t> vBytes = hashSecret.GetBytes();
             LLC::CSecret vchSecret(vBytes.begin(), vBytes.end());
@@ -1409,6 +1556,9 @@ namespace TAO
         /* Signs the transaction with the private key and sets the public key */
         bool Transaction::Sign(const uint512_t& hashSecret)
         {
+            /* Hash the transaction as it is now. */
+            invalidate();
+
             /* Get the secret from new key. */
             std::vector<uint8_t> vBytes = hashSecret.GetBytes();
             LLC::CSecret vchSecret(vBytes.begin(), vBytes.end());
@@ -1531,5 +1681,74 @@ namespace TAO
 
             return nFee;
         }
+
+
+        /* Invalidate the cached hash and size, for when the contracts are changed. */
+        void Transaction::invalidate() const
+        {
+            LOCK(CACHE_MUTEX);
+            fCached = false;
+        }
+
+
+        /* Copy the cached hash and size of another transaction with the same data. */
+        void Transaction::copy_cache(const Transaction& tx) const
+        {
+            /* Check for self assignment. */
+            if(&tx == this)
+                return;
+
+            /* Get the cache of the other transaction. */
+            bool fCachedIn = false;
+            uint512_t hashCachedIn = 0;
+            uint64_t nCachedSizeIn = 0;
+            Header headerCachedIn;
+            {
+                LOCK(tx.CACHE_MUTEX);
+
+                fCachedIn      = tx.fCached;
+                hashCachedIn   = tx.hashCached;
+                nCachedSizeIn  = tx.nCachedSize;
+                headerCachedIn = tx.headerCached;
+            }
+
+            LOCK(CACHE_MUTEX);
+
+            fCached      = fCachedIn;
+            hashCached   = hashCachedIn;
+            nCachedSize  = nCachedSizeIn;
+            headerCached = headerCachedIn;
+        }
+
+
+        /* Get the header fields that are part of the hash. */
+        Transaction::Header Transaction::header() const
+        {
+            return Header(nVersion, nSequence, nTimestamp, hashNext, hashRecovery, hashGenesis, hashPrevTx, nKeyType, nNextType);
+        }
+
+
+        /* Compute the hash and size if they are not cached or the header has changed. */
+        void Transaction::cache() const
+        {
+            /* Check if the cache is current. */
+            const Header headerNow = header();
+            if(fCached && headerCached == headerNow)
+                return;
+
+            DataStream ss(SER_GETHASH, nVersion);
+            ss << *this;
+
+            /* Get the hash. */
+            hashCached = LLC::SK512(ss.begin(), ss.end());
+
+            /* Type of 0xff designates tritium tx. */
+            hashCached.SetType(TAO::Ledger::TRITIUM);
+
+            /* Keep the size and header it was computed with. */
+            nCachedSize  = ss.size();
+            headerCached = headerNow;
+            fCached      = true;
+        }
     }
 }
@@ -36,7 +36,9 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/enum.h>
 #include <TAO/Ledger/include/supply.h>
 #include <TAO/Ledger/include/timelocks.h>
+#include <TAO/Ledger/types/chain_index.h>
 #include <TAO/Ledger/types/syncblock.h>
+#include <TAO/Ledger/types/validation_pool.h>
 
 #include <TAO/Register/include/enum.h>
 #include <TAO/Register/types/address.h>
@@ -229,7 +231,27 @@ namespace TAO
             if(block.nVersion < 7)
                 throw debug::exception(FUNCTION, "invalid sync block version for tritium block");
 
+            /* Deserialize the tritium transactions first, so they can be hashed as a batch. */
+            std::vector<Transaction> vTritium;
+            for(uint32_t n = 0; n < block.vtx.size(); ++n)
+            {
+                /* Check for tritium. */
+                if(block.vtx[n].first != TRANSACTION::TRITIUM)
+                    continue;
+
+                /* Serialize stream. */
+                DataStream ssData(block.vtx[n].second, SER_DISK, LLD::DATABASE_VERSION);
+
+                /* Build the transaction. */
+                vTritium.push_back(Transaction());
+                ssData >> vTritium.back();
+            }
+
+            std::vector<uint512_t> vHashes;
+            Transaction::GetHashes(vTritium, vHashes);
+
             /* Loop through transctions. */
+            uint32_t nTritium = 0;
             for(uint32_t n = 0; n < block.vtx.size(); ++n)
             {
                 /* Switch for type. */
@@ -238,12 +260,10 @@ namespace TAO
                     /* Check for tritium. */
                     case TRANSACTION::TRITIUM:
                     {
-                        /* Serialize stream. */
-                        DataStream ssData(block.vtx[n].second, SER_DISK, LLD::DATABASE_VERSION);
-
-                        /* Build the transaction. */
-                        Transaction tx;
-                        ssData >> tx;
+                        /* Get the transaction and its hash. */
+                        const Transaction& tx = vTritium[nTritium];
+                        const uint512_t& hash = vHashes[nTritium];
+                        ++nTritium;
 
                         /* Add transaction to binary data. */
                         if(nVersion < 9 && n == (block.vtx.size() - 1))
@@ -254,14 +274,11 @@ namespace TAO
 
                         else
                         {
-                            /* Get the transaction hash */
-                            uint512_t hash = tx.GetHash();
-
                             /* Accept into memory pool. */
-                            if(!LLD::Ledger->HasTx(tx.GetHash()))
+                            if(!LLD::Ledger->HasTx(hash))
                                 mempool.AddUnchecked(tx);
 
-                            vtx.push_back(std::make_pair(block.vtx[n].first, tx.GetHash()));
+                            vtx.push_back(std::make_pair(block.vtx[n].first, hash));
                         }
 
                         break;
@@ -397,6 +414,31 @@ namespace TAO
             if(!ChannelActive(GetBlockTime(), GetChannel()))
                 return debug::error(FUNCTION, "block created before channel time-lock");
 
+            /* Check for producers before verifying them. */
+            if(nVersion >= 9 && vProducer.size() == 0)
+                return debug::error(FUNCTION, "missing producer transaction");
+
+            /* The producer checks, block signature and work are stateless, so they are verified across the validation
+             * threads up front, and their results are checked in order below. */
+            const uint32_t nProducers = (nVersion < 9 ? 1 : vProducer.size());
+            std::vector<uint8_t> vVerified(nProducers + 2, 0);
+            ValidationPool::GetInstance().ForEach(nProducers + 2, [this, nProducers, &vVerified](const uint32_t n)
+            {
+                /* Check that the producers are valid transactions. */
+                if(n < nProducers)
+                    vVerified[n] = (nVersion < 9 ? producer : vProducer[n]).Check();
+
+                /* Verify the work, which is skipped while synchronizing. */
+                else if(n == nProducers)
+                    vVerified[n] = (TAO::Ledger::ChainState::Synchronizing() || IsPrivate() || VerifyWork());
+
+                /* Verify the block signature, which is skipped while synchronizing. */
+                else
+                    vVerified[n] = (TAO::Ledger::ChainState::Synchronizing() || VerifyProducer());
+
+                return true;
+            });
+
             if(nVersion < 9)
             {
                 /* Check coinbase/coinstake timestamp against block time */
@@ -404,22 +446,19 @@ namespace TAO
                     return debug::error(FUNCTION, "producer transaction timestamp is too early");
 
                 /* Check that the producer is a valid transaction. */
-                if(!producer.Check())
+                if(!vVerified[0])
                     return debug::error(FUNCTION, "producer transaction is invalid");
             }
             else
             {
-                if(vProducer.size() == 0)
-                    return debug::error(FUNCTION, "missing producer transaction");
-
-                for(const TAO::Ledger::Transaction& txProducer : vProducer)
+                for(uint32_t n = 0; n < nProducers; ++n)
                 {
                     /* Check coinbase/coinstake timestamp against block time */
-                    if(GetBlockTime() > (uint64_t)txProducer.nTimestamp + 3600)
+                    if(GetBlockTime() > (uint64_t)vProducer[n].nTimestamp + 3600)
                         return debug::error(FUNCTION, "producer transaction timestamp is too early");
 
                     /* Check that the producer is a valid transaction. */
-                    if(!txProducer.Check())
+                    if(!vVerified[n])
                         return debug::error(FUNCTION, "producer transaction is invalid");
                 }
             }
@@ -498,7 +537,7 @@ namespace TAO
                 }
 
                 /* Check the Proof of Stake Claims. */
-                if(!TAO::Ledger::ChainState::Synchronizing() && !VerifyWork())
+                if(!vVerified[nProducers])
                     return debug::error(FUNCTION, "invalid proof of stake");
             }
 
@@ -529,7 +568,7 @@ namespace TAO
                     return debug::error(FUNCTION, "offsets included in non prime block");
 
                 /* Check the Proof of Work Claims. */
-                if(!TAO::Ledger::ChainState::Synchronizing() && !VerifyWork())
+                if(!vVerified[nProducers])
                     return debug::error(FUNCTION, "invalid proof of work");
             }
 
@@ -570,20 +609,43 @@ namespace TAO
             /* Get list of producer transactions. */
             std::map<uint256_t, uint512_t> mapLast;
 
-            /* Get the signature operations for legacy tx's. */
+            /* Read the transactions from the memory pool and check legacy transactions across the validation threads. */
             uint32_t nSize = (uint32_t)vtx.size();
+            std::vector<Legacy::Transaction> vLegacy(nSize);
+            std::vector<TAO::Ledger::Transaction> vTritium(nSize);
+            std::vector<uint8_t> vRead(nSize, 0), vChecked(nSize, 0), vConflicted(nSize, 0);
+            ValidationPool::GetInstance().ForEach(nSize, [&](const uint32_t n)
+            {
+                bool fConflict = false;
+                if(vtx[n].first == TRANSACTION::LEGACY)
+                {
+                    vRead[n]    = LLD::Legacy->ReadTx(vtx[n].second, vLegacy[n], fConflict, FLAGS::MEMPOOL);
+                    vChecked[n] = (vRead[n] && vLegacy[n].CheckTransaction());
+                }
+                else if(vtx[n].first == TRANSACTION::TRITIUM)
+                    vRead[n]    = LLD::Ledger->ReadTx(vtx[n].second, vTritium[n], fConflict, FLAGS::MEMPOOL);
+
+                vConflicted[n] = fConflict;
+                return true;
+            });
+
+            /* Get the signature operations for legacy tx's. */
             for(uint32_t i = 0; i < nSize; ++i)
             {
                 /* Insert txid into set to check for duplicates. */
                 setUnique.insert(vtx[i].second);
                 vHashes.push_back(vtx[i].second);
 
+                /* Flag the block if it has conflicted transactions. */
+                if(vConflicted[i])
+                    fConflicted = true;
+
                 /* Basic checks for legacy transactions. */
                 if(vtx[i].first == TRANSACTION::LEGACY)
                 {
                     /* Check the memory pool. */
-                    Legacy::Transaction tx;
-                    if(!LLD::Legacy->ReadTx(vtx[i].second, tx, fConflicted, FLAGS::MEMPOOL))
+                    const Legacy::Transaction& tx = vLegacy[i];
+                    if(!vRead[i])
                     {
                         vMissing.push_back(vtx[i]);
                         continue;
@@ -598,7 +660,7 @@ namespace TAO
                         return debug::error(FUNCTION, "block timestamp earlier than transaction timestamp");
 
                     /* Check the transaction for validity. */
-                    if(!tx.CheckTransaction())
+                    if(!vChecked[i])
                         return debug::error(FUNCTION, "check transaction failed.");
 
                     /* Check legacy transaction for finality. */
@@ -610,8 +672,8 @@ namespace TAO
                 else if(vtx[i].first == TRANSACTION::TRITIUM)
                 {
                     /* Check the memory pool. */
-                    TAO::Ledger::Transaction tx;
-                    if(!LLD::Ledger->ReadTx(vtx[i].second, tx, fConflicted, FLAGS::MEMPOOL))
+                    const TAO::Ledger::Transaction& tx = vTritium[i];
+                    if(!vRead[i])
                     {
                         vMissing.push_back(vtx[i]);
                         continue;
@@ -684,55 +746,9 @@ namespace TAO
             if(hashMerkleRoot != BuildMerkleTree(vHashes))
                 return debug::error(FUNCTION, "hashMerkleRoot mismatch");
 
-            /* Verify producer signature(s) (if not synchronizing) */
-            if(!TAO::Ledger::ChainState::Synchronizing())
-            {
-                TAO::Ledger::Transaction txProducer;
-
-                if(nVersion < 9)
-                    txProducer = producer;
-                else
-                    txProducer = vProducer.back(); ///block signed by block finder which is last producer
-
-                /* Switch based on signature type. */
-                switch(txProducer.nKeyType)
-                {
-                    /* Support for the FALCON signature scheeme. */
-                    case SIGNATURE::FALCON:
-                    {
-                        /* Create the FL Key object. */
-                        LLC::FLKey key;
-
-                        /* Set the public key and verify. */
-                        key.SetPubKey(txProducer.vchPubKey);
-
-                        /* Check the Block Signature. */
-                        if(!VerifySignature(key))
-                            return debug::error(FUNCTION, "bad block signature");
-
-                        break;
-                    }
-
-                    /* Support for the BRAINPOOL signature scheme. */
-                    case SIGNATURE::BRAINPOOL:
-                    {
-                        /* Create EC Key object. */
-                        LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
-
-                        /* Set the public key and verify. */
-                        key.SetPubKey(txProducer.vchPubKey);
-
-                        /* Check the Block Signature. */
-                        if(!VerifySignature(key))
-                            return debug::error(FUNCTION, "bad block signature");
-
-                        break;
-                    }
-
-                    default:
-                        return debug::error(FUNCTION, "unknown signature type");
-                }
-            }
+            /* Check the block signature. */
+            if(!vVerified[nProducers + 1])
+                return debug::error(FUNCTION, "bad block signature");
 
             return true;
         }
@@ -809,6 +825,7 @@ namespace TAO
 
             /* Start the database transaction. */
             LLD::TxnBegin();
+            ChainIndex::GetInstance().TxnBegin();
 
             /* Write the transactions. */
             for(const auto& proof : vtx)
@@ -869,12 +886,14 @@ namespace TAO
             if(!state.Index())
             {
                 LLD::TxnAbort();
+                ChainIndex::GetInstance().TxnAbort();
 
                 return false;
             }
 
             /* Commit the transaction to database. */
             LLD::TxnCommit();
+            ChainIndex::GetInstance().TxnCommit();
 
             /* Check for best chain. */
             if(GetHash() == ChainState::hashBestChain.load())
@@ -1166,6 +1185,49 @@ namespace TAO
         }
 
 
+        /* Verify the block signature with the key of the block finder. */
+        bool TritiumBlock::VerifyProducer() const
+        {
+            /* Block is signed by the block finder, which is the last producer. */
+            const TAO::Ledger::Transaction& txProducer = (nVersion < 9 ? producer : vProducer.back());
+
+            /* Switch based on signature type. */
+            switch(txProducer.nKeyType)
+            {
+                /* Support for the FALCON signature scheeme. */
+                case SIGNATURE::FALCON:
+                {
+                    /* Create the FL Key object. */
+                    LLC::FLKey key;
+
+                    /* Set the public key and verify. */
+                    key.SetPubKey(txProducer.vchPubKey);
+
+                    /* Check the Block Signature. */
+                    return VerifySignature(key);
+                }
+
+                /* Support for the BRAINPOOL signature scheme. */
+                case SIGNATURE::BRAINPOOL:
+                {
+                    /* Create EC Key object. */
+                    LLC::ECKey key = LLC::ECKey(LLC::BRAINPOOL_P512_T1, 64);
+
+                    /* Set the public key and verify. */
+                    key.SetPubKey(txProducer.vchPubKey);
+
+                    /* Check the Block Signature. */
+                    return VerifySignature(key);
+                }
+
+                default:
+                    return debug::error(FUNCTION, "unknown signature type");
+            }
+
+            return false;
+        }
+
+
         /* Get the Signarture Hash of the block. Used to verify work claims. */
         uint1024_t TritiumBlock::SignatureHash() const
         {
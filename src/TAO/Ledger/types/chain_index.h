@@ -0,0 +1,367 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_TYPES_CHAIN_INDEX_H
+#define NEXUS_TAO_LEDGER_TYPES_CHAIN_INDEX_H
+
+#include <LLC/types/uint1024.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+        class BlockState;
+
+
+        /** BlockIndex
+         *
+         *  The header fields of a block in the main chain, without its transactions or chain state.
+         *
+         **/
+        class BlockIndex
+        {
+        public:
+
+            /** The hash of the block. **/
+            uint1024_t hashBlock;
+
+
+            /** The height of the block. **/
+            uint32_t nHeight;
+
+
+            /** The channel of the block. **/
+            uint32_t nChannel;
+
+
+            /** The timestamp of the block. **/
+            uint64_t nTime;
+
+
+            /** The difficulty bits of the block. **/
+            uint32_t nBits;
+
+
+            /** The trust of the chain to this block. **/
+            uint64_t nChainTrust;
+
+
+            /** Default Constructor. **/
+            BlockIndex();
+
+
+            /** Constructor
+             *
+             *  @param[in] state The block state to get the header fields of.
+             *
+             **/
+            BlockIndex(const BlockState& state);
+        };
+
+
+        /** ChainIndex
+         *
+         *  The headers of the main chain in memory, by height and by hash, so walking back through the chain
+         *  doesn't read every block from the ledger database. It is built from the best block on startup and
+         *  follows the blocks as they are connected and disconnected. Changes are journaled until the database
+         *  transaction they belong to is committed, and undone if it is aborted. If a block arrives out of order
+         *  it is cleared and built again on a background thread. Lookups fail until it is built, and callers fall
+         *  back to the ledger database.
+         *
+         **/
+        class ChainIndex
+        {
+            /** Mutex to protect the index. **/
+            mutable std::mutex MUTEX;
+
+
+            /** The headers of the main chain, by height. **/
+            std::vector<BlockIndex> vChain;
+
+
+            /** The height of each block in the main chain, by the first 64 bits of its hash. **/
+            std::unordered_multimap<uint64_t, uint32_t> mapHeights;
+
+
+            /** The blocks connected (true) and disconnected (false) since the database transaction began. **/
+            std::vector<std::pair<bool, BlockIndex>> vJournal;
+
+
+            /** The blocks connected and disconnected in committed transactions while the index is built again. **/
+            std::vector<std::pair<bool, BlockIndex>> vPending;
+
+
+            /** Flag to tell if the index is built. **/
+            std::atomic<bool> fReady;
+
+
+            /** Flag to tell if the index was cleared by a block out of order, and needs to be built again. **/
+            bool fRebuild;
+
+
+            /** Flag to tell if the index is being built again, so blocks are kept for when it is done. **/
+            bool fBuilding;
+
+
+            /** Thread to build the index again. **/
+            std::thread BUILD_THREAD;
+
+
+        public:
+
+            /** Default Constructor. **/
+            ChainIndex();
+
+
+            /** Default Destructor. **/
+            ~ChainIndex();
+
+
+            /** GetInstance
+             *
+             *  Singleton instance for the main chain.
+             *
+             **/
+            static ChainIndex& GetInstance();
+
+
+            /** Initialize
+             *
+             *  Build the index by reading back from the best block to genesis, then apply the blocks connected
+             *  and disconnected while it was built. Stops early with an empty index if the node is shutting down.
+             *
+             *  @param[in] stateBest The best block of the chain.
+             *
+             *  @return true if the index was built.
+             *
+             **/
+            bool Initialize(const BlockState& stateBest);
+
+
+            /** Clear
+             *
+             *  Empty the index, so lookups fall back to the ledger database.
+             *
+             **/
+            void Clear();
+
+
+            /** Stop
+             *
+             *  Wait for the index to finish building, before the ledger database is shut down.
+             *
+             **/
+            void Stop();
+
+
+            /** Ready
+             *
+             *  Check if the index is built.
+             *
+             **/
+            bool Ready() const;
+
+
+            /** TxnBegin
+             *
+             *  Start journaling the blocks connected and disconnected, along with a database transaction.
+             *
+             **/
+            void TxnBegin();
+
+
+            /** TxnCommit
+             *
+             *  Keep the blocks connected and disconnected since the database transaction began. Starts building
+             *  the index again from the best block if it was cleared.
+             *
+             **/
+            void TxnCommit();
+
+
+            /** TxnAbort
+             *
+             *  Undo the blocks connected and disconnected since the database transaction began. Starts building
+             *  the index again from the best block if it was cleared.
+             *
+             **/
+            void TxnAbort();
+
+
+            /** Connect
+             *
+             *  Add a block connected to the end of the main chain. Clears the index to be built again if it
+             *  doesn't follow the current end, and keeps the block for when it is built.
+             *
+             *  @param[in] state The block state connected.
+             *
+             **/
+            void Connect(const BlockState& state);
+
+
+            /** Disconnect
+             *
+             *  Remove a block disconnected from the end of the main chain. Clears the index to be built again
+             *  if it isn't the current end, and keeps the block for when it is built.
+             *
+             *  @param[in] state The block state disconnected.
+             *
+             **/
+            void Disconnect(const BlockState& state);
+
+
+            /** Has
+             *
+             *  Check if a block is in the main chain.
+             *
+             *  @param[in] hashBlock The hash of the block.
+             *
+             *  @return true if the index is built and has the block.
+             *
+             **/
+            bool Has(const uint1024_t& hashBlock) const;
+
+
+            /** Get
+             *
+             *  Get the header of a block in the main chain.
+             *
+             *  @param[in] hashBlock The hash of the block.
+             *  @param[out] index The header of the block.
+             *
+             *  @return true if the index is built and has the block.
+             *
+             **/
+            bool Get(const uint1024_t& hashBlock, BlockIndex &index) const;
+
+
+            /** Get
+             *
+             *  Get the header of the block in the main chain at a height.
+             *
+             *  @param[in] nHeight The height of the block.
+             *  @param[out] index The header of the block.
+             *
+             *  @return true if the index is built and reaches the height.
+             *
+             **/
+            bool Get(const uint32_t nHeight, BlockIndex &index) const;
+
+
+            /** Last
+             *
+             *  Get the header of the last block of a channel, searching back from a block in the main chain.
+             *  The search stops at genesis, which is returned if no block of the channel is found.
+             *
+             *  @param[in] hashBlock The hash of the block to start from.
+             *  @param[in] nChannel The channel to search for.
+             *  @param[out] index The header of the block found.
+             *
+             *  @return true if the index is built and has the starting block.
+             *
+             **/
+            bool Last(const uint1024_t& hashBlock, const uint32_t nChannel, BlockIndex &index) const;
+
+
+            /** Last
+             *
+             *  Get the header of the last block of a channel, searching back from a height in the main chain.
+             *  The search stops at genesis, which is returned if no block of the channel is found.
+             *
+             *  @param[in] nHeight The height to start from.
+             *  @param[in] nChannel The channel to search for.
+             *  @param[out] index The header of the block found.
+             *
+             *  @return true if the index is built and reaches the height.
+             *
+             **/
+            bool Last(const uint32_t nHeight, const uint32_t nChannel, BlockIndex &index) const;
+
+
+        private:
+
+            /** find
+             *
+             *  Find the height of a block in the main chain. MUTEX must be held.
+             *
+             *  @param[in] hashBlock The hash of the block.
+             *  @param[out] nHeight The height of the block.
+             *
+             *  @return true if the index has the block.
+             *
+             **/
+            bool find(const uint1024_t& hashBlock, uint32_t &nHeight) const;
+
+
+            /** push
+             *
+             *  Add a header to the end of the chain. MUTEX must be held.
+             *
+             *  @param[in] index The header to add.
+             *
+             **/
+            void push(const BlockIndex& index);
+
+
+            /** pop
+             *
+             *  Remove the header at the end of the chain. MUTEX must be held.
+             *
+             **/
+            void pop();
+
+
+            /** apply
+             *
+             *  Apply a block connected or disconnected while the index was built, which can already be in
+             *  the index from the best block it was built from. MUTEX must be held.
+             *
+             *  @param[in] entry The block, and whether it was connected.
+             *  @param[out] fApplied Flag to tell if the index was changed.
+             *
+             *  @return true if the block fits the index.
+             *
+             **/
+            bool apply(const std::pair<bool, BlockIndex>& entry, bool &fApplied);
+
+
+            /** reset
+             *
+             *  Empty the index. MUTEX must be held.
+             *
+             **/
+            void reset();
+
+
+            /** rebuild
+             *
+             *  Start building the index again from the best block if it was cleared by a block out of order.
+             *
+             **/
+            void rebuild();
+        };
+    }
+}
+
+#endif
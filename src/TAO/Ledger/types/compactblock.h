@@ -0,0 +1,149 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_TYPES_COMPACTBLOCK_H
+#define NEXUS_TAO_LEDGER_TYPES_COMPACTBLOCK_H
+
+#include <LLC/types/uint1024.h>
+
+#include <TAO/Ledger/types/tritium.h>
+
+#include <Util/templates/serialize.h>
+
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** The total bytes of a short transaction ID. **/
+        const uint32_t SHORTID_SIZE = 6;
+
+
+        /** ShortID
+         *
+         *  Get the short ID of a transaction, being the low bytes of a hash of the transaction hash keyed by a salt.
+         *  The salt is different for every compact block, so collisions can't be made ahead of time.
+         *
+         *  @param[in] hashTx The hash of the transaction.
+         *  @param[in] nSalt The salt of the compact block.
+         *
+         *  @return the short ID.
+         *
+         **/
+        uint64_t ShortID(const uint512_t& hashTx, const uint64_t nSalt);
+
+
+        /** CompactBlock
+         *
+         *  A tritium block relayed with short IDs in place of the transaction hashes. The receiver rebuilds
+         *  the block from its memory pool, and only asks for the transactions it doesn't have.
+         *
+         **/
+        class CompactBlock
+        {
+        public:
+
+            /** The block with its producers, without any transactions. **/
+            TritiumBlock block;
+
+
+            /** The salt of the short IDs. **/
+            uint64_t nSalt;
+
+
+            /** The short IDs of the transactions, packed SHORTID_SIZE bytes each. **/
+            std::vector<uint8_t> vShortIDs;
+
+
+            /** Serialization **/
+            IMPLEMENT_SERIALIZE
+            (
+                READWRITE(block);
+                READWRITE(nSalt);
+                READWRITE(vShortIDs);
+            )
+
+
+            /** The default constructor. **/
+            CompactBlock();
+
+
+            /** Constructor
+             *
+             *  @param[in] blockIn The block to relay.
+             *  @param[in] nSaltIn The salt of the short IDs.
+             *
+             **/
+            CompactBlock(const TritiumBlock& blockIn, const uint64_t nSaltIn);
+
+
+            /** Supported
+             *
+             *  Check if a block can be relayed as a compact block, which needs every transaction to be in
+             *  the memory pool of the receiver.
+             *
+             *  @param[in] blockIn The block to check.
+             *
+             **/
+            static bool Supported(const TritiumBlock& blockIn);
+
+
+            /** Size
+             *
+             *  Get the total transactions in the block.
+             *
+             **/
+            uint32_t Size() const;
+
+
+            /** GetShortID
+             *
+             *  Get the short ID of a transaction by its index.
+             *
+             *  @param[in] nIndex The index of the transaction.
+             *
+             **/
+            uint64_t GetShortID(const uint32_t nIndex) const;
+
+
+            /** Rebuild
+             *
+             *  Rebuild the block from the memory pool. Transactions that aren't in the memory pool, or whose
+             *  short ID matches more than one transaction, are left with a hash of zero.
+             *
+             *  @param[out] blockOut The rebuilt block.
+             *  @param[out] vMissing The indexes of the transactions that are missing.
+             *
+             **/
+            void Rebuild(TritiumBlock& blockOut, std::vector<uint32_t> &vMissing) const;
+
+
+            /** CheckMerkle
+             *
+             *  Check the transactions of a rebuilt block against its merkle root, to catch short ID collisions.
+             *
+             *  @param[in] blockIn The rebuilt block.
+             *
+             **/
+            static bool CheckMerkle(const TritiumBlock& blockIn);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,161 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_TYPES_EVENT_QUEUE_H
+#define NEXUS_TAO_LEDGER_TYPES_EVENT_QUEUE_H
+
+#include <LLC/types/uint1024.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** EventQueue
+         *
+         *  The events of tracked sigchains that are not processed yet, by their sequence in the ledger database.
+         *  Only sigchains with a session on this node are tracked. Their events are queued as they are written once
+         *  they have been scanned, so finding outstanding work doesn't scan back through the ledger again. Events are
+         *  removed when they are processed in a block, and the queues are cleared when blocks are disconnected, so
+         *  the next lookup scans again.
+         *
+         **/
+        class EventQueue
+        {
+            /** Mutex to protect the queue. **/
+            mutable std::mutex MUTEX;
+
+
+            /** The sigchains with a session on this node. **/
+            std::set<uint256_t> setTracked;
+
+
+            /** The pending event sequences of each tracked sigchain whose events have been scanned. **/
+            std::map<uint256_t, std::set<uint32_t> > mapPending;
+
+
+            /** The tracked sigchains with events written since they were last signaled. **/
+            std::set<uint256_t> setSignal;
+
+
+        public:
+
+            /** Default Constructor. **/
+            EventQueue();
+
+
+            /** GetInstance
+             *
+             *  Singleton instance.
+             *
+             **/
+            static EventQueue& GetInstance();
+
+
+            /** Track
+             *
+             *  Allow the events of a sigchain to be queued, once they are scanned.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *
+             **/
+            void Track(const uint256_t& hashGenesis);
+
+
+            /** Begin
+             *
+             *  Start queueing the events of a tracked sigchain, before its events are scanned.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *
+             *  @return true if the sigchain is tracked.
+             *
+             **/
+            bool Begin(const uint256_t& hashGenesis);
+
+
+            /** Untrack
+             *
+             *  Stop queueing the events of a sigchain and drop its pending events.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *
+             **/
+            void Untrack(const uint256_t& hashGenesis);
+
+
+            /** Clear
+             *
+             *  Drop the queued events of every sigchain, so they are all scanned again.
+             *
+             **/
+            void Clear();
+
+
+            /** Push
+             *
+             *  Add an event written to the ledger database, if its sigchain is queued.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *  @param[in] nSequence The sequence of the event.
+             *
+             **/
+            void Push(const uint256_t& hashGenesis, const uint32_t nSequence);
+
+
+            /** Remove
+             *
+             *  Remove an event that has been processed.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *  @param[in] nSequence The sequence of the event.
+             *
+             **/
+            void Remove(const uint256_t& hashGenesis, const uint32_t nSequence);
+
+
+            /** Pending
+             *
+             *  Get the pending events of a sigchain, newest first.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *  @param[out] vSequences The sequences of the pending events.
+             *
+             *  @return true if the events of the sigchain are queued.
+             *
+             **/
+            bool Pending(const uint256_t& hashGenesis, std::vector<uint32_t> &vSequences) const;
+
+
+            /** Signal
+             *
+             *  Get the tracked sigchains with events written since the last signal.
+             *
+             *  @return the genesis of each sigchain with new events.
+             *
+             **/
+            std::vector<uint256_t> Signal();
+        };
+    }
+}
+
+#endif
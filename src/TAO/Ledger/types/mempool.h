@@ -26,6 +26,11 @@ ________________________________________________________________________________
 
 #include <Util/include/mutex.h>
 
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
 namespace LLP
 {
     class TritiumNode;
@@ -54,6 +59,12 @@ namespace TAO
 
         private:
 
+            /** Mutex for the indexes. Writers hold MUTEX while validating, and only take this mutex to change
+             *  the indexes, so lookups never wait on Accept. Orphans are only used by writers under MUTEX.
+             **/
+            mutable std::mutex INDEX_MUTEX;
+
+
             /** The transactions in the ledger memory pool. **/
             std::map<uint512_t, Legacy::Transaction> mapLegacy;
 
@@ -85,6 +96,77 @@ namespace TAO
             /** Set to keep track of duplicate orphans by index. **/
             std::set<uint512_t> setOrphansByIndex;
 
+
+            /** The hashes of the ledger memory pool transactions by genesis, in order of sequence. **/
+            std::map<uint256_t, std::vector<uint512_t> > mapGenesis;
+
+
+            /** The total fees of the ledger memory pool transactions by genesis, kept as they are added and removed. **/
+            std::map<uint256_t, uint64_t> mapFees;
+
+
+            /** The genesis of each sigchain in the ledger memory pool by priority, being the highest fees and
+             *  then the oldest first transaction. Keys are (max - fees, timestamp, genesis).
+             **/
+            std::set<std::tuple<uint64_t, uint64_t, uint256_t> > setPriority;
+
+
+            /** priority
+             *
+             *  Get the priority key of a sigchain in the ledger memory pool from its total fees. Requires INDEX_MUTEX.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *
+             *  @return the key in setPriority.
+             *
+             **/
+            std::tuple<uint64_t, uint64_t, uint256_t> priority(const uint256_t& hashGenesis) const;
+
+
+            /** fees
+             *
+             *  Get the fees of a transaction, where malformed contracts count as having no fees.
+             *
+             *  @param[in] tx The transaction.
+             *
+             *  @return the fees of the transaction.
+             *
+             **/
+            static uint64_t fees(const TAO::Ledger::Transaction& tx);
+
+
+            /** index
+             *
+             *  Add a transaction to the ledger memory pool and its indexes. Requires INDEX_MUTEX.
+             *
+             *  @param[in] hashTx The hash of the transaction.
+             *  @param[in] tx The transaction to add.
+             *
+             **/
+            void index(const uint512_t& hashTx, const TAO::Ledger::Transaction& tx);
+
+
+            /** unindex
+             *
+             *  Remove a transaction from the ledger memory pool and its indexes. Requires INDEX_MUTEX.
+             *
+             *  @param[in] hashTx The hash of the transaction.
+             *
+             **/
+            void unindex(const uint512_t& hashTx);
+
+
+            /** chain
+             *
+             *  Get the transactions of a sigchain in the ledger memory pool, stopping at the first transaction
+             *  that is out of sequence. Requires INDEX_MUTEX.
+             *
+             *  @param[in] hashGenesis The genesis of the sigchain.
+             *  @param[out] vHashes The hashes of the transactions.
+             *
+             **/
+            void chain(const uint256_t& hashGenesis, std::vector<uint512_t> &vHashes) const;
+
         public:
 
             /** Default Constructor. **/
@@ -301,7 +383,8 @@ namespace TAO
 
             /** List
              *
-             *  List transactions in memory pool.
+             *  List transactions in memory pool. Tritium transactions are listed by sigchain in order of
+             *  priority, so block creation takes the highest fees first.
              *
              *  @param[out] vHashes List of transaction hashes.
              *  @param[in] nCount The total transactions to get.
@@ -312,6 +395,18 @@ namespace TAO
             bool List(std::vector<uint512_t> &vHashes, uint32_t nCount = std::numeric_limits<uint32_t>::max(), bool fLegacy = false);
 
 
+            /** ShortIDs
+             *
+             *  Get the transactions in memory pool by their short ID for a compact block. Short IDs that
+             *  match more than one transaction are given a hash of zero.
+             *
+             *  @param[in] nSalt The salt of the compact block.
+             *  @param[out] mapShortIDs The transaction types and hashes by short ID.
+             *
+             **/
+            void ShortIDs(const uint64_t nSalt, std::map<uint64_t, std::pair<uint8_t, uint512_t>> &mapShortIDs) const;
+
+
             /** Size
              *
              *  Gets the size of the memory pool.
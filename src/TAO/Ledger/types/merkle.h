@@ -94,6 +94,10 @@ namespace TAO
             /* serialization macros */
             IMPLEMENT_SERIALIZE
             (
+                /* Reading new data makes the cache stale. */
+                if(fRead)
+                    invalidate();
+
                 /* Contracts layers. */
                 READWRITE(vContracts);
 
@@ -0,0 +1,157 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_TYPES_TEMPLATE_ENGINE_H
+#define NEXUS_TAO_LEDGER_TYPES_TEMPLATE_ENGINE_H
+
+#include <TAO/Ledger/types/tritium.h>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** Function prototype to create a block template with a given extra nonce. **/
+        typedef std::function<bool(TritiumBlock&, const uint64_t)> TemplateFunction;
+
+
+        /** TemplateEngine
+         *
+         *  Shares a block template between the miners of a channel. The template is created once per best block,
+         *  change of the memory pool or change of key, and each block handed out is a copy with a new extra nonce
+         *  in the producer's coinbase. Only the producer's hash and its merkle branch are hashed again, since the
+         *  producer is the last leaf of the merkle tree. The producer is not signed again for each copy, so it has
+         *  to be signed when the block is.
+         *
+         **/
+        class TemplateEngine
+        {
+            /** Mutex to protect the template. **/
+            std::mutex MUTEX;
+
+
+            /** The block template. **/
+            TritiumBlock blockTemplate;
+
+
+            /** The merkle branch of the producer, which doesn't change with the producer. **/
+            std::vector<uint512_t> vBranch;
+
+
+            /** The total leaves of the merkle tree, with the producer last. **/
+            uint32_t nLeaves;
+
+
+            /** The key the template was created for. **/
+            uint512_t hashKey;
+
+
+            /** The best block the template was created on. **/
+            uint1024_t hashBest;
+
+
+            /** The size of the memory pool when the template was created. **/
+            uint32_t nMempool;
+
+
+            /** The time the template was created. **/
+            uint64_t nCreated;
+
+
+            /** The last extra nonce handed out. **/
+            uint64_t nExtraNonce;
+
+
+            /** Flag to tell if the template can be handed out. **/
+            bool fValid;
+
+
+            /** create
+             *
+             *  Create a new template and its producer's merkle branch.
+             *
+             *  @param[in] hashKeyIn The key to create the template for.
+             *  @param[in] xCreate The function to create the template.
+             *
+             *  @return true if the template was created.
+             *
+             **/
+            bool create(const uint512_t& hashKeyIn, const TemplateFunction& xCreate);
+
+
+        public:
+
+            /** The seconds a template is handed out for before it is created again. **/
+            static const uint64_t TEMPLATE_LIFETIME = 60;
+
+
+            /** Default Constructor. **/
+            TemplateEngine();
+
+
+            /** GetInstance
+             *
+             *  Get the shared engine of a channel.
+             *
+             *  @param[in] nChannel The channel being mined.
+             *
+             **/
+            static TemplateEngine& GetInstance(const uint32_t nChannel);
+
+
+            /** Clear
+             *
+             *  Drop the template, so the next block creates a new one.
+             *
+             **/
+            void Clear();
+
+
+            /** New
+             *
+             *  Get a block with unique work from the template, creating the template first if it is stale.
+             *
+             *  @param[in] hashKeyIn The key of who the template is for, such as the sigchain and coinbase recipients.
+             *  @param[in] xCreate The function to create the template with a given extra nonce.
+             *  @param[out] block The block to mine.
+             *
+             *  @return true if a block was made.
+             *
+             **/
+            bool New(const uint512_t& hashKeyIn, const TemplateFunction& xCreate, TritiumBlock &block);
+
+
+            /** SetExtraNonce
+             *
+             *  Set the extra nonce of a producer's coinbase.
+             *
+             *  @param[out] txProducer The producer to update.
+             *  @param[in] nExtraNonceIn The extra nonce to set.
+             *
+             *  @return true if the producer starts with a coinbase.
+             *
+             **/
+            static bool SetExtraNonce(Transaction &txProducer, const uint64_t nExtraNonceIn);
+        };
+    }
+}
+
+#endif
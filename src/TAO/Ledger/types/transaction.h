@@ -19,6 +19,8 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/include/enum.h>
 
+#include <mutex>
+#include <tuple>
 #include <vector>
 
 /* Global TAO namespace. */
@@ -42,6 +44,30 @@ namespace TAO
          **/
         class Transaction
         {
+            /** The header fields that are part of the hash. **/
+            typedef std::tuple<uint32_t, uint32_t, uint64_t, uint256_t, uint256_t, uint256_t, uint512_t, uint8_t, uint8_t> Header;
+
+
+            /** Mutex for the cached hash and size. **/
+            mutable std::mutex CACHE_MUTEX;
+
+
+            /** Memory only, flag for if the cached hash and size were computed. **/
+            mutable bool fCached;
+
+
+            /** Memory only, the cached hash of the transaction. **/
+            mutable uint512_t hashCached;
+
+
+            /** Memory only, the cached size of the hashed data. **/
+            mutable uint64_t nCachedSize;
+
+
+            /** Memory only, the header fields the cached hash was computed with. The header fields are public, so
+             *  they are checked against the cache instead of invalidating it on every write. **/
+            mutable Header headerCached;
+
         protected:
 
             /** For disk indexing on contract. **/
@@ -93,6 +119,10 @@ namespace TAO
             /* serialization macros */
             IMPLEMENT_SERIALIZE
             (
+                /* Reading new data makes the cache stale. */
+                if(fRead)
+                    invalidate();
+
                 /* Contracts layers. */
                 READWRITE(vContracts);
 
@@ -184,6 +214,8 @@ namespace TAO
             /** Operator Overload []
              *
              *  Write access fot the contract operator overload. This handles writes to create new contracts.
+             *  The cached hash is invalidated, so contracts must not be written through an older reference
+             *  after the hash has been taken.
              *
              **/
             TAO::Operation::Contract& operator[](const uint32_t n);
@@ -217,6 +249,15 @@ namespace TAO
             bool Verify(const uint8_t nFlags = TAO::Ledger::FLAGS::BLOCK) const;
 
 
+            /** Prefetch
+             *
+             *  Read the registers the contracts are verified against, so they are cached before the
+             *  transaction is verified in order.
+             *
+             **/
+            void Prefetch(const uint8_t nFlags = TAO::Ledger::FLAGS::BLOCK) const;
+
+
             /** CheckTrust
              *
              *  Check that the claimed trust score and stake reward are correct.
@@ -375,7 +416,7 @@ namespace TAO
 
             /** GetHash
              *
-             *  Gets the hash of the transaction object.
+             *  Gets the hash of the transaction object. The hash is cached until the transaction changes.
              *
              *  @return 512-bit unsigned integer of hash.
              *
@@ -383,6 +424,29 @@ namespace TAO
             uint512_t GetHash() const;
 
 
+            /** GetSize
+             *
+             *  Gets the serialized size of the transaction, including the public key and signature.
+             *  The size of the hashed data is cached along with the hash.
+             *
+             *  @return The total bytes of the serialized transaction.
+             *
+             **/
+            uint64_t GetSize() const;
+
+
+            /** GetHashes
+             *
+             *  Gets the hashes of many transactions, hashed as a batch. Cached hashes are reused, and the rest
+             *  are cached once hashed.
+             *
+             *  @param[in] vtx The transactions to hash.
+             *  @param[out] vHashes The hashes, in the same order as the transactions.
+             *
+             **/
+            static void GetHashes(const std::vector<Transaction>& vtx, std::vector<uint512_t> &vHashes);
+
+
             /** ProofHash
              *
              *  Gets a proof hash of the transaction object.
@@ -472,9 +536,46 @@ namespace TAO
             uint64_t Fees() const;
 
 
+            /** invalidate
+             *
+             *  Invalidate the cached hash and size, for when a contract was changed through a reference taken
+             *  before the hash.
+             *
+             **/
+            void invalidate() const;
+
+
             /** Class friends. **/
             friend class MerkleTx;
 
+        protected:
+
+            /** copy_cache
+             *
+             *  Copy the cached hash and size of another transaction with the same data.
+             *
+             *  @param[in] tx The transaction to copy the cache from.
+             *
+             **/
+            void copy_cache(const Transaction& tx) const;
+
+        private:
+
+            /** header
+             *
+             *  Get the header fields that are part of the hash.
+             *
+             **/
+            Header header() const;
+
+
+            /** cache
+             *
+             *  Compute the hash and size if they are not cached or the header has changed. Requires CACHE_MUTEX.
+             *
+             **/
+            void cache() const;
+
         };
     }
 }
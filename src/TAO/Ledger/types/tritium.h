@@ -216,6 +216,16 @@ namespace TAO
             bool VerifyWork() const override;
 
 
+            /** VerifyProducer
+             *
+             *  Verify the block signature with the key of the block finder.
+             *
+             *  @return True if the signature is valid, false otherwise.
+             *
+             **/
+            bool VerifyProducer() const;
+
+
             /** SignatureHash
              *
              *  Get the Signature Hash of the block. Used to verify work claims.
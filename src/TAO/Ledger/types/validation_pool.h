@@ -0,0 +1,158 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_TAO_LEDGER_TYPES_VALIDATION_POOL_H
+#define NEXUS_TAO_LEDGER_TYPES_VALIDATION_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /** Function prototype for the stateless validation of one item of a batch. **/
+        typedef std::function<bool(const uint32_t)> ValidationFunction;
+
+
+        /** ValidationPool
+         *
+         *  Worker threads for the stateless part of validating blocks and transactions, such as reading
+         *  transactions, checking signatures and reading the register pre-states ahead of the ordered
+         *  connect. A batch is split across the workers and the calling thread, and returns when every
+         *  item is done, so the results can be applied in order afterwards.
+         *
+         **/
+        class ValidationPool
+        {
+            /** Mutex to allow only one batch at a time. **/
+            std::mutex BATCH_MUTEX;
+
+
+            /** Mutex to protect the current batch. **/
+            std::mutex MUTEX;
+
+
+            /** Condition to wake the workers for a new batch. **/
+            std::condition_variable CONDITION;
+
+
+            /** Condition to tell the calling thread the workers are done. **/
+            std::condition_variable DONE_CONDITION;
+
+
+            /** The worker threads. **/
+            std::vector<std::thread> vThreads;
+
+
+            /** Flag to tell the workers to shut down. **/
+            bool fShutdown;
+
+
+            /** The sequence of the current batch, so a worker joins each batch once. **/
+            uint64_t nBatch;
+
+
+            /** The function of the current batch. **/
+            const ValidationFunction* pFunction;
+
+
+            /** The total items in the current batch. **/
+            uint32_t nTotal;
+
+
+            /** The next item of the current batch to validate. **/
+            std::atomic<uint32_t> nNext;
+
+
+            /** The total workers still running the current batch. **/
+            uint32_t nRunning;
+
+
+            /** Flag to tell if an item of the current batch failed. **/
+            std::atomic<bool> fFailed;
+
+
+            /** worker
+             *
+             *  Thread that waits for batches and validates their items.
+             *
+             **/
+            void worker();
+
+
+            /** run
+             *
+             *  Validate items of the current batch until there are none left or one fails.
+             *
+             **/
+            void run();
+
+
+        public:
+
+            /** Constructor
+             *
+             *  @param[in] nThreads The total worker threads, not counting the calling thread.
+             *
+             **/
+            ValidationPool(const uint32_t nThreads);
+
+
+            /** Default Destructor. **/
+            ~ValidationPool();
+
+
+            /** GetInstance
+             *
+             *  Singleton instance, with the total threads set by -validationthreads.
+             *
+             **/
+            static ValidationPool& GetInstance();
+
+
+            /** Threads
+             *
+             *  Get the total threads that validate a batch, including the calling thread.
+             *
+             **/
+            uint32_t Threads() const;
+
+
+            /** ForEach
+             *
+             *  Validate a batch of items across the workers. No more items are started once one fails.
+             *  Functions must not start a batch themselves.
+             *
+             *  @param[in] nItems The total items in the batch.
+             *  @param[in] xFunction The function to validate one item by its index.
+             *
+             *  @return true if every item was valid.
+             *
+             **/
+            bool ForEach(const uint32_t nItems, const ValidationFunction& xFunction);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,190 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/Ledger/types/validation_pool.h>
+
+#include <Util/include/args.h>
+#include <Util/include/debug.h>
+#include <Util/include/mutex.h>
+
+#include <algorithm>
+
+/* Global TAO namespace. */
+namespace TAO
+{
+
+    /* Ledger Layer namespace. */
+    namespace Ledger
+    {
+
+        /* Constructor. */
+        ValidationPool::ValidationPool(const uint32_t nThreads)
+        : BATCH_MUTEX    ( )
+        , MUTEX          ( )
+        , CONDITION      ( )
+        , DONE_CONDITION ( )
+        , vThreads       ( )
+        , fShutdown      (false)
+        , nBatch         (0)
+        , pFunction      (nullptr)
+        , nTotal         (0)
+        , nNext          (0)
+        , nRunning       (0)
+        , fFailed        (false)
+        {
+            /* Start the worker threads. */
+            for(uint32_t n = 0; n < nThreads; ++n)
+                vThreads.push_back(std::thread(&ValidationPool::worker, this));
+        }
+
+
+        /* Default Destructor. */
+        ValidationPool::~ValidationPool()
+        {
+            /* Tell the workers to shut down. */
+            {
+                LOCK(MUTEX);
+                fShutdown = true;
+            }
+            CONDITION.notify_all();
+
+            /* Wait for the workers to finish. */
+            for(auto& thread : vThreads)
+            {
+                if(thread.joinable())
+                    thread.join();
+            }
+        }
+
+
+        /* Singleton instance. */
+        ValidationPool& ValidationPool::GetInstance()
+        {
+            /* The calling thread validates too, so it is taken from the total. */
+            static ValidationPool ret(std::max(int64_t(1),
+                config::GetArg("-validationthreads", int64_t(std::thread::hardware_concurrency()))) - 1);
+
+            return ret;
+        }
+
+
+        /* Get the total threads that validate a batch, including the calling thread. */
+        uint32_t ValidationPool::Threads() const
+        {
+            return vThreads.size() + 1;
+        }
+
+
+        /* Validate a batch of items across the workers. */
+        bool ValidationPool::ForEach(const uint32_t nItems, const ValidationFunction& xFunction)
+        {
+            /* Validate small batches on the calling thread. */
+            if(vThreads.empty() || nItems < 2)
+            {
+                for(uint32_t n = 0; n < nItems; ++n)
+                {
+                    if(!xFunction(n))
+                        return false;
+                }
+
+                return true;
+            }
+
+            LOCK(BATCH_MUTEX);
+
+            /* Set up the batch for the workers. */
+            {
+                LOCK(MUTEX);
+
+                pFunction = &xFunction;
+                nTotal    = nItems;
+                nRunning  = vThreads.size();
+
+                nNext.store(0);
+                fFailed.store(false);
+
+                ++nBatch;
+            }
+            CONDITION.notify_all();
+
+            /* Validate on this thread too. */
+            run();
+
+            /* Wait for the workers to finish their items. */
+            {
+                std::unique_lock<std::mutex> lock(MUTEX);
+                DONE_CONDITION.wait(lock, [this]{ return nRunning == 0; });
+
+                pFunction = nullptr;
+            }
+
+            return !fFailed.load();
+        }
+
+
+        /* Thread that waits for batches and validates their items. */
+        void ValidationPool::worker()
+        {
+            uint64_t nLast = 0;
+            while(true)
+            {
+                /* Wait for the next batch. */
+                {
+                    std::unique_lock<std::mutex> lock(MUTEX);
+                    CONDITION.wait(lock, [this, &nLast]{ return fShutdown || nBatch != nLast; });
+
+                    if(fShutdown)
+                        return;
+
+                    nLast = nBatch;
+                }
+
+                /* Validate the items. */
+                run();
+
+                /* Tell the calling thread this worker is done. */
+                {
+                    LOCK(MUTEX);
+                    --nRunning;
+                }
+                DONE_CONDITION.notify_all();
+            }
+        }
+
+
+        /* Validate items of the current batch until there are none left or one fails. */
+        void ValidationPool::run()
+        {
+            while(!fFailed.load())
+            {
+                /* Take the next item. */
+                const uint32_t n = nNext++;
+                if(n >= nTotal)
+                    break;
+
+                /* Exceptions fail the batch rather than the thread. */
+                try
+                {
+                    if(!(*pFunction)(n))
+                        fFailed.store(true);
+                }
+                catch(const std::exception& e)
+                {
+                    debug::error(FUNCTION, "exception: ", e.what());
+
+                    fFailed.store(true);
+                }
+            }
+        }
+    }
+}
@@ -45,6 +45,10 @@ namespace TAO
             if(!LLD::Register->WriteState(hashAddress, state, nFlags))
                 return debug::error(FUNCTION, "failed to write post-state to disk");
 
+            /* Index the register to its claimant. */
+            if(nFlags == TAO::Ledger::FLAGS::BLOCK && !LLD::Register->IndexOwner(state.hashOwner, hashAddress))
+                return debug::error(FUNCTION, "failed to index owner");
+
             return true;
         }
 
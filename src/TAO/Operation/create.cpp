@@ -267,6 +267,10 @@ namespace TAO
             if(!LLD::Register->WriteState(address, state, nFlags))
                 return debug::error(FUNCTION, "failed to write post-state to disk");
 
+            /* Index the register to its owner. */
+            if(nFlags == TAO::Ledger::FLAGS::BLOCK && !LLD::Register->IndexOwner(state.hashOwner, address))
+                return debug::error(FUNCTION, "failed to index owner");
+
             return true;
         }
 
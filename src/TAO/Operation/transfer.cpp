@@ -46,6 +46,11 @@ namespace TAO
             if(!LLD::Register->WriteState(hashAddress, state, nFlags))
                 return debug::error(FUNCTION, "failed to write post-state to disk");
 
+            /* Index the register to the recipient of a forced transfer, which needs no claim. */
+            if(nFlags == TAO::Ledger::FLAGS::BLOCK && state.hashOwner.GetType() != TAO::Ledger::GENESIS::SYSTEM
+            && !LLD::Register->IndexOwner(state.hashOwner, hashAddress))
+                return debug::error(FUNCTION, "failed to index owner");
+
             return true;
         }
 
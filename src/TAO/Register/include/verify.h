@@ -49,6 +49,18 @@ namespace TAO
         bool Verify(const TAO::Operation::Contract& contract,
                     std::map<uint256_t, TAO::Register::State>& mapStates, const uint8_t nFlags = TAO::Ledger::FLAGS::BLOCK);
 
+
+        /** Prefetch
+         *
+         *  Read the register a contract's pre-state is verified against, so it is cached before the
+         *  contract is verified in order. The contract must be bound to its transaction.
+         *
+         *  @param[in] contract The contract to prefetch for.
+         *  @param[in] nFlags The flags to read with.
+         *
+         **/
+        void Prefetch(const TAO::Operation::Contract& contract, const uint8_t nFlags = TAO::Ledger::FLAGS::BLOCK);
+
     }
 }
 
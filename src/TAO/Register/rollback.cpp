@@ -170,6 +170,10 @@ namespace TAO
                         if(!LLD::Register->EraseState(hashAddress, nFlags))
                             return debug::error(FUNCTION, "OP::CREATE: failed to erase post-state");
 
+                        /* Erase the register from its owner's index. */
+                        if(nFlags == TAO::Ledger::FLAGS::BLOCK && !LLD::Register->EraseOwner(contract.Caller(), hashAddress))
+                            return debug::error(FUNCTION, "OP::CREATE: failed to erase owner index");
+
                         break;
                     }
 
@@ -185,8 +189,9 @@ namespace TAO
                         uint256_t hashTransfer = 0;
                         contract >> hashTransfer;
 
-                        /* Seek past flag. */
-                        contract.Seek(1);
+                        /* Read the force transfer flag. */
+                        uint8_t nType = 0;
+                        contract >> nType;
 
                         /* Verify the first register code. */
                         uint8_t nState = 0;
@@ -204,6 +209,16 @@ namespace TAO
                         if(!LLD::Register->WriteState(hashAddress, state, nFlags))
                             return debug::error(FUNCTION, "OP::TRANSFER: failed to rollback to pre-state");
 
+                        /* Index the register back to its owner from the recipient of a forced transfer. */
+                        if(nFlags == TAO::Ledger::FLAGS::BLOCK && nType == TAO::Operation::TRANSFER::FORCE)
+                        {
+                            if(!LLD::Register->EraseOwner(hashTransfer, hashAddress))
+                                return debug::error(FUNCTION, "OP::TRANSFER: failed to erase owner index");
+
+                            if(!LLD::Register->IndexOwner(state.hashOwner, hashAddress))
+                                return debug::error(FUNCTION, "OP::TRANSFER: failed to rollback owner index");
+                        }
+
                         /* Write the event to the ledger database. */
                         if(nFlags == TAO::Ledger::FLAGS::BLOCK && hashTransfer != WILDCARD_ADDRESS && !LLD::Ledger->EraseEvent(hashTransfer))
                             return debug::error(FUNCTION, "OP::TRANSFER: failed to rollback event");
@@ -247,6 +262,21 @@ namespace TAO
                         if(!LLD::Register->WriteState(hashAddress, state, nFlags))
                             return debug::error(FUNCTION, "OP::CLAIM: failed to rollback to pre-state");
 
+                        /* Index the register back to who transferred it, which is the pre-state owner without the SYSTEM byte. */
+                        if(nFlags == TAO::Ledger::FLAGS::BLOCK)
+                        {
+                            if(!LLD::Register->EraseOwner(contract.Caller(), hashAddress))
+                                return debug::error(FUNCTION, "OP::CLAIM: failed to erase owner index");
+
+                            uint256_t hashOwner = state.hashOwner;
+                            if(hashOwner != 0)
+                            {
+                                hashOwner.SetType(TAO::Ledger::GenesisType());
+                                if(!LLD::Register->IndexOwner(hashOwner, hashAddress))
+                                    return debug::error(FUNCTION, "OP::CLAIM: failed to rollback owner index");
+                            }
+                        }
+
                         break;
                     }
 
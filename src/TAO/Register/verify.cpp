@@ -941,5 +941,85 @@ namespace TAO
             /* If nothing failed, return true for evaluation. */
             return true;
         }
+
+
+        /* Read the register a contract's pre-state is verified against, so it is cached before verifying in order. */
+        void Prefetch(const TAO::Operation::Contract& contract, const uint8_t nFlags)
+        {
+            /* Reset the contract streams. */
+            contract.Reset();
+
+            /* Prefetching is only a hint, so malformed contracts are left for Verify to reject. */
+            try
+            {
+                /* Get the contract OP. */
+                uint8_t nOP = 0;
+                contract >> nOP;
+
+                /* Skip over conditions and validations the same as Verify. */
+                if(nOP == TAO::Operation::OP::CONDITION)
+                    contract >> nOP;
+                else if(nOP == TAO::Operation::OP::VALIDATE)
+                {
+                    contract.Seek(68);
+                    contract >> nOP;
+                }
+
+                /* Get the address of the register with the pre-state. */
+                uint256_t hashAddress = 0;
+                switch(nOP)
+                {
+                    /* Address is the first parameter. */
+                    case TAO::Operation::OP::WRITE:
+                    case TAO::Operation::OP::APPEND:
+                    case TAO::Operation::OP::TRANSFER:
+                    case TAO::Operation::OP::DEBIT:
+                    case TAO::Operation::OP::FEE:
+                    case TAO::Operation::OP::LEGACY:
+                    {
+                        contract >> hashAddress;
+                        break;
+                    }
+
+                    /* Address is after the previous transaction and contract. */
+                    case TAO::Operation::OP::CLAIM:
+                    case TAO::Operation::OP::CREDIT:
+                    {
+                        contract.Seek(68);
+                        contract >> hashAddress;
+                        break;
+                    }
+
+                    /* Address is after the legacy transaction. */
+                    case TAO::Operation::OP::MIGRATE:
+                    {
+                        contract.Seek(64);
+                        contract >> hashAddress;
+                        break;
+                    }
+
+                    /* Address is the trust account of the caller. */
+                    case TAO::Operation::OP::TRUST:
+                    case TAO::Operation::OP::GENESIS:
+                    case TAO::Operation::OP::TRUSTPOOL:
+                    case TAO::Operation::OP::GENESISPOOL:
+                    {
+                        hashAddress = TAO::Register::Address(std::string("trust"), contract.Caller(), TAO::Register::Address::TRUST);
+                        break;
+                    }
+
+                    /* Other operations have no pre-state. */
+                    default:
+                        return;
+                }
+
+                /* Read the register into the cache. */
+                State state;
+                LLD::Register->ReadState(hashAddress, state, nFlags);
+            }
+            catch(const std::exception& e)
+            {
+            }
+        }
     }
 }
@@ -0,0 +1,75 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/templates/bufferpool.h>
+
+#include <utility>
+
+
+/* Definitions of the pool limits, for when they are bound to references. */
+const uint32_t BufferPool::MAX_BUFFERS;
+const uint64_t BufferPool::MAX_CAPACITY;
+
+
+/* The buffers of this thread. */
+static thread_local std::vector<std::vector<uint8_t>> vPool;
+
+
+/*  Get an empty buffer from the pool of this thread, or a new one if the pool is empty. */
+std::vector<uint8_t> BufferPool::Get()
+{
+    if(vPool.empty())
+        return std::vector<uint8_t>();
+
+    std::vector<uint8_t> vBuffer = std::move(vPool.back());
+    vPool.pop_back();
+
+    return vBuffer;
+}
+
+
+/*  Give a buffer back to the pool of this thread. */
+void BufferPool::Put(std::vector<uint8_t>&& vBuffer)
+{
+    /* Only keep buffers worth reusing. */
+    if(vBuffer.capacity() == 0 || vBuffer.capacity() > MAX_CAPACITY || vPool.size() >= MAX_BUFFERS)
+        return;
+
+    /* Reserve the pool once, so giving buffers back doesn't allocate. */
+    if(vPool.capacity() < MAX_BUFFERS)
+        vPool.reserve(MAX_BUFFERS);
+
+    vBuffer.clear();
+    vPool.push_back(std::move(vBuffer));
+}
+
+
+/*  Get the number of buffers in the pool of this thread. */
+uint32_t BufferPool::Size()
+{
+    return static_cast<uint32_t>(vPool.size());
+}
+
+
+/** Default Constructor. **/
+PooledStream::PooledStream(const uint32_t nSerTypeIn, const uint32_t nSerVersionIn)
+: DataStream(BufferPool::Get(), nSerTypeIn, nSerVersionIn)
+{
+}
+
+
+/** Destructor. **/
+PooledStream::~PooledStream()
+{
+    BufferPool::Put(std::move(Bytes()));
+}
@@ -0,0 +1,104 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/templates/readstream.h>
+
+#include <Util/include/debug.h>
+
+#include <algorithm>
+
+
+/*  Constructs the ReadStream object. */
+ReadStream::ReadStream(const uint8_t* pBeginIn, const uint8_t* pEndIn, const uint32_t nSerTypeIn, const uint32_t nSerVersionIn)
+: pBegin(pBeginIn)
+, pEnd(pEndIn)
+, nReadPos(0)
+, nSerType(nSerTypeIn)
+, nSerVersion(nSerVersionIn)
+{
+}
+
+
+/*  Constructs the ReadStream object. */
+ReadStream::ReadStream(const std::vector<uint8_t>& vData, const uint32_t nSerTypeIn, const uint32_t nSerVersionIn)
+: pBegin(vData.data())
+, pEnd(vData.data() + vData.size())
+, nReadPos(0)
+, nSerType(nSerTypeIn)
+, nSerVersion(nSerVersionIn)
+{
+}
+
+
+/*  Sets the position in the stream. */
+void ReadStream::SetPos(const uint64_t nNewPos) const
+{
+    /* Check size constraints. */
+    if(nNewPos > size())
+        throw std::runtime_error(debug::safe_printstr(FUNCTION, "cannot set at end of stream ", nNewPos));
+
+    /* Set the new read pos. */
+    nReadPos = nNewPos;
+}
+
+
+/*  Gets the position in the stream. */
+uint64_t ReadStream::GetPos() const
+{
+    return nReadPos;
+}
+
+
+/*  Resets the internal read pointer. */
+void ReadStream::Reset() const
+{
+    nReadPos = 0;
+}
+
+
+/*  Returns if end of stream is found. */
+bool ReadStream::End() const
+{
+    return nReadPos >= size();
+}
+
+
+/*  Reads raw data from the stream. */
+const ReadStream& ReadStream::read(char* pch, uint64_t nSize) const
+{
+    /* Check size constraints. */
+    if(nReadPos + nSize > size())
+        throw std::runtime_error(debug::safe_printstr(FUNCTION, "reached end of stream ", nReadPos));
+
+    /* Copy the bytes into tmp object. */
+    std::copy(pBegin + nReadPos, pBegin + nReadPos + nSize, (uint8_t*)pch);
+
+    /* Iterate the read position. */
+    nReadPos += nSize;
+
+    return *this;
+}
+
+
+/*  Get the start of the data. */
+const uint8_t* ReadStream::data() const
+{
+    return pBegin;
+}
+
+
+/*  Get the size of the data. */
+uint64_t ReadStream::size() const
+{
+    return static_cast<uint64_t>(pEnd - pBegin);
+}
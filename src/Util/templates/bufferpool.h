@@ -0,0 +1,96 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_UTIL_TEMPLATES_BUFFERPOOL_H
+#define NEXUS_UTIL_TEMPLATES_BUFFERPOOL_H
+
+#include <Util/templates/datastream.h>
+
+#include <cstdint>
+#include <vector>
+
+
+/** BufferPool
+ *
+ *  Pool of byte buffers for each thread, so buffers used for a short time in hot loops keep their capacity rather
+ *  than being allocated and freed every time.
+ *
+ **/
+class BufferPool
+{
+public:
+
+    /** The most buffers kept for each thread. **/
+    static const uint32_t MAX_BUFFERS = 16;
+
+
+    /** The largest capacity of a buffer kept, so a single large record doesn't stay allocated. **/
+    static const uint64_t MAX_CAPACITY = 1024 * 1024;
+
+
+    /** Get
+     *
+     *  Get an empty buffer from the pool of this thread, or a new one if the pool is empty.
+     *
+     **/
+    static std::vector<uint8_t> Get();
+
+
+    /** Put
+     *
+     *  Give a buffer back to the pool of this thread. Buffers over the maximum capacity, or over the maximum
+     *  number of buffers, are freed.
+     *
+     *  @param[in] vBuffer The buffer to give back.
+     *
+     **/
+    static void Put(std::vector<uint8_t>&& vBuffer);
+
+
+    /** Size
+     *
+     *  Get the number of buffers in the pool of this thread.
+     *
+     **/
+    static uint32_t Size();
+};
+
+
+/** PooledStream
+ *
+ *  DataStream that takes its buffer from the pool of the thread and gives it back when it is destroyed, for keys and
+ *  records serialized and thrown away in the same function. It can't be copied, so the buffer is given back once.
+ *
+ **/
+class PooledStream : public DataStream
+{
+public:
+
+    /** Default Constructor. **/
+    PooledStream(const uint32_t nSerTypeIn, const uint32_t nSerVersionIn);
+
+
+    /** Copy Constructor. **/
+    PooledStream(const PooledStream& stream) = delete;
+
+
+    /** Copy Assignment. **/
+    PooledStream& operator=(const PooledStream& stream) = delete;
+
+
+    /** Destructor. **/
+    ~PooledStream();
+};
+
+#endif
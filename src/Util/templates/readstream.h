@@ -0,0 +1,164 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#pragma once
+#ifndef NEXUS_UTIL_TEMPLATES_READSTREAM_H
+#define NEXUS_UTIL_TEMPLATES_READSTREAM_H
+
+#include <Util/templates/serialize.h>
+
+#include <cstdint>
+#include <vector>
+
+
+/** ReadStream
+ *
+ *  Class to handle the deserializing of data from bytes it doesn't own, such as a record read from disk or a bucket of
+ *  a memory mapped file, without copying them into a DataStream first. The bytes must outlive the stream.
+ *
+ **/
+class ReadStream
+{
+    /** The beginning of the data. **/
+    const uint8_t* pBegin;
+
+
+    /** The end of the data. **/
+    const uint8_t* pEnd;
+
+
+    /** The current reading position. **/
+    mutable uint64_t nReadPos;
+
+
+    /** The serialization type. **/
+    uint32_t nSerType;
+
+
+    /** The serializtion version **/
+    uint32_t nSerVersion;
+
+
+public:
+
+    /** ReadStream
+     *
+     *  Constructs the ReadStream object.
+     *
+     *  @param[in] pBeginIn The beginning of the data to read.
+     *  @param[in] pEndIn The end of the data to read.
+     *  @param[in] nSerTypeIn The serialize type.
+     *  @param[in] nSerVersionIn The serialize version.
+     *
+     **/
+    ReadStream(const uint8_t* pBeginIn, const uint8_t* pEndIn, const uint32_t nSerTypeIn, const uint32_t nSerVersionIn);
+
+
+    /** ReadStream
+     *
+     *  Constructs the ReadStream object.
+     *
+     *  @param[in] vData The byte vector to read, which must not change while it is read.
+     *  @param[in] nSerTypeIn The serialize type.
+     *  @param[in] nSerVersionIn The serialize version.
+     *
+     **/
+    ReadStream(const std::vector<uint8_t>& vData, const uint32_t nSerTypeIn, const uint32_t nSerVersionIn);
+
+
+    /** Rvalue vectors would be destroyed before they are read. **/
+    ReadStream(const std::vector<uint8_t>&& vData, const uint32_t nSerTypeIn, const uint32_t nSerVersionIn) = delete;
+
+
+    /** SetPos
+     *
+     *  Sets the position in the stream.
+     *
+     *  @param[in] nNewPos The position to set to in the stream.
+     *
+     **/
+    void SetPos(const uint64_t nNewPos) const;
+
+
+    /** GetPos
+     *
+     *  Gets the position in the stream.
+     *
+     *  @return the current read position in the stream.
+     *
+     **/
+    uint64_t GetPos() const;
+
+
+    /** Reset
+     *
+     *  Resets the internal read pointer.
+     *
+     **/
+    void Reset() const;
+
+
+    /** End
+     *
+     *  Returns if end of stream is found.
+     *
+     **/
+    bool End() const;
+
+
+    /** read
+     *
+     *  Reads raw data from the stream.
+     *
+     *  @param[in] pch The pointer to beginning of memory to write.
+     *  @param[in] nSize The total number of bytes to read.
+     *
+     *  @return Returns a reference to the ReadStream object.
+     *
+     **/
+    const ReadStream& read(char* pch, uint64_t nSize) const;
+
+
+    /** data
+     *
+     *  Get the start of the data.
+     *
+     **/
+    const uint8_t* data() const;
+
+
+    /** size
+     *
+     *  Get the size of the data.
+     *
+     **/
+    uint64_t size() const;
+
+
+    /** Operator Overload >>
+     *
+     *  Serializes data from the stream.
+     *
+     *  @param[out] obj The object to de-serialize from the data.
+     *
+     **/
+    template<typename Type>
+    const ReadStream& operator>>(Type& obj) const
+    {
+        /* Unserialize from the stream. */
+        ::Unserialize(*this, obj, nSerType, nSerVersion);
+        return (*this);
+    }
+};
+
+#endif
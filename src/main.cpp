@@ -28,6 +28,7 @@ ________________________________________________________________________________
 #include <TAO/Ledger/include/create.h>
 #include <TAO/Ledger/include/chainstate.h>
 #include <TAO/Ledger/include/dispatch.h>
+#include <TAO/Ledger/types/chain_index.h>
 #include <TAO/Ledger/types/stake_minter.h>
 #include <TAO/Ledger/include/timelocks.h>
 
@@ -316,6 +317,10 @@ int main(int argc, char** argv)
     LLP::Shutdown();
 
 
+    /* Stop building the chain index, which reads from the ledger database. */
+    TAO::Ledger::ChainIndex::GetInstance().Stop();
+
+
     /* Shutdown database instances. */
     LLD::Shutdown();
 
@@ -0,0 +1,98 @@
+#include <Util/include/runtime.h>
+#include <Util/include/debug.h>
+
+#include <LLC/include/fermat.h>
+#include <LLC/include/random.h>
+#include <LLC/prime/fermat.h>
+#include <LLC/types/bignum.h>
+
+#include <TAO/Ledger/include/prime.h>
+
+#include <openssl/bn.h>
+
+#include <unit/catch2/catch.hpp>
+
+
+TEST_CASE( "Fermat Benchmarks", "[LLC]")
+{
+    debug::log(0, "===== Begin Fermat Benchmarks =====");
+
+    /* Odd 1024-bit numbers, like the ones in prime blocks. */
+    std::vector<uint1024_t> vPrimes;
+    for(uint32_t i = 0; i < 1024; ++i)
+    {
+        uint1024_t hashNumber = LLC::GetRand1024();
+        hashNumber |= 1;
+
+        vPrimes.push_back(hashNumber);
+    }
+
+
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        for(const auto& hashNumber : vPrimes)
+        {
+            LLC::CAutoBN_CTX pctx;
+
+            LLC::CBigNum bnPrime(hashNumber);
+            LLC::CBigNum bnBase(2);
+            LLC::CBigNum bnExp = bnPrime - 1;
+
+            LLC::CBigNum bnResult;
+            BN_mod_exp(bnResult.getBN(), bnBase.getBN(), bnExp.getBN(), bnPrime.getBN(), pctx);
+        }
+
+        uint64_t nTime = timer.ElapsedMicroseconds();
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "OpenSSL::", ANSI_COLOR_RESET, vPrimes.size() * 1000000.0 / nTime, " tests / second");
+    }
+
+
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        for(const auto& hashNumber : vPrimes)
+        {
+            uint1024_t hashResult;
+            uint32_t e[32];
+            uint32_t table[WINDOW_SIZE * 32];
+
+            sub_ui<32>(e, (uint32_t *)hashNumber.begin(), 1);
+            pow2m<32>((uint32_t *)hashResult.begin(), e, (uint32_t *)hashNumber.begin(), table);
+        }
+
+        uint64_t nTime = timer.ElapsedMicroseconds();
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "pow2m::", ANSI_COLOR_RESET, vPrimes.size() * 1000000.0 / nTime, " tests / second");
+    }
+
+
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        std::vector<uint1024_t> vRemainders;
+        LLC::FermatBatch(vPrimes, vRemainders);
+
+        uint64_t nTime = timer.ElapsedMicroseconds();
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "FermatBatch::", ANSI_COLOR_RESET, vPrimes.size() * 1000000.0 / nTime,
+            " tests / second with ", LLC::FermatLanes(), " lanes");
+    }
+
+
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        std::vector<uint64_t> vNonces;
+        TAO::Ledger::PrimeSieve(vPrimes[0], 0, 1 << 16, vNonces);
+
+        uint64_t nTime = timer.ElapsedMicroseconds();
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "PrimeSieve::", ANSI_COLOR_RESET, (1 << 16) * 1000000.0 / nTime,
+            " nonces / second, ", vNonces.size(), " primes");
+    }
+
+
+    debug::log(0, "===== End Fermat Benchmarks =====\n");
+}
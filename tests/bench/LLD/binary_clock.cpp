@@ -0,0 +1,91 @@
+#include <Util/include/runtime.h>
+
+#include <LLC/include/random.h>
+
+#include <LLD/cache/binary_clock.h>
+#include <LLD/cache/binary_lru.h>
+
+#include <LLD/include/enum.h>
+#include <LLD/include/version.h>
+#include <LLD/templates/key.h>
+
+#include <Util/templates/datastream.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <thread>
+
+
+/* Read the same records from a cache with a number of threads, returning millions of reads per second. */
+template<typename CacheType>
+static double ConcurrentGets(CacheType* cache, const uint256_t& hash, const uint32_t nThreads, const uint32_t nRecords)
+{
+    runtime::timer timer;
+    timer.Start();
+
+    std::vector<std::thread> vThreads;
+    for(uint32_t nThread = 0; nThread < nThreads; ++nThread)
+    {
+        vThreads.push_back(std::thread([cache, hash, nThread, nRecords]()
+        {
+            for(uint32_t i = 0; i < nRecords; ++i)
+            {
+                DataStream ssKey(SER_LLD, LLD::DATABASE_VERSION);
+                ssKey << std::make_pair(std::string("data"), hash + ((i * 7919 + nThread) % nRecords));
+
+                std::vector<uint8_t> vBytes;
+                cache->Get(ssKey.Bytes(), vBytes);
+            }
+        }));
+    }
+
+    for(auto& thread : vThreads)
+        thread.join();
+
+    return (double(nRecords) * nThreads) / timer.ElapsedMicroseconds();
+}
+
+
+TEST_CASE( "Binary CLOCK Benchmarks", "[LLD]")
+{
+    debug::log(0, "===== Begin Binary CLOCK Benchmarks =====");
+
+    //benchmarks
+    LLD::BinaryCLOCK* clock = new LLD::BinaryCLOCK(1024 * 1024 * 64);
+    LLD::BinaryLRU*   lru   = new LLD::BinaryLRU(1024 * 1024 * 64);
+
+    uint256_t hash = LLC::GetRand256();
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        for(uint32_t i = 0; i < 100000; i++)
+        {
+            DataStream ssKey(SER_LLD, LLD::DATABASE_VERSION);
+            ssKey << std::make_pair(std::string("data"), hash + i);
+
+            DataStream ssData(SER_LLD, LLD::DATABASE_VERSION);
+            ssData << uint1024_t(4934943);
+
+            LLD::SectorKey key(LLD::STATE::READY, ssKey.Bytes(), 0, i * 256, 256);
+            clock->Put(key, ssKey.Bytes(), ssData.Bytes());
+            lru->Put(key, ssKey.Bytes(), ssData.Bytes());
+        }
+
+        uint64_t nTime = timer.ElapsedMicroseconds();
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Put::", ANSI_COLOR_RESET, 200000.0 / nTime, " million records / second");
+    }
+
+    /* Compare reads under contention, as RPC threads reading registers would. */
+    for(const uint32_t nThreads : {1, 8, 32})
+    {
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Get::", ANSI_COLOR_RESET, nThreads, " threads: ",
+            "LRU ", ConcurrentGets(lru, hash, nThreads, 100000), " | ",
+            "CLOCK ", ConcurrentGets(clock, hash, nThreads, 100000), " million records / second");
+    }
+
+    delete clock;
+    delete lru;
+
+    debug::log(0, "===== End Binary CLOCK Benchmarks =====\n");
+}
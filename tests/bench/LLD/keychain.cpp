@@ -0,0 +1,175 @@
+#include <Util/include/runtime.h>
+#include <Util/include/filesystem.h>
+#include <Util/include/args.h>
+
+#include <LLC/include/random.h>
+
+#include <LLD/include/enum.h>
+#include <LLD/include/version.h>
+#include <LLD/templates/key.h>
+
+#include <LLD/keychain/hashmap.h>
+#include <LLD/keychain/shard_hashmap.h>
+#include <LLD/keychain/hashtree.h>
+#include <LLD/keychain/filemap.h>
+
+#include <Util/templates/datastream.h>
+
+#include <unit/catch2/catch.hpp>
+
+
+/* Serialize keys the way a sector database would, under the same distribution for every keychain. */
+static std::vector<std::vector<uint8_t>> GenerateKeys(const uint256_t& hash, const uint32_t nStart, const uint32_t nTotal)
+{
+    std::vector<std::vector<uint8_t>> vKeys;
+    vKeys.reserve(nTotal);
+
+    for(uint32_t i = nStart; i < nStart + nTotal; ++i)
+    {
+        DataStream ssKey(SER_LLD, LLD::DATABASE_VERSION);
+        ssKey << std::make_pair(std::string("bench"), hash + i);
+
+        vKeys.push_back(ssKey.Bytes());
+    }
+
+    return vKeys;
+}
+
+
+/* Get a clean location for a benchmark keychain. */
+static std::string KeychainLocation(const std::string& strName)
+{
+    std::string strPath = config::GetDataDir() + "_BENCH_KEYCHAIN/" + strName + "/";
+    if(filesystem::exists(strPath))
+        filesystem::remove_directories(strPath);
+
+    return strPath;
+}
+
+
+/* Time the gets of a set of keys, returning the average microseconds per get. */
+template<typename KeychainType>
+static double TimeGets(KeychainType* pKeychain, const std::vector<std::vector<uint8_t>>& vKeys, uint32_t& nFound)
+{
+    runtime::timer timer;
+    timer.Start();
+
+    nFound = 0;
+    for(const auto& vKey : vKeys)
+    {
+        LLD::SectorKey cKey;
+        if(pKeychain->Get(vKey, cKey))
+            ++nFound;
+    }
+
+    return double(timer.ElapsedNanoseconds()) / (vKeys.size() * 1000.0);
+}
+
+
+/* Put, hit and miss the same keys on a keychain. */
+template<typename KeychainType>
+static void KeychainBenchmark(const std::string& strName, KeychainType* pKeychain,
+                       const std::vector<std::vector<uint8_t>>& vKeys, const std::vector<std::vector<uint8_t>>& vMisses)
+{
+    double dPut = 0;
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        for(uint32_t i = 0; i < vKeys.size(); ++i)
+        {
+            LLD::SectorKey cKey(LLD::STATE::READY, vKeys[i], 0, i * 256, 256);
+            pKeychain->Put(cKey);
+        }
+
+        dPut = double(timer.ElapsedNanoseconds()) / (vKeys.size() * 1000.0);
+    }
+
+    uint32_t nHits = 0, nMisses = 0;
+    const double dHit  = TimeGets(pKeychain, vKeys, nHits);
+    const double dMiss = TimeGets(pKeychain, vMisses, nMisses);
+
+    debug::log(0, ANSI_COLOR_BRIGHT_CYAN, strName, "::", ANSI_COLOR_RESET,
+        "Put ", dPut, " us | Hit ", dHit, " us (", nHits, "/", vKeys.size(), " found) | Miss ", dMiss, " us (", nMisses, " false hits)");
+}
+
+
+TEST_CASE( "Keychain Benchmarks", "[LLD]")
+{
+    debug::log(0, "===== Begin Keychain Comparison Benchmarks =====");
+
+    const uint32_t nTotal = 20000;
+
+    const uint256_t hash = LLC::GetRand256();
+    const std::vector<std::vector<uint8_t>> vKeys   = GenerateKeys(hash, 0, nTotal);
+    const std::vector<std::vector<uint8_t>> vMisses = GenerateKeys(hash, 1u << 30, nTotal);
+
+    {
+        LLD::BinaryHashMap* pKeychain = new LLD::BinaryHashMap(KeychainLocation("hashmap"), LLD::FLAGS::CREATE, 256 * 256);
+        KeychainBenchmark("BinaryHashMap", pKeychain, vKeys, vMisses);
+        delete pKeychain;
+    }
+
+    {
+        LLD::BinaryHashMap* pKeychain = new LLD::BinaryHashMap(KeychainLocation("hashmap_mapped"),
+            LLD::FLAGS::CREATE | LLD::FLAGS::MAPPED | LLD::FLAGS::FILTER, 256 * 256);
+        KeychainBenchmark("BinaryHashMap (mapped, filter)", pKeychain, vKeys, vMisses);
+        delete pKeychain;
+    }
+
+    {
+        LLD::ShardHashMap* pKeychain = new LLD::ShardHashMap(KeychainLocation("shard_hashmap"), LLD::FLAGS::CREATE, 256 * 256);
+        KeychainBenchmark("ShardHashMap", pKeychain, vKeys, vMisses);
+        delete pKeychain;
+    }
+
+    {
+        LLD::BinaryHashTree* pKeychain = new LLD::BinaryHashTree(KeychainLocation("hashtree"), LLD::FLAGS::CREATE);
+        KeychainBenchmark("BinaryHashTree", pKeychain, vKeys, vMisses);
+        delete pKeychain;
+    }
+
+    {
+        LLD::BinaryFileMap* pKeychain = new LLD::BinaryFileMap(KeychainLocation("filemap"), LLD::FLAGS::CREATE);
+        KeychainBenchmark("BinaryFileMap", pKeychain, vKeys, vMisses);
+        delete pKeychain;
+    }
+
+    debug::log(0, "===== End Keychain Comparison Benchmarks =====\n");
+
+
+    debug::log(0, "===== Begin Keychain Probe Chain Benchmarks =====");
+
+    /* Fill a small hashmap a bucket's worth at a time, so each round adds about one file to every probe chain. */
+    for(const uint8_t nFlags : {uint8_t(LLD::FLAGS::CREATE), uint8_t(LLD::FLAGS::CREATE | LLD::FLAGS::MAPPED | LLD::FLAGS::FILTER)})
+    {
+        const uint32_t nBuckets = 4096;
+
+        LLD::BinaryHashMap* pKeychain = new LLD::BinaryHashMap(KeychainLocation("probe"), nFlags, nBuckets);
+        debug::log(0, (nFlags & LLD::FLAGS::MAPPED) ? "Mapped with filter:" : "Streams:");
+
+        std::vector<std::vector<uint8_t>> vFirst;
+        for(uint32_t nRound = 0; nRound < 8; ++nRound)
+        {
+            const std::vector<std::vector<uint8_t>> vRound = GenerateKeys(hash, nRound * nBuckets, nBuckets);
+            for(uint32_t i = 0; i < vRound.size(); ++i)
+                pKeychain->Put(LLD::SectorKey(LLD::STATE::READY, vRound[i], 0, i * 256, 256));
+
+            if(nRound == 0)
+                vFirst = vRound;
+
+            /* Newest keys are found first, the oldest are at the end of the chain, and misses walk all of it. */
+            uint32_t nFound = 0;
+            const double dNewest = TimeGets(pKeychain, vRound, nFound);
+            const double dOldest = TimeGets(pKeychain, vFirst, nFound);
+            const double dMiss   = TimeGets(pKeychain, vMisses, nFound);
+
+            debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Load ", nRound + 1, ".0::", ANSI_COLOR_RESET,
+                "Hit newest ", dNewest, " us | Hit oldest ", dOldest, " us | Miss ", dMiss, " us");
+        }
+
+        delete pKeychain;
+    }
+
+    debug::log(0, "===== End Keychain Probe Chain Benchmarks =====\n");
+}
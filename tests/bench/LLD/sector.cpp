@@ -0,0 +1,156 @@
+#include <Util/include/runtime.h>
+#include <Util/include/filesystem.h>
+#include <Util/include/args.h>
+
+#include <LLD/include/enum.h>
+#include <LLD/cache/binary_clock.h>
+#include <LLD/keychain/hashmap.h>
+#include <LLD/templates/sector.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+
+/* The database the workloads run against, with the keychain and cache of the ledger and register databases. */
+typedef LLD::SectorDatabase<LLD::BinaryHashMap, LLD::BinaryCLOCK> BenchDB;
+
+
+namespace
+{
+    /* The latencies of one type of operation. */
+    struct Latencies
+    {
+        std::vector<uint64_t> vNanoseconds;
+
+        /* Get a percentile of the latencies in microseconds, once they are sorted. */
+        double Percentile(const double dPercent) const
+        {
+            if(vNanoseconds.empty())
+                return 0;
+
+            const uint64_t nIndex = std::min(uint64_t(vNanoseconds.size() * dPercent / 100.0), uint64_t(vNanoseconds.size() - 1));
+            return vNanoseconds[nIndex] / 1000.0;
+        }
+    };
+}
+
+
+/* Run a mixed read, write and erase workload with a number of threads, logging latencies and throughput. */
+static void MixedWorkload(BenchDB* db, const uint32_t nThreads, const uint32_t nRecords, const uint32_t nOps, const uint32_t nRecordSize)
+{
+    const std::vector<uint8_t> vValue(nRecordSize, 0xaa);
+
+    /* Operations are 70% reads, 20% writes and 10% erases. */
+    std::vector<Latencies> vReads(nThreads), vWrites(nThreads), vErases(nThreads);
+    std::atomic<uint64_t> nBytes(0);
+
+    runtime::timer timer;
+    timer.Start();
+
+    std::vector<std::thread> vThreads;
+    for(uint32_t nThread = 0; nThread < nThreads; ++nThread)
+    {
+        vThreads.push_back(std::thread([&, nThread]()
+        {
+            /* Each thread has its own deterministic key sequence. */
+            uint64_t nState = 0x9e3779b97f4a7c15 * (nThread + 1);
+
+            uint64_t nThreadBytes = 0;
+            for(uint32_t i = 0; i < nOps; ++i)
+            {
+                nState ^= nState << 13;
+                nState ^= nState >> 7;
+                nState ^= nState << 17;
+
+                const uint64_t nKey = nState % nRecords;
+                const uint32_t nType = (nState >> 32) % 10;
+
+                runtime::timer op;
+                op.Start();
+
+                if(nType < 7)
+                {
+                    std::vector<uint8_t> vRead;
+                    if(db->Read(std::make_pair(std::string("bench"), nKey), vRead))
+                        nThreadBytes += vRead.size();
+
+                    vReads[nThread].vNanoseconds.push_back(op.ElapsedNanoseconds());
+                }
+                else if(nType < 9)
+                {
+                    if(db->Write(std::make_pair(std::string("bench"), nKey), vValue))
+                        nThreadBytes += vValue.size();
+
+                    vWrites[nThread].vNanoseconds.push_back(op.ElapsedNanoseconds());
+                }
+                else
+                {
+                    db->Erase(std::make_pair(std::string("bench"), nKey));
+
+                    vErases[nThread].vNanoseconds.push_back(op.ElapsedNanoseconds());
+                }
+            }
+
+            nBytes += nThreadBytes;
+        }));
+    }
+
+    for(auto& thread : vThreads)
+        thread.join();
+
+    const uint64_t nTime = timer.ElapsedMicroseconds();
+
+    /* Merge the latencies of every thread. */
+    for(const auto& pair : {std::make_pair(std::string("Read"), &vReads), std::make_pair(std::string("Write"), &vWrites), std::make_pair(std::string("Erase"), &vErases)})
+    {
+        Latencies total;
+        for(const auto& latencies : *pair.second)
+            total.vNanoseconds.insert(total.vNanoseconds.end(), latencies.vNanoseconds.begin(), latencies.vNanoseconds.end());
+
+        std::sort(total.vNanoseconds.begin(), total.vNanoseconds.end());
+
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, pair.first, "::", ANSI_COLOR_RESET, nThreads, " threads: ", total.vNanoseconds.size(), " ops",
+            " | p50 ", total.Percentile(50), " us | p99 ", total.Percentile(99), " us | p999 ", total.Percentile(99.9), " us");
+    }
+
+    debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Total::", ANSI_COLOR_RESET, nThreads, " threads: ",
+        (uint64_t(nThreads) * nOps * 1000000) / std::max(nTime, uint64_t(1)), " ops/s | ",
+        (double(nBytes.load()) / (1024 * 1024)) / (std::max(nTime, uint64_t(1)) / 1000000.0), " MB/s");
+}
+
+
+TEST_CASE( "Sector Database Mixed Workload Benchmarks", "[LLD]")
+{
+    debug::log(0, "===== Begin Sector Database Mixed Workload Benchmarks =====");
+
+    std::string strPath = config::GetDataDir() + "_BENCH_SECTOR/";
+    if(filesystem::exists(strPath))
+        filesystem::remove_directories(strPath);
+
+    const uint32_t nRecords    = 20000;
+    const uint32_t nRecordSize = 256;
+
+    BenchDB* db = new BenchDB("_BENCH_SECTOR", LLD::FLAGS::CREATE | LLD::FLAGS::FORCE, 256 * 256 * 4, 1024 * 1024);
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        const std::vector<uint8_t> vValue(nRecordSize, 0x55);
+        for(uint64_t nKey = 0; nKey < nRecords; ++nKey)
+            db->Write(std::make_pair(std::string("bench"), nKey), vValue);
+
+        uint64_t nTime = timer.ElapsedMicroseconds();
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Load::", ANSI_COLOR_RESET, nRecords, " records in ", nTime, " microseconds (",
+            (uint64_t(nRecords) * 1000000) / std::max(nTime, uint64_t(1)), ") per/s");
+    }
+
+    for(const uint32_t nThreads : {1, 4, 16})
+        MixedWorkload(db, nThreads, nRecords, 200000 / nThreads, nRecordSize);
+
+    delete db;
+
+    debug::log(0, "===== End Sector Database Mixed Workload Benchmarks =====\n");
+}
@@ -0,0 +1,141 @@
+#include <LLC/hash/SK.h>
+#include <LLC/include/random.h>
+
+#include <TAO/Operation/include/enum.h>
+
+#include <TAO/Register/include/create.h>
+#include <TAO/Register/include/enum.h>
+#include <TAO/Register/types/address.h>
+
+#include <TAO/Ledger/include/create.h>
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/types/mempool.h>
+#include <TAO/Ledger/types/sigchain.h>
+#include <TAO/Ledger/types/template_engine.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <Util/include/debug.h>
+#include <Util/include/runtime.h>
+#include <Util/templates/datastream.h>
+
+#include <set>
+
+/* Get the hash of a transaction from its serialized data, without its cached hash. */
+static uint512_t SerializedHash(const TAO::Ledger::Transaction& tx)
+{
+    DataStream ss(SER_GETHASH, tx.nVersion);
+    ss << tx;
+
+    uint512_t hash = LLC::SK512(ss.begin(), ss.end());
+    hash.SetType(TAO::Ledger::TRITIUM);
+
+    return hash;
+}
+
+
+/* Get the merkle root of a block from the serialized producer. */
+static uint512_t SerializedRoot(const TAO::Ledger::TritiumBlock& block)
+{
+    std::vector<uint512_t> vHashes;
+    for(const auto& tx : block.vtx)
+        vHashes.push_back(tx.second);
+
+    vHashes.push_back(SerializedHash(block.nVersion < 9 ? block.producer : block.vProducer.back()));
+
+    return block.BuildMerkleTree(vHashes);
+}
+
+
+TEST_CASE( "Block Template Benchmarks", "[ledger]")
+{
+    using namespace TAO::Register;
+    using namespace TAO::Operation;
+
+    debug::log(0, "===== Begin Block Template Benchmarks =====");
+
+    /* Fill the memory pool, so creating a block has transactions to add. */
+    const uint32_t nTransactions = 100;
+    for(uint32_t i = 0; i < nTransactions; ++i)
+    {
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = TAO::Ledger::SignatureChain::Genesis(LLC::GetRand256().ToString().c_str());
+        tx.nSequence   = 0;
+        tx.nTimestamp  = runtime::unifiedtimestamp();
+        tx.nKeyType    = TAO::Ledger::SIGNATURE::BRAINPOOL;
+        tx.nNextType   = TAO::Ledger::SIGNATURE::BRAINPOOL;
+        tx.NextHash(LLC::GetRand512(), TAO::Ledger::SIGNATURE::BRAINPOOL);
+
+        Address hashAccount = Address(Address::ACCOUNT);
+        tx[0] << uint8_t(OP::CREATE) << hashAccount << uint8_t(REGISTER::OBJECT) << CreateAccount(0).GetState();
+
+        REQUIRE(tx.Build());
+        REQUIRE(tx.Sign(LLC::GetRand512()));
+        REQUIRE(TAO::Ledger::mempool.Accept(tx));
+    }
+
+    /* The miner's sigchain. */
+    const SecureString strPin = "1234";
+    memory::encrypted_ptr<TAO::Ledger::SignatureChain> user =
+        new TAO::Ledger::SignatureChain(LLC::GetRand256().ToString().c_str(), "password");
+
+    /* Create blocks the same as the mining server. */
+    TAO::Ledger::TemplateFunction xCreate = [&](TAO::Ledger::TritiumBlock& block, const uint64_t nExtraNonce)
+    {
+        return TAO::Ledger::CreateBlock(user, strPin, 2, block, nExtraNonce);
+    };
+
+
+    /* Every block from CreateBlock scans the memory pool and signs its producer. */
+    const uint32_t nBlocks = 100;
+    {
+        runtime::timer timer;
+        timer.Start();
+
+        TAO::Ledger::TritiumBlock block;
+        for(uint32_t i = 0; i < nBlocks; ++i)
+        {
+            REQUIRE(xCreate(block, i));
+        }
+
+        uint64_t nTime = timer.ElapsedMicroseconds();
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "CreateBlock::", ANSI_COLOR_RESET, nBlocks * 1000000.0 / nTime, " blocks / second");
+
+        REQUIRE(block.hashMerkleRoot == SerializedRoot(block));
+    }
+
+
+    /* Blocks from the template are only signed when they are solved, so signing isn't timed here. */
+    {
+        TAO::Ledger::TemplateEngine engine;
+
+        runtime::timer timer;
+        timer.Start();
+
+        std::vector<TAO::Ledger::TritiumBlock> vBlocks(nBlocks);
+        for(uint32_t i = 0; i < nBlocks; ++i)
+        {
+            REQUIRE(engine.New(0, xCreate, vBlocks[i]));
+        }
+
+        uint64_t nTime = timer.ElapsedMicroseconds();
+        debug::log(0, ANSI_COLOR_BRIGHT_CYAN, "Template::", ANSI_COLOR_RESET, nBlocks * 1000000.0 / nTime, " blocks / second");
+
+        /* The merkle root from the branch matches the serialized producer, and every block has different work. */
+        std::set<uint512_t> setRoots;
+        for(auto& block : vBlocks)
+        {
+            REQUIRE(block.hashMerkleRoot == SerializedRoot(block));
+            setRoots.insert(block.hashMerkleRoot);
+
+            /* Signing the solved block keeps the producer's hash. */
+            TAO::Ledger::Transaction& txProducer = (block.nVersion < 9 ? block.producer : block.vProducer.back());
+            REQUIRE(txProducer.Sign(user->Generate(txProducer.nSequence, strPin)));
+            REQUIRE(block.hashMerkleRoot == SerializedRoot(block));
+        }
+
+        REQUIRE(setRoots.size() == nBlocks);
+    }
+
+    debug::log(0, "===== End Block Template Benchmarks =====\n");
+}
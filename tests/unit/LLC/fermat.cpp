@@ -14,6 +14,7 @@ ________________________________________________________________________________
 #include <LLC/types/uint1024.h>
 #include <LLC/types/bignum.h>
 #include <LLC/include/random.h>
+#include <LLC/include/fermat.h>
 #include <LLC/prime/fermat.h>
 #include <openssl/bn.h>
 #include <unit/catch2/catch.hpp>
@@ -82,3 +83,48 @@ TEST_CASE("Fermat Tests", "[LLC]")
 
 
 }
+
+
+TEST_CASE("Fermat Batch Tests", "[LLC]")
+{
+    /* Mix odd and even numbers of every size, with a few small ones. */
+    std::vector<uint1024_t> vPrimes;
+    for(uint32_t i = 0; i < 100; ++i)
+    {
+        uint1024_t hashNumber = LLC::GetRand1024();
+        hashNumber >>= (i * 13) % 1000;
+
+        if(i % 5 != 0)
+            hashNumber |= 1;
+
+        vPrimes.push_back(hashNumber);
+    }
+
+    vPrimes.push_back(uint1024_t(1));
+    vPrimes.push_back(uint1024_t(3));
+    vPrimes.push_back(uint1024_t(65537));
+
+    /* Check the batch against OpenSSL. */
+    std::vector<uint1024_t> vRemainders;
+    LLC::FermatBatch(vPrimes, vRemainders);
+
+    REQUIRE(vRemainders.size() == vPrimes.size());
+    for(uint32_t i = 0; i < vPrimes.size(); ++i)
+    {
+        REQUIRE(vRemainders[i] == FermatTest2(LLC::CBigNum(vPrimes[i])).getuint1024());
+        REQUIRE(vRemainders[i] == LLC::FermatTest(vPrimes[i]));
+    }
+
+    /* Check batches smaller than the lanes. */
+    for(uint32_t nSize = 0; nSize <= 4; ++nSize)
+    {
+        std::vector<uint1024_t> vSmall(vPrimes.begin() + 1, vPrimes.begin() + 1 + nSize);
+        LLC::FermatBatch(vSmall, vRemainders);
+
+        REQUIRE(vRemainders.size() == nSize);
+        for(uint32_t i = 0; i < nSize; ++i)
+        {
+            REQUIRE(vRemainders[i] == LLC::FermatTest(vSmall[i]));
+        }
+    }
+}
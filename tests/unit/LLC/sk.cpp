@@ -0,0 +1,54 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/hash/SK.h>
+#include <LLC/include/random.h>
+
+#include <unit/catch2/catch.hpp>
+
+TEST_CASE( "SK512 Batch Tests", "[LLC]")
+{
+    /* Messages of every length across several Skein blocks, then random lengths. */
+    std::vector<std::vector<uint8_t> > vData;
+    for(uint32_t n = 0; n < 2000; ++n)
+    {
+        std::vector<uint8_t> vch((n < 300) ? n : (LLC::GetRand() % 4096));
+        for(auto& ch : vch)
+            ch = static_cast<uint8_t>(LLC::GetRand());
+
+        vData.push_back(vch);
+    }
+
+    /* The batch must match hashing one at a time, whatever lanes this CPU has. */
+    std::vector<uint512_t> vHashes;
+    LLC::SK512Batch(vData, vHashes);
+    REQUIRE(vHashes.size() == vData.size());
+
+    for(uint32_t n = 0; n < vData.size(); ++n)
+    {
+        REQUIRE(vHashes[n] == LLC::SK512(vData[n].begin(), vData[n].end()));
+    }
+
+    /* Batches smaller than the lanes. */
+    for(uint32_t nSize = 0; nSize <= LLC::SK512Lanes() + 1; ++nSize)
+    {
+        std::vector<std::vector<uint8_t> > vSmall(vData.begin() + 100, vData.begin() + 100 + nSize);
+        LLC::SK512Batch(vSmall, vHashes);
+
+        REQUIRE(vHashes.size() == nSize);
+        for(uint32_t n = 0; n < nSize; ++n)
+        {
+            REQUIRE(vHashes[n] == LLC::SK512(vSmall[n].begin(), vSmall[n].end()));
+        }
+    }
+}
@@ -0,0 +1,161 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLP/include/sync_scheduler.h>
+
+#include <TAO/Ledger/types/block.h>
+
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <memory>
+#include <vector>
+
+TEST_CASE( "LLP::SyncScheduler", "[sync_scheduler]")
+{
+    /* Make a chain of ten blocks after a base at height 100, with versions hashed by their header. */
+    std::vector<TAO::Ledger::Block> vChain(11);
+    for(auto& block : vChain)
+    {
+        block.nVersion = 4;
+        block.nChannel = 2;
+    }
+
+    vChain[0].nHeight = 100;
+    for(uint32_t n = 1; n < vChain.size(); ++n)
+    {
+        vChain[n].hashPrevBlock = vChain[n - 1].GetHash();
+        vChain[n].nHeight       = 100 + n;
+        vChain[n].nNonce        = n;
+    }
+
+    /* Windows of four blocks, with a second of stall timeout. */
+    LLP::SyncScheduler scheduler(4, 4, 1000);
+    scheduler.Start(vChain[0].GetHash(), 100);
+    REQUIRE(scheduler.Active());
+
+    /* Headers have to extend the chain. */
+    REQUIRE_FALSE(scheduler.AddHeader(vChain[2].GetHash(), vChain[1].GetHash(), 102));
+    for(uint32_t n = 1; n < vChain.size(); ++n)
+    {
+        REQUIRE(scheduler.AddHeader(vChain[n].GetHash(), vChain[n].hashPrevBlock, vChain[n].nHeight));
+    }
+    REQUIRE(scheduler.LastHeader() == vChain[10].GetHash());
+
+    /* Assign the first two windows. */
+    uint1024_t hashFrom, hashTo;
+    REQUIRE(scheduler.Assign(1, 1000, 1, hashFrom, hashTo));
+    REQUIRE(hashFrom == vChain[0].GetHash());
+    REQUIRE(hashTo   == vChain[4].GetHash());
+    REQUIRE_FALSE(scheduler.Assign(1, 1000, 1, hashFrom, hashTo));
+
+    REQUIRE(scheduler.Assign(2, 1000, 1, hashFrom, hashTo));
+    REQUIRE(hashFrom == vChain[4].GetHash());
+    REQUIRE(hashTo   == vChain[8].GetHash());
+
+    /* The last window is short, so it waits for all of the headers. */
+    REQUIRE_FALSE(scheduler.Assign(3, 1000, 1, hashFrom, hashTo));
+    REQUIRE_FALSE(scheduler.Requested(3));
+
+    /* Blocks wait until their window is complete. */
+    REQUIRE(scheduler.Deliver(1, vChain[1], 100));
+    REQUIRE(scheduler.Deliver(1, vChain[2], 100));
+
+    std::vector<std::unique_ptr<TAO::Ledger::Block>> vReady;
+    scheduler.Ready(vReady);
+    REQUIRE(vReady.empty());
+
+    /* Both windows stall, and are given to the other peer. */
+    REQUIRE(scheduler.Stalled(runtime::timestamp(true) + 2000) == 2);
+
+    REQUIRE(scheduler.Assign(1, 1000, 1, hashFrom, hashTo));
+    REQUIRE(hashFrom == vChain[4].GetHash());
+    REQUIRE(hashTo   == vChain[8].GetHash());
+
+    REQUIRE(scheduler.Assign(2, 1000, 1, hashFrom, hashTo));
+    REQUIRE(hashFrom == vChain[2].GetHash());
+    REQUIRE(hashTo   == vChain[4].GetHash());
+
+    /* A late block from the peer the window was taken from is still requested and kept. */
+    REQUIRE(scheduler.Requested(1));
+    REQUIRE(scheduler.Requested(2));
+    REQUIRE(scheduler.Deliver(1, vChain[3], 100));
+    REQUIRE(scheduler.Deliver(2, vChain[3], 100));
+    REQUIRE(scheduler.Deliver(2, vChain[4], 100));
+
+    scheduler.Ready(vReady);
+    REQUIRE(vReady.size() == 4);
+    for(uint32_t n = 0; n < vReady.size(); ++n)
+    {
+        REQUIRE(vReady[n]->GetHash() == vChain[n + 1].GetHash());
+    }
+
+    /* Blocks already processed don't belong to a window anymore. */
+    REQUIRE_FALSE(scheduler.Deliver(2, vChain[1], 100));
+
+    /* A peer that stopped part way continues after the last block it sent. */
+    REQUIRE(scheduler.Deliver(1, vChain[5], 100));
+    REQUIRE(scheduler.Deliver(1, vChain[6], 100));
+    REQUIRE(scheduler.Continue(1, vChain[6].GetHash(), hashFrom, hashTo));
+    REQUIRE(hashFrom == vChain[6].GetHash());
+    REQUIRE(hashTo   == vChain[8].GetHash());
+    REQUIRE_FALSE(scheduler.Continue(2, vChain[6].GetHash(), hashFrom, hashTo));
+
+    /* The last block of a window has to match its header. */
+    TAO::Ledger::Block fork = vChain[8];
+    fork.nNonce = 0;
+    REQUIRE_FALSE(scheduler.Deliver(1, fork, 100));
+
+    /* A block that doesn't link drops the window's blocks below it, and the window is given to another peer. */
+    fork = vChain[7];
+    fork.nNonce = 0;
+    REQUIRE(scheduler.Deliver(1, fork, 100));
+    REQUIRE(scheduler.Deliver(1, vChain[8], 100));
+
+    vReady.clear();
+    scheduler.Ready(vReady);
+    REQUIRE(vReady.empty());
+
+    REQUIRE(scheduler.Assign(2, 1000, 1, hashFrom, hashTo));
+    REQUIRE(hashFrom == vChain[4].GetHash());
+    REQUIRE(hashTo   == vChain[8].GetHash());
+
+    for(uint32_t n = 5; n < 8; ++n)
+    {
+        REQUIRE(scheduler.Deliver(2, vChain[n], 100));
+    }
+
+    /* The last window is assigned once the headers are complete. */
+    scheduler.FinishHeaders();
+    REQUIRE(scheduler.Assign(2, 1000, 2, hashFrom, hashTo));
+    REQUIRE(hashFrom == vChain[8].GetHash());
+    REQUIRE(hashTo   == vChain[10].GetHash());
+
+    REQUIRE(scheduler.Deliver(2, vChain[9],  100));
+    REQUIRE(scheduler.Deliver(2, vChain[10], 100));
+
+    scheduler.Ready(vReady);
+    REQUIRE(vReady.size() == 6);
+    for(uint32_t n = 0; n < vReady.size(); ++n)
+    {
+        REQUIRE(vReady[n]->GetHash() == vChain[n + 5].GetHash());
+    }
+
+    REQUIRE(scheduler.Complete());
+
+    /* Late blocks after the synchronization stops aren't unsolicited, but don't belong to a window. */
+    scheduler.Stop();
+    REQUIRE(scheduler.Requested(1));
+    REQUIRE_FALSE(scheduler.Deliver(1, vChain[10], 100));
+}
@@ -265,6 +265,62 @@ TEST_CASE( "Test Finance API - list acccounts", "[finance/list/accounts]")
         REQUIRE(account.find("token") != account.end());
         REQUIRE(account.find("balance") != account.end());
     }
+
+    /* Page through the accounts with a cursor */
+    {
+        /* Get the full list to compare with */
+        params.clear();
+        params["session"] = SESSION1;
+
+        ret = APICall("finance/list/accounts", params);
+        REQUIRE(ret.find("result") != ret.end());
+
+        json::json jsonList = ret["result"];
+
+        /* Read one account per page until the cursor is empty */
+        std::vector<std::string> vAddresses;
+        std::string strCursor = "";
+        do
+        {
+            params.clear();
+            params["session"] = SESSION1;
+            params["limit"] = "1";
+            params["cursor"] = strCursor;
+
+            ret = APICall("finance/list/accounts", params);
+            REQUIRE(ret.find("result") != ret.end());
+            result = ret["result"];
+
+            REQUIRE(result.find("results") != result.end());
+            REQUIRE(result.find("cursor") != result.end());
+            REQUIRE(result["results"].size() <= 1);
+
+            for(const auto& account : result["results"])
+                vAddresses.push_back(account["address"].get<std::string>());
+
+            strCursor = result["cursor"].get<std::string>();
+        }
+        while(!strCursor.empty() && vAddresses.size() <= jsonList.size());
+
+        /* The pages must match the full list */
+        REQUIRE(vAddresses.size() == jsonList.size());
+        for(uint32_t n = 0; n < jsonList.size(); ++n)
+        {
+            REQUIRE(vAddresses[n] == jsonList[n]["address"].get<std::string>());
+        }
+    }
+
+    /* Fail with a cursor from another list */
+    {
+        params.clear();
+        params["session"] = SESSION1;
+        params["cursor"] = "00000000000000000000";
+
+        ret = APICall("finance/list/accounts", params);
+
+        REQUIRE(ret.find("error") != ret.end());
+        REQUIRE(ret["error"]["code"].get<int32_t>() == -306);
+    }
 }
 
 
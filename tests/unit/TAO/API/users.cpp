@@ -17,6 +17,7 @@ ________________________________________________________________________________
 
 #include <LLD/include/global.h>
 
+#include <TAO/Ledger/types/event_queue.h>
 #include <TAO/Ledger/types/mempool.h>
 #include <TAO/Operation/include/execute.h>
 
@@ -704,4 +705,109 @@ TEST_CASE( "Test Users API Recovery User", "[API/users/recover/user]")
         }
     }
 
-}
\ No newline at end of file
+}
+
+
+TEST_CASE( "Test Users API - notifications of other users", "[API/users/list/notifications]")
+{
+    /* Declare variables shared across test cases */
+    json::json params;
+    json::json ret;
+
+    /* Enure that we use low argon2 requirements for unit test to speed up the use of the sig chain */
+    config::SoftSetArg("-argon2", "0");
+    config::SoftSetArg("-argon2_memory", "0");
+
+    /* Ensure User1 is logged out before we start testing.  This is only an issue when not in multiuser mode */
+    if(!config::fMultiuser.load())
+        LogoutUser(GENESIS1, SESSION1);
+
+    std::string strOther = "USER" + std::to_string(LLC::GetRand());
+    uint256_t hashOther = 0;
+
+    /* Create a user that isn't logged in */
+    {
+        /* Build the parameters to pass to the API */
+        params.clear();
+        params["username"] = strOther;
+        params["password"] = PASSWORD;
+        params["pin"] = PIN;
+
+        /* Invoke the API */
+        ret = APICall("users/create/user", params);
+        REQUIRE(ret.find("result") != ret.end());
+
+        /* Write sig chain genesis transaction to disk, so its events are scanned */
+        hashOther.SetHex(ret["result"]["genesis"].get<std::string>());
+        uint512_t txid(ret["result"]["hash"].get<std::string>());
+
+        REQUIRE(LLD::Ledger->WriteGenesis(hashOther, txid));
+
+        TAO::Ledger::Transaction tx;
+        REQUIRE(TAO::Ledger::mempool.Get(txid, tx));
+
+        REQUIRE(LLD::Ledger->WriteTx(txid, tx));
+        REQUIRE(LLD::Ledger->WriteLast(hashOther, txid));
+
+        REQUIRE(TAO::Ledger::mempool.Remove(txid));
+    }
+
+    /* Looking up the notifications of another user doesn't queue its events */
+    std::vector<uint32_t> vSequences;
+    {
+        /* Build the parameters to pass to the API */
+        params.clear();
+        params["genesis"] = hashOther.GetHex();
+
+        /* Invoke the API */
+        ret = APICall("users/list/notifications", params);
+        REQUIRE(ret.find("result") != ret.end());
+
+        REQUIRE_FALSE(TAO::Ledger::EventQueue::GetInstance().Pending(hashOther, vSequences));
+
+        /* Nor by username */
+        params.clear();
+        params["username"] = strOther;
+
+        /* Invoke the API */
+        ret = APICall("users/list/notifications", params);
+        REQUIRE(ret.find("result") != ret.end());
+
+        REQUIRE_FALSE(TAO::Ledger::EventQueue::GetInstance().Pending(hashOther, vSequences));
+    }
+
+    /* The events of a logged in user are queued once they are scanned */
+    std::string strSession;
+    {
+        /* Build the parameters to pass to the API */
+        params.clear();
+        params["username"] = strOther;
+        params["password"] = PASSWORD;
+        params["pin"] = PIN;
+
+        /* Invoke the API */
+        ret = APICall("users/login/user", params);
+        REQUIRE(ret.find("result") != ret.end());
+
+        if(config::fMultiuser.load())
+            strSession = ret["result"]["session"].get<std::string>();
+
+        /* Build the parameters to pass to the API */
+        params.clear();
+        params["session"] = strSession;
+
+        /* Invoke the API */
+        ret = APICall("users/list/notifications", params);
+        REQUIRE(ret.find("result") != ret.end());
+
+        REQUIRE(TAO::Ledger::EventQueue::GetInstance().Pending(hashOther, vSequences));
+    }
+
+    /* Logging out stops queueing them */
+    {
+        const uint256_t hashGenesis = hashOther;
+        LogoutUser(hashOther, strSession);
+
+        REQUIRE_FALSE(TAO::Ledger::EventQueue::GetInstance().Pending(hashGenesis, vSequences));
+    }
+}
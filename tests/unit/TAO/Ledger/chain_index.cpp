@@ -0,0 +1,156 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLD/include/global.h>
+
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/types/chain_index.h>
+#include <TAO/Ledger/types/state.h>
+
+#include <Util/include/runtime.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <vector>
+
+TEST_CASE( "Chain index tests", "[ledger]")
+{
+    /* Make a chain of blocks cycling through the channels. */
+    std::vector<TAO::Ledger::BlockState> vChain;
+    for(uint32_t n = 0; n < 10; ++n)
+    {
+        TAO::Ledger::BlockState state;
+        state.nVersion      = 7;
+        state.nHeight       = n;
+        state.nChannel      = (n % 3);
+        state.nTime         = 1000 + (n * 50);
+        state.nBits         = 100 + n;
+        state.nNonce        = n;
+        state.nChainTrust   = n * 3;
+        state.hashPrevBlock = (n == 0 ? uint1024_t(0) : vChain.back().GetHash());
+
+        vChain.push_back(state);
+    }
+
+    /* Lookups fail until the index is built. */
+    TAO::Ledger::ChainIndex index;
+    REQUIRE_FALSE(index.Ready());
+    REQUIRE_FALSE(index.Has(vChain[0].GetHash()));
+
+    /* Build from genesis and connect the rest. */
+    REQUIRE(index.Initialize(vChain[0]));
+    REQUIRE(index.Ready());
+    for(uint32_t n = 1; n < vChain.size(); ++n)
+        index.Connect(vChain[n]);
+
+    /* Every block is found by hash and height. */
+    for(const auto& state : vChain)
+    {
+        TAO::Ledger::BlockIndex header;
+        REQUIRE(index.Get(state.GetHash(), header));
+        REQUIRE(header.nHeight       == state.nHeight);
+        REQUIRE(header.nChannel      == state.nChannel);
+        REQUIRE(header.nTime         == state.nTime);
+        REQUIRE(header.nBits         == state.nBits);
+        REQUIRE(header.nChainTrust   == state.nChainTrust);
+
+        REQUIRE(index.Get(state.nHeight, header));
+        REQUIRE(header.hashBlock == state.GetHash());
+    }
+
+    /* The last block of a channel is found searching back, stopping at genesis. */
+    {
+        TAO::Ledger::BlockIndex header;
+        REQUIRE(index.Last(vChain[9].GetHash(), 2, header));
+        REQUIRE(header.nHeight == 8);
+
+        REQUIRE(index.Last(vChain[9].GetHash(), 0, header));
+        REQUIRE(header.nHeight == 9);
+
+        REQUIRE(index.Last(vChain[1].GetHash(), 2, header));
+        REQUIRE(header.nHeight == 0);
+
+        REQUIRE(index.Last(7, 2, header));
+        REQUIRE(header.nHeight == 5);
+
+        REQUIRE_FALSE(index.Last(10, 2, header));
+    }
+
+    /* Disconnecting removes the end of the chain. */
+    index.Disconnect(vChain[9]);
+    REQUIRE(index.Ready());
+    REQUIRE_FALSE(index.Has(vChain[9].GetHash()));
+    REQUIRE(index.Has(vChain[8].GetHash()));
+
+    /* Aborting undoes the blocks connected and disconnected since the transaction began. */
+    index.TxnBegin();
+    index.Disconnect(vChain[8]);
+    index.Disconnect(vChain[7]);
+    index.Connect(vChain[7]);
+    REQUIRE_FALSE(index.Has(vChain[8].GetHash()));
+
+    index.TxnAbort();
+    REQUIRE(index.Ready());
+    REQUIRE(index.Has(vChain[8].GetHash()));
+    {
+        TAO::Ledger::BlockIndex header;
+        REQUIRE(index.Get(8, header));
+        REQUIRE(header.hashBlock == vChain[8].GetHash());
+        REQUIRE_FALSE(index.Get(9, header));
+    }
+
+    /* Committing keeps them. */
+    index.TxnBegin();
+    index.Connect(vChain[9]);
+    index.TxnCommit();
+    index.TxnAbort();
+    REQUIRE(index.Has(vChain[9].GetHash()));
+
+    /* A block that doesn't follow the end clears the index. */
+    index.TxnBegin();
+    index.Connect(vChain[5]);
+    REQUIRE_FALSE(index.Ready());
+    REQUIRE_FALSE(index.Has(vChain[0].GetHash()));
+
+    /* Blocks connected until it is rebuilt are kept. */
+    index.Connect(vChain[1]);
+    REQUIRE_FALSE(index.Ready());
+
+    /* It is built again from the best block in the background when the transaction ends. */
+    for(const auto& state : vChain)
+    {
+        REQUIRE(LLD::Ledger->WriteBlock(state.GetHash(), state));
+    }
+
+    const TAO::Ledger::BlockState stateBest = TAO::Ledger::ChainState::stateBest.load();
+    TAO::Ledger::ChainState::stateBest.store(vChain[8]);
+    index.TxnCommit();
+    TAO::Ledger::ChainState::stateBest.store(stateBest);
+
+    /* Blocks connected while it is built are applied when it is done. */
+    index.TxnBegin();
+    index.Connect(vChain[9]);
+    index.TxnCommit();
+
+    for(uint32_t n = 0; n < 1000 && !index.Ready(); ++n)
+        runtime::sleep(10);
+
+    REQUIRE(index.Ready());
+    REQUIRE(index.Has(vChain[0].GetHash()));
+    REQUIRE(index.Has(vChain[9].GetHash()));
+    {
+        TAO::Ledger::BlockIndex header;
+        REQUIRE(index.Get(9, header));
+        REQUIRE(header.hashBlock == vChain[9].GetHash());
+    }
+}
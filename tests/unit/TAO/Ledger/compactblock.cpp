@@ -0,0 +1,63 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <LLC/include/random.h>
+
+#include <TAO/Ledger/include/enum.h>
+#include <TAO/Ledger/types/compactblock.h>
+
+#include <unit/catch2/catch.hpp>
+
+TEST_CASE( "Compact block tests", "[ledger]")
+{
+    /* Build a block with some transactions. */
+    TAO::Ledger::TritiumBlock block;
+    for(uint32_t n = 0; n < 100; ++n)
+        block.vtx.push_back(std::make_pair(uint8_t(TAO::Ledger::TRANSACTION::TRITIUM), LLC::GetRand512()));
+
+    block.vtx.push_back(std::make_pair(uint8_t(TAO::Ledger::TRANSACTION::LEGACY), LLC::GetRand512()));
+    REQUIRE(TAO::Ledger::CompactBlock::Supported(block));
+
+    /* Short ids are packed in the order of the transactions. */
+    const uint64_t nSalt = LLC::GetRand();
+    TAO::Ledger::CompactBlock compact(block, nSalt);
+    REQUIRE(compact.block.vtx.empty());
+    REQUIRE(compact.Size() == block.vtx.size());
+    REQUIRE(compact.vShortIDs.size() == block.vtx.size() * TAO::Ledger::SHORTID_SIZE);
+
+    for(uint32_t n = 0; n < compact.Size(); ++n)
+    {
+        const uint64_t nShortID = TAO::Ledger::ShortID(block.vtx[n].second, nSalt);
+        REQUIRE(compact.GetShortID(n) == nShortID);
+        REQUIRE((nShortID >> (TAO::Ledger::SHORTID_SIZE * 8)) == 0);
+    }
+
+    /* Short ids change with the salt. */
+    REQUIRE(TAO::Ledger::ShortID(block.vtx[0].second, nSalt) != TAO::Ledger::ShortID(block.vtx[0].second, nSalt + 1));
+
+    /* Check the merkle root catches a wrong transaction. */
+    std::vector<uint512_t> vHashes;
+    for(const auto& proof : block.vtx)
+        vHashes.push_back(proof.second);
+    vHashes.push_back(block.producer.GetHash());
+
+    block.hashMerkleRoot = block.BuildMerkleTree(vHashes);
+    REQUIRE(TAO::Ledger::CompactBlock::CheckMerkle(block));
+
+    block.vtx[50].second = LLC::GetRand512();
+    REQUIRE_FALSE(TAO::Ledger::CompactBlock::CheckMerkle(block));
+
+    /* Blocks with other transaction types are sent in full. */
+    block.vtx.push_back(std::make_pair(uint8_t(TAO::Ledger::TRANSACTION::CHECKPOINT), uint512_t(0)));
+    REQUIRE_FALSE(TAO::Ledger::CompactBlock::Supported(block));
+}
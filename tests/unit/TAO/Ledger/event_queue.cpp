@@ -0,0 +1,81 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/Ledger/types/event_queue.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <vector>
+
+TEST_CASE( "Event queue tests", "[ledger]")
+{
+    TAO::Ledger::EventQueue queue;
+
+    const uint256_t hashGenesis = 1;
+    const uint256_t hashOther   = 2;
+
+    /* Events of untracked sigchains are not queued. */
+    std::vector<uint32_t> vSequences;
+    queue.Push(hashGenesis, 0);
+    REQUIRE_FALSE(queue.Pending(hashGenesis, vSequences));
+    REQUIRE(queue.Signal().empty());
+
+    /* Untracked sigchains are not queued when they are scanned. */
+    REQUIRE_FALSE(queue.Begin(hashGenesis));
+    REQUIRE_FALSE(queue.Pending(hashGenesis, vSequences));
+
+    /* Tracked sigchains are only queued once they are scanned. */
+    queue.Track(hashGenesis);
+    queue.Push(hashGenesis, 2);
+    REQUIRE_FALSE(queue.Pending(hashGenesis, vSequences));
+
+    /* Then they queue their events, newest first. */
+    REQUIRE(queue.Begin(hashGenesis));
+    REQUIRE(queue.Pending(hashGenesis, vSequences));
+    REQUIRE(vSequences.empty());
+
+    queue.Push(hashGenesis, 3);
+    queue.Push(hashGenesis, 5);
+    queue.Push(hashGenesis, 4);
+    queue.Push(hashOther, 1);
+
+    REQUIRE(queue.Pending(hashGenesis, vSequences));
+    REQUIRE(vSequences == std::vector<uint32_t>({5, 4, 3}));
+    REQUIRE_FALSE(queue.Pending(hashOther, vSequences));
+
+    /* Only tracked sigchains are signaled, once. */
+    REQUIRE(queue.Signal() == std::vector<uint256_t>({hashGenesis}));
+    REQUIRE(queue.Signal().empty());
+
+    /* Processed events are removed. */
+    queue.Remove(hashGenesis, 4);
+    REQUIRE(queue.Pending(hashGenesis, vSequences));
+    REQUIRE(vSequences == std::vector<uint32_t>({5, 3}));
+
+    /* Untracking drops the pending events, and the sigchain isn't queued again when it is scanned. */
+    queue.Untrack(hashGenesis);
+    REQUIRE_FALSE(queue.Pending(hashGenesis, vSequences));
+    REQUIRE_FALSE(queue.Begin(hashGenesis));
+
+    /* Clearing drops the queued events of every sigchain, which are queued again when scanned. */
+    queue.Track(hashGenesis);
+    queue.Track(hashOther);
+    REQUIRE(queue.Begin(hashGenesis));
+    REQUIRE(queue.Begin(hashOther));
+    queue.Push(hashOther, 7);
+    queue.Clear();
+    REQUIRE_FALSE(queue.Pending(hashGenesis, vSequences));
+    REQUIRE_FALSE(queue.Pending(hashOther, vSequences));
+    REQUIRE(queue.Signal().empty());
+    REQUIRE(queue.Begin(hashOther));
+}
@@ -1676,3 +1676,104 @@ TEST_CASE( "Mempool and memory sequencing tests", "[mempool]")
         TAO::Ledger::mempool.Check();
     }
 }
+
+
+/* Make a transaction for the memory pool indexes, paying a fee. */
+static TAO::Ledger::Transaction MakeTx(const uint256_t& hashGenesis, const uint32_t nSequence, const uint512_t& hashPrevTx,
+                                       const uint64_t nTimestamp, const uint64_t nFee)
+{
+    TAO::Ledger::Transaction tx;
+    tx.hashGenesis = hashGenesis;
+    tx.nSequence   = nSequence;
+    tx.hashPrevTx  = hashPrevTx;
+    tx.nTimestamp  = nTimestamp;
+
+    //payload
+    tx[0] << uint8_t(TAO::Operation::OP::FEE) << TAO::Register::Address(TAO::Register::Address::ACCOUNT) << nFee;
+
+    return tx;
+}
+
+
+TEST_CASE( "Mempool genesis and priority index tests", "[mempool]")
+{
+    TAO::Ledger::Mempool pool;
+
+    const uint256_t hashGenesis1 = TAO::Ledger::SignatureChain::Genesis("indexuser1");
+    const uint256_t hashGenesis2 = TAO::Ledger::SignatureChain::Genesis("indexuser2");
+    const uint256_t hashGenesis3 = TAO::Ledger::SignatureChain::Genesis("indexuser3");
+
+    //a sigchain added out of order is kept in order of sequence
+    TAO::Ledger::Transaction tx10 = MakeTx(hashGenesis1, 0, 0,              100, 0);
+    TAO::Ledger::Transaction tx11 = MakeTx(hashGenesis1, 1, tx10.GetHash(), 101, 0);
+    TAO::Ledger::Transaction tx12 = MakeTx(hashGenesis1, 2, tx11.GetHash(), 102, 0);
+    {
+        REQUIRE(pool.AddUnchecked(tx10));
+        REQUIRE(pool.AddUnchecked(tx12));
+        REQUIRE(pool.AddUnchecked(tx11));
+
+        std::vector<TAO::Ledger::Transaction> vtx;
+        REQUIRE(pool.Get(hashGenesis1, vtx));
+        REQUIRE(vtx.size() == 3);
+        for(uint32_t n = 0; n < vtx.size(); ++n)
+        {
+            REQUIRE(vtx[n].nSequence == n);
+        }
+    }
+
+    //sigchains are listed with the highest fees first, then the oldest
+    TAO::Ledger::Transaction tx20 = MakeTx(hashGenesis2, 0, 0, 300, 50);
+    TAO::Ledger::Transaction tx30 = MakeTx(hashGenesis3, 0, 0, 50,  0);
+    {
+        REQUIRE(pool.AddUnchecked(tx20));
+        REQUIRE(pool.AddUnchecked(tx30));
+
+        std::vector<uint512_t> vHashes;
+        REQUIRE(pool.List(vHashes));
+        REQUIRE(vHashes == std::vector<uint512_t>({tx20.GetHash(), tx30.GetHash(), tx10.GetHash(), tx11.GetHash(), tx12.GetHash()}));
+    }
+
+    //the fees of a sigchain add up over its transactions
+    TAO::Ledger::Transaction tx13 = MakeTx(hashGenesis1, 3, tx12.GetHash(), 103, 100);
+    {
+        REQUIRE(pool.AddUnchecked(tx13));
+
+        std::vector<uint512_t> vHashes;
+        REQUIRE(pool.List(vHashes));
+        REQUIRE(vHashes == std::vector<uint512_t>({tx10.GetHash(), tx11.GetHash(), tx12.GetHash(), tx13.GetHash(), tx20.GetHash(), tx30.GetHash()}));
+    }
+
+    //removing a transaction takes its fees off the sigchain
+    {
+        REQUIRE(pool.Remove(tx13.GetHash()));
+
+        std::vector<uint512_t> vHashes;
+        REQUIRE(pool.List(vHashes));
+        REQUIRE(vHashes == std::vector<uint512_t>({tx20.GetHash(), tx30.GetHash(), tx10.GetHash(), tx11.GetHash(), tx12.GetHash()}));
+    }
+
+    //removing the last transaction of a sigchain removes it from the indexes
+    {
+        REQUIRE(pool.Remove(tx20.GetHash()));
+        REQUIRE_FALSE(pool.Has(hashGenesis2));
+
+        REQUIRE(pool.Remove(tx10.GetHash()));
+        REQUIRE(pool.Remove(tx11.GetHash()));
+        REQUIRE(pool.Has(hashGenesis1));
+
+        REQUIRE(pool.Remove(tx12.GetHash()));
+        REQUIRE_FALSE(pool.Has(hashGenesis1));
+
+        std::vector<uint512_t> vHashes;
+        REQUIRE(pool.List(vHashes));
+        REQUIRE(vHashes == std::vector<uint512_t>({tx30.GetHash()}));
+
+        //a sigchain added again starts from no fees
+        TAO::Ledger::Transaction tx14 = MakeTx(hashGenesis1, 0, 0, 10, 0);
+        REQUIRE(pool.AddUnchecked(tx14));
+
+        vHashes.clear();
+        REQUIRE(pool.List(vHashes));
+        REQUIRE(vHashes == std::vector<uint512_t>({tx14.GetHash(), tx30.GetHash()}));
+    }
+}
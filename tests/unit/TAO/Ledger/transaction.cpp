@@ -13,6 +13,12 @@ ________________________________________________________________________________
 
 #include <TAO/Ledger/types/transaction.h>
 
+#include <TAO/Operation/include/enum.h>
+
+#include <LLC/hash/SK.h>
+
+#include <Util/templates/datastream.h>
+
 #include <unit/catch2/catch.hpp>
 
 //test greater than operator
@@ -39,3 +45,83 @@ TEST_CASE( "Transaction::operator<", "[ledger]" )
     REQUIRE(tx1 < tx2);
     REQUIRE_FALSE(tx2 < tx1);
 }
+
+
+//test the cached hash follows changes to the transaction
+TEST_CASE( "Transaction::GetHash cache", "[ledger]" )
+{
+    TAO::Ledger::Transaction tx;
+    tx.nSequence = 1;
+
+    /* The cached hash should be the same on every call. */
+    const uint512_t hash1 = tx.GetHash();
+    REQUIRE(tx.GetHash() == hash1);
+
+    /* Changing a header field should change the hash. */
+    tx.nSequence = 2;
+    const uint512_t hash2 = tx.GetHash();
+    REQUIRE(hash2 != hash1);
+
+    /* Changing a contract should change the hash. */
+    tx[0] << uint8_t(TAO::Operation::OP::WRITE) << uint256_t(1);
+    const uint512_t hash3 = tx.GetHash();
+    REQUIRE(hash3 != hash2);
+
+    /* A copy should have the same hash. */
+    TAO::Ledger::Transaction tx2 = tx;
+    REQUIRE(tx2.GetHash() == hash3);
+
+    /* A batch should agree with the cached hashes. */
+    std::vector<TAO::Ledger::Transaction> vtx = { tx, tx2 };
+    vtx[1].nSequence = 3;
+
+    std::vector<uint512_t> vHashes;
+    TAO::Ledger::Transaction::GetHashes(vtx, vHashes);
+    REQUIRE(vHashes[0] == hash3);
+    REQUIRE(vHashes[1] == vtx[1].GetHash());
+    REQUIRE(vHashes[1] != hash3);
+}
+
+
+//test the cached hash follows writes into an existing contract
+TEST_CASE( "Transaction::GetHash contract writes", "[ledger]" )
+{
+    /* Get the hash the same as GetHash, without the cache. */
+    auto fresh = [](const TAO::Ledger::Transaction& tx)
+    {
+        DataStream ss(SER_GETHASH, tx.nVersion);
+        ss << tx;
+
+        uint512_t hash = LLC::SK512(ss.begin(), ss.end());
+        hash.SetType(TAO::Ledger::TRITIUM);
+
+        return hash;
+    };
+
+    TAO::Ledger::Transaction tx;
+    tx[0] << uint8_t(TAO::Operation::OP::WRITE) << uint256_t(1);
+    REQUIRE(tx.GetHash() == fresh(tx));
+
+    /* Writing into the same contract should change the hash. */
+    const uint512_t hash1 = tx.GetHash();
+    tx[0] << uint256_t(2);
+    REQUIRE(tx.GetHash() == fresh(tx));
+    REQUIRE(tx.GetHash() != hash1);
+
+    /* Rewriting the contract should change the hash. */
+    tx[0].Clear();
+    tx[0] << uint8_t(TAO::Operation::OP::WRITE) << uint256_t(3);
+    REQUIRE(tx.GetHash() == fresh(tx));
+
+    /* A copy should have the current hash. */
+    TAO::Ledger::Transaction tx2 = tx;
+    REQUIRE(tx2.GetHash() == fresh(tx));
+
+    /* Writing through a reference taken before the hash needs the cache invalidated. */
+    TAO::Operation::Contract& contract = tx[0];
+    const uint512_t hash2 = tx.GetHash();
+    contract << uint256_t(4);
+    tx.invalidate();
+    REQUIRE(tx.GetHash() == fresh(tx));
+    REQUIRE(tx.GetHash() != hash2);
+}
@@ -0,0 +1,97 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <TAO/Ledger/types/validation_pool.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE( "Validation pool tests", "[ledger]")
+{
+    TAO::Ledger::ValidationPool pool(3);
+    REQUIRE(pool.Threads() == 4);
+
+    /* Every item is validated exactly once. */
+    {
+        std::vector<uint8_t> vSeen(10000, 0);
+        bool fValid = pool.ForEach(vSeen.size(), [&vSeen](const uint32_t n)
+        {
+            ++vSeen[n];
+            return true;
+        });
+        REQUIRE(fValid);
+
+        uint32_t nOnce = std::count(vSeen.begin(), vSeen.end(), 1);
+        REQUIRE(nOnce == vSeen.size());
+    }
+
+    /* A failed item fails the batch. */
+    {
+        bool fValid = pool.ForEach(1000, [](const uint32_t n)
+        {
+            return n != 500;
+        });
+        REQUIRE_FALSE(fValid);
+    }
+
+    /* Exceptions fail the batch, and the pool keeps working. */
+    {
+        bool fValid = pool.ForEach(1000, [](const uint32_t n)
+        {
+            if(n == 10)
+                throw std::runtime_error("invalid item");
+
+            return true;
+        });
+        REQUIRE_FALSE(fValid);
+
+        std::atomic<uint32_t> nTotal(0);
+        for(uint32_t nBatch = 0; nBatch < 100; ++nBatch)
+        {
+            fValid = pool.ForEach(100, [&nTotal](const uint32_t n)
+            {
+                ++nTotal;
+                return true;
+            });
+            REQUIRE(fValid);
+        }
+
+        REQUIRE(nTotal.load() == 10000);
+    }
+
+    /* Small batches and pools without workers validate on the calling thread. */
+    {
+        TAO::Ledger::ValidationPool inline_pool(0);
+        REQUIRE(inline_pool.Threads() == 1);
+
+        uint32_t nTotal = 0;
+        bool fValid = inline_pool.ForEach(50, [&nTotal](const uint32_t n)
+        {
+            ++nTotal;
+            return true;
+        });
+        REQUIRE(fValid);
+        REQUIRE(nTotal == 50);
+
+        /* Empty batches are always valid. */
+        fValid = pool.ForEach(0, [](const uint32_t n)
+        {
+            return false;
+        });
+        REQUIRE(fValid);
+    }
+}
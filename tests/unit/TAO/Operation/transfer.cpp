@@ -20,12 +20,17 @@ ________________________________________________________________________________
 #include <TAO/Operation/include/enum.h>
 
 #include <TAO/Register/include/create.h>
+#include <TAO/Register/include/rollback.h>
 #include <TAO/Register/types/address.h>
 
+#include <TAO/Ledger/include/chainstate.h>
+#include <TAO/Ledger/types/genesis.h>
 #include <TAO/Ledger/types/transaction.h>
 
 #include <unit/catch2/catch.hpp>
 
+#include <algorithm>
+
 
 
 TEST_CASE( "Transfer Primitive Tests", "[operation]")
@@ -89,6 +94,11 @@ TEST_CASE( "Transfer Primitive Tests", "[operation]")
 
             //commit to disk
             REQUIRE(Execute(tx[0], TAO::Ledger::FLAGS::BLOCK));
+
+            //check the asset is indexed to its creator
+            std::vector<uint256_t> vOwned;
+            REQUIRE(LLD::Register->ListOwned(hashGenesis, vOwned));
+            REQUIRE(std::find(vOwned.begin(), vOwned.end(), hashAsset) != vOwned.end());
         }
 
         //now transfer the asset to the token which is a forced transfer
@@ -123,9 +133,193 @@ TEST_CASE( "Transfer Primitive Tests", "[operation]")
                    and no claim is required */
                 REQUIRE(asset.hashOwner == hashToken);
             }
+
+            //check the asset is indexed to the token
+            {
+                std::vector<uint256_t> vOwned;
+                REQUIRE(LLD::Register->ListOwned(hashToken, vOwned));
+                REQUIRE(std::find(vOwned.begin(), vOwned.end(), hashAsset) != vOwned.end());
+            }
         }
 
     }
 
 
 }
+
+
+/* Check if a register is in the owner index of a genesis. */
+static bool IsOwned(const uint256_t& hashGenesis, const uint256_t& hashRegister)
+{
+    std::vector<uint256_t> vOwned;
+    LLD::Register->ListOwned(hashGenesis, vOwned);
+
+    return std::find(vOwned.begin(), vOwned.end(), hashRegister) != vOwned.end();
+}
+
+
+TEST_CASE( "Transfer Owner Index Rollback Tests", "[operation]")
+{
+    using namespace TAO::Register;
+    using namespace TAO::Operation;
+
+    uint256_t hashToken    = TAO::Register::Address(TAO::Register::Address::TOKEN);
+    uint256_t hashAsset    = TAO::Register::Address(TAO::Register::Address::OBJECT);
+    uint256_t hashGenesis  = TAO::Ledger::Genesis(LLC::GetRand256(), true);
+    uint256_t hashGenesis2 = TAO::Ledger::Genesis(LLC::GetRand256(), true);
+
+    //rolling back a create removes the register from its owner
+    {
+        //create the transaction object
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = hashGenesis;
+        tx.nSequence   = 0;
+        tx.nTimestamp  = runtime::timestamp();
+
+        //payload
+        tx[0] << uint8_t(OP::CREATE) << hashToken << uint8_t(REGISTER::OBJECT) << CreateToken(hashToken, 1000, 100).GetState();
+
+        //generate the prestates and poststates
+        REQUIRE(tx.Build());
+
+        //verify the prestates and poststates
+        REQUIRE(tx.Verify());
+
+        //commit to disk
+        REQUIRE(Execute(tx[0], TAO::Ledger::FLAGS::BLOCK));
+        REQUIRE(IsOwned(hashGenesis, hashToken));
+
+        //rollback the transaction
+        REQUIRE(Rollback(tx[0]));
+        REQUIRE_FALSE(IsOwned(hashGenesis, hashToken));
+
+        //create the token again for the transfers
+        REQUIRE(Execute(tx[0], TAO::Ledger::FLAGS::BLOCK));
+        REQUIRE(IsOwned(hashGenesis, hashToken));
+    }
+
+    //create the asset to transfer
+    {
+        //create the transaction object
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = hashGenesis;
+        tx.nSequence   = 1;
+        tx.nTimestamp  = runtime::timestamp();
+
+        //create object
+        Object asset = CreateAsset();
+
+        // add some data
+        asset << std::string("data") << uint8_t(TAO::Register::TYPES::STRING) << std::string("somedata");
+
+        //payload
+        tx[0] << uint8_t(OP::CREATE) << hashAsset << uint8_t(REGISTER::OBJECT) << asset.GetState();
+
+        //generate the prestates and poststates
+        REQUIRE(tx.Build());
+
+        //verify the prestates and poststates
+        REQUIRE(tx.Verify());
+
+        //commit to disk
+        REQUIRE(Execute(tx[0], TAO::Ledger::FLAGS::BLOCK));
+        REQUIRE(IsOwned(hashGenesis, hashAsset));
+    }
+
+    //rolling back a forced transfer indexes the register back to its owner
+    {
+        //create the transaction object
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = hashGenesis;
+        tx.nSequence   = 2;
+        tx.nTimestamp  = runtime::timestamp();
+
+        //payload
+        tx[0] << uint8_t(OP::TRANSFER) << hashAsset << hashToken << uint8_t(TRANSFER::FORCE);
+
+        //generate the prestates and poststates
+        REQUIRE(tx.Build());
+
+        //verify the prestates and poststates
+        REQUIRE(tx.Verify());
+
+        //write transaction
+        REQUIRE(LLD::Ledger->WriteTx(tx.GetHash(), tx));
+
+        //commit to disk
+        REQUIRE(Execute(tx[0], TAO::Ledger::FLAGS::BLOCK));
+        REQUIRE(IsOwned(hashToken, hashAsset));
+
+        //rollback the transaction
+        REQUIRE(Rollback(tx[0]));
+        REQUIRE_FALSE(IsOwned(hashToken, hashAsset));
+        REQUIRE(IsOwned(hashGenesis, hashAsset));
+
+        //check the owner
+        State state;
+        REQUIRE(LLD::Register->ReadState(hashAsset, state));
+        REQUIRE(state.hashOwner == hashGenesis);
+    }
+
+    //transfer the asset to be claimed
+    uint512_t hashTx;
+    {
+        //create the transaction object
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = hashGenesis;
+        tx.nSequence   = 3;
+        tx.nTimestamp  = runtime::timestamp();
+
+        //payload
+        tx[0] << uint8_t(OP::TRANSFER) << hashAsset << hashGenesis2 << uint8_t(TRANSFER::CLAIM);
+
+        //generate the prestates and poststates
+        REQUIRE(tx.Build());
+
+        //verify the prestates and poststates
+        REQUIRE(tx.Verify());
+
+        //write transaction
+        REQUIRE(LLD::Ledger->WriteTx(tx.GetHash(), tx));
+        REQUIRE(LLD::Ledger->IndexBlock(tx.GetHash(), TAO::Ledger::ChainState::Genesis()));
+
+        //commit to disk
+        REQUIRE(Execute(tx[0], TAO::Ledger::FLAGS::BLOCK));
+
+        //get claim hash
+        hashTx = tx.GetHash();
+
+        //the sender still lists the register until it is claimed
+        REQUIRE(IsOwned(hashGenesis, hashAsset));
+    }
+
+    //rolling back a claim indexes the register back to its sender
+    {
+        //create the transaction object
+        TAO::Ledger::Transaction tx;
+        tx.hashGenesis = hashGenesis2;
+        tx.nSequence   = 0;
+        tx.nTimestamp  = runtime::timestamp();
+
+        //payload
+        tx[0] << uint8_t(OP::CLAIM) << hashTx << uint32_t(0) << hashAsset;
+
+        //generate the prestates and poststates
+        REQUIRE(tx.Build());
+
+        //verify the prestates and poststates
+        REQUIRE(tx.Verify());
+
+        //commit to disk
+        REQUIRE(Execute(tx[0], TAO::Ledger::FLAGS::BLOCK));
+        REQUIRE(IsOwned(hashGenesis2, hashAsset));
+
+        //remove the sender's index record, so the rollback has to write it again
+        REQUIRE(LLD::Register->EraseOwner(hashGenesis, hashAsset));
+
+        //rollback the transaction
+        REQUIRE(Rollback(tx[0]));
+        REQUIRE_FALSE(IsOwned(hashGenesis2, hashAsset));
+        REQUIRE(IsOwned(hashGenesis, hashAsset));
+    }
+}
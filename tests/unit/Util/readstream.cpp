@@ -0,0 +1,98 @@
+/*__________________________________________________________________________________________
+
+            (c) Hash(BEGIN(Satoshi[2010]), END(Sunny[2012])) == Videlicet[2014] ++
+
+            (c) Copyright The Nexus Developers 2014 - 2019
+
+            Distributed under the MIT software license, see the accompanying
+            file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+            "ad vocem populi" - To the Voice of the People
+
+____________________________________________________________________________________________*/
+
+#include <Util/templates/bufferpool.h>
+#include <Util/templates/datastream.h>
+#include <Util/templates/readstream.h>
+
+#include <unit/catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("Util read stream tests", "[readstream]")
+{
+    DataStream ssData(SER_LLD, 1);
+    ssData << std::string("record") << uint64_t(42) << std::vector<uint8_t>(3, 7);
+
+    /* Reads the same values as a data stream, without owning the bytes. */
+    const ReadStream ssRead(ssData.Bytes(), SER_LLD, 1);
+    REQUIRE(ssRead.size() == ssData.size());
+    REQUIRE(ssRead.data() == ssData.Bytes().data());
+
+    std::string strType;
+    uint64_t nValue = 0;
+    std::vector<uint8_t> vBytes;
+    ssRead >> strType >> nValue >> vBytes;
+
+    REQUIRE(strType == "record");
+    REQUIRE(nValue  == 42);
+    REQUIRE(vBytes  == std::vector<uint8_t>(3, 7));
+    REQUIRE(ssRead.End());
+
+    /* Reading past the end throws and doesn't move the position. */
+    uint8_t nByte = 0;
+    REQUIRE_THROWS_AS(ssRead >> nByte, std::runtime_error);
+    REQUIRE(ssRead.End());
+
+    /* Resetting reads from the start again. */
+    ssRead.Reset();
+    ssRead >> strType;
+    REQUIRE(strType == "record");
+    REQUIRE(ssRead.GetPos() == 7);
+
+    /* Reads part of a buffer. */
+    const ReadStream ssPart(ssData.Bytes().data() + 7, ssData.Bytes().data() + 15, SER_LLD, 1);
+    ssPart >> nValue;
+    REQUIRE(nValue == 42);
+    REQUIRE(ssPart.End());
+}
+
+
+TEST_CASE("Util buffer pool tests", "[bufferpool]")
+{
+    /* Empty the pool of this thread. */
+    while(BufferPool::Size() > 0)
+        BufferPool::Get();
+
+    /* Buffers given back are reused with their capacity. */
+    const uint8_t* pData = nullptr;
+    {
+        PooledStream ssData(SER_LLD, 1);
+        ssData << uint64_t(42);
+
+        pData = ssData.Bytes().data();
+    }
+    REQUIRE(BufferPool::Size() == 1);
+
+    {
+        PooledStream ssData(SER_LLD, 1);
+        REQUIRE(ssData.size() == 0);
+        REQUIRE(ssData.Bytes().capacity() >= 8);
+        REQUIRE(ssData.Bytes().data() == pData);
+        REQUIRE(BufferPool::Size() == 0);
+    }
+    REQUIRE(BufferPool::Size() == 1);
+
+    /* Buffers that are too large or empty aren't kept. */
+    BufferPool::Put(std::vector<uint8_t>(BufferPool::MAX_CAPACITY + 1));
+    BufferPool::Put(std::vector<uint8_t>());
+    REQUIRE(BufferPool::Size() == 1);
+
+    /* No more than the maximum buffers are kept. */
+    for(uint32_t n = 0; n < BufferPool::MAX_BUFFERS + 4; ++n)
+        BufferPool::Put(std::vector<uint8_t>(16));
+
+    REQUIRE(BufferPool::Size() == BufferPool::MAX_BUFFERS);
+}